@@ -49,10 +49,11 @@ def SetupExtraOutput(config, file_num=0, logger=None):
         all_keys = [ k for k in valid_extra_outputs.keys() if k in output ]
 
         # We don't need the manager stuff if we (a) are already in a multiprocessing Process, or
-        # (b) config.image.nproc == 1.
+        # (b) config.image.nproc == 1, or (c) config.image.nproc refers to threads.
         use_manager = (
                 'current_nproc' not in config and
                 'image' in config and 'nproc' in config['image'] and
+                not galsim.config.UseThreads(config) and
                 galsim.config.ParseValue(config['image'], 'nproc', config, int)[0] != 1 )
 
         if use_manager and 'output_manager' not in config:
@@ -89,7 +89,8 @@ def BuildImages(nimages, config, image_num=0, obj_num=0, logger=None):
 
     images = galsim.config.MultiProcess(nproc, config, BuildImage, tasks, 'image', logger,
                                         done_func = done_func,
-                                        except_func = except_func)
+                                        except_func = except_func,
+                                        use_threads = galsim.config.UseThreads(config))
 
     if logger:
         logger.debug('file %d: Done making images',config.get('file_num',0))
@@ -180,7 +181,7 @@ def SetupConfigImageSize(config, xsize, ysize):
 
 # Ignore these when parsing the parameters for specific Image types:
 image_ignore = [ 'random_seed', 'draw_method', 'noise', 'pixel_scale', 'wcs',
-                 'sky_level', 'sky_level_pixel', 'index_convention', 'nproc',
+                 'sky_level', 'sky_level_pixel', 'index_convention', 'nproc', 'use_threads',
                  'retry_failures', 'n_photons', 'wmult', 'offset', 'gsparams' ]
 
 
@@ -18,6 +18,7 @@
 
 import galsim
 import logging
+import numpy as np
 
 # This file adds image type Scattered, which places individual stamps at arbitrary
 # locations on a larger image.
@@ -51,7 +52,7 @@ class ScatteredImageBuilder(ImageBuilder):
         # These are allowed for Scattered, but we don't use them here.
         extra_ignore = [ 'image_pos', 'world_pos', 'stamp_size', 'stamp_xsize', 'stamp_ysize',
                          'nobjects' ]
-        opt = { 'size' : int , 'xsize' : int , 'ysize' : int }
+        opt = { 'size' : int , 'xsize' : int , 'ysize' : int, 'tile_size' : int }
         params = galsim.config.GetAllParams(config, base, opt=opt, ignore=ignore+extra_ignore)[0]
 
         # Special check for the size.  Either size or both xsize and ysize is required.
@@ -71,6 +72,11 @@ class ScatteredImageBuilder(ImageBuilder):
             full_xsize = params['size']
             full_ysize = params['size']
 
+        # If tile_size is given, the image is built up in tiles, so adding each stamp only
+        # touches a few contiguous blocks of memory.  This is only worth it for very large
+        # images with many objects.  tile_size = 0 (the default) means to use a normal image.
+        self.tile_size = params.get('tile_size', 0)
+
         # If image_force_xsize and image_force_ysize were set in config, make sure it matches.
         if ( ('image_force_xsize' in base and full_xsize != base['image_force_xsize']) or
              ('image_force_ysize' in base and full_ysize != base['image_force_ysize']) ):
@@ -96,10 +102,19 @@ class ScatteredImageBuilder(ImageBuilder):
         full_ysize = base['image_ysize']
         wcs = base['wcs']
 
-        full_image = galsim.ImageF(full_xsize, full_ysize)
-        full_image.setOrigin(base['image_origin'])
-        full_image.wcs = wcs
-        full_image.setZero()
+        origin = base['image_origin']
+        full_bounds = galsim.BoundsI(origin.x, origin.x + full_xsize-1,
+                                     origin.y, origin.y + full_ysize-1)
+
+        # When building in tiles, the full image isn't allocated until the tiles are done,
+        # so we don't need to hold two copies of the image while adding the stamps.
+        if self.tile_size > 0:
+            tiled_image = galsim._galsim.TiledImage[np.float32](full_bounds, self.tile_size)
+        else:
+            tiled_image = None
+            full_image = galsim.ImageF(full_bounds)
+            full_image.wcs = wcs
+            full_image.setZero()
 
         if 'image_pos' in config and 'world_pos' in config:
             raise AttributeError("Both image_pos and world_pos specified for Scattered image.")
@@ -123,21 +138,33 @@ class ScatteredImageBuilder(ImageBuilder):
         for k in range(self.nobjects):
             # This is our signal that the object was skipped.
             if stamps[k] is None: continue
-            bounds = stamps[k].bounds & full_image.bounds
+            bounds = stamps[k].bounds & full_bounds
             if logger:
-                logger.debug('image %d: full bounds = %s',image_num,str(full_image.bounds))
+                logger.debug('image %d: full bounds = %s',image_num,str(full_bounds))
                 logger.debug('image %d: stamp %d bounds = %s',image_num,k,str(stamps[k].bounds))
                 logger.debug('image %d: Overlap = %s',image_num,str(bounds))
             if bounds.isDefined():
-                full_image[bounds] += stamps[k][bounds]
+                if tiled_image is not None:
+                    stamp = stamps[k][bounds]
+                    if stamp.dtype != np.float32:
+                        stamp = galsim.ImageF(stamp)
+                    tiled_image.addImage(stamp.image)
+                else:
+                    full_image[bounds] += stamps[k][bounds]
             else:
                 if logger:
                     logger.warning(
                         "Object centered at (%d,%d) is entirely off the main image,\n"%(
                             stamps[k].bounds.center().x, stamps[k].bounds.center().y) +
                         "whose bounds are (%d,%d,%d,%d)."%(
-                            full_image.bounds.xmin, full_image.bounds.xmax,
-                            full_image.bounds.ymin, full_image.bounds.ymax))
+                            full_bounds.xmin, full_bounds.xmax,
+                            full_bounds.ymin, full_bounds.ymax))
+
+        if tiled_image is not None:
+            full_image = galsim.ImageF(full_bounds)
+            full_image.wcs = wcs
+            tiled_image.assignTo(full_image.image.view())
+            del tiled_image
 
         # Bring the image so far up to a flat noise variance
         current_var = galsim.config.FlattenNoiseVariance(
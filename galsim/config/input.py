@@ -96,11 +96,13 @@ def ProcessInput(config, file_num=0, logger=None, file_scope_only=False, safe_on
 
         # We don't need the manager stuff if we (a) are already in a multiprocessing Process, or
         # (b) we are only loading for file scope, or (c) both config.image.nproc and
-        # config.output.nproc == 1.
+        # config.output.nproc == 1, or (d) config.image.nproc refers to threads, which can
+        # share the input objects directly, and config.output.nproc == 1.
         use_manager = (
                 'current_nproc' not in config and
                 not file_scope_only and
                 ( ('image' in config and 'nproc' in config['image'] and
+                   not galsim.config.UseThreads(config) and
                    galsim.config.ParseValue(config['image'], 'nproc', config, int)[0] != 1) or
                   ('output' in config and 'nproc' in config['output'] and
                    galsim.config.ParseValue(config['output'], 'nproc', config, int)[0] != 1) ) )
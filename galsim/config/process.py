@@ -239,6 +239,9 @@ def CopyConfig(config):
     # Make sure the input_manager isn't in the copy
     config1.pop('input_manager',None)
 
+    # Each copy accumulates its own stage times.
+    config1.pop('_stage_times',None)
+
     # Now deepcopy all the regular config fields to make sure things like current_val don't
     # get clobbered by two processes writing to the same dict.
     if 'gal' in config:
@@ -249,6 +252,8 @@ def CopyConfig(config):
         config1['pix'] = copy.deepcopy(config['pix'])
     if 'image' in config:
         config1['image'] = copy.deepcopy(config['image'])
+    if 'stamp' in config:
+        config1['stamp'] = copy.deepcopy(config['stamp'])
     if 'input' in config:
         config1['input'] = copy.deepcopy(config['input'])
     if 'output' in config:
@@ -358,6 +363,41 @@ def UpdateNProc(nproc, ntot, config, logger=None):
     return nproc
 
 
+def UseThreads(config):
+    """Check whether image.use_threads is set in the config dict.
+
+    If it is, then image.nproc is the number of threads to use for building images and stamps,
+    rather than the number of processes.  The threads all run in the current process, so they
+    share the input objects (catalogs, power spectrum grids, etc.) and the C++ caches, rather
+    than each process building its own copy.  The completed images are also passed back
+    directly, without needing to be pickled.
+
+    The drawing itself is done in C++ without holding the python GIL, so the threads can draw
+    different stamps at the same time.  The rest of the processing (parsing the config dict,
+    building the profiles, adding noise) is still done one thread at a time.  So this is most
+    effective when most of the time is spent drawing.
+
+    @param config       The configuration dict.
+
+    @returns whether to use threads rather than processes.
+    """
+    if 'image' in config and 'use_threads' in config['image']:
+        return galsim.config.ParseValue(config['image'], 'use_threads', config, bool)[0]
+    else:
+        return False
+
+def AddStageTime(config, stage, t):
+    """Add to the total time spent in some stage of the processing.
+
+    These are reported by MultiProcess once all the jobs are done.
+
+    @param config       The configuration dict.
+    @param stage        The name of the stage (e.g. 'draw').
+    @param t            The time taken.
+    """
+    stage_times = config.setdefault('_stage_times', OrderedDict())
+    stage_times[stage] = stage_times.get(stage, 0.) + t
+
 def SetupConfigRNG(config, seed_offset=0):
     """Set up the RNG in the config dict.
 
@@ -659,7 +699,7 @@ def Process(config, logger=None, njobs=1, job=1, new_params=None):
 
 
 def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
-                 done_func=None, except_func=None, except_abort=True):
+                 done_func=None, except_func=None, except_abort=True, use_threads=False):
     """A helper function for performing a task using multiprocessing.
 
     A note about the nomenclature here.  We use the term "job" to mean the job of building a single
@@ -673,6 +713,12 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
     Each job is a tuple consisting of (kwargs, k), where kwargs is the dict of kwargs to pass to
     the job_func and k is the index of this job in the full list of jobs.
 
+    Any time recorded with AddStageTime while doing the jobs is summed over all the jobs and
+    reported at the end (at the info level).  When using more than one process, the tail
+    latency is also reported.  This is the time from when the first process runs out of jobs
+    to do until the last one finishes.  If this is a large fraction of the total time, then
+    the work was not shared out very evenly.
+
     @param nproc            How many processes to use.
     @param config           The configuration dict.
     @param job_func         The function to run for each job.  It will be called as
@@ -693,20 +739,21 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
     @param except_abort     Whether an exception should abort the rest of the processing.
                             If False, then the returned results list will not include anything
                             for the jobs that failed.  [default: True]
+    @param use_threads      Whether to use nproc threads in this process rather than nproc
+                            separate processes.  See UseThreads for details. [default: False]
 
     @returns a list of the outputs from job_func for each job
     """
     import time
 
-    # The worker function will be run once in each process.
+    # The worker function will be run once in each process (or thread).
     # It pulls tasks off the task_queue, runs them, and puts the results onto the results_queue
     # to send them back to the main process.
     # The *tasks* can be made up of more than one *job*.  Each job involves calling job_func
     # with the kwargs from the list of jobs.
     # Each job also carries with it its index in the original list of all jobs.
-    def worker(task_queue, results_queue, config, logger):
-        proc = current_process().name
-
+    # When it is done, it sends back the time spent in each stage, with k = None.
+    def worker(task_queue, results_queue, config, logger, proc):
         # The logger object passed in here is a proxy object.  This means that all the arguments
         # to any logging commands are passed through the pipe to the real Logger object on the
         # other end of the pipe.  This tends to produce a lot of unnecessary communication, since
@@ -745,6 +792,7 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
                 results_queue.put( (e, k, tr, proc) )
         if logger:
             logger.debug('%s: Received STOP', proc)
+        results_queue.put( (config.pop('_stage_times',None), None, 0., proc) )
         if pr:
             pr.disable()
             s = io.StringIO()
@@ -756,12 +804,34 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
 
     njobs = sum([len(task) for task in tasks])
 
+    # Keep the stage times from any outer level separate from the ones for these jobs.
+    outer_stage_times = config.pop('_stage_times',None)
+    stage_times = OrderedDict()
+    def add_stage_times(times):
+        if times:
+            for stage in times:
+                stage_times[stage] = stage_times.get(stage, 0.) + times[stage]
+    t0 = time.time()
+
     if nproc > 1:
-        if logger:
-            logger.warning("Using %d processes for %s processing",nproc,item)
+        if use_threads:
+            if logger:
+                logger.warning("Using %d threads for %s processing",nproc,item)
+
+            import threading
+            try:
+                from queue import Queue
+            except ImportError:
+                from Queue import Queue
+            Worker = threading.Thread
+            worker_name = 'Thread-%d'
+        else:
+            if logger:
+                logger.warning("Using %d processes for %s processing",nproc,item)
 
-        from multiprocessing import Process, Queue, current_process
-        from multiprocessing.managers import BaseManager
+            from multiprocessing import Process, Queue
+            Worker = Process
+            worker_name = 'Process-%d'
 
         # Send the tasks to the task_queue.
         task_queue = Queue()
@@ -772,9 +842,13 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
         # round of multiprocessing later.
         config['current_nproc'] = nproc
 
-        # The logger is not picklable, so we need to make a proxy for it so all the
-        # processes can emit logging information safely.
-        logger_proxy = GetLoggerProxy(logger)
+        if use_threads:
+            # The threads can all use the logger directly.
+            logger_proxy = logger
+        else:
+            # The logger is not picklable, so we need to make a proxy for it so all the
+            # processes can emit logging information safely.
+            logger_proxy = GetLoggerProxy(logger)
 
         # Run the tasks.
         # Each Process command starts up a parallel process that will keep checking the queue
@@ -788,8 +862,20 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
             # multiprocessing, then it just keeps incrementing the numbers, rather than starting
             # over at Process-1.  As far as I can tell, it's not actually spawning more
             # processes, so for the sake of the logging output, we name the processes explicitly.
-            p = Process(target=worker, args=(task_queue, results_queue, config, logger_proxy),
-                        name='Process-%d'%(j+1))
+            if use_threads:
+                # The processes each get a pickled copy of the config dict, but the threads need
+                # to be given their own copy explicitly.  The input objects themselves are
+                # shared, but each thread gets its own lists of them, since they may be
+                # updated for each image.
+                config1 = CopyConfig(config)
+                if 'input_objs' in config:
+                    config1['input_objs'] = dict([ (key, list(value)) for key, value
+                                                   in config['input_objs'].items() ])
+            else:
+                config1 = config
+            p = Worker(target=worker,
+                       args=(task_queue, results_queue, config1, logger_proxy, worker_name%(j+1)),
+                       name=worker_name%(j+1))
             p.start()
             p_list.append(p)
 
@@ -797,8 +883,11 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
         # results_queue and put them in the appropriate place in the lists.
         # This loop is happening while the other processes are still working on their tasks.
         results = [ None for k in range(njobs) ]
+        # The time each process finished its last job, for the tail latency.
+        last_done = dict([ (worker_name%(j+1), t0) for j in range(nproc) ])
         for kk in range(njobs):
             res, k, t, proc = results_queue.get()
+            last_done[proc] = time.time()
             if isinstance(res,Exception):
                 # res is really the exception, e
                 # t is really the traceback
@@ -806,8 +895,21 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
                 if except_func is not None:
                     except_func(logger, proc, k, res, t)
                 if except_abort:
-                    for j in range(nproc):
-                        p_list[j].terminate()
+                    if use_threads:
+                        # Threads cannot be terminated, so clear out the remaining tasks and
+                        # let them finish what they are doing.
+                        while not task_queue.empty():
+                            task_queue.get()
+                        for j in range(nproc):
+                            task_queue.put('STOP')
+                        for j in range(nproc):
+                            p_list[j].join()
+                    else:
+                        for j in range(nproc):
+                            p_list[j].terminate()
+                    config['current_nproc'] = nproc
+                    if outer_stage_times is not None:
+                        config['_stage_times'] = outer_stage_times
                     raise res
             else:
                 # The normal case
@@ -823,11 +925,17 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
         # This is important, because the program will keep running as long as there are running
         # processes, even if the main process gets to the end.  So you do want to make sure to
         # add those 'STOP's at some point!
+        tail = max(last_done.values()) - min(last_done.values())
         for j in range(nproc):
             task_queue.put('STOP')
+        # Each one sends back its stage times when it stops.
+        for j in range(nproc):
+            res, k, t, proc = results_queue.get()
+            add_stage_times(res)
         for j in range(nproc):
             p_list[j].join()
-        task_queue.close()
+        if not use_threads:
+            task_queue.close()
 
         # And clear this out, so we know that we're not multiprocessing anymore.
         config['current_nproc'] = nproc
@@ -852,7 +960,21 @@ def MultiProcess(nproc, config, job_func, tasks, item, logger=None,
                     tr = traceback.format_exc()
                     if except_func is not None:
                         except_func(logger, None, k, e, tr)
-                    if except_abort: raise
+                    if except_abort:
+                        config.pop('_stage_times',None)
+                        if outer_stage_times is not None:
+                            config['_stage_times'] = outer_stage_times
+                        raise
+        add_stage_times(config.pop('_stage_times',None))
+
+    if logger and (nproc > 1 or stage_times):
+        times = [ 'total = %f sec'%(time.time()-t0) ]
+        if nproc > 1:
+            times.append('tail latency = %f sec'%tail)
+        times += [ '%s = %f sec'%(stage, stage_times[stage]) for stage in stage_times ]
+        logger.info('Time spent building %d %ss: %s', njobs, item, ', '.join(times))
+    if outer_stage_times is not None:
+        config['_stage_times'] = outer_stage_times
 
     # If there are any failures, then there will still be some Nones in the results list.
     # Remove them.
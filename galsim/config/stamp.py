@@ -18,6 +18,7 @@
 
 import galsim
 import logging
+import time
 import numpy as np
 
 # This file handles the building of postage stamps to place onto a larger image.
@@ -98,10 +99,13 @@ def BuildStamps(nobjects, config, obj_num=0,
     # Convert to the tasks structure we need for MultiProcess.
     # Each task is a list of (job, k) tuples.
     tasks = MakeStampTasks(config, jobs, logger)
+    if nproc > 1:
+        tasks = OrderStampTasks(config, tasks, logger)
 
     results = galsim.config.MultiProcess(nproc, config, BuildStamp, tasks, 'stamp', logger,
                                          done_func = done_func,
-                                         except_func = except_func)
+                                         except_func = except_func,
+                                         use_threads = galsim.config.UseThreads(config))
 
     if not results:
         images, current_vars = [], []
@@ -287,6 +291,7 @@ def BuildStamp(config, obj_num=0, xsize=0, ysize=0, do_noise=True, logger=None):
         # On the last time through, we reraise any exception caught.
         # If no exception is thrown, we simply break the loop and return.
         try:
+            t1 = time.time()
 
             # Do the necessary initial setup for this stamp type.
             xsize, ysize, image_pos, world_pos = builder.setup(
@@ -331,6 +336,8 @@ def BuildStamp(config, obj_num=0, xsize=0, ysize=0, do_noise=True, logger=None):
                 #       things like ring tests that rely on objects being made in pairs.
 
             im = builder.makeStamp(stamp, config, xsize, ysize, logger)
+            t2 = time.time()
+            galsim.config.AddStageTime(config, 'setup', t2-t1)
 
             if not skip:
                 if 'draw_method' in stamp:
@@ -350,6 +357,8 @@ def BuildStamp(config, obj_num=0, xsize=0, ysize=0, do_noise=True, logger=None):
 
                 scale_factor = builder.getSNRScale(im, stamp, config, logger)
                 im, prof = builder.applySNRScale(im, prof, scale_factor, method, logger)
+            t3 = time.time()
+            galsim.config.AddStageTime(config, 'draw', t3-t2)
 
             # Set the origin appropriately
             if im is None:
@@ -385,6 +394,8 @@ def BuildStamp(config, obj_num=0, xsize=0, ysize=0, do_noise=True, logger=None):
                                 "you should specify a larger stamp.retry_failures.")
 
             galsim.config.ProcessExtraOutputsForStamp(config, logger)
+            t4 = time.time()
+            galsim.config.AddStageTime(config, 'extra', t4-t3)
 
             # We always need to do the whiten step here in the stamp processing
             if not skip:
@@ -399,6 +410,7 @@ def BuildStamp(config, obj_num=0, xsize=0, ysize=0, do_noise=True, logger=None):
             # Sometimes, depending on the image type, we go on to do the rest of the noise as well.
             if do_noise:
                 im, current_var = builder.addNoise(stamp,config,im,skip,current_var,logger)
+            galsim.config.AddStageTime(config, 'noise', time.time()-t4)
 
             return im, current_var
 
@@ -445,6 +457,57 @@ def MakeStampTasks(config, jobs, logger):
     return valid_stamp_types[stamp_type].makeTasks(stamp, config, jobs, logger)
 
 
+def OrderStampTasks(config, tasks, logger):
+    """Sort a list of tasks so the ones that are expected to take the longest are done first.
+
+    The processes (or threads) each take the next task from a common queue whenever they finish
+    one, so the work is always shared out to whichever ones are free.  But if an expensive
+    stamp (e.g. a bright star drawn with photon shooting) is near the end of the list, one
+    process can still be left working on it long after the others have run out of things to do.
+    Doing the expensive ones first avoids this.
+
+    The cost of each stamp is estimated by the estimateCost method of the stamp builder.  This
+    is done using a copy of the config dict, so the config dict is not changed.  The results
+    are put back in the original order by MultiProcess, so the output does not depend on the
+    order in which the stamps are built.
+
+    @param config           The configuration dict
+    @param tasks            A list of tasks, as returned by MakeStampTasks.
+    @param logger           If given, a logger object to log progress.
+
+    @returns the sorted list of tasks
+    """
+    stamp = config.get('stamp', {})
+    stamp_type = stamp.get('type', 'Basic')
+    builder = valid_stamp_types[stamp_type]
+
+    config1 = galsim.config.CopyConfig(config)
+    costs = []
+    for task in tasks:
+        cost = 0.
+        for kwargs, k in task:
+            obj_num = kwargs['obj_num']
+            try:
+                SetupConfigObjNum(config1, obj_num)
+                galsim.config.SetupConfigRNG(config1, seed_offset=1)
+                cost += builder.estimateCost(config1['stamp'], config1,
+                                             kwargs['xsize'], kwargs['ysize'], logger)
+            except KeyboardInterrupt:
+                raise
+            except Exception as e:
+                # This is only a heuristic, so if we cannot figure out the cost, that's fine.
+                if logger:
+                    logger.debug('obj %d: Unable to estimate cost: %s',obj_num,str(e))
+                cost += 1.
+        costs.append(cost)
+    if logger:
+        logger.debug('image %d: Estimated stamp costs = %s',config.get('image_num',0),costs)
+
+    # Python's sort is stable, so tasks with equal costs stay in their original order.
+    order = sorted(range(len(tasks)), key=lambda i: -costs[i])
+    return [ tasks[i] for i in order ]
+
+
 def DrawBasic(prof, image, method, offset, config, base, logger, **kwargs):
     """The basic implementation of the draw command
 
@@ -840,6 +903,76 @@ class StampBuilder(object):
             current_var = galsim.config.AddNoise(base,image,current_var,logger)
         return image, current_var
 
+    # The approximate cost per pixel (or per photon) of drawing different kinds of profiles,
+    # relative to a simple analytic profile like a Gaussian.
+    _cost_factors = {
+        'Sersic' : 3., 'DeVaucouleurs' : 3., 'Spergel' : 3., 'Kolmogorov' : 3.,
+        'Airy' : 3., 'OpticalPSF' : 10., 'InterpolatedImage' : 10., 'RealGalaxy' : 10.,
+        'RealGalaxyOriginal' : 10., 'COSMOSGalaxy' : 10., 'Shapelet' : 5.,
+    }
+
+    def estimateCost(self, config, base, xsize, ysize, logger):
+        """Estimate the relative cost of building the current stamp.
+
+        This is used to decide the order in which the stamps are built when there are multiple
+        processes.  (cf. OrderStampTasks)  Only the relative values matter, and they only need
+        to be accurate to within a factor of a few, since the costs of different stamps can
+        easily differ by factors of thousands.
+
+        The base config dict has been set up for the current obj_num, but setup has not been
+        run yet.  If this raises an exception, the stamp is given a nominal cost.
+
+        For the Basic stamp type, the estimate is based on the draw method, the size of the
+        stamp, the types of the gal and psf profiles, and for photon shooting, the number of
+        photons (or the flux).
+
+        @param config       The configuration dict for the stamp field.
+        @param base         The base configuration dict.
+        @param xsize        The xsize of the image to build (if known).
+        @param ysize        The ysize of the image to build (if known).
+        @param logger       If given, a logger object to log progress.
+
+        @returns the estimated cost
+        """
+        import math
+        xsize, ysize, image_pos, world_pos = self.setup(
+                config, base, xsize, ysize, stamp_ignore, logger)
+        # Automatically sized stamps are typically something like this size.
+        if not xsize: xsize = 64
+        if not ysize: ysize = 64
+        area = float(xsize * ysize)
+
+        factor = 1.
+        gal = base.get('gal', None)
+        psf = base.get('psf', None)
+        for field in [gal, psf]:
+            if isinstance(field, dict) and field.get('type',None) in self._cost_factors:
+                factor = max(factor, self._cost_factors[field['type']])
+
+        if 'draw_method' in config:
+            method = galsim.config.ParseValue(config,'draw_method',base,str)[0]
+        else:
+            method = 'auto'
+
+        if method == 'phot':
+            if 'nphotons' in config:
+                nphot = galsim.config.ParseValue(config,'nphotons',base,float)[0]
+            elif isinstance(gal, dict) and 'flux' in gal:
+                nphot = galsim.config.ParseValue(gal,'flux',base,float)[0]
+            else:
+                nphot = 1.
+            return area + factor * abs(nphot)
+        elif method == 'real_space':
+            # Real-space convolution needs a 2-d integral for each pixel.
+            return 100. * factor * area
+        elif method in ['no_pixel', 'sb']:
+            return factor * area
+        else:
+            # The FFT is typically done on an image that is about 4 times larger (in each
+            # direction) than the stamp.
+            nfft = 16. * area
+            return factor * nfft + nfft * math.log(nfft, 2)
+
     def makeTasks(self, config, base, jobs, logger):
         """Turn a list of jobs into a list of tasks.
 
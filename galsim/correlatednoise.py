@@ -74,6 +74,16 @@ class _BaseCorrelatedNoise(object):
     these correlation properties, and generate covariance matrices according to the correlation
     function.
     """
+    # The maximum number of square-rooted power spectra to keep for reuse (for different image
+    # shapes and wcs's, and for normal, whitening and symmetrizing noise).
+    _max_stored = 10
+    # Images that are larger than this along either side get their noise made in tiles, rather
+    # than with a single FFT of the whole image.  See applyTo() for details.
+    _max_periodic_size = 2048
+    # The size of the FFTs used for each tile, and the largest kernel to use with them.
+    _noise_tile_size = 512
+    _max_kernel_size = 256
+
     def __init__(self, rng, gsobject, wcs):
 
         if rng is not None and not isinstance(rng, galsim.BaseDeviate):
@@ -89,16 +99,15 @@ class _BaseCorrelatedNoise(object):
         self._profile = gsobject
         self.wcs = wcs
 
-        # When applying normal or whitening noise to an image, we normally do calculations.
-        # If _profile_for_stored is profile, then it means that we can use the stored values in
-        # _rootps_store, _rootps_whitening_store, and/or _rootps_symmetrizing_store and avoid having
-        # to redo the calculations.
-        # So for now, we start out with _profile_for_stored = None, and _rootps_store,
-        # _rootps_whitening_store, _rootps_symmetrizing_store empty.
+        # When applying normal, whitening or symmetrizing noise to an image, we normally do
+        # calculations.  If _profile_for_stored is profile, then it means that we can use the
+        # stored values in _rootps_store and avoid having to redo the calculations.
+        # _rootps_store is a list of (key, value) pairs, with the most recently used first, where
+        # the key is the kind of noise, the shape of the power spectrum grid and the wcs (and for
+        # symmetrizing noise, the order).  See _get_stored() and _set_stored().
+        # So for now, we start out with _profile_for_stored = None, and _rootps_store empty.
         self._profile_for_stored = None
         self._rootps_store = []
-        self._rootps_whitening_store = []
-        self._rootps_symmetrizing_store = []
         # Also set up the cache for a stored value of the variance, needed for efficiency once the
         # noise field can get convolved with other GSObjects making isAnalyticX() False
         self._variance_stored = None
@@ -199,6 +208,15 @@ class _BaseCorrelatedNoise(object):
         avoid this property being present in your final `image` you should add the noise to an
         `image` of greater extent than you need, and take a subset.
 
+        The exception is for very large images (more than 2048 pixels along either side), for
+        which a single FFT of the whole image would need a lot of memory.  For these, the
+        correlation function is only drawn on a grid large enough to hold it, and the noise is
+        made by convolving white noise with the corresponding kernel one tile at a time, using
+        FFTs of a fixed size.  The tiles are done in parallel if GalSim was compiled with OpenMP.
+        The noise made this way is not periodic.  If the correlation function is too large for
+        this (more than 256 pixels across, as judged from its stepK), a warning is issued and a
+        single FFT of the whole image is used after all.
+
         @param image The input Image object.
         """
         # Note that this uses the (fast) method of going via the power spectrum and FFTs to generate
@@ -213,15 +231,6 @@ class _BaseCorrelatedNoise(object):
         if not image.bounds.isDefined():
             raise ValueError("Input image argument must have defined bounds.")
 
-        # If the profile has changed since last time (or if we have never been here before),
-        # clear out the stored values.
-        if self._profile_for_stored is not self._profile:
-            self._rootps_store = []
-            self._rootps_whitening_store = []
-            self._variance_stored = None
-        # Set profile_for_stored for next time.
-        self._profile_for_stored = self._profile
-
         if image.wcs is not None and not image.wcs.isUniform():
             raise NotImplementedError("Sorry, correlated noise cannot be applied to an "+
                                       "image with a non-uniform WCS.")
@@ -232,13 +241,11 @@ class _BaseCorrelatedNoise(object):
             wcs = image.wcs
 
         # Then retrieve or redraw the sqrt(power spectrum) needed for making the noise field
-        rootps = self._get_update_rootps(image.array.shape, wcs)
-
-        # Finally generate a random field in Fourier space with the right PS
-        noise_array = _generate_noise_from_rootps(self.rng, image.array.shape, rootps)
+        ps_shape, fft_size = self._get_ps_shape(image.array.shape, wcs)
+        rootps = self._get_rootps(ps_shape, wcs)
 
-        # Add it to the image
-        image.array[:,:] += noise_array
+        # Finally generate a random field with the right PS and add it to the image
+        _add_noise_from_rootps(self.rng, image, rootps, ps_shape, fft_size)
         return image
 
     def applyToView(self, image_view):
@@ -316,12 +323,7 @@ class _BaseCorrelatedNoise(object):
 
         # If the profile has changed since last time (or if we have never been here before),
         # clear out the stored values.
-        if self._profile_for_stored is not self._profile:
-            self._rootps_store = []
-            self._rootps_whitening_store = []
-            self._variance_stored = None
-        # Set profile_for_stored for next time.
-        self._profile_for_stored = self._profile
+        self._check_stored()
 
         if image.wcs is None:
             wcs = self.wcs
@@ -330,11 +332,11 @@ class _BaseCorrelatedNoise(object):
 
         # Then retrieve or redraw the sqrt(power spectrum) needed for making the whitening noise,
         # and the total variance of the combination
-        rootps_whitening, variance = self._get_update_rootps_whitening(image.array.shape, wcs)
+        ps_shape, fft_size = self._get_ps_shape(image.array.shape, wcs)
+        rootps_whitening, variance = self._get_update_rootps_whitening(ps_shape, wcs)
 
-        # Finally generate a random field in Fourier space with the right PS and add to image
-        noise_array = _generate_noise_from_rootps(self.rng, image.array.shape, rootps_whitening)
-        image += galsim.Image(noise_array)
+        # Finally generate a random field with the right PS and add it to the image
+        _add_noise_from_rootps(self.rng, image, rootps_whitening, ps_shape, fft_size)
 
         # Return the variance to the interested user
         return variance
@@ -407,13 +409,8 @@ class _BaseCorrelatedNoise(object):
             raise ValueError("Order must be an even number >=4!")
 
         # If the profile has changed since last time (or if we have never been here before),
-        # clear out the stored values.  Note that this cache is not the same as the one used for
-        # whitening.
-        if self._profile_for_stored is not self._profile:
-            self._rootps_store = []
-            self._rootps_symmetrizing_store = []
-        # Set profile_for_stored for next time.
-        self._profile_for_stored = self._profile
+        # clear out the stored values.
+        self._check_stored()
 
         if image.wcs is None:
             wcs = self.wcs
@@ -422,12 +419,11 @@ class _BaseCorrelatedNoise(object):
 
         # Then retrieve or redraw the sqrt(power spectrum) needed for making the symmetrizing noise,
         # and the total variance of the combination.
-        rootps_symmetrizing, variance = self._get_update_rootps_symmetrizing(
-            image.array.shape, wcs, order)
+        ps_shape, fft_size = self._get_ps_shape(image.array.shape, wcs)
+        rootps_symmetrizing, variance = self._get_update_rootps_symmetrizing(ps_shape, wcs, order)
 
-        # Finally generate a random field in Fourier space with the right PS and add to image.
-        noise_array = _generate_noise_from_rootps(self.rng, image.array.shape, rootps_symmetrizing)
-        image += galsim.Image(noise_array)
+        # Finally generate a random field with the right PS and add it to the image.
+        _add_noise_from_rootps(self.rng, image, rootps_symmetrizing, ps_shape, fft_size)
 
         # Return the variance to the interested user
         return variance
@@ -528,12 +524,7 @@ class _BaseCorrelatedNoise(object):
         else:
             # If the profile has changed since last time (or if we have never been here before),
             # clear out the stored values.
-            if self._profile_for_stored is not self._profile:
-                self._rootps_store = []
-                self._rootps_whitening_store = []
-                self._variance_stored = None
-            # Set profile_for_stored for next time.
-            self._profile_for_stored = self._profile
+            self._check_stored()
             # Then use cached version or rebuild if necessary
             if self._variance_stored is not None:
                 variance = self._variance_stored
@@ -667,23 +658,81 @@ class _BaseCorrelatedNoise(object):
             image=image, wcs=wcs, dtype=dtype, method='sb', gain=1., wmult=wmult,
             add_to_image=add_to_image, use_true_center=False)
 
+    def _get_rootps(self, shape, wcs):
+        """Internal utility function to get the `rootps` for generating noise on an image of the
+        given shape and wcs, used by applyTo() and by InterpolatedImage for its noise padding.
+        """
+        # If the profile has changed since last time (or if we have never been here before),
+        # clear out the stored values.
+        self._check_stored()
+
+        return self._get_update_rootps(shape, wcs)
+
+    def _check_stored(self):
+        """Internal utility function to clear out the stored values if the profile has changed
+        since they were calculated.
+        """
+        if self._profile_for_stored is not self._profile:
+            self._rootps_store = []
+            self._variance_stored = None
+        # Set profile_for_stored for next time.
+        self._profile_for_stored = self._profile
+
+    def _get_stored(self, key):
+        """Internal utility function to get a stored value, or None if there isn't one for this key.
+        """
+        for i, (saved_key, value) in enumerate(self._rootps_store):
+            if saved_key == key:
+                # Move it to the front, so the least recently used values are at the end.
+                if i > 0:
+                    self._rootps_store.insert(0, self._rootps_store.pop(i))
+                return value
+        return None
+
+    def _set_stored(self, key, value):
+        """Internal utility function to store a value, dropping the least recently used ones if
+        there are more than _max_stored.
+        """
+        self._rootps_store.insert(0, (key, value))
+        del self._rootps_store[self._max_stored:]
+
+    def _get_ps_shape(self, shape, wcs):
+        """Internal utility function to get the shape of the grid on which to make the power
+        spectrum for noise on an image of the given shape.
+
+        @returns ps_shape, fft_size, where fft_size is None if the noise is to be made with a
+                 single FFT of the whole image, or the size of the FFTs to use for each tile if
+                 it is to be made one tile at a time.
+        """
+        if max(shape) <= self._max_periodic_size:
+            return shape, None
+        # The grid only needs to be large enough to hold the correlation function.  Use the
+        # stepk of the profile to tell how large that is in world coordinates, and then convert
+        # to pixels using the smallest linear scale of the wcs, to be safe.
+        size = 2. * np.pi / self._profile.stepK() / wcs.minLinearScale()
+        size = galsim._galsim.goodFFTSize(int(np.ceil(size)))
+        if size > self._max_kernel_size:
+            # Cutting the correlation function off at _max_kernel_size would silently lose the
+            # correlations at larger separations.  So do it the slow way instead.
+            import warnings
+            warnings.warn(
+                "The correlation function needs a kernel of %d pixels, which is larger than "%size+
+                "the maximum of %d for making noise in tiles.\n"%self._max_kernel_size+
+                "Using a single FFT of the whole image instead, so the noise will be periodic.")
+            return shape, None
+        return (size, size), self._noise_tile_size
+
     def _get_update_rootps(self, shape, wcs):
         """Internal utility function for querying the `rootps` cache, used by applyTo(),
         whitenImage(), and symmetrizeImage() methods.
         """
         # First check whether we can just use a stored power spectrum (no drawing necessary if so)
-        use_stored = False
-        # Query using the rfft2/irfft2 half-sized shape (shape[0], shape[1] // 2 + 1)
-        half_shape = (shape[0], shape[1] // 2 + 1)
-        for rootps_array, saved_wcs in self._rootps_store:
-            if rootps_array.shape == half_shape and wcs == saved_wcs:
-                use_stored = True
-                rootps = rootps_array
-                break
+        key = ('rootps', tuple(shape), wcs)
+        rootps = self._get_stored(key)
 
         # If not, draw the correlation function to the desired size and resolution, then DFT to
         # generate the required array of the square root of the power spectrum
-        if use_stored is False:
+        if rootps is None:
             # Draw this correlation function into an array.  If this is not done at the same wcs as
             # the original image from which the CF derives, even if the image is rotated, then this
             # step requires interpolation and the newcf (used to generate the PS below) is thus
@@ -720,8 +769,8 @@ class _BaseCorrelatedNoise(object):
             # For now we just take the sqrt(abs(PS)):
             rootps = np.sqrt(np.abs(ps))
 
-            # Then add this and the relevant wcs to the _rootps_store for later use
-            self._rootps_store.append((rootps, newcf.wcs))
+            # Then add this to the _rootps_store for later use
+            self._set_stored(key, rootps)
 
         return rootps
 
@@ -732,22 +781,15 @@ class _BaseCorrelatedNoise(object):
         @returns rootps_whitening, variance
         """
         # First check whether we can just use a stored whitening power spectrum
-        use_stored = False
-        # Query using the rfft2/irfft2 half-sized shape (shape[0], shape[1] // 2 + 1)
-        half_shape = (shape[0], shape[1] // 2 + 1)
-        for rootps_whitening_array, saved_wcs, var in self._rootps_whitening_store:
-            if rootps_whitening_array.shape == half_shape and wcs == saved_wcs:
-                use_stored = True
-                rootps_whitening = rootps_whitening_array
-                variance = var
-                break
+        key = ('whitening', tuple(shape), wcs)
+        stored = self._get_stored(key)
 
         # If not, calculate the whitening power spectrum as (almost) the smallest power spectrum
         # that when added to rootps**2 gives a flat resultant power that is nowhere negative.
         # Note that rootps = sqrt(power spectrum), and this procedure therefore works since power
         # spectra add (rather like variances).  The resulting power spectrum will be all positive
-        # (and thus physical).
-        if use_stored is False:
+        # (and thus physical).  This uses the stored rootps if there is one.
+        if stored is None:
 
             rootps = self._get_update_rootps(shape, wcs)
             ps_whitening = -rootps * rootps
@@ -759,10 +801,11 @@ class _BaseCorrelatedNoise(object):
             # element we could use any as the PS should be flat.
             variance = rootps[0, 0]**2 + ps_whitening[0, 0]
 
-            # Then add all this and the relevant wcs to the _rootps_whitening_store
-            self._rootps_whitening_store.append((rootps_whitening, wcs, variance))
+            # Then add all this to the _rootps_store
+            stored = (rootps_whitening, variance)
+            self._set_stored(key, stored)
 
-        return rootps_whitening, variance
+        return stored
 
     def _get_update_rootps_symmetrizing(self, shape, wcs, order, headroom=1.02):
         """Internal utility function for querying the `rootps_symmetrizing` cache, used by the
@@ -773,25 +816,15 @@ class _BaseCorrelatedNoise(object):
         # First check whether we can just use a stored symmetrizing power spectrum.  In addition for
         # the considerations for use of cached observations for noise whitening, we need the
         # requested order of the symmetry to be the same as the stored one.
-        use_stored = False
-        # Query using the rfft2/irfft2 half-sized shape (shape[0], shape[1] // 2 + 1)
-        half_shape = (shape[0], shape[1] // 2 + 1)
-        for (
-            rootps_symmetrizing_array, saved_wcs, var, saved_order
-            ) in self._rootps_symmetrizing_store:
-            if (rootps_symmetrizing_array.shape == half_shape and saved_order == order and
-                    wcs == saved_wcs):
-                use_stored = True
-                rootps_symmetrizing = rootps_symmetrizing_array
-                variance = var
-                break
+        key = ('symmetrizing', tuple(shape), wcs, order)
+        stored = self._get_stored(key)
 
         # If not, calculate the symmetrizing power spectrum as (almost) the smallest power spectrum
         # that when added to rootps**2 gives a power that has N-fold symmetry, where `N=order`.
         # Note that rootps = sqrt(power spectrum), and this procedure therefore works since power
         # spectra add (rather like variances).  The resulting power spectrum will be all positive
-        # (and thus physical).
-        if use_stored is False:
+        # (and thus physical).  This uses the stored rootps if there is one.
+        if stored is None:
 
             rootps = self._get_update_rootps(shape, wcs)
             ps_actual = rootps * rootps
@@ -807,10 +840,11 @@ class _BaseCorrelatedNoise(object):
             # we have to take the mean power instead of just using the [0, 0] element.
             variance = np.mean(rootps**2 + ps_symmetrizing)
 
-            # Then add all this and the relevant wcs to the _rootps_symmetrizing_store
-            self._rootps_symmetrizing_store.append((rootps_symmetrizing, wcs, variance, order))
+            # Then add all this to the _rootps_store
+            stored = (rootps_symmetrizing, variance)
+            self._set_stored(key, stored)
 
-        return rootps_symmetrizing, variance
+        return stored
 
     def _get_symmetrized_ps(self, ps, order):
         """Internal utility function for taking an input power spectrum and generating a version of
@@ -881,52 +915,46 @@ class _BaseCorrelatedNoise(object):
 # Now a standalone utility function for generating noise according to an input (square rooted)
 # Power Spectrum
 #
-def _generate_noise_from_rootps(rng, shape, rootps):
-    """Utility function for generating a NumPy array containing a Gaussian random noise field with
-    a user-specified power spectrum also supplied as a NumPy array.
+def _add_noise_from_rootps(rng, image, rootps, shape, fft_size=None):
+    """Utility function for adding a Gaussian random noise field with a user-specified power
+    spectrum, supplied as a NumPy array, to an Image.
+
+    The noise is made in C++.  If `fft_size` is None, this is done with a single FFT of the whole
+    image, so the noise is periodic.  Otherwise, the inverse transform of `rootps` is used as a
+    kernel, which is convolved with white noise one tile at a time, using FFTs of size `fft_size`
+    (or larger if needed for the kernel).
 
     @param rng      BaseDeviate instance to provide the random number generation
-    @param shape    Shape of the output array, needed because of the use of Hermitian symmetry to
-                    increase inverse FFT efficiency using the `np.fft.irfft2` function (gets sent to
-                    the kwarg `s=` of `np.fft.irfft2`)
+    @param image    The Image to which to add the noise.
     @param rootps   NumPy array containing the square root of the discrete Power Spectrum ordered
                     in two dimensions according to the usual DFT pattern for `np.fft.rfft2` output
                     (see also `np.fft.fftfreq`)
-
-    @returns a NumPy array (contiguous) of the requested shape, filled with the noise field.
+    @param shape    Shape of the grid on which `rootps` was made, needed because of the use of
+                    Hermitian symmetry (cf. the kwarg `s=` of `np.fft.irfft2`).  If `fft_size` is
+                    None, this must be the shape of the image.
+    @param fft_size The size of the FFTs to use for each tile, or None to do the whole image at
+                    once.  [default: None]
     """
     # Sanity check on requested shape versus that of rootps
     if len(shape) != 2 or (shape[0], shape[1]//2+1) != rootps.shape:
         raise ValueError("Requested shape does not match that of the supplied rootps")
-    #  Quickest to create Gaussian rng each time needed, so do that here...
-    gd = galsim.GaussianDeviate(
-        rng, sigma=np.sqrt(.5 * shape[0] * shape[1])) # Note sigma scaling: 1/sqrt(2) needed so
-                                                      # <|gaussvec|**2> = product(shape); shape
-                                                      # needed because of the asymmetry in the
-                                                      # 1/N^2 division in the NumPy FFT/iFFT
-    # Fill a couple of arrays with this noise
-    gvec_real = galsim.utilities.rand_arr((shape[0], shape[1]//2+1), gd)
-    gvec_imag = galsim.utilities.rand_arr((shape[0], shape[1]//2+1), gd)
-    # Prepare a complex vector upon which to impose Hermitian symmetry
-    gvec = gvec_real + 1J * gvec_imag
-    # Now impose requirements of Hermitian symmetry on random Gaussian halfcomplex array, and ensure
-    # self-conjugate elements (e.g. [0, 0]) are purely real and multiplied by sqrt(2) to compensate
-    # for lost variance, see https://github.com/GalSim-developers/GalSim/issues/563
-    # First do the bits necessary for both odd and even shapes:
-    gvec[-1:shape[0]//2:-1, 0] = np.conj(gvec[1:(shape[0]+1)//2, 0])
-    rt2 = np.sqrt(2.)
-    gvec[0, 0] = rt2 * gvec[0, 0].real
-    # Then make the changes necessary for even sized arrays
-    if shape[1] % 2 == 0: # x dimension even
-        gvec[-1:shape[0]//2:-1, shape[1]//2] = np.conj(gvec[1:(shape[0]+1)//2, shape[1]//2])
-        gvec[0, shape[1]//2] = rt2 * gvec[0, shape[1]//2].real
-    if shape[0] % 2 == 0: # y dimension even
-        gvec[shape[0]//2, 0] = rt2 * gvec[shape[0]//2, 0].real
-        # Both dimensions even
-        if shape[1] % 2 == 0:
-            gvec[shape[0]//2, shape[1]//2] = rt2 * gvec[shape[0]//2, shape[1]//2].real
-    # Finally generate and return noise using the irfft
-    return np.fft.irfft2(gvec * rootps, s=shape)
+    if fft_size is None and tuple(shape) != image.array.shape:
+        raise ValueError("Requested shape does not match that of the image")
+    rootps = np.ascontiguousarray(rootps, dtype=float)
+
+    # The noise is made in double precision.  So add it directly to the image if possible, and
+    # otherwise make it in a temporary ImageD, which is then added to the image.
+    if image.dtype is np.float64 and image.array.flags.writeable:
+        noise_image = image
+    else:
+        noise_image = galsim.ImageD(image.bounds)
+    if fft_size is None:
+        galsim._galsim._addNoiseFromRootPS(noise_image.image.view(), rootps, rng)
+    else:
+        galsim._galsim._addTiledNoiseFromRootPS(noise_image.image.view(), rootps, shape[1],
+                                                int(fft_size), rng)
+    if noise_image is not image:
+        image += noise_image
 
 
 ###
@@ -1215,10 +1243,9 @@ class CorrelatedNoise(_BaseCorrelatedNoise):
         _BaseCorrelatedNoise.__init__(self, rng, cf_object, cf_image.wcs)
 
         if store_rootps:
-            # If it corresponds to the CF above, store useful data as a (rootps, wcs) tuple for
-            # efficient later use:
+            # If it corresponds to the CF above, store the rootps for efficient later use:
             self._profile_for_stored = self._profile
-            self._rootps_store.append((np.sqrt(ps_array), cf_image.wcs))
+            self._set_stored(('rootps', image.array.shape, cf_image.wcs), np.sqrt(ps_array))
 
         self._image = image
 
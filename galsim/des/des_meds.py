@@ -19,7 +19,8 @@
 
 This module defines the MultiExposureObject class for representing multiple exposure data for a
 single object.  The WriteMEDS function can be used to write a list of MultiExposureObject
-instances to a single MEDS file.
+instances to a single MEDS file, and the MEDSWriter class can be used to write them one at a time
+as they are made.
 
 Importing this module also adds these data structures to the config framework, so that MEDS file
 output can subsequently be simulated directly using a config file.
@@ -28,13 +29,11 @@ output can subsequently be simulated directly using a config file.
 import numpy as np
 import galsim
 import galsim.config
-import sys
 
 # these image stamp sizes are available in MEDS format
 BOX_SIZES = [32,48,64,96,128,192,256]
-# while creating the meds file, all the data is stored in memory, and then written to disc once all
-# the necessary images have been created.
-# You can control the amound of memory used to prevent jamming your system.
+# This used to limit the memory used while creating a meds file.  It is no longer used, since the
+# cutouts are now stored in temporary files until the meds file is written.
 MAX_MEMORY = 1e9
 # Maximum number of exposures allowed per galaxy (incl. coadd)
 MAX_NCUTOUTS = 11
@@ -165,177 +164,296 @@ class MultiExposureObject(object):
         self.psf = psf
 
 
-def WriteMEDS(obj_list, file_name, clobber=True):
+# The columns of the object_data table.
+# cf. https://github.com/esheldon/meds/wiki/MEDS-Format
+# The types are big-endian, since that is what FITS uses, so the table can be written out
+# directly from the memory-mapped array that holds it without any byte swapping.
+_object_data_dtype = np.dtype([
+    ('id',             '>i8'),
+    ('number',         '>i8'),
+    ('ra',             '>f8'),
+    ('dec',            '>f8'),
+    ('box_size',       '>i8'),
+    ('ncutout',        '>i8'),
+    ('file_id',        '>i8', (MAX_NCUTOUTS,)),
+    ('start_row',      '>i8', (MAX_NCUTOUTS,)),
+    ('orig_row',       '>f8', (MAX_NCUTOUTS,)),
+    ('orig_col',       '>f8', (MAX_NCUTOUTS,)),
+    ('orig_start_row', '>i8', (MAX_NCUTOUTS,)),
+    ('orig_start_col', '>i8', (MAX_NCUTOUTS,)),
+    ('cutout_row',     '>f8', (MAX_NCUTOUTS,)),
+    ('cutout_col',     '>f8', (MAX_NCUTOUTS,)),
+    ('dudrow',         '>f8', (MAX_NCUTOUTS,)),
+    ('dudcol',         '>f8', (MAX_NCUTOUTS,)),
+    ('dvdrow',         '>f8', (MAX_NCUTOUTS,)),
+    ('dvdcol',         '>f8', (MAX_NCUTOUTS,)),
+    ('psf_box_size',   '>i8'),
+    ('psf_start_row',  '>i8', (MAX_NCUTOUTS,)),
+])
+
+class _MappedVector(object):
+    """A 1-d array stored in a temporary file, which grows as items are appended to it.
+
+    The file is memory mapped, so the pages that have been written can be dropped by the OS
+    whenever it needs the memory, and the total size is not limited by the available memory.
+    Whenever the array needs to grow, the capacity is doubled, so appending n items takes
+    O(n) time overall.
+
+    @param dtype        The data type of the items, or None to use the type of the first array
+                        that is appended.  The type is always converted to big-endian.
+    @param capacity     The initial number of items to allocate. [default: 0]
+    @param dir          The directory in which to make the temporary file. [default: None,
+                        which means to use the system default]
     """
-    Writes a MEDS file from a list of MultiExposureObjects.
+    def __init__(self, dtype=None, capacity=0, dir=None):
+        import tempfile
+        self.dtype = None
+        if dtype is not None: self._setType(dtype)
+        self.size = 0
+        self._capacity = 0
+        self._data = None
+        self._file = tempfile.TemporaryFile(dir=dir)
+        if capacity > 0 and self.dtype is not None:
+            self._reserve(capacity)
+
+    def _setType(self, dtype):
+        dtype = np.dtype(dtype)
+        if dtype.fields is None:
+            dtype = dtype.newbyteorder('>')
+        self.dtype = dtype
+
+    def _reserve(self, capacity):
+        if capacity <= self._capacity: return
+        if self._data is not None:
+            self._data.flush()
+        # Opening the map with a larger shape extends the file as needed.
+        self._data = np.memmap(self._file, dtype=self.dtype, mode='r+', shape=(capacity,))
+        self._capacity = capacity
+
+    def allocate(self, n, dtype=None):
+        """Add n items to the end of the array, and return the index of the first one.
+        """
+        if self.dtype is None:
+            self._setType(dtype if dtype is not None else float)
+        if self.size + n > self._capacity:
+            self._reserve(max(2*self._capacity, self.size + n))
+        start = self.size
+        self.size += n
+        return start
+
+    def append(self, values):
+        """Append the values in a 1-d numpy array, and return the index of the first one.
+        """
+        start = self.allocate(len(values), values.dtype)
+        self._data[start:self.size] = values
+        return start
+
+    @property
+    def array(self):
+        """The used part of the array.  This is a view into the memory map, so it becomes
+        invalid if any more items are appended.
+        """
+        if self._data is None:
+            return np.zeros(0, dtype=self.dtype if self.dtype is not None else float)
+        return self._data[:self.size]
 
-    Arguments:
-    ----------
-    @param obj_list:     List of MultiExposureObjects
-    @param file_name:    Name of meds file to be written
-    @param clobber       Setting `clobber=True` when `file_name` is given will silently overwrite
-                         existing files. (Default `clobber = True`.)
+    def close(self):
+        self._data = None
+        self._file.close()
+
+
+class MEDSWriter(object):
     """
+    A class for writing a MEDS file one object at a time.
 
-    from galsim._pyfits import pyfits
+    The cutouts of each object are appended to memory-mapped temporary files as soon as the
+    object is written, and the object_data table is filled in at the same time, so the memory
+    that is needed does not grow with the number of objects.  The MEDS file itself is written
+    when close() is called.  The writer can be used as a context manager, in which case the
+    file is written at the end of the `with` block (unless there was an exception):
+
+        >>> with galsim.des.MEDSWriter(file_name) as meds:
+        ...     for obj in objects:
+        ...         meds.write(make_multi_exposure_object(obj))
+
+    The output is identical to that of WriteMEDS for the same list of objects.
 
-    # initialise the catalog
-    cat = {}
-    cat['id'] = []
-    cat['box_size'] = []
-    cat['ra'] = []
-    cat['dec'] = []
-    cat['ncutout'] = []
-    cat['start_row'] = []
-    cat['dudrow'] = []
-    cat['dudcol'] = []
-    cat['dvdrow'] = []
-    cat['dvdcol'] = []
-    cat['row0'] = []
-    cat['col0'] = []
-    cat['psf_box_size'] = []
-    cat['psf_start_row'] = []
-
-    # initialise the image vectors
-    vec = {}
-    vec['image'] = []
-    vec['seg'] = []
-    vec['weight'] = []
-    vec['psf'] = []
-
-    # initialise the image vector index
-    n_vec = 0
-    psf_n_vec = 0
-
-    # get number of objects
-    n_obj = len(obj_list)
-
-    # loop over objects
-    for obj in obj_list:
-
-        # initialise the start indices for each image
-        start_rows = np.ones(MAX_NCUTOUTS)*EMPTY_START_INDEX
-        psf_start_rows = np.ones(MAX_NCUTOUTS)*EMPTY_START_INDEX
-        dudrow = np.ones(MAX_NCUTOUTS)*EMPTY_JAC_diag
-        dudcol = np.ones(MAX_NCUTOUTS)*EMPTY_JAC_offdiag
-        dvdrow = np.ones(MAX_NCUTOUTS)*EMPTY_JAC_offdiag
-        dvdcol = np.ones(MAX_NCUTOUTS)*EMPTY_JAC_diag
-        row0   = np.ones(MAX_NCUTOUTS)*EMPTY_SHIFT
-        col0   = np.ones(MAX_NCUTOUTS)*EMPTY_SHIFT
-
-        # get the number of cutouts (exposures)
+    The cutout HDUs may optionally be compressed.  Tile compression ('rice' or 'gzip_tile') is
+    done by pyfits, which needs the compressed data for each HDU to fit in memory.  Also,
+    rice compression of floating point images is lossy.  Compressing the full file with 'gzip'
+    or 'bzip2' keeps the memory bounded when the system gzip or bzip2 executable is available,
+    since then the file is streamed through it.
+
+    Initialization
+    --------------
+
+    @param file_name    Name of the MEDS file to be written.
+    @param clobber      Setting `clobber=True` will silently overwrite existing files.
+                        [default: True]
+    @param compression  Which compression scheme to use (if any).  Options are the same as for
+                        galsim.fits.write(), except that tile compression is only applied to the
+                        cutout HDUs, not the tables. [default: 'auto']
+    @param nobjects     If known, the number of objects that will be written.  This is only used
+                        to preallocate the object_data table. [default: None]
+    @param tmp_dir      The directory in which to put the temporary files.  [default: None,
+                        which means to use the same directory as `file_name`]
+    """
+    _cutout_hdus = [ ('image', 'image_cutouts'), ('weight', 'weight_cutouts'),
+                     ('seg', 'seg_cutouts'), ('psf', 'psf') ]
+
+    def __init__(self, file_name, clobber=True, compression='auto', nobjects=None, tmp_dir=None):
+        import os
+        if os.path.isfile(file_name) and not clobber:
+            raise IOError('File %r already exists'%file_name)
+        self.file_name = file_name
+        self.clobber = clobber
+        self._file_compress, self._pyfits_compress = galsim.fits._parse_compression(
+                compression, file_name)
+        if tmp_dir is None:
+            tmp_dir = os.path.dirname(os.path.abspath(file_name))
+
+        self._cat = _MappedVector(_object_data_dtype, nobjects or 0, tmp_dir)
+        self._vec = {}
+        self._vec['image'] = _MappedVector(dir=tmp_dir)
+        self._vec['weight'] = _MappedVector(dir=tmp_dir)
+        self._vec['seg'] = _MappedVector(dir=tmp_dir)
+        self._vec['psf'] = _MappedVector(dir=tmp_dir)
+        self._closed = False
+
+    @property
+    def nobjects(self):
+        """The number of objects that have been written so far.
+        """
+        return self._cat.size
+
+    def write(self, obj):
+        """Append a MultiExposureObject to the file.
+        """
+        if self._closed:
+            raise RuntimeError("Cannot write to a MEDSWriter after it is closed")
         n_cutout = obj.n_cutouts
+        if n_cutout > MAX_NCUTOUTS:
+            raise ValueError("Too many cutouts (%d) for MEDS file.  The maximum is %d"%(
+                    n_cutout, MAX_NCUTOUTS))
+
+        k = self._cat.allocate(1)
+        cat = self._cat.array
 
-        # append the catalog for this object
-        cat['id'].append(obj.id)
-        cat['box_size'].append(obj.box_size)
+        # Set the catalog values for this object, starting with the flags for unused cutouts.
+        cat['id'][k] = obj.id
+        cat['number'][k] = obj.id
         # TODO: If the config defines a world position, get the right ra, dec here.
-        cat['ra'].append(0.)
-        cat['dec'].append(0.)
-        cat['ncutout'].append(n_cutout)
-        cat['psf_box_size'].append(obj.psf_box_size)
+        cat['ra'][k] = 0.
+        cat['dec'][k] = 0.
+        cat['box_size'][k] = obj.box_size
+        cat['ncutout'][k] = n_cutout
+        cat['file_id'][k] = 1
+        cat['start_row'][k] = EMPTY_START_INDEX
+        cat['orig_row'][k] = 0.
+        cat['orig_col'][k] = 0.
+        cat['orig_start_row'][k] = 0
+        cat['orig_start_col'][k] = 0
+        cat['cutout_row'][k] = EMPTY_SHIFT
+        cat['cutout_col'][k] = EMPTY_SHIFT
+        cat['dudrow'][k] = EMPTY_JAC_diag
+        cat['dudcol'][k] = EMPTY_JAC_offdiag
+        cat['dvdrow'][k] = EMPTY_JAC_offdiag
+        cat['dvdcol'][k] = EMPTY_JAC_diag
+        cat['psf_box_size'][k] = obj.psf_box_size
+        cat['psf_start_row'][k] = EMPTY_START_INDEX
 
-        # loop over cutouts
         for i in range(n_cutout):
-
-            # assign the start row to the end of image vector
-            start_rows[i] = n_vec
-            psf_start_rows[i] = psf_n_vec
-            # update n_vec to point to the end of image vector
-            n_vec += len(obj.images[i].array.flatten())
+            # The image, weight and seg vectors are parallel, so they share the start row.
+            start_row = self._vec['image'].append(obj.images[i].array.ravel())
+            self._vec['weight'].append(obj.weight[i].array.ravel())
+            self._vec['seg'].append(obj.seg[i].array.ravel())
+            cat['start_row'][k,i] = start_row
             if obj.psf is not None:
-                psf_n_vec += len(obj.psf[i].array.flatten())
-
-            # append the image vectors
-            vec['image'].append(obj.images[i].array.flatten())
-            vec['seg'].append(obj.seg[i].array.flatten())
-            vec['weight'].append(obj.weight[i].array.flatten())
-            vec['psf'].append(obj.psf[i].array.flatten())
+                cat['psf_start_row'][k,i] = self._vec['psf'].append(obj.psf[i].array.ravel())
 
-            # append the Jacobian
             # col == x
             # row == y
-            dudcol[i] = obj.wcs[i].dudx
-            dudrow[i] = obj.wcs[i].dudy
-            dvdcol[i] = obj.wcs[i].dvdx
-            dvdrow[i] = obj.wcs[i].dvdy
-            col0[i]   = obj.wcs[i].origin.x
-            row0[i]   = obj.wcs[i].origin.y
-
-            # check if we are running out of memory
-            if sys.getsizeof(vec) > MAX_MEMORY:
-                raise MemoryError(
-                    'Running out of memory > %1.0fGB '%MAX_MEMORY/1.e9 +
-                    '- you can increase the limit by changing MAX_MEMORY')
-
-        # update the start rows fields in the catalog
-        cat['start_row'].append(start_rows)
-        cat['psf_start_row'].append(psf_start_rows)
-
-        # add lists of Jacobians
-        cat['dudrow'].append(dudrow)
-        cat['dudcol'].append(dudcol)
-        cat['dvdrow'].append(dvdrow)
-        cat['dvdcol'].append(dvdcol)
-        cat['row0'].append(row0)
-        cat['col0'].append(col0)
-
-    # concatenate list to one big vector
-    vec['image'] = np.concatenate(vec['image'])
-    vec['seg'] = np.concatenate(vec['seg'])
-    vec['weight'] = np.concatenate(vec['weight'])
-    vec['psf'] = np.concatenate(vec['psf'])
-
-    # get the primary HDU
-    primary = pyfits.PrimaryHDU()
-
-    # second hdu is the object_data
-    # cf. https://github.com/esheldon/meds/wiki/MEDS-Format
-    cols = []
-    cols.append( pyfits.Column(name='id',             format='K', array=cat['id']       ) )
-    cols.append( pyfits.Column(name='number',         format='K', array=cat['id']       ) )
-    cols.append( pyfits.Column(name='ra',             format='D', array=cat['ra']       ) )
-    cols.append( pyfits.Column(name='dec',            format='D', array=cat['dec']      ) )
-    cols.append( pyfits.Column(name='box_size',       format='K', array=cat['box_size'] ) )
-    cols.append( pyfits.Column(name='ncutout',        format='K', array=cat['ncutout']  ) )
-    cols.append( pyfits.Column(name='file_id',        format='%dK' % MAX_NCUTOUTS,
-                               array=[1]*n_obj) )
-    cols.append( pyfits.Column(name='start_row',      format='%dK' % MAX_NCUTOUTS,
-                               array=np.array(cat['start_row'])) )
-    cols.append( pyfits.Column(name='orig_row',       format='%dD' % MAX_NCUTOUTS,
-                               array=[[0]*MAX_NCUTOUTS]*n_obj     ) )
-    cols.append( pyfits.Column(name='orig_col',       format='%dD' % MAX_NCUTOUTS,
-                               array=[[0]*MAX_NCUTOUTS]*n_obj     ) )
-    cols.append( pyfits.Column(name='orig_start_row', format='%dK' % MAX_NCUTOUTS,
-                               array=[[0]*MAX_NCUTOUTS]*n_obj     ) )
-    cols.append( pyfits.Column(name='orig_start_col', format='%dK' % MAX_NCUTOUTS,
-                               array=[[0]*MAX_NCUTOUTS]*n_obj     ) )
-    cols.append( pyfits.Column(name='cutout_row',     format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['row0'])     ) )
-    cols.append( pyfits.Column(name='cutout_col',     format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['col0'])     ) )
-    cols.append( pyfits.Column(name='dudrow',         format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['dudrow'])   ) )
-    cols.append( pyfits.Column(name='dudcol',         format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['dudcol'])   ) )
-    cols.append( pyfits.Column(name='dvdrow',         format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['dvdrow'])   ) )
-    cols.append( pyfits.Column(name='dvdcol',         format='%dD' % MAX_NCUTOUTS,
-                               array=np.array(cat['dvdcol'])   ) )
-    cols.append( pyfits.Column(name='psf_box_size',   format='K', array=cat['psf_box_size'] ) )
-    cols.append( pyfits.Column(name='psf_start_row',  format='%dK' % MAX_NCUTOUTS,
-                               array=np.array(cat['psf_start_row'])) )
-
-
-    # Depending on the version of pyfits, one of these should work:
-    try:
-        object_data = pyfits.BinTableHDU.from_columns(cols)
-        object_data.name = 'object_data'
-    except:
-        object_data = pyfits.new_table(pyfits.ColDefs(cols))
-        object_data.update_ext_name('object_data')
+            cat['dudcol'][k,i] = obj.wcs[i].dudx
+            cat['dudrow'][k,i] = obj.wcs[i].dudy
+            cat['dvdcol'][k,i] = obj.wcs[i].dvdx
+            cat['dvdrow'][k,i] = obj.wcs[i].dvdy
+            cat['cutout_col'][k,i] = obj.wcs[i].origin.x
+            cat['cutout_row'][k,i] = obj.wcs[i].origin.y
+
+    def close(self):
+        """Write the MEDS file and remove the temporary files.
+
+        If writing the file fails, the temporary files are kept, so close() may be called again
+        to retry.
+        """
+        if self._closed: return
+        hdu_list = self._makeHDUList()
+        galsim.fits._write_file(self.file_name, None, hdu_list, self.clobber,
+                                self._file_compress, self._pyfits_compress)
+        self._discard()
+
+    def _discard(self):
+        self._cat.close()
+        for v in self._vec.values():
+            v.close()
+        self._closed = True
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        try:
+            if type is None:
+                self.close()
+        finally:
+            self._discard()
+
+    def _makeHDUList(self):
+        from galsim._pyfits import pyfits, pyfits_version
+
+        # get the primary HDU
+        primary = pyfits.PrimaryHDU()
+
+        # second hdu is the object_data
+        # Viewing the mapped array as a FITS_rec lets pyfits write it without making a copy.
+        object_data = pyfits.BinTableHDU(data=self._cat.array.view(pyfits.FITS_rec),
+                                         name='object_data')
+
+        # rest of HDUs are image vectors
+        cutouts = []
+        for key, name in self._cutout_hdus:
+            data = self._vec[key].array
+            if len(data) == 0:
+                data = None
+            if self._pyfits_compress and data is not None:
+                # Use tiles of at most 64K pixels, rather than one tile for the whole vector.
+                tile = [min(len(data), 65536)]
+                if pyfits_version < '4.3':
+                    hdu = pyfits.CompImageHDU(data, name=name,
+                                              compressionType=self._pyfits_compress,
+                                              tileSize=tile)
+                else:
+                    try:
+                        hdu = pyfits.CompImageHDU(data, name=name,
+                                                  compression_type=self._pyfits_compress,
+                                                  tile_shape=tile)
+                    except TypeError:
+                        # Older versions of astropy call this tile_size.
+                        hdu = pyfits.CompImageHDU(data, name=name,
+                                                  compression_type=self._pyfits_compress,
+                                                  tile_size=tile)
+            else:
+                hdu = pyfits.ImageHDU(data, name=name)
+            cutouts.append(hdu)
+
+        return pyfits.HDUList([primary, object_data, _MakeImageInfoHDU(), _MakeMetadataHDU()] +
+                              cutouts)
+
 
-    # third hdu is image_info
+def _MakeImageInfoHDU():
+    """The image_info HDU of a MEDS file.
+    """
+    from galsim._pyfits import pyfits
     cols = []
     cols.append( pyfits.Column(name='image_path',  format='A256',   array=['generated_by_galsim'] ))
     cols.append( pyfits.Column(name='image_ext',   format='I',      array=[0]                     ))
@@ -359,8 +477,13 @@ def WriteMEDS(obj_list, file_name, clobber=True):
     except:
         image_info = pyfits.new_table(pyfits.ColDefs(cols))
         image_info.update_ext_name('image_info')
+    return image_info
 
-    # fourth hdu is metadata
+
+def _MakeMetadataHDU():
+    """The metadata HDU of a MEDS file.
+    """
+    from galsim._pyfits import pyfits
     # default values?
     cols = []
     cols.append( pyfits.Column(name='magzp_ref',     format='E',    array=[30.]                   ))
@@ -391,30 +514,39 @@ def WriteMEDS(obj_list, file_name, clobber=True):
     except:
         metadata = pyfits.new_table(pyfits.ColDefs(cols))
         metadata.update_ext_name('metadata')
+    return metadata
+
 
-    # rest of HDUs are image vectors
-    image_cutouts   = pyfits.ImageHDU( vec['image'] , name='image_cutouts'  )
-    weight_cutouts  = pyfits.ImageHDU( vec['weight'], name='weight_cutouts' )
-    seg_cutouts     = pyfits.ImageHDU( vec['seg']   , name='seg_cutouts'    )
-    psf_cutouts     = pyfits.ImageHDU( vec['psf']   , name='psf'            )
-
-    # write all
-    hdu_list = pyfits.HDUList([
-        primary,
-        object_data,
-        image_info,
-        metadata,
-        image_cutouts,
-        weight_cutouts,
-        seg_cutouts,
-        psf_cutouts
-    ])
-    hdu_list.writeto(file_name,clobber=clobber)
+def WriteMEDS(obj_list, file_name, clobber=True, compression='auto'):
+    """
+    Writes a MEDS file from a list of MultiExposureObjects.
+
+    This is a convenience wrapper around MEDSWriter.  If the objects are being made one at a
+    time, it is more efficient to write them with a MEDSWriter as they are made, so that the
+    whole list does not need to be kept in memory.
+
+    Arguments:
+    ----------
+    @param obj_list:     List of MultiExposureObjects
+    @param file_name:    Name of meds file to be written
+    @param clobber       Setting `clobber=True` when `file_name` is given will silently overwrite
+                         existing files. (Default `clobber = True`.)
+    @param compression   Which compression scheme to use (if any).  See MEDSWriter for details.
+                         (Default `compression = 'auto'`.)
+    """
+    with MEDSWriter(file_name, clobber=clobber, compression=compression,
+                    nobjects=len(obj_list)) as meds:
+        for obj in obj_list:
+            meds.write(obj)
 
 
 # Make the class that will 
 class MEDSBuilder(galsim.config.OutputBuilder):
 
+    # The images are built this many at a time (rounded to whole objects), and each batch is
+    # written to the MEDSWriter before the next one is built.
+    _batch_nimages = 256
+
     def buildImages(self, config, base, file_num, image_num, obj_num, ignore, logger):
         """
         Build a meds file as specified in config.
@@ -428,7 +560,7 @@ class MEDSBuilder(galsim.config.OutputBuilder):
                                 ignore here.
         @param logger           If given, a logger object to log progress.
 
-        @returns obj_list
+        @returns a MEDSWriter holding the objects, which writes the file when it is closed.
         """
         import time
         t1 = time.time()
@@ -443,37 +575,66 @@ class MEDSBuilder(galsim.config.OutputBuilder):
 
         nobjects = params['nobjects']
         nstamps_per_object = params['nstamps_per_object']
-        ntot = nobjects * nstamps_per_object
-
-        main_images = galsim.config.BuildImages(ntot, base, image_num=image_num,  obj_num=obj_num,
-                                                logger=logger)
 
-        weight_images = galsim.config.GetFinalExtraOutput('weight', base, logger)
-        if 'badpix' in config:
-            badpix_images = galsim.config.GetFinalExtraOutput('badpix', base, logger)
-        else:
-            badpix_images = None
-        psf_images = galsim.config.GetFinalExtraOutput('psf', base, logger)
-
-        obj_list = []
-        for i in range(nobjects):
-            k1 = i*nstamps_per_object
-            k2 = (i+1)*nstamps_per_object
-            if badpix_images is not None:
-                bpk = badpix_images[k1:k2]
-            else:
-                bpk = None
-            obj = MultiExposureObject(images = main_images[k1:k2],
-                                      weight = weight_images[k1:k2],
-                                      badpix = bpk,
-                                      psf = psf_images[k1:k2],
-                                      id = obj_num + i)
-            obj_list.append(obj)
-
-        return obj_list
+        # Rather than building all the images and then writing them, write each batch of
+        # objects to a MEDSWriter as soon as it is built, so only one batch of images needs
+        # to be in memory at a time.  The MEDS file itself is written in writeFile.
+        file_name = self.getFilename(config, base, logger)
+        meds = MEDSWriter(file_name, nobjects=nobjects)
+        nobj_per_batch = max(1, self._batch_nimages // nstamps_per_object)
+        try:
+            for i1 in range(0, nobjects, nobj_per_batch):
+                i2 = min(i1 + nobj_per_batch, nobjects)
+                k1 = i1 * nstamps_per_object
+                k2 = i2 * nstamps_per_object
+
+                main_images = galsim.config.BuildImages(
+                        k2-k1, base, image_num=image_num+k1, obj_num=obj_num+k1, logger=logger)
+                weight_images = self._takeExtraOutput('weight', base, k1, k2)
+                if 'badpix' in config:
+                    badpix_images = self._takeExtraOutput('badpix', base, k1, k2)
+                else:
+                    badpix_images = None
+                psf_images = self._takeExtraOutput('psf', base, k1, k2)
+
+                for i in range(i2-i1):
+                    j1 = i*nstamps_per_object
+                    j2 = (i+1)*nstamps_per_object
+                    if badpix_images is not None:
+                        bpk = badpix_images[j1:j2]
+                    else:
+                        bpk = None
+                    obj = MultiExposureObject(images = main_images[j1:j2],
+                                              weight = weight_images[j1:j2],
+                                              badpix = bpk,
+                                              psf = psf_images[j1:j2],
+                                              id = obj_num + i1 + i)
+                    meds.write(obj)
+        except:
+            meds._discard()
+            raise
+
+        return meds
+
+    def _takeExtraOutput(self, key, base, k1, k2):
+        """Get the images k1..k2 of the given extra output.
+
+        Unless the extra output is also being written to its own file, the images are released
+        once they are taken, so they don't accumulate over the whole file.
+        """
+        builder = base['extra_builder'][key]
+        images = builder.data[k1:k2]
+        if 'file_name' not in base['output'][key]:
+            for k in range(k1,k2):
+                builder.data[k] = None
+        return images
 
     def writeFile(self, data, file_name):
-        WriteMEDS(data, file_name)
+        data.close()
+
+    def canAddHdus(self):
+        # The extra outputs are already in the MEDS file, and it has no place for other HDUs.
+        return False
 
     def getNImages(self, config, base, file_num):
         # This gets called before starting work on the file, so we can use this opportunity
@@ -236,6 +236,27 @@ class DES_PSFEx(object):
         self.y_scale = pol_scal2
         self.sample_scale = psf_samp
 
+        # The interpolants are shared by all the profiles made by getPSF and getPSFs, so they
+        # only set up their lookup tables once.
+        self._x_interpolant = galsim.Lanczos(3)
+        self._k_interpolant = galsim.Quintic(tol=1e-4)
+        self._setModel()
+
+    def _setModel(self):
+        # The C++ model keeps the basis as one contiguous array in double precision.
+        basis = np.ascontiguousarray(self.basis, dtype=float)
+        self._model = galsim._galsim._PSFExModel(basis, self.fit_order, self.x_zero, self.y_zero,
+                                                 self.x_scale, self.y_scale)
+
+    def __getstate__(self):
+        d = self.__dict__.copy()
+        del d['_model']
+        return d
+
+    def __setstate__(self, d):
+        self.__dict__ = d
+        self._setModel()
+
     def getSampleScale(self): 
         return self.sample_scale
 
@@ -263,8 +284,9 @@ class DES_PSFEx(object):
         im = galsim.Image(self.getPSFArray(image_pos))
 
         # Build the PSF profile in the image coordinate system.
-        psf = galsim.InterpolatedImage(im, scale=self.sample_scale, flux=1, 
-                                       x_interpolant=galsim.Lanczos(3), gsparams=gsparams)
+        psf = galsim.InterpolatedImage(im, scale=self.sample_scale, flux=1,
+                                       x_interpolant=self._x_interpolant,
+                                       k_interpolant=self._k_interpolant, gsparams=gsparams)
 
         # This brings if from image coordinates to world coordinates.
         if self.wcs:
@@ -275,31 +297,62 @@ class DES_PSFEx(object):
 
         return psf
 
+    def getPSFs(self, image_pos_list, gsparams=None):
+        """Returns the PSFs at a list of positions.
+
+        This is equivalent to `[ self.getPSF(image_pos) for image_pos in image_pos_list ]`, but
+        it is much faster when there are many positions.  The PSF images for all the positions
+        are calculated at once in C++, and the interpolated image profiles are also made there
+        (in parallel if OpenMP is enabled), all sharing the same interpolants.
+
+        The returned profiles are not InterpolatedImage instances, but they draw the same way
+        as the ones returned by getPSF.
+
+        @param image_pos_list   A list of positions in image coordinates at which to build the
+                                PSF.
+        @param gsparams         (Optional) A GSParams instance to pass to the constructed
+                                GSObjects.
+
+        @returns a list of the PSFs as GSObjects
+        """
+        x = np.array([ pos.x for pos in image_pos_list ], dtype=float)
+        y = np.array([ pos.y for pos in image_pos_list ], dtype=float)
+        sbiis = self._model.getProfiles(x, y, self._x_interpolant, self._k_interpolant,
+                                        4., gsparams)
+
+        # Do the same steps that InterpolatedImage does to go from the profile in PSFEx pixels
+        # to one in image coordinates.
+        shape = self.basis.shape[1:]
+        pixel_wcs = galsim.PixelScale(self.sample_scale)
+        zero = galsim.PositionD(0,0)
+        psfs = []
+        for image_pos, sbii in zip(image_pos_list, sbiis):
+            psf = galsim.GSObject(sbii)._fix_center(shape, zero, True, reverse=True)
+            psf = pixel_wcs.toWorld(psf).withFlux(1.)
+            if self.wcs:
+                psf = self.wcs.toWorld(psf, image_pos=image_pos)
+            psfs.append(psf)
+        return psfs
+
     def getPSFArray(self, image_pos):
         """Returns the PSF image as a numpy array at position image_pos in image coordinates.
         """
-        xto = self._define_xto( (image_pos.x - self.x_zero) / self.x_scale )
-        yto = self._define_xto( (image_pos.y - self.y_zero) / self.y_scale )
-        order = self.fit_order
-        P = np.array([ xto[nx] * yto[ny] for ny in range(order+1) for nx in range(order+1-ny) ])
-        assert len(P) == self.fit_size
-        ar = np.tensordot(P,self.basis,(0,0)).astype(np.float32)
-        # Note: This is equivalent to:
-        #   ar = self.basis[0].astype(numpy.float32)
-        #   for n in range(1,self.fit_order+1):
-        #       for ny in range(n+1):
-        #           nx = n-ny
-        #           k = nx+ny*(self.fit_order+1)-ny*(ny-1)/2
-        #           ar += xto[nx] * yto[ny] * self.basis[k]
-        # which is pretty much Peter's version of this code.
-        return ar
+        return self.getPSFArrays([image_pos])[0]
+
+    def getPSFArrays(self, image_pos_list):
+        """Returns the PSF images as a numpy array at a list of positions in image coordinates.
 
-    def _define_xto(self, x):
-        xto = np.empty(self.fit_order+1)
-        xto[0] = 1
-        for i in range(1,self.fit_order+1):
-            xto[i] = x*xto[i-1]
-        return xto
+        The returned array has shape (n, ny, nx), where n is the number of positions.
+        """
+        x = np.array([ pos.x for pos in image_pos_list ], dtype=float)
+        y = np.array([ pos.y for pos in image_pos_list ], dtype=float)
+        ar = np.empty((len(x),) + self.basis.shape[1:], dtype=np.float32)
+        # This is the matrix product of the polynomial terms at each position with the basis:
+        #   P = [ xto[nx] * yto[ny] for ny in range(order+1) for nx in range(order+1-ny) ]
+        #   ar[i] = np.tensordot(P,self.basis,(0,0))
+        # where xto and yto are the powers of (x-x_zero)/x_scale and (y-y_zero)/y_scale.
+        self._model.getImages(x, y, ar)
+        return ar
 
 
 class PSFExLoader(galsim.config.InputLoader):
@@ -24,6 +24,7 @@ routines for handling multiple Images.
 
 from future.utils import iteritems, iterkeys, itervalues
 import os
+import numpy as np
 import galsim
 
 
@@ -483,6 +484,122 @@ def closeHDUList(hdu_list, fin):
         else:
             fin.close()
 
+# The C++ layer can write single images itself, uncompressed or with tile compression, which
+# avoids making a separate copy of the data for pyfits.  It can also read parts of images.
+_structural_keys = [ 'SIMPLE', 'BITPIX', 'NAXIS', 'NAXIS1', 'NAXIS2', 'EXTEND', 'XTENSION',
+                     'PCOUNT', 'GCOUNT', 'BSCALE', 'BZERO', 'END' ]
+
+def _native_compression(pyfits_compress, dtype):
+    """Return the compression argument for the C++ FITS writer, or None if the given
+    compression needs to be done by pyfits.
+    """
+    if pyfits_compress is None:
+        return 'none'
+    elif pyfits_compress == 'GZIP_1':
+        return 'gzip_tile'
+    elif pyfits_compress == 'RICE_1' and dtype in [np.int16, np.int32]:
+        return 'rice'
+    else:
+        return None
+
+def _header_cards(bounds, wcs, header=None):
+    """Make the header cards for the C++ FITS writer as a single string.
+    """
+    from galsim._pyfits import pyfits
+    hdr = pyfits.Header()
+    if header is not None:
+        for key in header.keys():
+            if key in _structural_keys or key.startswith('NAXIS') or key.startswith('Z'):
+                continue
+            hdr[key] = header[key]
+    if wcs:
+        wcs.writeToFitsHeader(hdr, bounds)
+    return hdr.tostring(endcard=False, padding=False)
+
+
+class FitsWriter(object):
+    """A class for writing an image to a FITS file a block of rows at a time.
+
+    The header is written when the FitsWriter is constructed, and then each call to `write`
+    writes the next rows of the image, so the full image does not need to be held in memory.
+    The rows must be written in order, starting from the bottom row of the given bounds, and
+    each image written must span the full width of the bounds.
+
+    Only the compression types 'none', 'gzip_tile', and (for integer types) 'rice' are
+    available for this.  The tiles are each a single row, and with OpenMP, they are compressed
+    in parallel.
+
+        >>> writer = galsim.fits.FitsWriter('out.fits.fz', bounds)
+        >>> for ymin in range(bounds.ymin, bounds.ymax+1, 100):
+        ...     b = galsim.BoundsI(bounds.xmin, bounds.xmax, ymin, min(ymin+99, bounds.ymax))
+        ...     block = galsim.ImageF(b)
+        ...     # Draw things on block
+        ...     writer.write(block)
+        >>> writer.close()
+
+    A FitsWriter may also be used as a context manager, in which case close() is called
+    automatically at the end of the `with` block.
+
+    @param file_name    The name of the file to write.
+    @param bounds       The bounds of the full image.
+    @param dtype        The data type of the pixels. [default: numpy.float32]
+    @param dir          Optionally a directory name can be provided if `file_name` does not
+                        already include it. [default: None]
+    @param wcs          If provided, the wcs to write to the header. [default: None]
+    @param header       If provided, a FitsHeader (or dict) with other items to write to the
+                        header. [default: None]
+    @param clobber      Setting `clobber=True` will silently overwrite existing files.
+                        [default: True]
+    @param compression  Which compression scheme to use.  See galsim.fits.write() for the
+                        options, although only 'none', 'gzip_tile', 'rice' and 'auto' are valid
+                        here.  [default: 'auto']
+    """
+    def __init__(self, file_name, bounds, dtype=np.float32, dir=None, wcs=None, header=None,
+                 clobber=True, compression='auto'):
+        file_compress, pyfits_compress = _parse_compression(compression,file_name)
+        dtype = galsim.Image.alias_dtypes.get(dtype, dtype)
+        if dtype not in galsim.Image.cpp_valid_dtypes:
+            raise ValueError("dtype must be one of "+str(galsim.Image.cpp_valid_dtypes))
+        comp = _native_compression(pyfits_compress, dtype)
+        if file_compress or comp is None:
+            raise ValueError("Compression %s is not valid for FitsWriter"%compression)
+        if not isinstance(bounds, galsim.BoundsI):
+            raise TypeError("bounds must be a galsim.BoundsI instance")
+        if dir:
+            file_name = os.path.join(dir,file_name)
+        if not clobber and os.path.isfile(file_name):
+            raise IOError('File %r already exists'%file_name)
+        self.file_name = file_name
+        self.bounds = bounds
+        self.dtype = dtype
+        cards = _header_cards(bounds, wcs, header)
+        self._writer = galsim._galsim.FitsWriter[dtype](file_name, bounds, cards, comp)
+
+    @property
+    def next_row(self):
+        """The next row of the image to be written."""
+        return self._writer.next_row
+
+    def write(self, image):
+        """Write the next rows of the image.
+        """
+        if image.dtype != self.dtype:
+            image = galsim.Image(image, dtype=self.dtype)
+        self._writer.write(image.image)
+
+    def close(self):
+        """Finish writing the file.
+        """
+        self._writer.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        if type is None:
+            self.close()
+
+
 ##############################################################################################
 #
 # Now the primary write functions.  We have:
@@ -494,7 +611,8 @@ def closeHDUList(hdu_list, fin):
 ##############################################################################################
 
 
-def write(image, file_name=None, dir=None, hdu_list=None, clobber=True, compression='auto'):
+def write(image, file_name=None, dir=None, hdu_list=None, clobber=True, compression='auto',
+          native=False):
     """Write a single image to a FITS file.
 
     Write the Image instance `image` to a FITS file, with details depending on the arguments.  This
@@ -532,6 +650,13 @@ def write(image, file_name=None, dir=None, hdu_list=None, clobber=True, compress
                                    '*.bz2' => 'bzip2'
                                    otherwise None
                         [default: 'auto']
+    @param native       Whether to write the file directly from the C++ image rather than through
+                        pyfits, which avoids making a copy of the data.  This is only possible
+                        when writing to `file_name` with no compression, 'gzip_tile', or (for
+                        integer images) 'rice'.  Other cases are always written by pyfits.  Note
+                        that unlike pyfits, the native writer stores floating point images
+                        losslessly with 'gzip_tile', rather than quantizing them.
+                        [default: False]
     """
     from galsim._pyfits import pyfits
 
@@ -542,6 +667,17 @@ def write(image, file_name=None, dir=None, hdu_list=None, clobber=True, compress
     if not (file_name or hdu_list is not None):
         raise TypeError("Must provide either file_name or hdu_list")
 
+    comp = _native_compression(pyfits_compress, image.dtype)
+    if native and hdu_list is None and not file_compress and comp is not None:
+        # We can write this directly from the C++ image.
+        if dir:
+            file_name = os.path.join(dir,file_name)
+        if not clobber and os.path.isfile(file_name):
+            raise IOError('File %r already exists'%file_name)
+        cards = _header_cards(image.bounds, image.wcs, getattr(image, 'header', None))
+        galsim._galsim._WriteFitsImage(image.image, file_name, cards, comp)
+        return
+
     if hdu_list is None:
         hdu_list = pyfits.HDUList()
 
@@ -740,7 +876,7 @@ def writeFile(file_name, hdu_list, dir=None, clobber=True, compression='auto'):
 ##############################################################################################
 
 
-def read(file_name=None, dir=None, hdu_list=None, hdu=None, compression='auto'):
+def read(file_name=None, dir=None, hdu_list=None, hdu=None, compression='auto', bounds=None):
     """Construct an Image from a FITS file or pyfits HDUList.
 
     The normal usage for this function is to read a fits file and return the image contained
@@ -782,6 +918,10 @@ def read(file_name=None, dir=None, hdu_list=None, hdu=None, compression='auto'):
                                    '*.bz2' => 'bzip2'
                                    otherwise None
                         [default: 'auto']
+    @param bounds       If provided, only read the part of the image with these bounds.  For
+                        files that are uncompressed or use gzip or rice tile compression, only
+                        the part of the file that contains these pixels is read (and
+                        decompressed).  [default: None]
 
     @returns the image as an Image instance.
     """
@@ -793,6 +933,13 @@ def read(file_name=None, dir=None, hdu_list=None, hdu=None, compression='auto'):
     if not (file_name or hdu_list is not None):
         raise TypeError("Must provide either file_name or hdu_list to read()")
 
+    if bounds is not None:
+        if file_name and not file_compress:
+            image = _read_bounds(file_name, dir, hdu, pyfits_compress, bounds)
+            if image is not None:
+                return image
+        return read(file_name, dir, hdu_list, hdu, compression)[bounds].copy()
+
     if file_name:
         hdu_list, fin = _read_file(file_name, dir, file_compress)
 
@@ -821,6 +968,42 @@ def read(file_name=None, dir=None, hdu_list=None, hdu=None, compression='auto'):
 
     return image
 
+def _read_bounds(file_name, dir, hdu, pyfits_compress, bounds):
+    """Read part of an image using the C++ FITS reader.  Returns None if the reader cannot
+    handle this HDU.
+    """
+    from galsim._pyfits import pyfits
+    if dir:
+        file_name = os.path.join(dir,file_name)
+    if hdu is None:
+        hdu = 1 if pyfits_compress else 0
+
+    # pyfits only reads the headers here, not the data.
+    hdu_list = pyfits.open(file_name)
+    try:
+        if len(hdu_list) <= hdu:
+            raise IOError('Expecting at least %d HDUs in galsim.read'%(hdu+1))
+        header = hdu_list[hdu].header
+        wcs, origin = galsim.wcs.readFromFitsHeader(header)
+        bitpix = header.get('BITPIX')
+        scaled = header.get('BSCALE',1) != 1 or header.get('BZERO',0) != 0
+    finally:
+        hdu_list.close()
+    dtypes = { 16 : np.int16, 32 : np.int32, -32 : np.float32, -64 : np.float64 }
+    dtype = np.float64 if scaled else dtypes.get(bitpix, np.float64)
+
+    # The C++ reader uses the FITS convention for the pixel coordinates.
+    fits_bounds = galsim.BoundsI(bounds.xmin - origin.x + 1, bounds.xmax - origin.x + 1,
+                                 bounds.ymin - origin.y + 1, bounds.ymax - origin.y + 1)
+    image = galsim.Image(fits_bounds, dtype=dtype)
+    try:
+        galsim._galsim._ReadFitsImage(image.image.view(), file_name, hdu)
+    except RuntimeError:
+        return None
+    image.setOrigin(bounds.xmin, bounds.ymin)
+    image.wcs = wcs
+    return image
+
 def readMulti(file_name=None, dir=None, hdu_list=None, compression='auto'):
     """Construct a list of Images from a FITS file or pyfits HDUList.
 
@@ -1023,6 +1206,92 @@ def readFile(file_name, dir=None, hdu=None, compression='auto'):
     return hdu, hdu_list, fin
 
 
+##############################################################################################
+#
+# Memory-mapped FITS images
+#
+##############################################################################################
+
+def mapImage(file_name, bounds, dtype=np.float32, dir=None, scale=None, wcs=None, header=None):
+    """Make a new FITS file whose data section is used directly as the memory of an Image.
+
+    This writes the primary header for an image with the given bounds and type, and then
+    returns an Image whose pixels are the (memory-mapped) data section of the file.  See
+    galsim.MappedImage for details.  This is useful for building a very large image, since
+    only the parts being worked on need to be in memory at any time, and there is no need to
+    write out the image at the end.
+
+    FITS files are required to be big-endian.  GalSim needs the pixels in native byte order
+    while it is working on them, so once you are done with the image, you must call
+    galsim.fits.unmapImage(image), which swaps the bytes in place if necessary.  After that,
+    the image should not be used any more.
+
+    @param file_name    The name of the file to write.  Any existing file is overwritten.
+    @param bounds       The bounds of the image (must be a BoundsI instance).
+    @param dtype        The data type of the pixels. [default: numpy.float32]
+    @param dir          Optionally a directory name can be provided if `file_name` does not 
+                        already include it. [default: None]
+    @param scale        If provided, use this as the pixel scale for the Image. [default: None]
+    @param wcs          If provided, use this as the wcs for the image.  It is also written to
+                        the header. [default: None]
+    @param header       If provided, a FitsHeader (or dict) with other items to add to the
+                        header. [default: None]
+
+    @returns the Image
+    """
+    from galsim._pyfits import pyfits
+
+    if dir:
+        file_name = os.path.join(dir,file_name)
+    if not isinstance(bounds, galsim.BoundsI):
+        raise TypeError("bounds must be a galsim.BoundsI instance")
+    dtype = galsim.Image.alias_dtypes.get(dtype, dtype)
+    if dtype not in galsim.Image.cpp_valid_dtypes:
+        raise ValueError("dtype must be one of "+str(galsim.Image.cpp_valid_dtypes))
+    if scale is not None:
+        if wcs is not None:
+            raise TypeError("Cannot provide both scale and wcs")
+        wcs = galsim.PixelScale(scale)
+
+    ncol = bounds.xmax - bounds.xmin + 1
+    nrow = bounds.ymax - bounds.ymin + 1
+    itemsize = np.dtype(dtype).itemsize
+    bitpix = { np.int16 : 16, np.int32 : 32, np.float32 : -32, np.float64 : -64 }[dtype]
+
+    hdr = pyfits.Header()
+    hdr['SIMPLE'] = True
+    hdr['BITPIX'] = bitpix
+    hdr['NAXIS'] = 2
+    hdr['NAXIS1'] = ncol
+    hdr['NAXIS2'] = nrow
+    if header is not None:
+        for key in header.keys():
+            hdr[key] = header[key]
+    if wcs is not None:
+        wcs.writeToFitsHeader(hdr, bounds)
+    hdr_str = hdr.tostring()  # Includes the END card and padding to 2880 bytes.
+
+    # The data section also needs to be padded to a multiple of 2880 bytes.
+    nbytes = ncol * nrow * itemsize
+    nbytes = ((nbytes + 2879) // 2880) * 2880
+    with open(file_name, 'wb') as fout:
+        fout.write(hdr_str.encode('ascii'))
+        fout.truncate(len(hdr_str) + nbytes)
+
+    return galsim.MappedImage(bounds, file_name, dtype=dtype, offset=len(hdr_str), wcs=wcs)
+
+def unmapImage(image):
+    """Finish writing a FITS file that was made with galsim.fits.mapImage.
+
+    This converts the pixel values in the file to big-endian order if necessary.  The image
+    should not be used any more after calling this.
+
+    @param image        The image returned by galsim.fits.mapImage.
+    """
+    import sys
+    if sys.byteorder == 'little':
+        image.array.byteswap(True)
+
 ##############################################################################################
 #
 # Finally, we have a class for handling FITS headers called FitsHeader.
@@ -949,14 +949,8 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
             self.pv = _data[4]
             self.ab = _data[5]
             self.abp = _data[6]
-            if self.wcs_type in [ 'TAN', 'TPV' ]:
-                self.projection = 'gnomonic'
-            elif self.wcs_type == 'STG':
-                self.projection = 'stereographic'
-            elif self.wcs_type == 'ZEA':
-                self.projection = 'lambert'
-            elif self.wcs_type == 'ARC':
-                self.projection = 'postel'
+            self.projection = self._get_projection(self.wcs_type)
+            self._set_transform()
             return
 
         # Read the file if given.
@@ -987,12 +981,38 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
         if origin is not None:
             self.crpix += [ origin.x, origin.y ]
 
+        self._set_transform()
+
     # The origin is a required attribute/property, since it is used by some functions like
     # withOrigin to get the current origin value.  We don't use it in this class, though, so
     # just make origin a dummy property that returns 0,0.
     @property
     def origin(self): return galsim.PositionD(0.,0.)
 
+    @staticmethod
+    def _get_projection(wcs_type):
+        if wcs_type in [ 'TAN', 'TPV', 'TNX', 'TAN-SIP' ]:
+            return 'gnomonic'
+        elif wcs_type == 'STG':
+            return 'stereographic'
+        elif wcs_type == 'ZEA':
+            return 'lambert'
+        elif wcs_type == 'ARC':
+            return 'postel'
+        else:
+            raise RuntimeError("GSFitsWCS cannot read files using WCS type "+wcs_type)
+
+    def _set_transform(self):
+        # The transformations themselves are done in C++, which works on whole arrays of
+        # positions at once.  It needs to be remade whenever any of the parameters change.
+        def carray(a):
+            if a is None: return None
+            return np.ascontiguousarray(a, dtype=float)
+        self._transform = galsim._galsim._FitsWCSTransform(
+                self.projection, self.center.ra.rad(), self.center.dec.rad(),
+                carray(self.crpix), carray(self.cd), carray(self.pv), carray(self.ab),
+                carray(self.abp))
+
     def _read_header(self, header):
         # Start by reading the basic WCS stuff that most types have.
         ctype1 = header['CTYPE1']
@@ -1008,16 +1028,7 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
         if ctype1[5:] != ctype2[5:]:
             raise RuntimeError("ctype1, ctype2 do not seem to agree on the WCS type")
         self.wcs_type = ctype1[5:]
-        if self.wcs_type in [ 'TAN', 'TPV', 'TNX', 'TAN-SIP' ]:
-            self.projection = 'gnomonic'
-        elif self.wcs_type == 'STG':
-            self.projection = 'stereographic'
-        elif self.wcs_type == 'ZEA':
-            self.projection = 'lambert'
-        elif self.wcs_type == 'ARC':
-            self.projection = 'postel'
-        else:
-            raise RuntimeError("GSFitsWCS cannot read files using WCS type "+self.wcs_type)
+        self.projection = self._get_projection(self.wcs_type)
         crval1 = float(header['CRVAL1'])
         crval2 = float(header['CRVAL2'])
         crpix1 = float(header['CRPIX1'])
@@ -1310,191 +1321,35 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
             return pv2
 
     def _radec(self, x, y):
-
-        # Start with (x,y) = the image position
-        p1 = np.array( [ np.atleast_1d(x), np.atleast_1d(y) ] )
-
-        p1 -= self.crpix[:,np.newaxis]
-
-        if self.ab is not None:
-            xx = p1[0]
-            yy = p1[1]
-            ones = np.ones(xx.shape)
-            order = len(self.ab[0])-1
-            xpow = np.array([ ones for i in range(order+1) ])
-            xpow[1] = xx
-            for i in range(2,order+1): xpow[i] = xpow[i-1] * xx
-            ypow = np.array([ ones for i in range(order+1) ])
-            ypow[1] = yy
-            for i in range(2,order+1): ypow[i] = ypow[i-1] * yy
-            # See below for the explanation of this calculation
-            temp = np.dot(self.ab, ypow)
-            p1 += np.sum(xpow * temp, axis=1)
-
-        # This converts to (u,v) in the tangent plane
-        p2 = np.dot(self.cd, p1)
-
-        if self.pv is not None:
-            # Now we apply the distortion terms
-            u = p2[0]
-            v = p2[1]
-            usq = u*u
-            vsq = v*v
-            ones = np.ones(u.shape)
-            upow = np.array([ ones, u, usq, usq*u ])
-            vpow = np.array([ ones, v, vsq, vsq*v ])
-            # If we only have one input position, then p2 is 
-            #     p2[0] = upowT . pv[0] . vpow
-            #     p2[1] = upowT . pv[1] . vpow
-            # using matrix products, which are effected with the numpy.dot function.
-            # When there are multiple inputs, then upow and vpow are each 4xN matrices.
-            # The values we want are the diagonal of the matrix you would get from the 
-            # above formulae.  So we use the fact that 
-            #     diag(AT . B) = sum_rows(A * B)
-            temp = np.dot(self.pv, vpow)
-            p2 = np.sum(upow * temp, axis=1)
-
-        # Convert (u,v) from degrees to arcsec
-        # Also, the FITS standard defines u,v backwards relative to our standard.
-        # They have +u increasing to the east, not west.  Hence the - for u.
-        factor = 1. * galsim.degrees / galsim.arcsec
-        u = -p2[0] * factor
-        v = p2[1] * factor
-
-        # Finally convert from (u,v) to (ra, dec) using the appropriate projection.
-        ra, dec = self.center.deproject_rad(u, v, projection=self.projection)
-
-        try:
-            len(x)
-            # If the inputs were numpy arrays, return the same
-            return ra, dec
-        except:
-            # Otherwise return scalars
-            assert len(ra) == 1
-            assert len(dec) == 1
+        x = np.asarray(x, dtype=float)
+        y = np.asarray(y, dtype=float)
+        ra = np.empty(x.size)
+        dec = np.empty(x.size)
+        self._transform.toWorld(x.ravel(), y.ravel(), ra, dec)
+        if x.ndim == 0:
             return ra[0], dec[0]
- 
-    def _xy(self, ra, dec):
-        import numpy.linalg
-
-        u, v = self.center.project_rad(ra, dec, projection=self.projection)
-
-        # Again, FITS has +u increasing to the east, not west.  Hence the - for u.
-        factor = 1. * galsim.arcsec / galsim.degrees
-        u *= -factor
-        v *= factor
-
-        p2 = np.array( [ u, v ] )
+        else:
+            return ra.reshape(x.shape), dec.reshape(x.shape)
 
-        if self.pv is not None:
-            # Let (s,t) be the current value of (u,v).  Then we want to find a new (u,v) such that
-            #
-            #       [ s t ] = [ 1 u u^2 u^3 ] pv [ 1 v v^2 v^3 ]^T
-            #
-            # Start with (u,v) = (s,t)
-            #
-            # Then use Newton-Raphson iteration to improve (u,v).  This is extremely fast
-            # for typical PV distortions, since the distortions are generally very small.
-            # Newton-Raphson doubles the number of significant digits in each iteration.
-
-
-            MAX_ITER = 10
-            TOL = 1.e-8 * galsim.arcsec / galsim.degrees   # pv always uses degrees units
-            prev_err = None
-            u = p2[0]
-            v = p2[1]
-            for iter in range(MAX_ITER):
-                usq = u*u
-                vsq = v*v
-                upow = np.array([ 1., u, usq, usq*u ])
-                vpow = np.array([ 1., v, vsq, vsq*v ])
-
-                diff = np.dot(np.dot(self.pv, vpow), upow) - p2
-
-                # Check that things are improving...
-                err = np.max(np.abs(diff))
-                if prev_err:
-                    if err > prev_err:
-                        raise RuntimeError("Unable to solve for image_pos (not improving)")
-                prev_err = err
-
-                # If we are below tolerance, break out of the loop
-                if err < TOL: 
-                    # Update p2 to the new value.
-                    p2 = np.array( [ u, v ] )
-                    break
-                else:
-                    dupow = np.array([ 0., 1., 2.*u, 3.*usq ])
-                    dvpow = np.array([ 0., 1., 2.*v, 3.*vsq ])
-                    j1 = np.transpose([ np.dot(np.dot(self.pv, vpow), dupow) ,
-                                        np.dot(np.dot(self.pv, dvpow), upow) ])
-                    dp = numpy.linalg.solve(j1, diff)
-                    u -= dp[0]
-                    v -= dp[1]
-            if not err < TOL:
-                raise RuntimeError("Unable to solve for image_pos (max iter reached)")
-
-        p1 = np.dot(numpy.linalg.inv(self.cd), p2)
+    def _xy(self, ra, dec):
+        ra = np.asarray(ra, dtype=float)
+        dec = np.asarray(dec, dtype=float)
+        x = np.empty(ra.size)
+        y = np.empty(ra.size)
+        self._transform.toImage(ra.ravel(), dec.ravel(), x, y)
+        if ra.ndim == 0:
+            return x[0], y[0]
+        else:
+            return x.reshape(ra.shape), y.reshape(ra.shape)
 
-        if self.ab is not None:
-            x = p1[0]
-            y = p1[1]
-            order = len(self.ab[0])-1
-            if self.abp is not None:
-                xpow = x ** np.arange(order+1)
-                ypow = y ** np.arange(order+1)
-                temp = np.dot(self.abp, ypow)
-                dp1 = np.sum(xpow * temp, axis=1)
-                x += dp1[0]
-                y += dp1[1]
-
-            # We do this iteration even if we have AP and BP matrices, since the inverse
-            # transformation is not always very accurate.
-            # The assumption here is that the A adn B matrices are correct and the AP and BP
-            # matrices are estimated from them, and thus are approximate at some level.
-            # Of course, in reality the A and B matrices are also approximate, but at least this
-            # way the WCS is consistent transforming in the two directions.
-            MAX_ITER = 10
-            TOL = 1.e-8 * galsim.arcsec / galsim.degrees
-            prev_err = None
-            for iter in range(MAX_ITER):
-                # Slightly easier here than in _radec function, since we don't have to worry
-                # about the possibility of doing many x,y at once.
-                xpow = x ** np.arange(order+1)
-                ypow = y ** np.arange(order+1)
-
-                diff = np.dot(np.dot(self.ab, ypow), xpow) + np.array([x,y]) - p1
-
-                # Check that things are improving...
-                err = np.max(np.abs(diff))
-                if prev_err:
-                    if err > prev_err:
-                        raise RuntimeError("Unable to solve for image_pos (not improving)")
-                prev_err = err
-
-                # If we are below tolerance, break out of the loop
-                if err < TOL: 
-                    # Update p2 to the new value.
-                    p1 = np.array( [ x, y ] )
-                    break
-                else:
-                    dxpow = np.zeros(order+1)
-                    dypow = np.zeros(order+1)
-                    dxpow[1:] = (np.arange(order)+1.) * xpow[:-1]
-                    dypow[1:] = (np.arange(order)+1.) * ypow[:-1]
-                    j1 = np.transpose([ np.dot(np.dot(self.ab, ypow), dxpow) ,
-                                        np.dot(np.dot(self.ab, dypow), xpow) ])
-                    j1 += np.diag([1,1])
-                    dp = numpy.linalg.solve(j1, diff)
-                    x -= dp[0]
-                    y -= dp[1]
-            if not err < TOL:
-                raise RuntimeError("Unable to solve for image_pos (max iter reached)")
-
-        p1 += self.crpix
-
-        x, y = p1
-        return x, y
+    def _jacobian(self, x, y):
+        # Returns the local jacobians at the image positions (x,y) as an array with shape
+        # (n,4), where the columns are dudx, dudy, dvdx, dvdy.
+        x = np.asarray(x, dtype=float).ravel()
+        y = np.asarray(y, dtype=float).ravel()
+        jac = np.empty((x.size, 4))
+        self._transform.jacobian(x, y, jac)
+        return jac
 
     # Override the version in CelestialWCS, since we can do this more efficiently.
     def _local(self, image_pos, world_pos):
@@ -1502,89 +1357,24 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
             if world_pos is None:
                 raise TypeError("Either image_pos or world_pos must be provided")
             image_pos = self._posToImage(world_pos)
-
-        # The key lemma here is that chain rule for jacobians is just matrix multiplication.
-        # i.e. if s = s(u,v), t = t(u,v) and u = u(x,y), v = v(x,y), then
-        # ( dsdx  dsdy ) = ( dsdu dudx + dsdv dvdx   dsdu dudy + dsdv dvdy )
-        # ( dtdx  dtdy ) = ( dtdu dudx + dtdv dvdx   dtdu dudy + dtdv dvdy )
-        #                = ( dsdu  dsdv )  ( dudx  dudy )
-        #                  ( dtdu  dtdv )  ( dvdx  dvdy )
-        #
-        # So if we can find the jacobian for each step of the process, we just multiply the 
-        # jacobians.
-        #
-        # We also need to keep track of the position along the way, so we have to repeat many
-        # of the steps in _radec.
-
-        p1 = np.array( [ image_pos.x, image_pos.y ] )
-
-        # Start with unit jacobian
-        jac = np.diag([1,1])
-
-        # No effect on the jacobian from this step.
-        p1 -= self.crpix
-
-        if self.ab is not None:
-            x = p1[0]
-            y = p1[1]
-            order = len(self.ab[0])-1
-            xpow = x ** np.arange(order+1)
-            ypow = y ** np.arange(order+1)
-            p1 += np.dot(np.dot(self.ab, ypow), xpow)
-
-            dxpow = np.zeros(order+1)
-            dypow = np.zeros(order+1)
-            dxpow[1:] = (np.arange(order)+1.) * xpow[:-1]
-            dypow[1:] = (np.arange(order)+1.) * ypow[:-1]
-            j1 = np.transpose([ np.dot(np.dot(self.ab, ypow), dxpow) ,
-                                np.dot(np.dot(self.ab, dypow), xpow) ])
-            j1 += np.diag([1,1])
-            jac = np.dot(j1,jac)
-
-        # The jacobian here is just the cd matrix.
-        p2 = np.dot(self.cd, p1)
-        jac = np.dot(self.cd, jac)
-        
-        if self.pv is not None:
-            # Now we apply the distortion terms
-            u = p2[0]
-            v = p2[1]
-            usq = u*u
-            vsq = v*v
-
-            upow = np.array([ 1., u, usq, usq*u ])
-            vpow = np.array([ 1., v, vsq, vsq*v ])
-
-            p2 = np.dot(np.dot(self.pv, vpow), upow)
-
-            # The columns of the jacobian for this step are the same function with dupow 
-            # or dvpow.
-            dupow = np.array([ 0., 1., 2.*u, 3.*usq ])
-            dvpow = np.array([ 0., 1., 2.*v, 3.*vsq ])
-            j1 = np.transpose([ np.dot(np.dot(self.pv, vpow), dupow) ,
-                                np.dot(np.dot(self.pv, dvpow), upow) ])
-            jac = np.dot(j1,jac)
-
-        unit_convert = [ -1 * galsim.degrees / galsim.arcsec, 1 * galsim.degrees / galsim.arcsec ]
-        p2 *= unit_convert
-        # Subtle point: Don't use jac *= ..., because jac might currently be self.cd, and 
-        #               that would change self.cd!
-        jac = jac * np.transpose( [ unit_convert ] )
-
-        # Finally convert from (u,v) to (ra, dec).  We have a special function that computes
-        # the jacobian of this step in the CelestialCoord class.
-        drdu, drdv, dddu, dddv = self.center.deproject_jac(p2[0], p2[1], projection=self.projection)
-        j2 = np.array([ [ drdu, drdv ],
-                        [ dddu, dddv ] ])
-        jac = np.dot(j2,jac)
-
-        return galsim.JacobianWCS(jac[0,0], jac[0,1], jac[1,0], jac[1,1])
-
+        jac = self._jacobian(image_pos.x, image_pos.y)[0]
+        return galsim.JacobianWCS(jac[0], jac[1], jac[2], jac[3])
+
+    # Also override this one, since we can calculate the pixel areas directly from the
+    # jacobians rather than from finite differences.
+    def _makeSkyImage(self, image, sky_level):
+        b = image.bounds
+        x, y = np.meshgrid(np.arange(b.xmin, b.xmax+1, dtype=float),
+                           np.arange(b.ymin, b.ymax+1, dtype=float))
+        jac = self._jacobian(x, y)
+        area = np.abs(jac[:,0] * jac[:,3] - jac[:,1] * jac[:,2])
+        image.image.array[:,:] = area.reshape(x.shape) * sky_level
 
     def _newOrigin(self, origin):
         ret = self.copy()
         if origin is not None:
             ret.crpix = ret.crpix + [ origin.x, origin.y ]
+            ret._set_transform()
         return ret
 
     def _writeHeader(self, header, bounds):
@@ -1682,6 +1472,15 @@ class GSFitsWCS(galsim.wcs.CelestialWCS):
 
     def __hash__(self): return hash(repr(self))
 
+    def __getstate__(self):
+        d = self.__dict__.copy()
+        del d['_transform']
+        return d
+
+    def __setstate__(self, d):
+        self.__dict__ = d
+        self._set_transform()
+
 
 def TanWCS(affine, world_origin, units=galsim.arcsec):
     """This is a function that returns a GSFitsWCS object for a TAN WCS projection.
@@ -955,6 +955,42 @@ def ImageD(*args, **kwargs):
     kwargs['dtype'] = np.float64
     return Image(*args, **kwargs)
 
+def MappedImage(bounds, file_name, dtype=np.float32, offset=0, scale=None, wcs=None):
+    """Make an Image whose pixel values are stored in a memory-mapped file.
+
+    The pixels are stored contiguously (with no padding between rows) in native byte order,
+    starting at byte `offset` in the file.  The file is created if necessary and extended if it
+    is too short, but any existing data in it are kept, so this can also be used to modify the
+    values of an image on disk.
+
+    Drawing into the image, or into views of it made with `subImage` or `image[bounds]`, writes
+    straight through to the file's pages, which the operating system reads and writes back as
+    needed.  This allows building an image that is larger than the available memory, and there
+    is no separate step at the end to write the image out.  The mapping is released once the
+    Image and all views of it have been deleted.
+
+    To make a FITS file this way, use galsim.fits.mapImage instead.
+
+    @param bounds       The bounds of the image (must be a BoundsI instance).
+    @param file_name    The name of the file to map.
+    @param dtype        The data type of the pixels. [default: numpy.float32]
+    @param offset       The offset in bytes of the first pixel in the file.  Must be a multiple
+                        of the pixel size. [default: 0]
+    @param scale        If provided, use this as the pixel scale for the Image. [default: None]
+    @param wcs          If provided, use this as the wcs for the image. [default: None]
+
+    @returns the Image
+    """
+    if not isinstance(bounds, galsim.BoundsI):
+        raise TypeError("bounds must be a galsim.BoundsI instance")
+    dtype = Image.alias_dtypes.get(dtype, dtype)
+    if dtype not in Image.cpp_valid_dtypes:
+        raise ValueError("dtype must be one of "+str(Image.cpp_valid_dtypes))
+    if offset < 0 or offset % np.dtype(dtype).itemsize != 0:
+        raise ValueError("offset must be a non-negative multiple of the pixel size")
+    im = _galsim.ImageAlloc[dtype](bounds, file_name, int(offset))
+    return Image(image=im, scale=scale, wcs=wcs)
+
 
 ################################################################################################
 #
@@ -20,6 +20,7 @@ Includes a Python layer version of the C++ int1d() function in galim::integ,
 and python image integrators for use in galsim.chromatic
 """
 
+import galsim
 from . import _galsim
 import numpy as np
 from functools import reduce
@@ -72,6 +73,28 @@ def midpt(fvals, x):
     weighted_fvals = [w*f for w,f in zip(dx, fvals)]
     return reduce(lambda y,z:y+z, weighted_fvals)
 
+def _rule_weights(rule, x):
+    """Return the weights w such that rule(fvals, x) = sum(w * fvals) for the integration rules
+    defined here, or None if the rule is not one of these.
+    """
+    x = np.array(x, dtype=float)
+    if len(x) < 2:
+        return None
+    if rule is midpt:
+        w = np.empty_like(x)
+        w[0] = x[1]-x[0]
+        w[1:-1] = 0.5*(x[2:]-x[0:-2])
+        w[-1] = x[-1]-x[-2]
+        return w
+    elif rule is np.trapz:
+        dx = np.diff(x)
+        w = np.zeros_like(x)
+        w[:-1] += 0.5*dx
+        w[1:] += 0.5*dx
+        return w
+    else:
+        return None
+
 class ImageIntegrator(object):
     def __init__(self):
         raise NotImplementedError("Must instantiate subclass of ImageIntegrator")
@@ -81,6 +104,13 @@ class ImageIntegrator(object):
     # 2) an function attribute `.rule` which takes a list of integrand evaluations as its first
     #    argument, and a list of evaluation wavelengths as its second argument, and returns
     #    an approximation to the integral.  (E.g., the function midpt above, or numpy.trapz)
+    #
+    # If `.batch` is True and the rule is one of the above, the integrand is not drawn at each
+    # wavelength separately.  Since drawing is linear in the profile, the integral can instead be
+    # drawn as a single weighted sum of the monochromatic profiles.  For FFT drawing, the k-space
+    # values of all the wavelengths are then accumulated on one grid, and there is only a single
+    # inverse FFT rather than one per wavelength.
+    batch = True
 
     def __call__(self, evaluateAtWavelength, bandpass, image, drawImageKwargs):
         """
@@ -96,6 +126,15 @@ class ImageIntegrator(object):
         waves = self.calculateWaves(bandpass)
         self.last_n_eval = len(waves)
         drawImageKwargs.pop('add_to_image', None) # Make sure add_to_image isn't in kwargs
+
+        # Photon shooting is left to draw each wavelength on its own, since n_photons and the
+        # like refer to the individual monochromatic images.
+        weights = _rule_weights(self.rule, waves) if self.batch else None
+        if weights is not None and drawImageKwargs.get('method', 'auto') != 'phot':
+            profs = [ evaluateAtWavelength(w) * (bandpass(w) * wt)
+                      for w, wt in zip(waves, weights) ]
+            return galsim.Add(profs).drawImage(image=image.copy(), **drawImageKwargs)
+
         for w in waves:
             prof = evaluateAtWavelength(w) * bandpass(w)
             images.append(prof.drawImage(image=image.copy(), **drawImageKwargs))
@@ -113,9 +152,13 @@ class SampleIntegrator(ImageIntegrator):
                         brightness samples.  Options include:
                             galsim.integ.midpt  --  Use the midpoint integration rule
                             numpy.trapz         --  Use the trapezoidal integration rule
+    @param batch        Whether to draw the integral as a single weighted sum of the
+                        monochromatic profiles, rather than drawing each one separately.  This
+                        is only possible for the two rules above.  [default: True]
     """
-    def __init__(self, rule):
+    def __init__(self, rule, batch=True):
         self.rule = rule
+        self.batch = batch
     def calculateWaves(self, bandpass):
         if len(bandpass.wave_list) < 0:
             raise AttributeError("Bandpass does not have attribute `wave_list` needed by " +
@@ -144,11 +187,15 @@ class ContinuousIntegrator(ImageIntegrator):
                         generally sampled, (only the midpoint between each integration limit and
                         its nearest interior point is sampled), thus `use_endpoints` should be
                         set to False in this case.  [default: True]
+    @param batch        Whether to draw the integral as a single weighted sum of the
+                        monochromatic profiles, rather than drawing each one separately.  This
+                        is only possible for the two rules above.  [default: True]
     """
-    def __init__(self, rule, N=250, use_endpoints=True):
+    def __init__(self, rule, N=250, use_endpoints=True, batch=True):
         self.N = N
         self.rule = rule
         self.use_endpoints = use_endpoints
+        self.batch = batch
     def calculateWaves(self, bandpass):
         h = (bandpass.red_limit*1.0 - bandpass.blue_limit)/self.N
         if self.use_endpoints:
@@ -336,7 +336,7 @@ class InterpolatedImage(GSObject):
             if noise_pad < 0.:
                 raise ValueError("Noise variance cannot be negative!")
         # There are other options for noise_pad, the validity of which will be checked in
-        # the helper function self.buildNoisePadImage()
+        # the helper function self._getNoise()
 
         # This will be passed to SBInterpolatedImage, so make sure it is the right type.
         pad_factor = float(pad_factor)
@@ -367,33 +367,29 @@ class InterpolatedImage(GSObject):
             elif noise_pad_size < max(self.image.array.shape):
                 noise_pad_size = max(self.image.array.shape)
 
-        # See if we need to pad out the image with either a pad_image or noise_pad
+        # See if we need to pad out the image with either a pad_image or noise_pad.  The noise
+        # padding is done in C++ by SBInterpolatedImage, which draws the noise directly into its
+        # padded array, only around the outside of the (possibly pad_image-padded) image.
         if noise_pad_size:
-            new_pad_image = self.buildNoisePadImage(noise_pad_size, noise_pad, rng)
-
-            if pad_image:
-                # if both noise_pad and pad_image are set, then we need to build up a larger
-                # pad_image and place the given pad_image in the center.
-
-                # We will change the bounds here, so make a new view to avoid modifying the
-                # input pad_image.
-                pad_image = pad_image.view()
-                pad_image.setCenter(0,0)
-                new_pad_image.setCenter(0,0)
-                if new_pad_image.bounds.includes(pad_image.bounds):
-                    new_pad_image[pad_image.bounds] = pad_image
-                else:
-                    new_pad_image = pad_image
-
-            pad_image = new_pad_image
-
-        elif pad_image:
-            # Just make sure pad_image is the right type
+            noise = self._getNoisePad(noise_pad_size, noise_pad, rng)
+            if rng is None:
+                rng = galsim.BaseDeviate()
+
+        if pad_image:
+            # Make a copy, since we will write the image into the center of it.
             pad_image = galsim.Image(pad_image, dtype=image.dtype)
+            pad_image.setCenter(0,0)
+            if noise_pad_size:
+                # If the pad_image does not fit inside the noise padding, then we just use the
+                # pad_image.
+                n1 = -(noise_pad_size//2)
+                n2 = n1 + noise_pad_size - 1
+                noise_bounds = galsim.BoundsI(n1, n2, n1, n2)
+                if not noise_bounds.includes(pad_image.bounds):
+                    noise_pad_size = 0
 
         # Now place the given image in the center of the padding image:
         if pad_image:
-            pad_image.setCenter(0,0)
             self.image.setCenter(0,0)
             if pad_image.bounds.includes(self.image.bounds):
                 pad_image[self.image.bounds] = self.image
@@ -403,6 +399,8 @@ class InterpolatedImage(GSObject):
                 pad_image = self.image
         else:
             pad_image = self.image
+        if noise_pad_size:
+            self.image.setCenter(0,0)
 
         # GalSim cannot automatically know what stepK and maxK are appropriate for the
         # input image.  So it is usually worth it to do a manual calculation (below).
@@ -439,9 +437,19 @@ class InterpolatedImage(GSObject):
         self._gsparams = gsparams
 
         # Make the SBInterpolatedImage out of the image.
-        sbii = galsim._galsim.SBInterpolatedImage(
-                pad_image.image, self.x_interpolant, self.k_interpolant, pad_factor,
-                _force_stepk, _force_maxk, gsparams)
+        if noise_pad_size:
+            sbii = galsim._galsim.SBInterpolatedImage(
+                    pad_image.image, self.x_interpolant, self.k_interpolant, pad_factor,
+                    _force_stepk, _force_maxk, gsparams, noise, noise_pad_size, rng)
+            # Keep the full noise-padded image for pickling.  This is in double precision,
+            # since that is what the C++ layer used.
+            self._pad_image = galsim.ImageD(noise_pad_size, noise_pad_size, wcs=self.image.wcs)
+            self._pad_image.setCenter(0,0)
+            self._pad_image.array[:,:] = sbii.getImage().array
+        else:
+            sbii = galsim._galsim.SBInterpolatedImage(
+                    pad_image.image, self.x_interpolant, self.k_interpolant, pad_factor,
+                    _force_stepk, _force_maxk, gsparams)
 
         # I think the only things that will mess up if getFlux() == 0 are the
         # calculateStepK and calculateMaxK functions, and rescaling the flux to some value.
@@ -508,11 +516,18 @@ class InterpolatedImage(GSObject):
 
     def buildNoisePadImage(self, noise_pad_size, noise_pad, rng):
         """A helper function that builds the `pad_image` from the given `noise_pad` specification.
+
+        This is no longer used by the constructor, which now does the noise padding in C++, but
+        it is kept for anyone who wants an image of the padding noise by itself.
         """
         # Make it with the same dtype as the image
         pad_image = galsim.Image(noise_pad_size, noise_pad_size, dtype=self.image.dtype)
+        pad_image.addNoise(self._getNoise(noise_pad, rng))
+        return pad_image
 
-        # Figure out what kind of noise to apply to the image
+    def _getNoise(self, noise_pad, rng):
+        """Get the noise object to use for the given `noise_pad` specification.
+        """
         if isinstance(noise_pad, float):
             noise = galsim.GaussianNoise(rng, sigma = np.sqrt(noise_pad))
         elif isinstance(noise_pad, galsim.correlatednoise._BaseCorrelatedNoise):
@@ -533,10 +548,51 @@ class InterpolatedImage(GSObject):
             raise ValueError(
                 "Input noise_pad must be a float/int, a CorrelatedNoise, Image, or filename "+
                 "containing an image to use to make a CorrelatedNoise!")
-        # Add the noise
-        pad_image.addNoise(noise)
+        return noise
 
-        return pad_image
+    def _getNoisePad(self, noise_pad_size, noise_pad, rng):
+        """Make the C++ NoisePad object that SBInterpolatedImage uses to pad the image.
+
+        For correlated noise, this needs the square root of the noise power spectrum on the
+        padded grid.  This is kept by the CorrelatedNoise object, so it is only calculated once
+        for each noise model (and size), as long as the same CorrelatedNoise is used each time.
+        When `noise_pad` is a file name, the CorrelatedNoise is cached when `use_cache=True`, so
+        that works too.
+        """
+        if isinstance(noise_pad, float):
+            return galsim._galsim._NoisePad(noise_pad)
+        if isinstance(noise_pad, galsim.correlatednoise._BaseCorrelatedNoise):
+            # Don't make a copy here, since the copy would not have the stored power spectrum.
+            noise = noise_pad
+        else:
+            noise = self._getNoise(noise_pad, rng)
+        # The noise is drawn on a grid with the pixel scale of the noise model, which is what
+        # CorrelatedNoise.applyTo does for an image that doesn't have a wcs.
+        rootps = noise._get_rootps((noise_pad_size, noise_pad_size), noise.wcs)
+        return galsim._galsim._NoisePad(rootps)
+
+    @staticmethod
+    def resize_ktable_cache(max_bytes):
+        """ Resize the cache (default size=256 MB) of padded images and their Fourier transforms,
+        which is shared by all InterpolatedImages.
+
+        InterpolatedImages that are made from the same pixel values with the same `pad_factor`
+        (and the same noise padding, if any) share one copy of the padded image, and the Fourier
+        transform of it is only done once.  This is helpful when the same image is used many
+        times, e.g. a RealGalaxy that is drawn with many different shears or rotations.  When
+        the cache is larger than `max_bytes`, the least recently used images are dropped from
+        it.  Setting `max_bytes=0` turns off the cache.
+
+        @param max_bytes    The new maximum size of the cache in bytes.
+        """
+        galsim._galsim.SetInterpolatedImageCacheSize(int(max_bytes))
+
+    @staticmethod
+    def ktable_cache_bytes():
+        """ Return the number of bytes currently held in the cache of padded images and their
+        Fourier transforms.  See InterpolatedImage.resize_ktable_cache() for details.
+        """
+        return galsim._galsim.GetInterpolatedImageCacheBytes()
 
     def __eq__(self, other):
         return (isinstance(other, galsim.InterpolatedImage) and
@@ -238,6 +238,17 @@ class PowerSpectrum(object):
 
     def __hash__(self): return hash(repr(self))
 
+    def __getstate__(self):
+        # The C++ interpolation tables are not picklable, but they are easy to remake.
+        d = self.__dict__.copy()
+        d.pop('_lensing_grids', None)
+        return d
+
+    def __setstate__(self, d):
+        self.__dict__ = d
+        if hasattr(self, 'im_g1'):
+            self._lensing_grids = {}
+
     def buildGrid(self, grid_spacing=None, ngrid=None, rng=None, interpolant=None,
                   center=galsim.PositionD(0,0), units=galsim.arcsec, get_convergence=False,
                   kmax_factor=1, kmin_factor=1, bandlimit="hard"):
@@ -581,11 +592,12 @@ class PowerSpectrum(object):
             self.grid_kappa = np.array(self.grid_kappa[s,s], copy=True, order='C')
 
         # Set up the images to be interpolated.
-        # Note: We don't make the SBInterpolatedImages yet, since it's not picklable.
+        # Note: We don't make the interpolation tables yet, since they are not picklable.
         #       So we wait to create them when we are actually going to use them.
         self.im_g1 = galsim.ImageD(self.grid_g1)
         self.im_g2 = galsim.ImageD(self.grid_g2)
         self.im_kappa = galsim.ImageD(self.grid_kappa)
+        self._lensing_grids = {}
 
         if get_convergence:
             return self.grid_g1, self.grid_g2, self.grid_kappa
@@ -646,6 +658,7 @@ class PowerSpectrum(object):
         if self.adjust_center:
             self.center += galsim.PositionD(0.5,0.5) * self.grid_spacing * (subsample_fac-1)
         self.grid_spacing *= subsample_fac
+        self._lensing_grids = {}
 
         if get_convergence:
             return self.grid_g1, self.grid_g2, self.grid_kappa
@@ -901,78 +914,57 @@ class PowerSpectrum(object):
             return (np.array(k) < k_max).astype(float)
         else: return (k < k_max).astype(float)
 
-    def _wrap_image(self, im, border=7):
+    def _getGridValues(self, kind, pos_x, pos_y, periodic, interpolant):
+        """Interpolate the gridded lensing quantities to the positions (pos_x, pos_y).
+
+        The quantities that are interpolated together are given by `kind`:
+          - 'reduced': the reduced shears g1, g2 and mu-1, as given by theoryToObserved().
+          - 'shear': the shears gamma1, gamma2.
+          - 'kappa': the convergence.
+        The quantities of each kind are stored in a single C++ table, which is padded (with the
+        values from the other side of the grid if periodic, otherwise with zeros) when it is
+        first needed, and then kept for later calls with the same interpolant.  The positions are
+        interpolated in parallel if GalSim was compiled with OpenMP.
+
+        @returns (vals, outside), where vals is an array of shape (nquantities, npos), and outside
+                 is a boolean array that is True for positions outside the bounds of the grid.
+                 If not periodic, vals is 0 at these positions.
         """
-        Utility function to wrap an input image with some number of border pixels.  By default, the
-        number of border pixels is 7, but this function works as long as it's less than the size of
-        the input image itself.  This function is used for periodic interpolation by the
-        getShear() and other methods, but eventually if we make a 2d LookupTable-type class, this
-        should become a method of that class.
-        """
-        # We should throw an exception if the image is smaller than 'border', since at this point
-        # this process doesn't make sense.
-        if im.bounds.xmax - im.bounds.xmin < border:
-            raise RuntimeError("Periodic wrapping does not work with images this small!")
-        expanded_bounds = im.bounds.withBorder(border)
-        # Make new image with those bounds.
-        im_new = galsim.ImageD(expanded_bounds)
-        # Make the central subarray equal to what we want.
-        im_new[im.bounds] = galsim.Image(im)
-        # Set the empty bits around the center properly.  There are four strips around the edge, and
-        # 4 corner squares that need to be filled in.  Surely there must be a smarter python-y way
-        # of doing this, but I'm not clever enough to figure it out.  This is basically the grossest
-        # code I've ever written, but it works properly.  Anyone who wants is welcome to fix it.
-        #
-        # Mike suggested a way to optimize it slightly, if we find that speed is an issue later on:
-        # We can make just 4 copies, corresponding to
-        # * Strip along left side.
-        # * Upper left and strip along top can be done together.
-        # * Lower left and strip along bottom can be done together.
-        # * Upper right, strip along right, and lower right can be done together.
-        # The code will also be a bit neater this way.
-        #
-        ## Strip along left-hand side
-        b1 = border-1
-        im_new[galsim.BoundsI(expanded_bounds.xmin, im.bounds.xmin-1,
-                              im.bounds.ymin, im.bounds.ymax)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmax-b1,im.bounds.xmax,
-                                                             im.bounds.ymin, im.bounds.ymax)])
-        ## Strip along right-hand side
-        im_new[galsim.BoundsI(im.bounds.xmax+1, expanded_bounds.xmax,
-                              im.bounds.ymin, im.bounds.ymax)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmin, im.bounds.xmin+b1,
-                                                             im.bounds.ymin, im.bounds.ymax)])
-        ## Strip along the bottom
-        im_new[galsim.BoundsI(im.bounds.xmin, im.bounds.xmax,
-                              expanded_bounds.ymin, im.bounds.ymin-1)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmin, im.bounds.xmax,
-                                                             im.bounds.ymax-b1, im.bounds.ymax)])
-        ## Strip along the top
-        im_new[galsim.BoundsI(im.bounds.xmin, im.bounds.xmax,
-                              im.bounds.ymax+1, expanded_bounds.ymax)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmin, im.bounds.xmax,
-                                                             im.bounds.ymin, im.bounds.ymin+b1)])
-        ## Lower-left corner
-        im_new[galsim.BoundsI(expanded_bounds.xmin, im.bounds.xmin-1,
-                              expanded_bounds.ymin, im.bounds.ymin-1)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmax-b1, im.bounds.xmax,
-                                                             im.bounds.ymax-b1, im.bounds.ymax)])
-        ## Upper-right corner
-        im_new[galsim.BoundsI(im.bounds.xmax+1, expanded_bounds.xmax,
-                              im.bounds.ymax+1, expanded_bounds.ymax)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmin, im.bounds.xmin+b1,
-                                                             im.bounds.ymin, im.bounds.ymin+b1)])
-        ## Upper-left corner
-        im_new[galsim.BoundsI(expanded_bounds.xmin, im.bounds.xmin-1,
-                              im.bounds.ymax+1, expanded_bounds.ymax)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmax-b1, im.bounds.xmax,
-                                                             im.bounds.ymin, im.bounds.ymin+b1)])
-        ## Lower-right corner
-        im_new[galsim.BoundsI(im.bounds.xmax+1, expanded_bounds.xmax,
-                              expanded_bounds.ymin, im.bounds.ymin-1)] = \
-                              galsim.Image(im[galsim.BoundsI(im.bounds.xmin, im.bounds.xmin+b1,
-                                                             im.bounds.ymax-b1, im.bounds.ymax)])
-        return im_new
+        if interpolant is not None:
+            xinterp = galsim.utilities.convert_interpolant(interpolant)
+        else:
+            xinterp = galsim.utilities.convert_interpolant(self.interpolant)
+
+        key = (kind, periodic, xinterp)
+        if key not in self._lensing_grids:
+            if kind == 'reduced':
+                g1_r, g2_r, mu = theoryToObserved(self.im_g1.array, self.im_g2.array,
+                                                  self.im_kappa.array)
+                # Interpolate mu-1, so the zero values off the edge are appropriate.
+                fields = [g1_r, g2_r, mu-1]
+            elif kind == 'shear':
+                fields = [self.im_g1.array, self.im_g2.array]
+            else:
+                fields = [self.im_kappa.array]
+            fields = np.ascontiguousarray(fields, dtype=float)
+            # self.center is at the nominal center of the images, which is index n//2 of the
+            # arrays.  (cf. the comment about adjust_center in buildGrid.)
+            n = fields.shape[1]
+            x0 = self.center.x - (n//2) * self.grid_spacing
+            y0 = self.center.y - (n//2) * self.grid_spacing
+            self._lensing_grids[key] = galsim._galsim._LensingGrid(
+                fields, x0, y0, self.grid_spacing, xinterp, periodic)
+        grid = self._lensing_grids[key]
+
+        pos_x = np.ascontiguousarray(pos_x, dtype=float)
+        pos_y = np.ascontiguousarray(pos_y, dtype=float)
+        vals = np.empty((grid.nfield, len(pos_x)))
+        grid.interpolate(pos_x, pos_y, vals)
+        outside = ((pos_x < self.bounds.xmin) | (pos_x > self.bounds.xmax) |
+                   (pos_y < self.bounds.ymin) | (pos_y > self.bounds.ymax))
+        if not periodic:
+            vals[:,outside] = 0.
+        return vals, outside
 
     def getShear(self, pos, units=galsim.arcsec, reduced=True, periodic=False, interpolant=None):
         """
@@ -1065,98 +1057,31 @@ class PowerSpectrum(object):
         # Convert to numpy arrays for internal usage:
         pos_x, pos_y = galsim.utilities._convertPositions(pos, units, 'getShear')
 
-        # Set the interpolant:
-        if interpolant is not None:
-            xinterp = galsim.utilities.convert_interpolant(interpolant)
-        else:
-            xinterp = galsim.utilities.convert_interpolant(self.interpolant)
-        kinterp = galsim.Quintic()
-
         if reduced:
             # get reduced shear (just discard magnification)
-            g1_r, g2_r, _ = galsim.lensing_ps.theoryToObserved(self.im_g1.array, self.im_g2.array,
-                                                               self.im_kappa.array)
-            g1_r = galsim.ImageD(g1_r)
-            g2_r = galsim.ImageD(g2_r)
-            # Make an SBInterpolatedImage, which will do the heavy lifting for the interpolation.
-            # However, if we are doing wrapped interpolation then we will want to manually stick the
-            # wrapped grid bits around the edges, because otherwise the interpolant will treat
-            # everything off the edges as zero.
-            if periodic:
-                # Make an expanded image.  We expand by 7 (default) to be safe, though most
-                # interpolants don't need that much.  Note that we do NOT overwrite the stored data
-                # in the PowerSpectrum instance with anything that is done here, so what's being
-                # done here must be redone in subsequent calls to getShear with periodic
-                # interpolation.
-                g1_r_new = self._wrap_image(g1_r)
-                g2_r_new = self._wrap_image(g2_r)
-
-                # Then make the SBInterpolated image.
-                sbii_g1 = galsim._galsim.SBInterpolatedImage(
-                    g1_r_new.image, xInterp=xinterp, kInterp=kinterp)
-                sbii_g2 = galsim._galsim.SBInterpolatedImage(
-                    g2_r_new.image, xInterp=xinterp, kInterp=kinterp)
-            else:
-                sbii_g1 = galsim._galsim.SBInterpolatedImage(
-                    g1_r.image, xInterp=xinterp, kInterp=kinterp)
-                sbii_g2 = galsim._galsim.SBInterpolatedImage(
-                    g2_r.image, xInterp=xinterp, kInterp=kinterp)
+            vals, outside = self._getGridValues('reduced', pos_x, pos_y, periodic, interpolant)
         else:
-            if periodic:
-                # Need to expand array here, as well.
-                g1_r_new = self._wrap_image(self.im_g1)
-                g2_r_new = self._wrap_image(self.im_g2)
-                sbii_g1 = galsim._galsim.SBInterpolatedImage(
-                    g1_r_new.image, xInterp=xinterp, kInterp=kinterp)
-                sbii_g2 = galsim._galsim.SBInterpolatedImage(
-                    g2_r_new.image, xInterp=xinterp, kInterp=kinterp)
-            else:
-                sbii_g1 = galsim._galsim.SBInterpolatedImage(self.im_g1.image, xInterp=xinterp,
-                                                             kInterp=kinterp)
-                sbii_g2 = galsim._galsim.SBInterpolatedImage(self.im_g2.image, xInterp=xinterp,
-                                                             kInterp=kinterp)
-
-        # Calculate some numbers that are useful to calculate before the loop over positions, but
-        # only if we are doing a periodic treatment of the box.
-        if periodic:
-            dx = self.bounds.xmax-self.bounds.xmin
-            dy = self.bounds.ymax-self.bounds.ymin
-
-        # interpolate if necessary
-        g1,g2 = [], []
-        for iter_pos in [ galsim.PositionD(pos_x[i],pos_y[i]) for i in range(len(pos_x)) ]:
-            # Check that the position is in the bounds of the interpolated image
-            if not self.bounds.includes(iter_pos):
-                if not periodic:
-                    # We're not treating this as a periodic box, so issue a warning and set the
-                    # shear to zero for positions that are outside the original grid.
-                    import warnings
-                    warnings.warn(
-                        "Warning: position (%f,%f) not within the bounds "%(iter_pos.x,iter_pos.y) +
-                        "of the gridded shear values: " + str(self.bounds) +
-                        ".  Returning a shear of (0,0) for this point.")
-                    g1.append(0.)
-                    g2.append(0.)
-                else:
-                    # Treat this as a periodic box.
-                    wrap_pos = galsim.PositionD(
-                        (iter_pos.x-self.bounds.xmin) % dx + self.bounds.xmin,
-                        (iter_pos.y-self.bounds.ymin) % dy + self.bounds.ymin
-                        )
-                    g1.append(sbii_g1.xValue((wrap_pos-self.center)/self.grid_spacing))
-                    g2.append(sbii_g2.xValue((wrap_pos-self.center)/self.grid_spacing))
-            else:
-                g1.append(sbii_g1.xValue((iter_pos-self.center)/self.grid_spacing))
-                g2.append(sbii_g2.xValue((iter_pos-self.center)/self.grid_spacing))
+            vals, outside = self._getGridValues('shear', pos_x, pos_y, periodic, interpolant)
+        g1, g2 = vals[0], vals[1]
+
+        if not periodic:
+            # We're not treating this as a periodic box, so issue a warning for positions that
+            # are outside the original grid.  The shear is zero for these.
+            import warnings
+            for i in np.nonzero(outside)[0]:
+                warnings.warn(
+                    "Warning: position (%f,%f) not within the bounds "%(pos_x[i],pos_y[i]) +
+                    "of the gridded shear values: " + str(self.bounds) +
+                    ".  Returning a shear of (0,0) for this point.")
 
         if isinstance(pos, galsim.PositionD):
-            return g1[0], g2[0]
+            return float(g1[0]), float(g2[0])
         elif isinstance(pos[0], np.ndarray):
-            return np.array(g1), np.array(g2)
+            return g1, g2
         elif len(pos_x) == 1 and not isinstance(pos[0],list):
-            return g1[0], g2[0]
+            return float(g1[0]), float(g2[0])
         else:
-            return g1, g2
+            return g1.tolist(), g2.tolist()
 
     def getConvergence(self, pos, units=galsim.arcsec, periodic=False, interpolant=None):
         """
@@ -1210,65 +1135,25 @@ class PowerSpectrum(object):
         # Convert to numpy arrays for internal usage:
         pos_x, pos_y = galsim.utilities._convertPositions(pos, units, 'getConvergence')
 
-        # Set the interpolant:
-        if interpolant is not None:
-            xinterp = galsim.utilities.convert_interpolant(interpolant)
-        else:
-            xinterp = galsim.utilities.convert_interpolant(self.interpolant)
-        kinterp = galsim.Quintic()
-
-        # Make an SBInterpolatedImage, which will do the heavy lifting for the interpolation.
-        # However, if we are doing wrapped interpolation then we will want to manually stick the
-        # wrapped grid bits around the edges, because otherwise the interpolant will treat
-        # everything off the edges as zero.
-        if periodic:
-            # Make an expanded bounds.  We expand by 7 (default) to be safe, though most
-            # interpolants don't need that much.
-            kappa_new = self._wrap_image(self.im_kappa)
-
-            # Then make the SBInterpolated image.
-            sbii_kappa = galsim._galsim.SBInterpolatedImage(
-                kappa_new.image, xInterp=xinterp, kInterp=kinterp)
-        else:
-            sbii_kappa = galsim._galsim.SBInterpolatedImage(
-                self.im_kappa.image, xInterp=xinterp, kInterp=kinterp)
-
-        # Calculate some numbers that are useful to calculate before the loop over positions, but
-        # only if we are doing a periodic treatment of the box.
-        if periodic:
-            dx = self.bounds.xmax-self.bounds.xmin
-            dy = self.bounds.ymax-self.bounds.ymin
-
-        # interpolate if necessary
-        kappa = []
-        for iter_pos in [ galsim.PositionD(pos_x[i],pos_y[i]) for i in range(len(pos_x)) ]:
-            # Check that the position is in the bounds of the interpolated image
-            if not self.bounds.includes(iter_pos):
-                if not periodic:
-                    import warnings
-                    warnings.warn(
-                        "Warning: position (%f,%f) not within the bounds "%(iter_pos.x,iter_pos.y) +
-                        "of the gridded convergence values: " + str(self.bounds) +
-                        ".  Returning a convergence of 0 for this point.")
-                    kappa.append(0.)
-                else:
-                    # Treat this as a periodic box.
-                    wrap_pos = galsim.PositionD(
-                        (iter_pos.x-self.bounds.xmin) % dx + self.bounds.xmin,
-                        (iter_pos.y-self.bounds.ymin) % dy + self.bounds.ymin
-                        )
-                    kappa.append(sbii_kappa.xValue((wrap_pos-self.center)/self.grid_spacing))
-            else:
-                kappa.append(sbii_kappa.xValue((iter_pos-self.center)/self.grid_spacing))
+        vals, outside = self._getGridValues('kappa', pos_x, pos_y, periodic, interpolant)
+        kappa = vals[0]
+
+        if not periodic:
+            import warnings
+            for i in np.nonzero(outside)[0]:
+                warnings.warn(
+                    "Warning: position (%f,%f) not within the bounds "%(pos_x[i],pos_y[i]) +
+                    "of the gridded convergence values: " + str(self.bounds) +
+                    ".  Returning a convergence of 0 for this point.")
 
         if isinstance(pos, galsim.PositionD):
-            return kappa[0]
+            return float(kappa[0])
         elif isinstance(pos[0], np.ndarray):
-            return np.array(kappa)
+            return kappa
         elif len(pos_x) == 1 and not isinstance(pos[0],list):
-            return kappa[0]
+            return float(kappa[0])
         else:
-            return kappa
+            return kappa.tolist()
 
     def getMagnification(self, pos, units=galsim.arcsec, periodic=False, interpolant=None):
         """
@@ -1323,72 +1208,26 @@ class PowerSpectrum(object):
         # Convert to numpy arrays for internal usage:
         pos_x, pos_y = galsim.utilities._convertPositions(pos, units, 'getMagnification')
 
-        # Set the interpolant:
-        if interpolant is not None:
-            xinterp = galsim.utilities.convert_interpolant(interpolant)
-        else:
-            xinterp = galsim.utilities.convert_interpolant(self.interpolant)
-        kinterp = galsim.Quintic()
-
-        # Calculate the magnification based on the convergence and shear
-        _, _, mu = galsim.lensing_ps.theoryToObserved(self.im_g1.array, self.im_g2.array,
-                                                      self.im_kappa.array)
-        # Interpolate mu-1, so the zero values off the edge are appropriate.
-        im_mu = galsim.ImageD(mu-1)
-
-        # Make an SBInterpolatedImage, which will do the heavy lifting for the interpolation.
-        # However, if we are doing wrapped interpolation then we will want to manually stick the
-        # wrapped grid bits around the edges, because otherwise the interpolant will treat
-        # everything off the edges as zero.
-        if periodic:
-            # Make an expanded bounds.  We expand by 7 (default) to be safe, though most
-            # interpolants don't need that much.
-            im_mu_new = self._wrap_image(im_mu)
-
-            # Then make the SBInterpolated image.
-            sbii_mu = galsim._galsim.SBInterpolatedImage(im_mu_new.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-        else:
-            sbii_mu = galsim._galsim.SBInterpolatedImage(im_mu.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-
-        # Calculate some numbers that are useful to calculate before the loop over positions, but
-        # only if we are doing a periodic treatment of the box.
-        if periodic:
-            dx = self.bounds.xmax-self.bounds.xmin
-            dy = self.bounds.ymax-self.bounds.ymin
-
-        # interpolate if necessary
-        mu = []
-        for iter_pos in [ galsim.PositionD(pos_x[i],pos_y[i]) for i in range(len(pos_x)) ]:
-            # Check that the position is in the bounds of the interpolated image
-            if not self.bounds.includes(iter_pos):
-                if not periodic:
-                    import warnings
-                    warnings.warn(
-                        "Warning: position (%f,%f) not within the bounds "%(iter_pos.x,iter_pos.y) +
-                        "of the gridded convergence values: " + str(self.bounds) +
-                        ".  Returning a magnification of 1 for this point.")
-                    mu.append(1.)
-                else:
-                    # Treat this as a periodic box.
-                    wrap_pos = galsim.PositionD(
-                        (iter_pos.x-self.bounds.xmin) % dx + self.bounds.xmin,
-                        (iter_pos.y-self.bounds.ymin) % dy + self.bounds.ymin
-                        )
-                    mu.append(sbii_mu.xValue((wrap_pos-self.center)/self.grid_spacing)+1.)
+        # This uses the same table as getLensing, which also has the reduced shears.
+        vals, outside = self._getGridValues('reduced', pos_x, pos_y, periodic, interpolant)
+        mu = vals[2] + 1.
 
-            else:
-                mu.append(sbii_mu.xValue((iter_pos-self.center)/self.grid_spacing)+1.)
+        if not periodic:
+            import warnings
+            for i in np.nonzero(outside)[0]:
+                warnings.warn(
+                    "Warning: position (%f,%f) not within the bounds "%(pos_x[i],pos_y[i]) +
+                    "of the gridded convergence values: " + str(self.bounds) +
+                    ".  Returning a magnification of 1 for this point.")
 
         if isinstance(pos, galsim.PositionD):
-            return mu[0]
+            return float(mu[0])
         elif isinstance(pos[0], np.ndarray):
-            return np.array(mu)
+            return mu
         elif len(pos_x) == 1 and not isinstance(pos[0],list):
-            return mu[0]
+            return float(mu[0])
         else:
-            return mu
+            return mu.tolist()
 
     def getLensing(self, pos, units=galsim.arcsec, periodic=False, interpolant=None):
         """
@@ -1445,89 +1284,25 @@ class PowerSpectrum(object):
         # Convert to numpy arrays for internal usage:
         pos_x, pos_y = galsim.utilities._convertPositions(pos, units, 'getLensing')
 
-        # Set the interpolant:
-        if interpolant is not None:
-            xinterp = galsim.utilities.convert_interpolant(interpolant)
-        else:
-            xinterp = galsim.utilities.convert_interpolant(self.interpolant)
-        kinterp = galsim.Quintic()
-
-        # Calculate the magnification based on the convergence and shear
-        g1_r, g2_r, mu = galsim.lensing_ps.theoryToObserved(self.im_g1.array, self.im_g2.array,
-                                                            self.im_kappa.array)
-        im_g1_r = galsim.ImageD(g1_r)
-        im_g2_r = galsim.ImageD(g2_r)
-        im_mu = galsim.ImageD(mu-1)
-
-        # Make an SBInterpolatedImage, which will do the heavy lifting for the interpolation.
-        # However, if we are doing wrapped interpolation then we will want to manually stick the
-        # wrapped grid bits around the edges, because otherwise the interpolant will treat
-        # everything off the edges as zero.
-        if periodic:
-            # Make an expanded bounds.  We expand by 7 (default) to be safe, though most
-            # interpolants don't need that much.
-            im_mu_new = self._wrap_image(im_mu)
-            im_g1_new = self._wrap_image(im_g1_r)
-            im_g2_new = self._wrap_image(im_g2_r)
-
-            # Then make the SBInterpolated image.
-            sbii_g1 = galsim._galsim.SBInterpolatedImage(im_g1_new.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-            sbii_g2 = galsim._galsim.SBInterpolatedImage(im_g2_new.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-            sbii_mu = galsim._galsim.SBInterpolatedImage(im_mu_new.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-        else:
-            sbii_g1 = galsim._galsim.SBInterpolatedImage(im_g1_r.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-            sbii_g2 = galsim._galsim.SBInterpolatedImage(im_g2_r.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-            sbii_mu = galsim._galsim.SBInterpolatedImage(im_mu.image, xInterp=xinterp,
-                                                         kInterp=kinterp)
-
-        # Calculate some numbers that are useful to calculate before the loop over positions, but
-        # only if we are doing a periodic treatment of the box.
-        if periodic:
-            dx = self.bounds.xmax-self.bounds.xmin
-            dy = self.bounds.ymax-self.bounds.ymin
-
-        # interpolate if necessary
-        g1, g2, mu = [], [], []
-        for iter_pos in [ galsim.PositionD(pos_x[i],pos_y[i]) for i in range(len(pos_x)) ]:
-            # Check that the position is in the bounds of the interpolated image
-            if not self.bounds.includes(iter_pos):
-                if not periodic:
-                    import warnings
-                    warnings.warn(
-                        "Warning: position (%f,%f) not within the bounds "%(iter_pos.x,iter_pos.y) +
-                        "of the gridded values: " + str(self.bounds) +
-                        ".  Returning 0 for lensing observables at this point.")
-                    g1.append(0.)
-                    g2.append(0.)
-                    mu.append(1.)
-                else:
-                    # Treat this as a periodic box.
-                    wrap_pos = galsim.PositionD(
-                        (iter_pos.x-self.bounds.xmin) % dx + self.bounds.xmin,
-                        (iter_pos.y-self.bounds.ymin) % dy + self.bounds.ymin
-                        )
-                    g1.append(sbii_g1.xValue((wrap_pos-self.center)/self.grid_spacing))
-                    g2.append(sbii_g2.xValue((wrap_pos-self.center)/self.grid_spacing))
-                    mu.append(sbii_mu.xValue((wrap_pos-self.center)/self.grid_spacing)+1.)
+        vals, outside = self._getGridValues('reduced', pos_x, pos_y, periodic, interpolant)
+        g1, g2, mu = vals[0], vals[1], vals[2] + 1.
 
-            else:
-                g1.append(sbii_g1.xValue((iter_pos-self.center)/self.grid_spacing))
-                g2.append(sbii_g2.xValue((iter_pos-self.center)/self.grid_spacing))
-                mu.append(sbii_mu.xValue((iter_pos-self.center)/self.grid_spacing)+1.)
+        if not periodic:
+            import warnings
+            for i in np.nonzero(outside)[0]:
+                warnings.warn(
+                    "Warning: position (%f,%f) not within the bounds "%(pos_x[i],pos_y[i]) +
+                    "of the gridded values: " + str(self.bounds) +
+                    ".  Returning 0 for lensing observables at this point.")
 
         if isinstance(pos, galsim.PositionD):
-            return g1[0], g2[0], mu[0]
+            return float(g1[0]), float(g2[0]), float(mu[0])
         elif isinstance(pos[0], np.ndarray):
-            return np.array(g1), np.array(g2), np.array(mu)
+            return g1, g2, mu
         elif len(pos_x) == 1 and not isinstance(pos[0],list):
-            return g1[0], g2[0], mu[0]
+            return float(g1[0]), float(g2[0]), float(mu[0])
         else:
-            return g1, g2, mu
+            return g1.tolist(), g2.tolist(), mu.tolist()
 
 class PowerSpectrumRealizer(object):
     """Class for generating realizations of power spectra with any area and pixel size.
@@ -1606,6 +1381,27 @@ class PowerSpectrumRealizer(object):
 
         @return a tuple of NumPy arrays (g1,g2,kappa) for the shear and convergence.
         """
+        if not isinstance(gd, galsim.GaussianDeviate):
+            raise TypeError(
+                "The gd provided to the PowerSpectrumRealizer is not a GaussianDeviate!")
+
+        # The C++ code draws a random complex realization for the E-mode and B-mode (if there
+        # are any) in the same way as _generate_realization below, so a given gd produces the
+        # same fields.  It then calculates the shear as exp(2i psi) kappa_k, where kappa_k is
+        # E_k + i B_k, and transforms back to real space.  The difference is that it does
+        # everything with real FFTs on the kx >= 0 half plane.
+        g1 = np.empty((self.ny,self.nx))
+        g2 = np.empty((self.ny,self.nx))
+        k = np.empty((self.ny,self.nx))
+        galsim._galsim._RealizePowerSpectrum(self.amplitude_E, self.amplitude_B, gd, g1, g2, k)
+        return g1, g2, k
+
+    def _generate_realization(self, gd):
+        """Generate a realization of the current power spectrum using numpy FFTs.
+
+        This is the python version of what __call__ does in C++.  It is slower and uses more
+        memory, but it is useful as a reference for testing.
+        """
         ISQRT2 = np.sqrt(1.0/2.0)
 
         if not isinstance(gd, galsim.GaussianDeviate):
@@ -1758,7 +1554,6 @@ def kappaKaiserSquires(g1, g2):
     prior to input.
     """
     # Checks on inputs
-    import galsim.utilities
     if isinstance(g1, galsim.Image) and isinstance(g2, galsim.Image):
         g1 = g1.array
         g2 = g2.array
@@ -1771,37 +1566,20 @@ def kappaKaiserSquires(g1, g2):
     if g1.shape[0] != g1.shape[1]:
         raise NotImplementedError("Non-square input shear grids not supported.")
 
-    # Then setup the kx, ky grids
-    kx, ky = galsim.utilities.kxky(g1.shape)
-    kz = kx + ky*1j
-
-    # exp(2i psi) = kz^2 / |kz|^2
-    ksq = kz*np.conj(kz)
-    # Need to adjust denominator for kz=0 to avoid division by 0.
-    ksq[0,0] = 1.
-    exp2ipsi = kz*kz/ksq
-
-    # Build complex g = g1 + i g2
-    gz = g1 + g2*1j
-
-    # Go to fourier space
-    gz_k = np.fft.fft2(gz)
-
-    # Equation 2.1.12 of Kaiser & Squires (1993) is equivalent to:
-    #   kz_k = -np.conj(exp2ipsi)*gz_k
-    # However, this equation has a sign error.  There should not be a minus in front.
-    # If you follow their subsequent deviation, you will see that they drop the minus sign
-    # when they get to 2.1.15 (another - appears from the derivative).  2.1.15 is correct.
-    # e.g. it correctly produces a positive point mass for tangential shear ~ 1/r^2.
-    # So this implies that the minus sign in 2.1.12 should not be there.
-    kz_k = np.conj(exp2ipsi)*gz_k
-
-    # Come back to real space
-    kz = np.fft.ifft2(kz_k)
-
-    # kz = kappa_E + i kappa_B
-    kappaE = np.real(kz)
-    kappaB = np.imag(kz)
+    # The C++ code does the following with real FFTs:
+    #   - Build complex g = g1 + i g2, and go to fourier space.
+    #   - Calculate kz_k = conj(exp(2i psi)) g_k, where psi is the polar angle of k.
+    #     (Equation 2.1.12 of Kaiser & Squires (1993) has a minus sign in front of this.
+    #     However, this equation has a sign error.  If you follow their subsequent deviation,
+    #     you will see that they drop the minus sign when they get to 2.1.15 (another - appears
+    #     from the derivative).  2.1.15 is correct.  e.g. it correctly produces a positive point
+    #     mass for tangential shear ~ 1/r^2.)
+    #   - Come back to real space, where kz = kappa_E + i kappa_B
+    g1 = np.ascontiguousarray(g1, dtype=float)
+    g2 = np.ascontiguousarray(g2, dtype=float)
+    kappaE = np.empty_like(g1)
+    kappaB = np.empty_like(g1)
+    galsim._galsim._KaiserSquires(g1, g2, kappaE, kappaB)
     return kappaE, kappaB
 
 class xip_integrand:
@@ -538,10 +538,27 @@ class Aperture(object):
         # Let unpickled object reconstruct cached values on-the-fly instead of including them in the
         # pickle.
         d = self.__dict__
-        for k in ['_rho', '_u', '_v', '_rsqr']:
+        for k in ['_rho', '_u', '_v', '_rsqr', '_pupil_fft']:
             d.pop(k, None)
         return d
 
+    def _get_pupil_fft(self):
+        """Return the C++ object that computes PSFs from wavefronts over this aperture.
+
+        This is made once and cached, so that the indices of the illuminated pixels and the FFTW
+        plan are shared by all the PSFs drawn through this aperture.
+        """
+        if not hasattr(self, '_pupil_fft'):
+            shape = self.illuminated.shape
+            npix = shape[0]*shape[1]
+            # Find where each pixel goes when the pupil plane is fftshifted, so that the center of
+            # the pupil is at the origin of the FFT.
+            shifted = np.empty(npix, dtype=np.int32)
+            shifted[np.fft.fftshift(np.arange(npix).reshape(shape)).ravel()] = np.arange(npix)
+            index = np.ascontiguousarray(shifted[np.flatnonzero(self.illuminated)])
+            self._pupil_fft = galsim._galsim._PupilFFT(shape[0], shape[1], index)
+        return self._pupil_fft
+
     # Some quick notes for Josh:
     # - Relation between real-space grid with size theta and pitch dtheta (dimensions of angle)
     #   and corresponding (fast) Fourier grid with size 2*maxK and pitch stepK (dimensions of
@@ -779,7 +796,36 @@ class PhaseScreenList(object):
                         [default: True]
         @returns        Wavefront lag or lead in nanometers over aperture.
         """
-        return np.sum([layer.wavefront(aper, theta, compact) for layer in self],axis=0)
+        return self._wavefronts(aper, [theta], compact)[0]
+
+    def _wavefronts(self, aper, thetas, compact=True):
+        """Compute the cumulative wavefront at each of a list of field angles.
+
+        The AtmosphericScreens are all evaluated in a single call to C++, which is parallelized
+        over field angles and pupil positions.  Other kinds of screens are added afterwards.
+
+        @returns  Array of wavefronts, whose first index corresponds to the field angle, and whose
+                  remaining indices are as for wavefront().
+        """
+        if compact:
+            u, v = aper.u[aper.illuminated], aper.v[aper.illuminated]
+        else:
+            u, v = aper.u, aper.v
+        shape = u.shape
+        u = np.ascontiguousarray(u.ravel(), dtype=float)
+        v = np.ascontiguousarray(v.ravel(), dtype=float)
+        wf = np.zeros((len(thetas), len(u)), dtype=float)
+
+        atm = [layer for layer in self if isinstance(layer, galsim.AtmosphericScreen)]
+        other = [layer for layer in self if not isinstance(layer, galsim.AtmosphericScreen)]
+        if len(atm) > 0:
+            offsets = np.array([[layer._offset(th) for layer in atm] for th in thetas],
+                               dtype=float)
+            galsim._galsim._SumWavefronts([layer._screen_obj for layer in atm], u, v, offsets, wf)
+        for layer in other:
+            for k, th in enumerate(thetas):
+                wf[k] += layer.wavefront(aper, th, compact).ravel()
+        return wf.reshape((len(thetas),) + shape)
 
     def makePSF(self, lam, **kwargs):
         """Compute one PSF or multiple PSFs from the current PhaseScreenList, depending on the type
@@ -878,10 +924,26 @@ class PhaseScreenList(object):
 
             flux = kwargs.get('flux', 1.0)
             _nstep = PSFs[0]._nstep
+            # If the PSFs share an aperture, which is normal, then get the wavefronts for all the
+            # field angles at each time step at once.
+            # The pupil FFTs for the different field angles are then done in parallel.
+            aper = PSFs[0].aper
+            batch = all(PSF.aper is aper or PSF.aper == aper for PSF in PSFs[1:])
+            if batch:
+                thetas = [PSF.theta for PSF in PSFs]
+                pupil_fft = aper._get_pupil_fft()
+                imgs = np.zeros((len(PSFs),) + aper.illuminated.shape, dtype=np.float64)
             for i in range(_nstep):
-                for PSF in PSFs:
-                    PSF._step()
+                if batch:
+                    wfs = self._wavefronts(aper, thetas)
+                    pupil_fft.accumulate(wfs, PSFs[0].lam, imgs)
+                else:
+                    for PSF in PSFs:
+                        PSF._step()
                 self.advance()
+            if batch:
+                for PSF, img in zip(PSFs, imgs):
+                    PSF.img += img
 
             suppress_warning = kwargs.pop('suppress_warning', False)
             for PSF in PSFs:
@@ -1077,14 +1139,18 @@ class PhaseScreenPSF(GSObject):
     def __hash__(self):
         return hash(("galsim.PhaseScreenPSF", self.ii))
 
-    def _step(self):
-        """Compute the current instantaneous PSF and add it to the developing integrated PSF."""
-        wf = self.screen_list.wavefront(self.aper, self.theta)
-        expwf = np.exp(2j * np.pi * wf / self.lam)
-        expwf_grid = np.zeros_like(self.aper.illuminated).astype(np.complex128)
-        expwf_grid[self.aper.illuminated] = expwf
-        ftexpwf = np.fft.fft2(np.fft.fftshift(expwf_grid))
-        self.img += np.abs(ftexpwf)**2
+    def _step(self, wf=None):
+        """Compute the current instantaneous PSF and add it to the developing integrated PSF.
+
+        @param wf   The current wavefront over the illuminated pixels, if it has already been
+                    computed.  [default: None]
+        """
+        if wf is None:
+            wf = self.screen_list.wavefront(self.aper, self.theta)
+        # This adds |FFT(exp(2 pi i wf / lam))|^2 of the fftshifted pupil plane to self.img.
+        self.aper._get_pupil_fft().accumulate(
+            np.ascontiguousarray(wf, dtype=float).reshape(1,-1), self.lam,
+            self.img.reshape((1,) + self.img.shape))
 
     def _finalize(self, flux, suppress_warning):
         """Take accumulated integrated PSF image and turn it into a proper GSObject."""
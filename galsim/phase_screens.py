@@ -97,7 +97,8 @@ class AtmosphericScreen(object):
         if _orig_rng is not None:
             self.orig_rng = _orig_rng
             self.rng = rng
-            self.tab2d = _tab2d
+            self._set_screen(_tab2d.f[:-1,:-1])
+            self._tab2d = _tab2d
             # Last two might get quickly deleted if alpha==1, but that's okay.
             self.psi = _psi
             self.screen = _screen
@@ -149,6 +150,53 @@ class AtmosphericScreen(object):
 
     def __ne__(self, other): return not self == other
 
+    def __getstate__(self):
+        # The C++ screen isn't picklable, so store its values instead.
+        d = self.__dict__.copy()
+        screen = np.empty((self.npix, self.npix), dtype=float)
+        self._screen_obj.getScreen(screen)
+        d['_screen_obj'] = screen
+        return d
+
+    def __setstate__(self, d):
+        screen = d.pop('_screen_obj')
+        tab2d = d.pop('_tab2d')
+        self.__dict__ = d
+        self._set_screen(screen)
+        self._tab2d = tab2d
+
+    def _set_screen(self, screen):
+        """Set the values of the C++ screen object, which is used to compute wavefronts.  This
+        updates the existing screen in place if there is one.
+        """
+        screen = np.ascontiguousarray(screen, dtype=float)
+        if getattr(self, '_screen_obj', None) is None:
+            self._screen_obj = galsim._galsim._PhaseScreen(screen, self.screen_scale,
+                                                           -0.5*self.screen_size)
+        else:
+            self._screen_obj.setScreen(screen)
+        self._tab2d = None
+
+    @property
+    def tab2d(self):
+        """A LookupTable2D holding the current screen values.
+        """
+        # This is only made when requested.  Updating it along with the C++ screen at every time
+        # step would be expensive for screens that are not frozen.
+        if self._tab2d is None:
+            screen = np.empty((self.npix, self.npix), dtype=float)
+            self._screen_obj.getScreen(screen)
+            xs = np.linspace(-0.5*self.screen_size, 0.5*self.screen_size, self.npix,
+                             endpoint=False)
+            self._tab2d = galsim.LookupTable2D(xs, xs, screen, edge_mode='wrap')
+        return self._tab2d
+
+    def _offset(self, theta):
+        """The position of the center of the pupil on the screen for a given field angle.
+        """
+        return (self.origin[0] + 1000*self.altitude*theta[0].tan(),
+                self.origin[1] + 1000*self.altitude*theta[1].tan())
+
     # Note the magic number 0.00058 is actually ... wait for it ...
     # (5 * (24/5 * gamma(6/5))**(5/6) * gamma(11/6)) / (6 * pi**(8/3) * gamma(1/6)) / (2 pi)**2
     # It nearly impossible to figure this out from a single source, but it can be derived from a
@@ -185,7 +233,7 @@ class AtmosphericScreen(object):
         # "Boil" the atmsopheric screen if alpha not 1.
         if self.alpha != 1.0:
             self.screen = self.alpha*self.screen + np.sqrt(1.-self.alpha**2)*self._random_screen()
-            self.tab2d = galsim.LookupTable2D(self._xs, self._ys, self.screen, edge_mode='wrap')
+            self._set_screen(self.screen)
 
     def advance_by(self, dt):
         """Advance phase screen by specified amount of time.
@@ -238,21 +286,23 @@ class AtmosphericScreen(object):
             u, v = aper.u[aper.illuminated], aper.v[aper.illuminated]
         else:
             u, v = aper.u, aper.v
-        return self.tab2d(u + self.origin[0] + 1000*self.altitude*theta[0].tan(),
-                          v + self.origin[1] + 1000*self.altitude*theta[1].tan())
+        shape = u.shape
+        u = np.ascontiguousarray(u.ravel(), dtype=float)
+        v = np.ascontiguousarray(v.ravel(), dtype=float)
+        wf = np.empty_like(u)
+        dx, dy = self._offset(theta)
+        self._screen_obj.wavefront(u, v, wf, dx, dy)
+        return wf.reshape(shape)
 
     def reset(self):
         """Reset phase screen back to time=0."""
         self.rng = self.orig_rng.duplicate()
         self.origin = np.array([0.0, 0.0])
 
-        # Only need to reset/create tab2d if not frozen or doesn't already exist
-        if self.alpha != 1.0 or not hasattr(self, 'tab2d'):
+        # Only need to reset/create the screen if not frozen or doesn't already exist
+        if self.alpha != 1.0 or getattr(self, '_screen_obj', None) is None:
             self.screen = self._random_screen()
-            self._xs = np.linspace(-0.5*self.screen_size, 0.5*self.screen_size, self.npix,
-                                   endpoint=False)
-            self._ys = self._xs
-            self.tab2d = galsim.LookupTable2D(self._xs, self._ys, self.screen, edge_mode='wrap')
+            self._set_screen(self.screen)
 
 
 def Atmosphere(screen_size, rng=None, **kwargs):
@@ -164,6 +164,7 @@ class RealGalaxy(GSObject):
             # Special (undocumented) way to build a RealGalaxy without needing the rgc directly
             # by providing the things we need from it.  Used by COSMOSGalaxy.
             self.gal_image, self.psf_image, noise_image, pixel_scale, var = real_galaxy_catalog
+            original_gal = original_psf = None
             use_index = 0  # For the logger statements below.
             if logger:
                 logger.debug('RealGalaxy %d: Start RealGalaxy constructor.',use_index)
@@ -185,15 +186,26 @@ class RealGalaxy(GSObject):
                 raise AttributeError('No method specified for selecting a galaxy!')
             if logger:
                 logger.debug('RealGalaxy %d: Start RealGalaxy constructor.',use_index)
+            original_gal = original_psf = None
+
+            if noise_pad_size == 0 and isinstance(real_galaxy_catalog, RealGalaxyCatalog):
+                # Without noise padding, the InterpolatedImages only depend on these parameters,
+                # so the catalog can keep recently used ones to be shared among RealGalaxy
+                # objects.  (But not if the catalog is a proxy for one in another process.)
+                self.gal_image, self.psf_image, original_gal, original_psf = \
+                    real_galaxy_catalog._getInterpolatedImages(
+                        use_index, x_interpolant, k_interpolant, pad_factor, gsparams)
+                if logger:
+                    logger.debug('RealGalaxy %d: Got interpolated images',use_index)
+            else:
+                # Read in the galaxy, PSF images; for now, rely on pyfits to make I/O errors.
+                self.gal_image = real_galaxy_catalog.getGal(use_index)
+                if logger:
+                    logger.debug('RealGalaxy %d: Got gal_image',use_index)
 
-            # Read in the galaxy, PSF images; for now, rely on pyfits to make I/O errors.
-            self.gal_image = real_galaxy_catalog.getGal(use_index)
-            if logger:
-                logger.debug('RealGalaxy %d: Got gal_image',use_index)
-
-            self.psf_image = real_galaxy_catalog.getPSF(use_index)
-            if logger:
-                logger.debug('RealGalaxy %d: Got psf_image',use_index)
+                self.psf_image = real_galaxy_catalog.getPSF(use_index)
+                if logger:
+                    logger.debug('RealGalaxy %d: Got psf_image',use_index)
 
             #self.noise = real_galaxy_catalog.getNoise(use_index, self.rng, gsparams)
             # We need to duplication some of the RealGalaxyCatalog.getNoise() function, since we
@@ -233,25 +245,20 @@ class RealGalaxy(GSObject):
         else:
             noise_pad = 0.
 
-        # Build the InterpolatedImage of the PSF.
-        self.original_psf = galsim.InterpolatedImage(
-            self.psf_image, x_interpolant=x_interpolant, k_interpolant=k_interpolant,
-            flux=1.0, gsparams=gsparams)
-        if logger:
-            logger.debug('RealGalaxy %d: Made original_psf',use_index)
-
-        # Build the InterpolatedImage of the galaxy.
-        # Use the stepK() value of the PSF as a maximum value for stepK of the galaxy.
-        # (Otherwise, low surface brightness galaxies can get a spuriously high stepk, which
-        # leads to problems.)
-        self.original_gal = galsim.InterpolatedImage(
-                self.gal_image, x_interpolant=x_interpolant, k_interpolant=k_interpolant,
-                pad_factor=pad_factor, noise_pad_size=noise_pad_size,
-                calculate_stepk=self.original_psf.stepK(),
-                calculate_maxk=self.original_psf.maxK(),
-                noise_pad=noise_pad, rng=self.rng, gsparams=gsparams)
-        if logger:
-            logger.debug('RealGalaxy %d: Made original_gal',use_index)
+        if original_psf is None:
+            original_psf = _makeRealGalaxyPSF(self.psf_image, x_interpolant, k_interpolant,
+                                              gsparams)
+            if logger:
+                logger.debug('RealGalaxy %d: Made original_psf',use_index)
+        self.original_psf = original_psf
+
+        if original_gal is None:
+            original_gal = _makeRealGalaxyGal(self.gal_image, original_psf, x_interpolant,
+                                              k_interpolant, pad_factor, noise_pad_size,
+                                              noise_pad, self.rng, gsparams)
+            if logger:
+                logger.debug('RealGalaxy %d: Made original_gal',use_index)
+        self.original_gal = original_gal
 
         # If flux is None, leave flux as given by original image
         if flux is not None:
@@ -330,6 +337,25 @@ class RealGalaxy(GSObject):
 
 
 
+def _makeRealGalaxyPSF(psf_image, x_interpolant, k_interpolant, gsparams):
+    # Build the InterpolatedImage of the PSF.
+    return galsim.InterpolatedImage(
+        psf_image, x_interpolant=x_interpolant, k_interpolant=k_interpolant,
+        flux=1.0, gsparams=gsparams)
+
+def _makeRealGalaxyGal(gal_image, original_psf, x_interpolant, k_interpolant, pad_factor,
+                       noise_pad_size, noise_pad, rng, gsparams):
+    # Build the InterpolatedImage of the galaxy.
+    # Use the stepK() value of the PSF as a maximum value for stepK of the galaxy.
+    # (Otherwise, low surface brightness galaxies can get a spuriously high stepk, which
+    # leads to problems.)
+    return galsim.InterpolatedImage(
+        gal_image, x_interpolant=x_interpolant, k_interpolant=k_interpolant,
+        pad_factor=pad_factor, noise_pad_size=noise_pad_size,
+        calculate_stepk=original_psf.stepK(), calculate_maxk=original_psf.maxK(),
+        noise_pad=noise_pad, rng=rng, gsparams=gsparams)
+
+
 class RealGalaxyCatalog(object):
     """Class containing a catalog with information about real galaxy training data.
 
@@ -401,11 +427,37 @@ class RealGalaxyCatalog(object):
                       approximately the same total I/O time (assuming you eventually use most of
                       the image files referenced in the catalog), but it is spread over the
                       various calls to getGal() and getPSF().  [default: False]
+    @param stamp_store  The name of a stamp store file written by writeStampStore(), from which
+                      to read the galaxy and PSF images instead of the FITS files.  If this is
+                      not an absolute path, it is taken to be relative to the image directory.
+                      [default: None]
+    @param cache_size The number of galaxies for which to keep the InterpolatedImages of the
+                      galaxy and PSF, so they can be reused by later RealGalaxy objects with
+                      the same index and parameters.  Set this to 0 to turn off the caching.
+                      [default: 100]
     @param logger     An optional logger object to log progress. [default: None]
+
+    Stamp stores
+    ------------
+    Reading a galaxy from the FITS files means parsing the headers of its HDUs, which is much
+    slower than drawing it in many applications.  The galaxy and PSF images can instead be
+    copied once into a single binary file with
+
+        >>> rgc.writeStampStore('real_galaxy_stamps.dat')
+
+    and the catalog then read with
+
+        >>> rgc = galsim.RealGalaxyCatalog(file_name, dir=dir,
+        ...                                stamp_store='real_galaxy_stamps.dat')
+
+    The stamp store has an index of where each image is in the file, and it is memory mapped
+    when it is opened, so reading any image is just a copy from memory.  The pages of the file
+    are shared among all the processes and threads that use it, and only the parts that are
+    actually used are ever read from disk.
     """
     _req_params = {}
     _opt_params = { 'file_name' : str, 'sample' : str, 'dir' : str,
-                    'preload' : bool }
+                    'preload' : bool, 'stamp_store' : str, 'cache_size' : int }
     _single_params = []
     _takes_rng = False
 
@@ -413,7 +465,8 @@ class RealGalaxyCatalog(object):
     # the config structure.  It indicates that all we care about is the nobjects parameter.
     # So skip any other calculations that might normally be necessary on construction.
     def __init__(self, file_name=None, sample=None, image_dir=None, dir=None, preload=False,
-                 noise_dir=None, logger=None, _nobjects_only=False):
+                 noise_dir=None, stamp_store=None, cache_size=100, logger=None,
+                 _nobjects_only=False):
         if sample is not None and file_name is not None:
             raise ValueError("Cannot specify both the sample and file_name!")
 
@@ -473,6 +526,18 @@ class RealGalaxyCatalog(object):
         self.psf_lock = Lock()  # Use this when accessing psf files
         self.loaded_lock = Lock()  # Use this when opening new files from disk
         self.noise_lock = Lock()  # Use this for building the noise image(s) (usually just one)
+        self.cache_lock = Lock()  # Use this when accessing the cache of InterpolatedImages
+
+        if stamp_store is None:
+            self.stamp_store = None
+        else:
+            self.stamp_store = _RealGalaxyStampStore(os.path.join(self.image_dir, stamp_store))
+            if self.stamp_store.nobjects != self.nobjects:
+                raise ValueError("Stamp store %s has %d objects, but the catalog has %d"%(
+                                 stamp_store, self.stamp_store.nobjects, self.nobjects))
+
+        self.cache_size = cache_size
+        self._makeCache()
 
         # Preload all files if desired
         if preload: self.preload()
@@ -494,6 +559,8 @@ class RealGalaxyCatalog(object):
             for f in self.loaded_files.values():
                 f.close()
         self.loaded_files = {}
+        if getattr(self, 'stamp_store', None) is not None:
+            self.stamp_store.close()
 
     def getNObjects(self) : return self.nobjects
     def getFileName(self) : return self.file_name
@@ -519,6 +586,9 @@ class RealGalaxyCatalog(object):
         """
         from multiprocessing import Lock
         from galsim._pyfits import pyfits
+        if self.stamp_store is not None:
+            # The images are read from the stamp store, so there are no files to load.
+            return
         if self.logger:
             self.logger.debug('RealGalaxyCatalog: start preload')
         for file_name in np.concatenate((self.gal_file_name , self.psf_file_name)):
@@ -566,16 +636,12 @@ class RealGalaxyCatalog(object):
         if i >= len(self.gal_file_name):
             raise IndexError(
                 'index %d given to getGal is out of range (0..%d)'%(i,len(self.gal_file_name)-1))
-        f = self._getFile(self.gal_file_name[i])
-        # For some reason the more elegant `with gal_lock:` syntax isn't working for me.
-        # It gives an EOFError.  But doing an explicit acquire and release seems to work fine.
-        self.gal_lock.acquire()
-        array = f[self.gal_hdu[i]].data
-        self.gal_lock.release()
-        im = galsim.Image(np.ascontiguousarray(array.astype(np.float64)),
-                          scale=self.pixel_scale[i])
-        return im
-
+        if self.stamp_store is not None:
+            array = self.stamp_store.getStamp(i, 0)
+        else:
+            array = self._readGal(i)
+        return galsim.Image(np.ascontiguousarray(array.astype(np.float64)),
+                            scale=self.pixel_scale[i])
 
     def getPSF(self, i):
         """Returns the PSF at index `i` as an Image object.
@@ -585,12 +651,78 @@ class RealGalaxyCatalog(object):
         if i >= len(self.psf_file_name):
             raise IndexError(
                 'index %d given to getPSF is out of range (0..%d)'%(i,len(self.psf_file_name)-1))
+        if self.stamp_store is not None:
+            array = self.stamp_store.getStamp(i, 1)
+        else:
+            array = self._readPSF(i)
+        return galsim.Image(np.ascontiguousarray(array.astype(np.float64)),
+                            scale=self.pixel_scale[i])
+
+    def _readGal(self, i):
+        # Read the galaxy image from its FITS file.
+        f = self._getFile(self.gal_file_name[i])
+        # For some reason the more elegant `with gal_lock:` syntax isn't working for me.
+        # It gives an EOFError.  But doing an explicit acquire and release seems to work fine.
+        self.gal_lock.acquire()
+        array = f[self.gal_hdu[i]].data
+        self.gal_lock.release()
+        return array
+
+    def _readPSF(self, i):
+        # Read the PSF image from its FITS file.
         f = self._getFile(self.psf_file_name[i])
         self.psf_lock.acquire()
         array = f[self.psf_hdu[i]].data
         self.psf_lock.release()
-        return galsim.Image(np.ascontiguousarray(array.astype(np.float64)),
-                            scale=self.pixel_scale[i])
+        return array
+
+    def writeStampStore(self, file_name, dtype=np.float32):
+        """Write all the galaxy and PSF images to a stamp store file.
+
+        The file can then be given as the `stamp_store` parameter of the constructor to read
+        the images from it rather than from the FITS files.  The images are always read from
+        the FITS files here, even if this catalog already uses a stamp store.
+
+        @param file_name    The name of the file to write.
+        @param dtype        The data type in which to store the pixel values.  The COSMOS images
+                            are all float32, so the default does not lose any precision for
+                            them.  [default: numpy.float32]
+        """
+        if self.logger:
+            self.logger.debug('RealGalaxyCatalog: start writeStampStore')
+        _RealGalaxyStampStore.write(file_name, self.nobjects, (self._readGal, self._readPSF),
+                                    dtype)
+
+    def _makeCache(self):
+        if self.cache_size > 0:
+            self._ii_cache = galsim.utilities.LRU_Cache(self._buildInterpolatedImages,
+                                                        self.cache_size)
+        else:
+            self._ii_cache = None
+
+    def _buildInterpolatedImages(self, i, x_interpolant, k_interpolant, pad_factor, gsparams):
+        gal_image = self.getGal(i)
+        psf_image = self.getPSF(i)
+        original_psf = _makeRealGalaxyPSF(psf_image, x_interpolant, k_interpolant, gsparams)
+        original_gal = _makeRealGalaxyGal(gal_image, original_psf, x_interpolant,
+                                          k_interpolant, pad_factor, 0, 0., None, gsparams)
+        return gal_image, psf_image, original_gal, original_psf
+
+    def _getInterpolatedImages(self, i, x_interpolant, k_interpolant, pad_factor, gsparams):
+        """Returns the galaxy and PSF images at index `i` along with their InterpolatedImages
+        (without any noise padding) as a tuple (gal_image, psf_image, gal, psf).
+
+        These are cached, so the same objects are returned for repeated calls with the same
+        arguments, as long as they are among the last `cache_size` distinct ones.
+        """
+        if self._ii_cache is None:
+            return self._buildInterpolatedImages(i, x_interpolant, k_interpolant, pad_factor,
+                                                 gsparams)
+        self.cache_lock.acquire()
+        try:
+            return self._ii_cache(i, x_interpolant, k_interpolant, pad_factor, gsparams)
+        finally:
+            self.cache_lock.release()
 
     def getNoiseProperties(self, i):
         """Returns the components needed to make the noise correlation function at index `i`.
@@ -667,6 +799,8 @@ class RealGalaxyCatalog(object):
         del d['psf_lock']
         del d['loaded_lock']
         del d['noise_lock']
+        del d['cache_lock']
+        del d['_ii_cache']
         return d
 
     def __setstate__(self, d):
@@ -676,7 +810,99 @@ class RealGalaxyCatalog(object):
         self.psf_lock = Lock()
         self.loaded_lock = Lock()
         self.noise_lock = Lock()
-        pass
+        self.cache_lock = Lock()
+        self._makeCache()
+
+
+class _RealGalaxyStampStore(object):
+    """A memory mapped file with the galaxy and PSF images of a RealGalaxyCatalog.
+
+    The file starts with a short header giving the number of objects and the data type of the
+    pixels.  Then there is an index with the offset in the file and the size of each image,
+    ordered as (gal_0, psf_0, gal_1, psf_1, ...), followed by all the pixel values.
+
+    Only the file name is pickled.  The file is mapped again when unpickling, so each process
+    shares the same pages of memory.
+    """
+    _magic = b'GalSimStampStore'
+    _header_dtype = np.dtype([ ('magic', 'S16'), ('nobjects', '<i8'), ('dtype', 'S8') ])
+    _index_dtype = np.dtype([ ('offset', '<i8'), ('nx', '<i4'), ('ny', '<i4') ])
+
+    def __init__(self, file_name):
+        self.file_name = file_name
+        self._open()
+
+    def _open(self):
+        import mmap
+        with open(self.file_name, 'rb') as f:
+            self._mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        header = np.frombuffer(self._mmap, dtype=self._header_dtype, count=1)[0]
+        if header['magic'] != self._magic:
+            raise IOError("%s is not a RealGalaxyCatalog stamp store"%self.file_name)
+        self.nobjects = int(header['nobjects'])
+        self.dtype = np.dtype(header['dtype'].decode())
+        self.index = np.frombuffer(self._mmap, dtype=self._index_dtype, count=2*self.nobjects,
+                                   offset=self._header_dtype.itemsize)
+
+    def getStamp(self, i, k):
+        """Returns a read-only view of the image k (0 = galaxy, 1 = PSF) for object i.
+        """
+        if self._mmap is None: self._open()
+        rec = self.index[2*i+k]
+        array = np.frombuffer(self._mmap, dtype=self.dtype, count=int(rec['nx'] * rec['ny']),
+                              offset=int(rec['offset']))
+        return array.reshape(rec['ny'], rec['nx'])
+
+    def close(self):
+        if self._mmap is not None:
+            # The index needs to go first, since the mmap can't be closed while it is in use.
+            self.index = None
+            try:
+                self._mmap.close()
+            except BufferError:
+                # Someone still has a view of one of the stamps.  The mapping will be
+                # released when that goes away.
+                pass
+            self._mmap = None
+
+    @staticmethod
+    def write(file_name, nobjects, readers, dtype):
+        """Write a stamp store file.
+
+        `readers` is a pair of functions that return the galaxy and PSF image arrays for a
+        given index.
+        """
+        cls = _RealGalaxyStampStore
+        dtype = np.dtype(dtype).newbyteorder('<')
+        header = np.zeros(1, dtype=cls._header_dtype)
+        header['magic'] = cls._magic
+        header['nobjects'] = nobjects
+        header['dtype'] = dtype.str.encode()
+        index = np.zeros(2*nobjects, dtype=cls._index_dtype)
+        offset = cls._header_dtype.itemsize + index.nbytes
+        with open(file_name, 'wb') as fout:
+            # Write the index at the end, once we know what it is.
+            fout.seek(offset)
+            for i in range(nobjects):
+                for k, reader in enumerate(readers):
+                    array = np.ascontiguousarray(reader(i), dtype=dtype)
+                    index[2*i+k] = (offset, array.shape[1], array.shape[0])
+                    fout.write(array.tobytes())
+                    offset += array.nbytes
+                    # Keep each image aligned to 8 bytes.
+                    if offset % 8 != 0:
+                        fout.write(b'\0' * (8 - offset % 8))
+                        offset += 8 - offset % 8
+            fout.seek(0)
+            fout.write(header.tobytes())
+            fout.write(index.tobytes())
+
+    def __getstate__(self):
+        return { 'file_name' : self.file_name }
+
+    def __setstate__(self, d):
+        self.file_name = d['file_name']
+        self._open()
 
 
 
@@ -325,6 +325,11 @@ class LookupTable2D(object):
       - 'floor'
       - 'ceil'
       - 'nearest'
+      - 'spline'
+
+    The 'spline' interpolant is a bicubic Hermite spline, where the derivatives at each grid point
+    are estimated by finite differences.  (For equally spaced grids, this is a Catmull-Rom spline.)
+    It requires at least 4 grid points along each axis.
 
         >>> tab2d = galsim.LookupTable2D(x, y, z, interpolant='floor')
         >>> tab2d(2.2, 3.7)
@@ -379,8 +384,8 @@ class LookupTable2D(object):
     @param x              Strictly increasing array of `x` positions at which to create table.
     @param y              Strictly increasing array of `y` positions at which to create table.
     @param f              Nx by Ny input array of function values.
-    @param interpolant    Interpolant to use.  One of 'floor', 'ceil', 'nearest', or 'linear'.
-                          [Default: 'linear']
+    @param interpolant    Interpolant to use.  One of 'floor', 'ceil', 'nearest', 'linear', or
+                          'spline'.  [Default: 'linear']
     @param edge_mode      Keyword controlling how extrapolation beyond the input range is handled.
                           See above for details.  [Default: 'raise']
     @param constant       A constant to return when extrapolating beyond the input range and
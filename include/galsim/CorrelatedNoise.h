@@ -29,6 +29,7 @@
 #include "TMV_Sym.h"
 #include "Image.h"
 #include "SBProfile.h"
+#include "Random.h"
 
 namespace galsim {
 
@@ -62,5 +63,38 @@ namespace galsim {
     tmv::SymMatrix<double, tmv::FortranStyle|tmv::Upper> calculateCovarianceSymMatrix(
         const SBProfile& sbp, const Bounds<int>& bounds, double dx);
 
+    /**
+     * @brief Add a Gaussian random field with a given power spectrum to an image.
+     *
+     * `rootps` is the square root of the power spectrum on the grid of the image, stored in the
+     * layout of a real-to-complex FFT (ny rows of nx/2+1 values, with the rows in the usual DFT
+     * order), which is the same as the output of numpy.fft.rfft2.  The noise field is periodic
+     * across the edges of the image.
+     *
+     * The random deviates are drawn in the same order as the python CorrelatedNoise used to
+     * draw them when it made the field with numpy, so the realization for a given rng is the
+     * same up to rounding errors.  NoisePad uses this too for correlated noise padding of an
+     * SBInterpolatedImage.
+     */
+    void addNoiseFromRootPS(ImageView<double> image, const double* rootps, BaseDeviate rng);
+
+    /**
+     * @brief Add a Gaussian random field with a given power spectrum to an image, one tile at a
+     * time.
+     *
+     * Here `rootps` is the square root of the power spectrum on a kny x knx grid, which only
+     * needs to be large enough to hold the correlation function, rather than on the grid of the
+     * whole image.  Its inverse transform is the kernel that turns white noise into noise with
+     * this power spectrum.  The white noise is made in tiles, each of which is convolved with the
+     * kernel using FFTs of size fftSize (or larger if needed for the kernel), and the results are
+     * added into the image (i.e. overlap-add).  So the memory needed does not grow with the size
+     * of the image, and the noise is not periodic across the edges of the image.
+     *
+     * The tiles are done in parallel if OpenMP is enabled.  Each tile has its own random number
+     * generator, seeded from `rng`, so the result does not depend on the number of threads.
+     */
+    void addTiledNoiseFromRootPS(ImageView<double> image, const double* rootps, int kny, int knx,
+                                 int fftSize, BaseDeviate rng);
+
 }
 #endif
@@ -59,6 +59,7 @@
 
 #include <stdexcept>
 #include <deque>
+#include <vector>
 #include <complex>
 #define BOOST_NO_CXX11_SMART_PTR
 #include <boost/shared_ptr.hpp>
@@ -68,6 +69,7 @@
 
 #include "Std.h"
 #include "Interpolant.h"
+#include "Mutex.h"
 
 // Define this to get extra debugging checks in the FFT routines.
 // Since these routines are not available to the end user, once code is working
@@ -100,6 +102,12 @@ namespace galsim {
         FFTInvalid(const std::string& m="invalid plan or data") : FFTError(m) {}
     };
 
+    // The fftw_execute function is the only thread-safe FFTW routine.  All creation and
+    // destruction of FFTW plans anywhere in GalSim should be done while holding this mutex,
+    // since it may happen in several threads at once (either OpenMP threads or python
+    // threads that are drawing with the GIL released).
+    extern Mutex fftw_plan_mutex;
+
     // Quick helper struct to tell if T is real or complex
     template <typename T>
     struct FFTW_Traits
@@ -196,6 +204,27 @@ namespace galsim {
      */
     int goodFFTSize(int input);
 
+    /**
+     * @brief Work space used to speed up repeated interpolations with a separable interpolant.
+     *
+     * When interpolating at several points with the same x value (e.g. up a column of an image),
+     * the sums over each row of the table can be reused.  The cache is owned by the caller
+     * rather than the table, so several threads can interpolate the same table at once, each
+     * with its own cache.  A cache should only be used with one table.
+     */
+    template <typename T>
+    struct InterpolationCache
+    {
+        InterpolationCache() : startY(0), x(0.), interp(0) {}
+        void clear() { rows.clear(); xwt.clear(); }
+
+        std::deque<T> rows;
+        std::vector<double> xwt;
+        int startY;
+        double x;
+        const InterpolantXY* interp;
+    };
+
     class XTable;
 
     /**
@@ -223,7 +252,6 @@ namespace galsim {
         KTable& operator=(const KTable& rhs) 
         {
             if (this != &rhs) {
-                clearCache();
                 _array = rhs._array;
                 _N=rhs._N;
                 _No2=rhs._No2;
@@ -265,8 +293,15 @@ namespace galsim {
         std::complex<double> kval2(int ix, int iy) const 
         { return _array[index2(ix,iy)]; }
 
+        typedef InterpolationCache<std::complex<double> > Cache;
+
         /// interpolate to k=(kx, ky) - WILL wrap k values to fill interpolant kernel
-        std::complex<double> interpolate(double kx, double ky, const Interpolant2d& interp) const;
+        std::complex<double> interpolate(double kx, double ky, const Interpolant2d& interp) const
+        { Cache cache; return interpolate(kx, ky, interp, cache); }
+
+        /// The same, reusing the work in cache from previous calls with the same kx.
+        std::complex<double> interpolate(double kx, double ky, const Interpolant2d& interp,
+                                         Cache& cache) const;
 
         /// Set the value of a grid point ix,iy (k = (ix*dk, iy*dk)) to a given value.
         void kSet(int ix, int iy, std::complex<double> value);
@@ -278,13 +313,6 @@ namespace galsim {
         /// Set all values to zero
         void clear();  
 
-        /// Clear any cached values that had been set from previous passes.
-        void clearCache() const 
-        {
-            _cache.clear(); 
-            _xwt.clear();
-        }
-
         /// this += scalar*rhs
         void accumulate(const KTable& rhs, double scalar=1.); 
 
@@ -363,13 +391,6 @@ namespace galsim {
 
         int wrapKValue(double k) const;  // wrap floor(k) to be within [-N/2,N/2-1]
 
-        // Objects used to accelerate interpolation with separable interpolants:
-        mutable std::deque<std::complex<double> > _cache;
-        mutable std::vector<double> _xwt;
-        mutable int _cacheStartY;
-        mutable double _cacheX;
-        mutable const InterpolantXY* _cacheInterp;
-
         friend class XTable; 
     };
 
@@ -394,7 +415,6 @@ namespace galsim {
         XTable& operator=(const XTable& rhs) 
         {
             if (this != &rhs) {
-                clearCache();
                 _array = rhs._array;
                 _N=rhs._N;
                 _No2=rhs._No2;
@@ -432,8 +452,14 @@ namespace galsim {
         /// Get value at grid point (x,y) = (ix*dx, iy*dx)
         double xval(int ix, int iy) const; 
 
+        typedef InterpolationCache<double> Cache;
+
         /// interpolate to (x,y) - will NOT wrap the x data around +-N/2
-        double interpolate(double x, double y, const Interpolant2d& interp) const;
+        double interpolate(double x, double y, const Interpolant2d& interp) const
+        { Cache cache; return interpolate(x, y, interp, cache); }
+
+        /// The same, reusing the work in cache from previous calls with the same x.
+        double interpolate(double x, double y, const Interpolant2d& interp, Cache& cache) const;
 
         /// Set the value of a grid point ix,iy ((x,y) = (ix*dk, iy*dk)) to a given value.
         void xSet(int ix, int iy, double value);
@@ -441,13 +467,6 @@ namespace galsim {
         /// Set all values to zero
         void clear();  
 
-        /// Clear any cached values that had been set from previous passes.
-        void clearCache() const 
-        {
-            _cache.clear(); 
-            _xwt.clear();
-        }
-
         /// this += scalar*rhs
         void accumulate(const XTable& rhs, double scalar=1.); 
 
@@ -507,13 +526,6 @@ namespace galsim {
         void check_array() const {}
 #endif
 
-        // Objects used to accelerate interpolation with separable interpolants:
-        mutable std::deque<double> _cache;
-        mutable std::vector<double> _xwt;
-        mutable double _cacheX;
-        mutable int _cacheStartY;
-        mutable const InterpolantXY* _cacheInterp;
-
         friend class KTable;
     };
 
@@ -521,7 +533,6 @@ namespace galsim {
     template <class T>
     void KTable::fill(const T& f) 
     {
-        clearCache(); // invalidate any stored interpolations
         std::complex<double>* zptr=_array.get();
         double kx, ky;
         for (int iy=0; iy< _No2; iy++) {
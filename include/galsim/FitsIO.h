@@ -0,0 +1,158 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_FitsIO_H
+#define GalSim_FitsIO_H
+
+/**
+ *  @file FitsIO.h
+ *  @brief Reading and writing images directly to and from FITS files.
+ *
+ *  This handles the common cases of writing a single 2-d image, either uncompressed or using
+ *  the tile compression convention with GZIP_1 or RICE_1 compression, and reading any part of
+ *  such an image back in.  More complicated FITS files are handled at the python layer using
+ *  pyfits.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Image.h"
+
+namespace galsim {
+
+    /**
+     *  @brief Exception class thrown by the FITS I/O functions.
+     */
+    class FitsError : public std::runtime_error {
+    public:
+        FitsError(const std::string& m) : std::runtime_error("FITS Error: " + m) {}
+    };
+
+    /**
+     *  @brief Write an image to a FITS file, one block of rows at a time.
+     *
+     *  The header is written when the writer is constructed, and then the rows of the image
+     *  are written as they are provided, so the full image never needs to be in memory at once.
+     *  The rows must be written in order, starting from the bottom row of the given bounds.
+     *
+     *  The compression may be "none", "gzip_tile" or "rice".  In the latter two cases the file
+     *  has an empty primary HDU, and the image is in the first extension, compressed in tiles
+     *  of one row each according to the FITS tile compression convention.  Tiles are compressed
+     *  in parallel if OpenMP is enabled.  Rice compression is only valid for integer pixel
+     *  types.
+     *
+     *  The output is finished when close() is called (or when the writer is destroyed).
+     */
+    template <typename T>
+    class FitsWriter
+    {
+    public:
+
+        /**
+         *  @brief Open the file and write the header.
+         *
+         *  @param[in] file_name    The name of the file to write.  Any existing file is
+         *                          overwritten.
+         *  @param[in] bounds       The bounds of the full image.
+         *  @param[in] cards        Additional header cards to write, as a string of 80
+         *                          character cards (with no END card).
+         *  @param[in] compression  The kind of compression to use: "none", "gzip_tile" or
+         *                          "rice".
+         */
+        FitsWriter(const std::string& file_name, const Bounds<int>& bounds,
+                   const std::string& cards="", const std::string& compression="none");
+
+        /**
+         *  @brief Destructor finishes the file if close() has not already been called.
+         */
+        ~FitsWriter();
+
+        /**
+         *  @brief Write the next rows of the image.
+         *
+         *  The image must span the full width of the bounds, and its first row must be the
+         *  next row to be written.
+         */
+        void write(const BaseImage<T>& rows);
+
+        /**
+         *  @brief The next row (in the coordinates of the bounds) that will be written.
+         */
+        int getNextRow() const { return _nextRow; }
+
+        /**
+         *  @brief Finish writing the file.
+         *
+         *  An exception is thrown if not all the rows of the image have been written.
+         */
+        void close();
+
+    private:
+
+        std::string _fileName;
+        Bounds<int> _bounds;
+        int _ncol;
+        int _compress;          // 0 = none, 1 = gzip_tile, 2 = rice
+        int _nextRow;
+        std::FILE* _fout;
+        long _dataStart;        // Start of the image data, or of the table if compressed.
+        long _heapSize;
+        long _maxTileSize;
+        long _pcountPos;        // Positions in the file of the cards that are filled in
+        long _tformPos;         // when the file is closed.
+        std::vector<int> _descriptors;
+
+        void finish();
+
+        // Disable copying
+        FitsWriter(const FitsWriter<T>& );
+        void operator=(const FitsWriter<T>& );
+    };
+
+    /**
+     *  @brief Write an image to a FITS file.
+     *
+     *  See FitsWriter for the meaning of the parameters.
+     */
+    template <typename T>
+    void WriteFitsImage(const BaseImage<T>& image, const std::string& file_name,
+                        const std::string& cards="", const std::string& compression="none");
+
+    /**
+     *  @brief Read part of an image from a FITS file.
+     *
+     *  The bounds of the given image give the pixels to read, in the FITS convention where the
+     *  lower left pixel is (1,1).  Only the parts of the file that contain these pixels are
+     *  read, and for a compressed image, only the tiles that contain them are decompressed.
+     *
+     *  The HDU may be a normal 2-d image or an image compressed with GZIP_1 or RICE_1
+     *  compression in tiles that each span the full width of the image.  Other kinds of HDUs
+     *  raise a FitsError.
+     *
+     *  @param[in] image        The image to fill.
+     *  @param[in] file_name    The name of the file to read.
+     *  @param[in] hdu          The number of the HDU to read (0 is the primary HDU).
+     */
+    template <typename T>
+    void ReadFitsImage(const ImageView<T>& image, const std::string& file_name, int hdu=0);
+
+}
+
+#endif
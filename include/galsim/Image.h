@@ -267,10 +267,10 @@ namespace galsim {
         ptrdiff_t _nElements;         // number of elements allocated in memory
         int _stride;                  // number of elements between rows (!= width for subimages)
 
-        inline int addressPixel(int y) const
-        { return (y - this->getYMin()) * _stride; }
+        inline ptrdiff_t addressPixel(int y) const
+        { return ptrdiff_t(y - this->getYMin()) * _stride; }
         
-        inline int addressPixel(int x, int y) const
+        inline ptrdiff_t addressPixel(int x, int y) const
         { return (x - this->getXMin()) + addressPixel(y); }
 
         /**
@@ -314,6 +314,13 @@ namespace galsim {
          */
         void allocateMem();
 
+        /**
+         *  @brief Map the image onto a file rather than allocating memory for it.
+         *
+         *  This is used to implement ImageAlloc<T>'s file-backed constructor.
+         */
+        void mapFile(const std::string& file_name, long offset);
+
     private:
         /**
          *  @brief op= is invalid.  So private and undefined.
@@ -551,13 +558,15 @@ namespace galsim {
         {
             if (!this->_bounds.isSameShapeAs(rhs.getBounds()))
                 throw ImageError("Attempt im1 = im2, but bounds not the same shape");
-            for (int y=this->getYMin(), y2=rhs.getYMin(); y <= this->getYMax(); ++y, ++y2) {
-                iterator it1 = rowBegin(y);
-                const iterator ee = rowEnd(y);      
-                typename BaseImage<U>::const_iterator it2 = rhs.rowBegin(y2);
-                while (it1 != ee) *(it1++) = T(*(it2++));
-            }
+            apply_pixel(*this, rhs, ConvertSecond());
         }
+
+    private:
+        struct ConvertSecond
+        {
+            template <class U>
+            T operator()(T, U v) const { return T(v); }
+        };
     };
 
     /**
@@ -600,6 +609,34 @@ namespace galsim {
          */
         ImageAlloc(const Bounds<int>& bounds, T init_value = T(0));
 
+        /**
+         *  @brief Use existing memory for the image rather than allocating a new array.
+         *
+         *  The data must be contiguous, with a stride equal to the number of columns in the
+         *  bounds.  The owner manages the lifetime of the memory, so this is how the python
+         *  layer makes an ImageAlloc that uses the buffer of a NumPy array without copying it.
+         */
+        ImageAlloc(T* data, const boost::shared_ptr<T>& owner, const Bounds<int>& b) :
+            BaseImage<T>(data, b.area(), owner, b.getXMax()-b.getXMin()+1, b) {}
+
+        /**
+         *  @brief Create a new image whose pixels are stored in a memory-mapped file.
+         *
+         *  The pixel values are stored contiguously, in native byte order, starting at
+         *  byte `offset` in the file, which must be a multiple of sizeof(T).  The file is
+         *  created if it does not exist, and extended if it is too small, but existing
+         *  contents are otherwise left alone, so this can also be used to modify an image
+         *  on disk in place.
+         *
+         *  The mapping is shared, so writes to the image or to any view of it go straight
+         *  to the file's pages, which the OS reads and writes back as needed.  This makes
+         *  it possible to build an image larger than the available memory.  The mapping
+         *  is released when the last image sharing its memory goes away.
+         *
+         *  Note that resize() to a larger size will switch to normal (heap) memory.
+         */
+        ImageAlloc(const Bounds<int>& bounds, const std::string& file_name, long offset=0);
+
         /**
          *  @brief Deep copy constructor.
          */
@@ -310,9 +310,145 @@ namespace galsim {
         return f;
     }
 
+    //
+    // Elementwise kernels for the arithmetic below.
+    //
+    // Unlike the templates above, these require the function to be stateless, so the pixels
+    // may be done in any order.  Each row is done with plain pointers, which lets the compiler
+    // vectorize the inner loop (including any conversion between pixel types), and the rows
+    // of large images are split among OpenMP threads.
+    //
+
+    // Images with at least this many pixels are split among threads.
+    const long parallelImageArithSize = 1L << 18;
+
+    template <typename T, typename Op>
+    inline void transform_row(T* p, long n, Op f)
+    { for (long i=0; i<n; ++i) p[i] = T(f(p[i])); }
+
+    template <typename T1, typename T2, typename Op>
+    inline void transform_row(T1* p1, const T2* p2, long n, Op f)
+    { for (long i=0; i<n; ++i) p1[i] = T1(f(p1[i],p2[i])); }
+
+    template <typename T1, typename T2, typename T3, typename Op>
+    inline void transform_row(T1* p1, const T2* p2, const T3* p3, long n, Op f)
+    { for (long i=0; i<n; ++i) p1[i] = T1(f(p2[i],p3[i])); }
+
+    /**
+     *  @brief Replace image with a stateless function of its pixel values.
+     */
+    template <typename T, typename Op>
+    void apply_pixel(const ImageView<T>& image, const Op& f)
+    {
+        T* ptr = image.getData();
+        if (!ptr) return;
+        const int ncol = image.getXMax() - image.getXMin() + 1;
+        const int nrow = image.getYMax() - image.getYMin() + 1;
+        const int step = image.getStride();
+        const long npix = long(ncol) * nrow;
+#ifdef _OPENMP
+        if (npix >= parallelImageArithSize) {
+#pragma omp parallel for
+            for (int y=0; y<nrow; ++y) transform_row(ptr + long(y)*step, ncol, f);
+            return;
+        }
+#endif
+        if (image.isContiguous()) {
+            transform_row(ptr, npix, f);
+        } else {
+            for (int y=0; y<nrow; ++y, ptr+=step) transform_row(ptr, ncol, f);
+        }
+    }
+
+    /**
+     *  @brief Assign a stateless function of 2 images to the 1st.
+     */
+    template <typename T1, typename T2, typename Op>
+    void apply_pixel(const ImageView<T1>& image1, const BaseImage<T2>& image2, const Op& f)
+    {
+        T1* ptr1 = image1.getData();
+        if (!ptr1) return;
+        if (!image1.getBounds().isSameShapeAs(image2.getBounds()))
+            throw ImageError("apply_pixel image bounds are not same shape");
+        const T2* ptr2 = image2.getData();
+        const int ncol = image1.getXMax() - image1.getXMin() + 1;
+        const int nrow = image1.getYMax() - image1.getYMin() + 1;
+        const int step1 = image1.getStride();
+        const int step2 = image2.getStride();
+        const long npix = long(ncol) * nrow;
+#ifdef _OPENMP
+        if (npix >= parallelImageArithSize) {
+#pragma omp parallel for
+            for (int y=0; y<nrow; ++y)
+                transform_row(ptr1 + long(y)*step1, ptr2 + long(y)*step2, ncol, f);
+            return;
+        }
+#endif
+        if (image1.isContiguous() && image2.isContiguous()) {
+            transform_row(ptr1, ptr2, npix, f);
+        } else {
+            for (int y=0; y<nrow; ++y, ptr1+=step1, ptr2+=step2)
+                transform_row(ptr1, ptr2, ncol, f);
+        }
+    }
+
+    /**
+     *  @brief Assign a stateless function of Img2 & Img3 to Img1.
+     */
+    template <typename T1, typename T2, typename T3, typename Op>
+    void apply_pixel(
+        const ImageView<T1>& image1,
+        const BaseImage<T2>& image2,
+        const BaseImage<T3>& image3,
+        const Op& f)
+    {
+        T1* ptr1 = image1.getData();
+        if (!ptr1) return;
+        if (!image1.getBounds().isSameShapeAs(image2.getBounds()))
+            throw ImageError("apply_pixel image1, image2 bounds are not same shape");
+        if (!image1.getBounds().isSameShapeAs(image3.getBounds()))
+            throw ImageError("apply_pixel image1, image3 bounds are not same shape");
+        const T2* ptr2 = image2.getData();
+        const T3* ptr3 = image3.getData();
+        const int ncol = image1.getXMax() - image1.getXMin() + 1;
+        const int nrow = image1.getYMax() - image1.getYMin() + 1;
+        const int step1 = image1.getStride();
+        const int step2 = image2.getStride();
+        const int step3 = image3.getStride();
+        const long npix = long(ncol) * nrow;
+#ifdef _OPENMP
+        if (npix >= parallelImageArithSize) {
+#pragma omp parallel for
+            for (int y=0; y<nrow; ++y)
+                transform_row(ptr1 + long(y)*step1, ptr2 + long(y)*step2,
+                              ptr3 + long(y)*step3, ncol, f);
+            return;
+        }
+#endif
+        if (image1.isContiguous() && image2.isContiguous() && image3.isContiguous()) {
+            transform_row(ptr1, ptr2, ptr3, npix, f);
+        } else {
+            for (int y=0; y<nrow; ++y, ptr1+=step1, ptr2+=step2, ptr3+=step3)
+                transform_row(ptr1, ptr2, ptr3, ncol, f);
+        }
+    }
+
     // All code between the @cond and @endcond is excluded from Doxygen documentation
     //! @cond
 
+    // A binary function of (pixel, value) that applies a unary function to the value after
+    // converting it to T.  This lets the image-scalar expressions below be done in one pass.
+    template <typename T, typename Op>
+    class ApplyToSecond
+    {
+    public:
+        ApplyToSecond(const Op& op) : _op(op) {}
+        template <typename T1, typename T2>
+        T operator()(const T1&, const T2& x) const { return _op(T(x)); }
+    private:
+        Op _op;
+    };
+
     // Default uses T1 as the result type
     template <typename T1, typename T2>
     struct ResultType { typedef T1 type; };
@@ -344,7 +480,12 @@ namespace galsim {
         typedef typename ResultType<T1,T2>::type result_type;
         SumIX(const BaseImage<T1>& im, const T2 x) :
             AssignableToImage<result_type>(im.getBounds()), _im(im), _x(x) {}
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im; rhs += _x; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        {
+            typedef std::binder2nd<std::plus<result_type> > Op;
+            apply_pixel(rhs, _im, ApplyToSecond<result_type,Op>(
+                    Op(std::plus<result_type>(),result_type(_x))));
+        }
     private:
         const BaseImage<T1>& _im;
         const T2 _x;
@@ -366,7 +507,7 @@ namespace galsim {
 
     template <typename T> 
     inline const ImageView<T>& operator+=(const ImageView<T>& im, T x) 
-    { transform_pixel(im, bind2nd(std::plus<T>(),x)); return im; }
+    { apply_pixel(im, bind2nd(std::plus<T>(),x)); return im; }
 
     template <typename T>
     inline ImageAlloc<T>& operator+=(ImageAlloc<T>& im, const T& x) 
@@ -401,7 +542,12 @@ namespace galsim {
         typedef typename ResultType<T1,T2>::type result_type;
         ProdIX(const BaseImage<T1>& im, const T2 x) :
             AssignableToImage<result_type>(im.getBounds()), _im(im), _x(x) {}
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im; rhs *= _x; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        {
+            typedef std::binder2nd<std::multiplies<result_type> > Op;
+            apply_pixel(rhs, _im, ApplyToSecond<result_type,Op>(
+                    Op(std::multiplies<result_type>(),result_type(_x))));
+        }
     private:
         const BaseImage<T1>& _im;
         const T2 _x;
@@ -417,7 +563,7 @@ namespace galsim {
 
     template <typename T> 
     inline const ImageView<T>& operator*=(const ImageView<T>& im, T x) 
-    { transform_pixel(im, bind2nd(std::multiplies<T>(),x)); return im; }
+    { apply_pixel(im, bind2nd(std::multiplies<T>(),x)); return im; }
 
     template <typename T>
     inline ImageAlloc<T>& operator*=(ImageAlloc<T>& im, const T& x) 
@@ -434,7 +580,12 @@ namespace galsim {
         typedef typename ResultType<T1,T2>::type result_type;
         QuotIX(const BaseImage<T1>& im, const T2 x) :
             AssignableToImage<result_type>(im.getBounds()), _im(im), _x(x) {}
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im; rhs /= _x; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        {
+            typedef std::binder2nd<std::divides<result_type> > Op;
+            apply_pixel(rhs, _im, ApplyToSecond<result_type,Op>(
+                    Op(std::divides<result_type>(),result_type(_x))));
+        }
     private:
         const BaseImage<T1>& _im;
         const T2 _x;
@@ -450,7 +601,7 @@ namespace galsim {
 
     template <typename T> 
     inline const ImageView<T>& operator/=(const ImageView<T>& im, T x) 
-    { transform_pixel(im, bind2nd(std::divides<T>(),x)); return im; }
+    { apply_pixel(im, bind2nd(std::divides<T>(),x)); return im; }
 
     template <typename T>
     inline ImageAlloc<T>& operator/=(ImageAlloc<T>& im, const T& x) 
@@ -471,7 +622,8 @@ namespace galsim {
             if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
                 throw ImageError("Attempt im1 + im2, but bounds not the same shape");
         }
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im1; rhs += _im2; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        { apply_pixel(rhs, _im1, _im2, std::plus<result_type>()); }
     private:
         const BaseImage<T1>& _im1;
         const BaseImage<T2>& _im2;
@@ -486,7 +638,7 @@ namespace galsim {
     {
         if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
             throw ImageError("Attempt im1 += im2, but bounds not the same shape");
-        transform_pixel(im1, im2, std::plus<T1>());
+        apply_pixel(im1, im2, std::plus<T1>());
         return im1; 
     }
 
@@ -510,7 +662,8 @@ namespace galsim {
             if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
                 throw ImageError("Attempt im1 - im2, but bounds not the same shape");
         }
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im1; rhs -= _im2; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        { apply_pixel(rhs, _im1, _im2, std::minus<result_type>()); }
     private:
         const BaseImage<T1>& _im1;
         const BaseImage<T2>& _im2;
@@ -525,7 +678,7 @@ namespace galsim {
     {
         if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
             throw ImageError("Attempt im1 -= im2, but bounds not the same shape");
-        transform_pixel(im1, im2, std::minus<T1>());
+        apply_pixel(im1, im2, std::minus<T1>());
         return im1; 
     }
 
@@ -549,7 +702,8 @@ namespace galsim {
             if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
                 throw ImageError("Attempt im1 * im2, but bounds not the same shape");
         }
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im1; rhs *= _im2; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        { apply_pixel(rhs, _im1, _im2, std::multiplies<result_type>()); }
     private:
         const BaseImage<T1>& _im1;
         const BaseImage<T2>& _im2;
@@ -564,7 +718,7 @@ namespace galsim {
     {
         if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
             throw ImageError("Attempt im1 *= im2, but bounds not the same shape");
-        transform_pixel(im1, im2, std::multiplies<T1>());
+        apply_pixel(im1, im2, std::multiplies<T1>());
         return im1; 
     }
 
@@ -588,7 +742,8 @@ namespace galsim {
             if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
                 throw ImageError("Attempt im1 / im2, but bounds not the same shape");
         }
-        void assignTo(const ImageView<result_type>& rhs) const { rhs = _im1; rhs /= _im2; }
+        void assignTo(const ImageView<result_type>& rhs) const
+        { apply_pixel(rhs, _im1, _im2, std::divides<result_type>()); }
     private:
         const BaseImage<T1>& _im1;
         const BaseImage<T2>& _im2;
@@ -603,7 +758,7 @@ namespace galsim {
     {
         if (!im1.getBounds().isSameShapeAs(im2.getBounds()))
             throw ImageError("Attempt im1 /= im2, but bounds not the same shape");
-        transform_pixel(im1, im2, std::divides<T1>());
+        apply_pixel(im1, im2, std::divides<T1>());
         return im1; 
     }
 
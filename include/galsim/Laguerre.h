@@ -418,9 +418,18 @@ namespace galsim {
             tmv::MatrixView<std::complex<double> > psi_k, int order, double sigma);
 
         // ?? Add routine to decompose a data vector into b's
-        // ?? Add routines to evaluate summed basis at a set of x/k points
-        // These can be written to use less memory than building the full basis matrix
-        //  so that they will run largely in cache.
+
+        // Evaluate the summed basis, f[i] = this->dot(basis(x[i],y[i])), at npts input points.
+        // This gives the same answer as basis(x,y,order,sigma) * rVector(), but it runs the
+        // Laguerre recurrences on small blocks of points and accumulates the sum as it goes,
+        // so the full npts x ndof basis matrix is never built and everything stays in cache.
+        // As for fillBasis, x and y should already be in units of sigma.
+        void sumBasis(const double* x, const double* y, double* f, int npts,
+                      double sigma=1.) const;
+
+        // The same thing for the Fourier-space basis, as given by kBasis.
+        void sumKBasis(const double* kx, const double* ky, std::complex<double>* f,
+                       int npts) const;
 
         // Transformations of coefficient LVectors representing real objects:
         // Rotate represented object by theta:
@@ -454,6 +463,12 @@ namespace galsim {
             const tmv::ConstVectorView<double>* invsig,
             tmv::MatrixView<T> psi, int order, double sigma=1.);
 
+        // The implementation of sumBasis and sumKBasis.
+        template <typename T>
+        static void mSumBasis(
+            const double* x, const double* y, const double* b,
+            T* f, int npts, int order, double sigma=1.);
+
         void allocateMem()
         {
             int s = PQIndex::size(_order);
@@ -0,0 +1,125 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#ifndef GalSim_LensingPS_H
+#define GalSim_LensingPS_H
+
+/**
+ *  @file LensingPS.h
+ *  @brief Gaussian random shear fields drawn from a power spectrum, and interpolation of the
+ *  gridded lensing quantities.
+ */
+
+#include <vector>
+#define BOOST_NO_CXX11_SMART_PTR
+#include <boost/shared_ptr.hpp>
+#include "Random.h"
+#include "Interpolant.h"
+
+namespace galsim {
+
+    /**
+     *  @brief Draw a realization of the shear and convergence fields on an N x N grid.
+     *
+     *  The amplitudes are the square roots of the E and B mode power (including the
+     *  normalization by the pixel size) at the non-negative kx values, given as arrays of shape
+     *  (N, N/2+1) in the usual FFT order.  Either may be null, in which case that mode has no
+     *  power.  For each non-null mode, two arrays of N*(N/2+1) Gaussian deviates are drawn for
+     *  the real and imaginary parts, in that order, and the E mode is drawn before the B mode.
+     *  This matches the order of the draws in the python PowerSpectrumRealizer, so a given
+     *  GaussianDeviate produces the same fields.
+     *
+     *  The outputs g1, g2 and kappa are N x N arrays in row-major order, which is the order of a
+     *  numpy array indexed by [y,x].
+     */
+    void RealizePowerSpectrum(const double* ampE, const double* ampB, int N, GaussianDeviate& gd,
+                              double* g1, double* g2, double* kappa);
+
+    /**
+     *  @brief Do a Kaiser & Squires (1993) inversion of the N x N shear fields g1, g2 to get
+     *  the E and B mode convergence fields kappaE, kappaB.
+     */
+    void KaiserSquires(const double* g1, const double* g2, int N, double* kappaE, double* kappaB);
+
+    /**
+     *  @brief A set of lensing quantities on a square grid, to be interpolated together at
+     *  arbitrary positions.
+     *
+     *  The quantities are stored interleaved in a single table, so the interpolation weights
+     *  for each position are calculated once and used for all of them.  The table has a border
+     *  around the N x N grid that is wide enough for the interpolant.  If the grid is periodic,
+     *  the border is filled with the values from the other side of the grid, and positions
+     *  outside the grid are wrapped back into it.  Otherwise the border is zero, so the values
+     *  taper to zero past the edge of the grid just as they would for an SBInterpolatedImage.
+     *
+     *  Grid point (i,j) of each quantity is at position (x0 + i*dx, y0 + j*dx), and the values
+     *  are given in the order of a numpy array indexed by [j,i].
+     */
+    class LensingGrid
+    {
+    public:
+
+        /**
+         *  @brief Construct the table from nfield arrays of N x N values.
+         *
+         *  @param[in] fields   The values, as an (nfield, N, N) array in row-major order.
+         *  @param[in] nfield   The number of quantities.
+         *  @param[in] N        The number of grid points along each side.
+         *  @param[in] x0, y0   The position of the first grid point.
+         *  @param[in] dx       The grid spacing.
+         *  @param[in] interp   The interpolant to use in each direction.
+         *  @param[in] periodic Whether to treat the grid as periodic.
+         */
+        LensingGrid(const double* fields, int nfield, int N, double x0, double y0, double dx,
+                    boost::shared_ptr<Interpolant> interp, bool periodic);
+
+        int getNField() const { return _nfield; }
+        int getN() const { return _N; }
+        bool isPeriodic() const { return _periodic; }
+
+        /**
+         *  @brief Interpolate all the quantities at the n positions (x[k], y[k]).
+         *
+         *  The value of quantity f at position k is written to out[f*n + k].  The positions are
+         *  done in parallel if OpenMP is enabled.
+         */
+        void interpolate(const double* x, const double* y, int n, double* out) const;
+
+    private:
+
+        int _nfield;
+        int _N;
+        double _x0;
+        double _y0;
+        double _invdx;
+        boost::shared_ptr<Interpolant> _interp;
+        bool _periodic;
+        int _border;
+        int _Np;                    // N + 2*border
+        std::vector<double> _table; // (Np x Np x nfield), including the border.
+
+        // Find the range of table indices needed for the (grid) coordinate x along one axis,
+        // along with their interpolation weights.  Returns false if there are none.
+        bool weights(double x, int& imin, int& imax, double* w) const;
+    };
+
+}
+
+#endif
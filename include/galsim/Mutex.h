@@ -0,0 +1,72 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_Mutex_H
+#define GalSim_Mutex_H
+
+#include <pthread.h>
+
+namespace galsim {
+
+    /**
+     * @brief A mutex for data that may be used from several threads at once.
+     *
+     * OpenMP critical sections and locks are only guaranteed to work among OpenMP threads.
+     * The python layer may also call into the C++ code from several python threads at once
+     * (e.g. drawing with the GIL released), so anything shared with those uses this instead.
+     */
+    class Mutex
+    {
+    public:
+        Mutex() { pthread_mutex_init(&_mutex, 0); }
+        ~Mutex() { pthread_mutex_destroy(&_mutex); }
+
+        void lock() { pthread_mutex_lock(&_mutex); }
+        void unlock() { pthread_mutex_unlock(&_mutex); }
+
+    private:
+        pthread_mutex_t _mutex;
+
+        // Disable copying
+        Mutex(const Mutex& );
+        void operator=(const Mutex& );
+    };
+
+    /**
+     * @brief Holds a Mutex locked for the lifetime of this object.
+     *
+     * This makes sure the Mutex is unlocked again if an exception is thrown.
+     */
+    class MutexLock
+    {
+    public:
+        MutexLock(Mutex& mutex) : _mutex(mutex) { _mutex.lock(); }
+        ~MutexLock() { _mutex.unlock(); }
+
+    private:
+        Mutex& _mutex;
+
+        // Disable copying
+        MutexLock(const MutexLock& );
+        void operator=(const MutexLock& );
+    };
+
+}
+
+#endif
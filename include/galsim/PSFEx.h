@@ -0,0 +1,134 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#ifndef GalSim_PSFEx_H
+#define GalSim_PSFEx_H
+
+/**
+ *  @file PSFEx.h
+ *  @brief Evaluation of PSFEx models of the PSF at many positions at once.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "SBInterpolatedImage.h"
+
+namespace galsim {
+
+    /**
+     *  @brief Exception class thrown when a PSFEx model cannot be evaluated.
+     */
+    class PSFExError : public std::runtime_error {
+    public:
+        PSFExError(const std::string& m) : std::runtime_error(m) {}
+    };
+
+    /**
+     *  @brief A PSFEx model of the PSF as a polynomial in the image position.
+     *
+     *  The PSF image at (x,y) is sum_k P_k(x,y) B_k, where B_k are the basis images and
+     *  P_k are the terms of a polynomial of the given order in the scaled positions
+     *  xs = (x-x0)/xscale and ys = (y-y0)/yscale, ordered as
+     *
+     *      1, xs, xs^2, ..., ys, xs ys, ..., ys^2, ...
+     *
+     *  i.e. xs^i ys^j is term k = i + j*(order+1) - j*(j-1)/2.
+     *
+     *  The basis images are stored as a single contiguous (nbasis x npix) matrix, so
+     *  evaluating the PSF at n positions is the matrix product of the (n x nbasis) matrix of
+     *  polynomial terms with the basis.  This is done a few positions at a time, so each row
+     *  of the basis is read once for several positions.  The positions are done in parallel if
+     *  OpenMP is enabled.
+     */
+    class PSFExModel
+    {
+    public:
+
+        /**
+         *  @brief Construct the model.
+         *
+         *  @param[in] basis        The basis images, as nbasis images of ny x nx pixels each,
+         *                          in row-major order.
+         *  @param[in] nbasis       The number of basis images.  This must be
+         *                          (order+1)(order+2)/2.
+         *  @param[in] nx, ny       The size of the basis images.
+         *  @param[in] order        The order of the polynomial.
+         *  @param[in] x0, y0       The zero points of the polynomial.
+         *  @param[in] xscale, yscale   The scales of the polynomial.
+         */
+        PSFExModel(const double* basis, int nbasis, int nx, int ny, int order,
+                   double x0, double y0, double xscale, double yscale);
+
+        int getNBasis() const { return _nbasis; }
+        int getNX() const { return _nx; }
+        int getNY() const { return _ny; }
+
+        /**
+         *  @brief Calculate the PSF images at n positions.
+         *
+         *  @param[in] x, y     The image positions (n values each).
+         *  @param[in] n        The number of positions.
+         *  @param[out] images  The PSF images, n images of ny x nx pixels each, in row-major
+         *                      order.
+         */
+        void getImages(const double* x, const double* y, int n, float* images) const;
+
+        /**
+         *  @brief Make SBInterpolatedImages of the PSF images at n positions.
+         *
+         *  These are the same as making an SBInterpolatedImage from each of the images of
+         *  getImages() with the given interpolants, pad_factor and gsparams, and then calling
+         *  calculateStepK() and calculateMaxK().  The profiles all share the same interpolants,
+         *  and they are made in parallel if OpenMP is enabled.
+         *
+         *  The profiles are in units of the PSFEx pixels, centered on the center of the image,
+         *  like the profile made by the python InterpolatedImage class before it is shifted
+         *  and scaled.
+         */
+        void getProfiles(const double* x, const double* y, int n,
+                         boost::shared_ptr<Interpolant> xInterp,
+                         boost::shared_ptr<Interpolant> kInterp,
+                         double pad_factor, const GSParamsPtr& gsparams,
+                         std::vector<boost::shared_ptr<SBInterpolatedImage> >& profiles) const;
+
+    private:
+
+        int _nbasis;
+        int _nx;
+        int _ny;
+        int _npix;
+        int _order;
+        double _x0;
+        double _y0;
+        double _xscale;
+        double _yscale;
+        std::vector<double> _basis;     // nbasis x npix
+
+        // Fill the nbasis polynomial terms for position (x,y).
+        void getTerms(double x, double y, double* terms) const;
+
+        // Fill the images for m <= MAX_BLOCK positions.
+        void getImageBlock(const double* terms, int m, float* images) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_PhaseScreen_H
+#define GalSim_PhaseScreen_H
+
+/**
+ *  @file PhaseScreen.h
+ *  @brief Evaluation of periodic atmospheric phase screens over a telescope pupil.
+ */
+
+#include <vector>
+#include <stdexcept>
+#include "FFT.h"
+
+namespace galsim {
+
+    /**
+     *  @brief A square, periodic phase screen that is sampled with bilinear interpolation.
+     *
+     *  The screen values are stored with one extra row and column that repeat the first ones,
+     *  so that interpolating between the last grid point and the first one (across the periodic
+     *  boundary) needs no special handling.  The values may be updated in place with
+     *  setScreen(), which is how the python layer evolves a screen that is not frozen, and the
+     *  screen is moved with the wind just by changing the offsets that are passed to
+     *  wavefront(), so advancing a screen in time never reallocates the buffer.
+     *
+     *  The screen value at grid point (i,j) is at position (x0 + i*scale, x0 + j*scale), and the
+     *  values are given in the order of a numpy array of shape (npix, npix) indexed by [i,j].
+     *  This matches the convention of galsim.LookupTable2D.
+     */
+    class PhaseScreen
+    {
+    public:
+
+        /**
+         *  @brief Construct a screen from an array of npix x npix values.
+         *
+         *  @param[in] screen   The screen values, in row-major order.
+         *  @param[in] npix     The number of grid points along each side.
+         *  @param[in] scale    The spacing of the grid points.
+         *  @param[in] x0       The coordinate of the first grid point (in both x and y).
+         */
+        PhaseScreen(const double* screen, int npix, double scale, double x0);
+
+        /**
+         *  @brief Replace the screen values with new ones on the same grid.
+         */
+        void setScreen(const double* screen);
+
+        /**
+         *  @brief Copy the screen values (without the periodic padding) into an npix x npix
+         *  array.
+         */
+        void getScreen(double* screen) const;
+
+        int getNPix() const { return _npix; }
+        double getScale() const { return _scale; }
+        double getX0() const { return _x0; }
+
+        /**
+         *  @brief Evaluate the screen at the points (u[k] + dx, v[k] + dy).
+         *
+         *  @param[in] u, v     The pupil coordinates of the n points.
+         *  @param[in] n        The number of points.
+         *  @param[in] dx, dy   The offset of the pupil on the screen, which combines the
+         *                      motion of the screen with the wind and the field angle.
+         *  @param[out] out     The output array of n values.
+         *  @param[in] add      Whether to add to the values in out rather than overwrite them.
+         *                      [default: false]
+         */
+        void wavefront(const double* u, const double* v, int n, double dx, double dy,
+                       double* out, bool add=false) const;
+
+        /**
+         *  @brief The value of the screen at a single point (x,y).
+         */
+        double operator()(double x, double y) const;
+
+    private:
+
+        int _npix;
+        double _scale;
+        double _x0;
+        std::vector<double> _buf;   // (npix+1) x (npix+1) with the periodic padding.
+
+        // Wrap a coordinate into the fundamental period, returning the index of the grid
+        // point below it and the fractional distance to the next one.
+        void wrap(double x, int& i, double& f) const;
+    };
+
+    /**
+     *  @brief Evaluate the summed wavefront of several screens at several field angles.
+     *
+     *  For field angle k, out[k*n + p] is the sum over screens s of
+     *  screens[s](u[p] + offsets[2*(k*nscreen + s)], v[p] + offsets[2*(k*nscreen + s) + 1]).
+     *  The offsets thus give the position of the pupil on each screen for each field angle.
+     *
+     *  The work is split over field angles and blocks of points, which are done in parallel
+     *  if OpenMP is enabled.
+     */
+    void SumWavefronts(const std::vector<const PhaseScreen*>& screens,
+                       const double* u, const double* v, int n,
+                       const double* offsets, int nfield, double* out);
+
+    /**
+     *  @brief The Fourier transform of the complex pupil function of an aperture, which gives
+     *  the instantaneous PSF.
+     *
+     *  The illuminated pixels of the pupil are given by their indices in the (nrow x ncol) FFT
+     *  buffer.  These should already include the shift that puts the center of the pupil at
+     *  the origin of the buffer.  The FFTW plan is made once, when the object is constructed,
+     *  and is then shared by all the calls to accumulate().
+     */
+    class PupilFFT
+    {
+    public:
+
+        /**
+         *  @brief Construct the FFTW plan for a given pupil.
+         *
+         *  @param[in] nrow, ncol   The shape of the pupil plane array.
+         *  @param[in] index        The indices in the (row-major) pupil plane array of the
+         *                          illuminated pixels.
+         */
+        PupilFFT(int nrow, int ncol, const std::vector<int>& index);
+
+        ~PupilFFT();
+
+        int getNRow() const { return _nrow; }
+        int getNCol() const { return _ncol; }
+        int getNPoint() const { return _index.size(); }
+
+        /**
+         *  @brief Add the instantaneous PSFs for several wavefronts to a set of images.
+         *
+         *  For each k < nfield, the pupil function exp(2 pi i wf[k*npoint + p] / lam) is placed
+         *  at the illuminated pixels, and the squared modulus of its FFT is added to the
+         *  (nrow x ncol) image starting at images[k*nrow*ncol].  The images are left in FFT
+         *  order, with the center of the PSF at element 0.
+         *
+         *  The wavefronts are done in parallel if OpenMP is enabled, each thread using its own
+         *  buffer with the shared plan.
+         */
+        void accumulate(const double* wf, int nfield, double lam, double* images) const;
+
+    private:
+
+        int _nrow;
+        int _ncol;
+        std::vector<int> _index;
+        fftw_plan _plan;
+
+        // Disable copying
+        PupilFFT(const PupilFFT& );
+        void operator=(const PupilFFT& );
+    };
+
+}
+
+#endif
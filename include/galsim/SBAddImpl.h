@@ -78,6 +78,8 @@ namespace galsim {
         bool hasHardEdges() const { return _anyHardEdges; }
         bool isAnalyticX() const { return _allAnalyticX; }
         bool isAnalyticK() const { return _allAnalyticK; }
+        bool hasThreadSafeXValue() const;
+        void prepareDraw() const;
 
         Position<double> centroid() const
         { return Position<double>(_sumfx / _sumflux, _sumfy / _sumflux); }
@@ -162,7 +164,13 @@ namespace galsim {
         /// @brief Keeps track of the cumulated `isAnalyticK()` properties of all summands.
         bool _allAnalyticK;
 
+        /// @brief If all summands are convolutions with some factors in common, this is the
+        /// equivalent convolution of the sum of the rest with the common factors.
+        SBProfile _hoisted;
+        bool _useHoisted;
+
         void initialize();  ///< Sets all private book-keeping variables to starting state.
+        void hoistFactors();  ///< Sets up _hoisted if possible.
 
         // Copy constructor and op= are undefined.
         SBAddImpl(const SBAddImpl& rhs);
@@ -53,6 +53,14 @@ namespace galsim {
          */
         virtual double xValue(double r) const = 0;
 
+        /**
+         * @brief Batch version of xValue: f[i] = xValue(r[i]) for i = 0..n-1.
+         *
+         * This evaluates all the Bessel functions for the batch together, which is faster
+         * than calling xValue one radius at a time.
+         */
+        virtual void xValueMany(const double* r, double* f, int n) const = 0;
+
         /**
          * @brief Returns the k-space value of the Airy function.
          * @param[in] ksq_over_pisq should be given in units of lam_over_D
@@ -99,6 +107,7 @@ namespace galsim {
         ~AiryInfoObs() {}
 
         double xValue(double r) const;
+        void xValueMany(const double* r, double* f, int n) const;
         double kValue(double ksq_over_pisq) const;
 
     private:
@@ -129,6 +138,9 @@ namespace galsim {
              */
             double operator()(double radius) const;
 
+            /// @brief Batch version: f[i] = operator()(radius[i]) for i = 0..n-1.
+            void operator()(const double* radius, double* f, int n) const;
+
         private:
             double _obscuration; ///< Central obstruction size
             double _obssq; ///< _obscuration*_obscuration
@@ -165,6 +177,7 @@ namespace galsim {
         ~AiryInfoNoObs() {}
 
         double xValue(double r) const;
+        void xValueMany(const double* r, double* f, int n) const;
         double kValue(double ksq_over_pisq) const;
 
     private:
@@ -174,6 +187,7 @@ namespace galsim {
             RadialFunction(const GSParamsPtr& gsparams) : _gsparams(gsparams) {}
 
             double operator()(double radius) const;
+            void operator()(const double* radius, double* f, int n) const;
 
         private:
             const GSParamsPtr _gsparams;
@@ -38,6 +38,7 @@ namespace galsim {
         bool hasHardEdges() const { return true; }
         bool isAnalyticX() const { return true; }
         bool isAnalyticK() const { return true; }
+        bool hasThreadSafeXValue() const { return true; }
 
         double maxK() const;
         double stepK() const;
@@ -104,6 +105,7 @@ namespace galsim {
         bool hasHardEdges() const { return true; }
         bool isAnalyticX() const { return true; }
         bool isAnalyticK() const { return true; }
+        bool hasThreadSafeXValue() const { return true; }
 
         double maxK() const;
         double stepK() const;
@@ -95,6 +95,7 @@ namespace galsim {
     protected:
 
         class SBConvolveImpl;
+        friend class SBAdd;
 
     private:
         // op= is undefined
@@ -25,6 +25,18 @@
 
 namespace galsim {
 
+    // Defined in RealSpaceConvolve.cpp
+    // Fill val with the real-space convolution of p1 and p2 at the positions
+    //     x = x0 + ix dx + iy dxy
+    //     y = y0 + iy dy + ix dyx
+    // If parallel = true and GalSim was compiled with OpenMP, the columns of val are
+    // computed in separate threads.  This requires that p1 and p2 have thread-safe
+    // xValue functions.
+    void RealSpaceConvolve(
+        const SBProfile& p1, const SBProfile& p2, tmv::MatrixView<double> val,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParamsPtr& gsparams, bool parallel);
+
     class SBConvolve::SBConvolveImpl: public SBProfileImpl
     {
     public:
@@ -38,6 +50,9 @@ namespace galsim {
 
         void add(const SBProfile& rhs);
 
+        // Replace any Gaussian components with a single Gaussian of the combined covariance.
+        void combineGaussians();
+
         // Do the real-space convolution to calculate this.
         double xValue(const Position<double>& p) const;
 
@@ -47,6 +62,8 @@ namespace galsim {
         bool hasHardEdges() const { return false; }
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }    // convolvees must all meet this
+        bool hasThreadSafeXValue() const;
+        void prepareDraw() const;
         double maxK() const { return _minMaxK; }
         double stepK() const { return _netStepK; }
 
@@ -114,6 +131,12 @@ namespace galsim {
         boost::shared_ptr<PhotonArray> shoot(int N, UniformDeviate ud) const;
 
         // Overrides for better efficiency
+        void fillXValue(tmv::MatrixView<double> val,
+                        double x0, double dx, int izero,
+                        double y0, double dy, int jzero) const;
+        void fillXValue(tmv::MatrixView<double> val,
+                        double x0, double dx, double dxy,
+                        double y0, double dy, double dyx) const;
         void fillKValue(tmv::MatrixView<std::complex<double> > val,
                         double kx0, double dkx, int izero,
                         double ky0, double dky, int jzero) const;
@@ -127,6 +150,11 @@ namespace galsim {
         typedef std::list<SBProfile>::iterator Iter;
         typedef std::list<SBProfile>::const_iterator ConstIter;
 
+        // Get the covariance matrix and centroid of a (possibly transformed) Gaussian.
+        // Returns false if prof is not a Gaussian.
+        static bool GetGaussianMoments(const SBProfile& prof, double& cxx, double& cxy,
+                                       double& cyy, Position<double>& cen);
+
         std::list<SBProfile> _plist; ///< list of profiles to convolve
         double _x0; ///< Centroid position in x.
         double _y0; ///< Centroid position in y.
@@ -168,6 +196,7 @@ namespace galsim {
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }
         double maxK() const { return _adaptee.maxK(); }
+        void prepareDraw() const { _adaptee.prepareDraw(); }
         double stepK() const { return _adaptee.stepK() / sqrt(2.); }
 
         Position<double> centroid() const { return _adaptee.centroid() * 2.; }
@@ -224,6 +253,7 @@ namespace galsim {
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }
         double maxK() const { return _adaptee.maxK(); }
+        void prepareDraw() const { _adaptee.prepareDraw(); }
         double stepK() const { return _adaptee.stepK() / sqrt(2.); }
 
         Position<double> centroid() const { return Position<double>(0., 0.); }
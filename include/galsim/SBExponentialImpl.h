@@ -115,6 +115,7 @@ namespace galsim {
         bool hasHardEdges() const { return false; }
         bool isAnalyticX() const { return true; }
         bool isAnalyticK() const { return true; }
+        bool hasThreadSafeXValue() const { return true; }
 
         double maxK() const;
         double stepK() const;
@@ -39,6 +39,7 @@ namespace galsim {
         std::complex<double> kValue(const Position<double>& k) const;
 
         double maxK() const { return _adaptee.maxK(); }
+        void prepareDraw() const { _adaptee.prepareDraw(); }
         double stepK() const { return _adaptee.stepK() * sqrt(2.); }
 
         bool isAxisymmetric() const { return _adaptee.isAxisymmetric(); }
@@ -62,6 +62,7 @@ namespace galsim {
     protected:
 
         class SBGaussianImpl;
+        friend class SBConvolve;
 
     private:
         // op= is undefined
@@ -26,9 +26,49 @@
 #include "SBProfile.h"
 #include "Interpolant.h"
 #include "FFT.h"
+#include "Random.h"
 
 namespace galsim {
 
+    /**
+     * @brief Gaussian noise used to pad the image of an SBInterpolatedImage out to a larger size.
+     *
+     * The noise is either white noise with a given variance or correlated noise described by
+     * the square root of its power spectrum on the N x N grid of the padded image.  The latter
+     * is stored in the layout of a real-to-complex FFT (N rows of N/2+1 values, with the rows
+     * in the usual DFT order), which is the same as the output of numpy.fft.rfft2.  It is
+     * normally computed once in the python layer and then used for many profiles.
+     */
+    class NoisePad
+    {
+    public:
+        /// @brief White noise with the given variance.
+        NoisePad(double variance);
+
+        /// @brief Correlated noise with the given sqrt(power spectrum) on an N x N grid.
+        NoisePad(const double* rootps, int N);
+
+        /// @brief The size of the grid for correlated noise, or 0 for white noise.
+        int getN() const { return _N; }
+
+        /**
+         * @brief Fill the pixels of the N x N square of xtab centered at (0,0) that are not in
+         * hole with noise.
+         *
+         * The square runs from -N/2 to N-1-N/2 in each direction, which is the same way the
+         * image of an SBInterpolatedImage is placed in its XTable.  For white noise, only the
+         * pixels outside of hole are drawn.  For correlated noise, the full field needs to be
+         * made, and then only the part outside of hole is copied into xtab.  In this case,
+         * N must be equal to getN().
+         */
+        void fill(XTable& xtab, int N, const Bounds<int>& hole, BaseDeviate rng) const;
+
+    private:
+        double _variance;
+        int _N;
+        std::vector<double> _rootps;
+    };
+
     /**
      * @brief Surface Brightness Profile represented by interpolation over one or more data
      * tables/images.
@@ -96,6 +136,29 @@ namespace galsim {
             double pad_factor, double stepk, double maxk,
             const GSParamsPtr& gsparams);
 
+        /**
+         * @brief Same as the first constructor, but also pad the image with noise out to
+         * noise_pad_size x noise_pad_size pixels.
+         *
+         * The noise is drawn directly into the padded table, so the padded image never needs to
+         * be made separately.  The image is placed in the center of the noise, and getImage()
+         * returns the full noise-padded image.
+         *
+         * @param[in] noise_pad       The kind of noise to use for the padding.
+         * @param[in] noise_pad_size  The size of the square region to fill with noise.  If this
+         *                            is smaller than the image in either direction, no noise
+         *                            is added.
+         * @param[in] rng             The random number generator to use for the noise.
+         */
+        template <typename T>
+        SBInterpolatedImage(
+            const BaseImage<T>& image,
+            boost::shared_ptr<Interpolant> xInterp,
+            boost::shared_ptr<Interpolant> kInterp,
+            double pad_factor, double stepk, double maxk,
+            const GSParamsPtr& gsparams,
+            const NoisePad& noise_pad, int noise_pad_size, BaseDeviate rng);
+
         /// @brief Copy Constructor.
         SBInterpolatedImage(const SBInterpolatedImage& rhs);
 
@@ -133,6 +196,24 @@ namespace galsim {
         void operator=(const SBInterpolatedImage& rhs);
     };
 
+    /**
+     * @brief Set the maximum size in bytes of the cache of padded images and their Fourier
+     * transforms that is shared by all SBInterpolatedImages.
+     *
+     * SBInterpolatedImages made from identical pixel values with the same padding share a single
+     * padded XTable, and the KTable made from it is only computed once.  When the cache holds
+     * more than max_bytes, the least recently used entries are dropped from it.  (Profiles that
+     * are still using them keep them alive until they are destroyed.)  Setting max_bytes to 0
+     * empties the cache and turns it off.  The default size is 256 MB.
+     */
+    void SetInterpolatedImageCacheSize(size_t max_bytes);
+
+    /**
+     * @brief The number of bytes currently held in the cache of padded images and their Fourier
+     * transforms.
+     */
+    size_t GetInterpolatedImageCacheBytes();
+
     class SBInterpolatedKImage : public SBProfile
     {
     public:
@@ -26,6 +26,9 @@
 
 namespace galsim {
 
+    // An entry in the cache of padded images and their transforms.  (See SBInterpolatedImage.cpp)
+    class KTableCacheEntry;
+
     class SBInterpolatedImage::SBInterpolatedImageImpl : public SBProfile::SBProfileImpl
     {
     public:
@@ -35,7 +38,8 @@ namespace galsim {
             const BaseImage<T>& image,
             boost::shared_ptr<Interpolant2d> xInterp,
             boost::shared_ptr<Interpolant2d> kInterp,
-            double pad_factor, double stepk, double maxk, const GSParamsPtr& gsparams);
+            double pad_factor, double stepk, double maxk, const GSParamsPtr& gsparams,
+            const NoisePad* noise_pad=0, int noise_pad_size=0, BaseDeviate* rng=0);
 
         ~SBInterpolatedImageImpl();
 
@@ -60,6 +64,7 @@ namespace galsim {
 
         double maxK() const { return _maxk; }
         double stepK() const { return _stepk; }
+        void prepareDraw() const { getKTable(); }
         bool isAxisymmetric() const { return false; }
         // We'll use false here, but really, there's not an easy way to tell.
         // Certainly an Image _could_ have hard edges.
@@ -127,7 +132,7 @@ namespace galsim {
         boost::shared_ptr<Interpolant2d> _xInterp; ///< Interpolant used in real space.
         boost::shared_ptr<Interpolant2d> _kInterp; ///< Interpolant used in k space.
         boost::shared_ptr<XTable> _xtab; ///< Final padded real-space image.
-        mutable boost::shared_ptr<KTable> _ktab; ///< Final k-space image.
+        boost::shared_ptr<KTableCacheEntry> _cacheEntry; ///< Shared _xtab and k-space image.
         mutable double _stepk;
         mutable double _maxk;
         double _flux;
@@ -135,8 +140,9 @@ namespace galsim {
         double _maxk1; ///< maxk based just on the xInterp urange
         double _uscale; ///< conversion from k to u for xInterpolant
 
-        /// @brief Make ktab if necessary.
-        void checkK() const;
+        /// @brief Return the k-space image, making it if necessary.
+        const KTable& getKTable() const;
+        mutable const KTable* _ktab; ///< Set by getKTable once the table is built.
 
         /// @brief Set true if the data structures for photon-shooting are valid
         mutable bool _readyToShoot;
@@ -41,9 +41,11 @@ namespace galsim {
         bool hasHardEdges() const { return (1.-_fluxFactor) > this->gsparams->maxk_threshold; }
         bool isAnalyticX() const { return true; }
         bool isAnalyticK() const { return true; }  // 1d lookup table
+        bool hasThreadSafeXValue() const { return true; }
 
         double maxK() const;
         double stepK() const;
+        void prepareDraw() const { if (_trunc > 0.) setupFT(); }
 
         void getXRange(double& xmin, double& xmax, std::vector<double>& ) const
         { xmin = -_maxR; xmax = _maxR; }
@@ -182,6 +182,15 @@ namespace galsim {
         /// @brief Sampling in k-space necessary to avoid folding too much of image in x space.
         double stepK() const;
 
+        /**
+         * @brief Build any lookup tables that drawing would otherwise build on first use.
+         *
+         * Afterwards, draw and drawK do not modify the profile, so the same profile may be
+         * drawn from several threads at once.  (Photon shooting may still build samplers on
+         * first use.)
+         */
+        void prepareDraw() const;
+
         /**
          * @brief Determine a good size for a drawn image based on dx and stepK()
          *
@@ -97,6 +97,15 @@ namespace galsim {
 
         virtual double getNegativeFlux() const { return getFlux()>0. ? 0. : -getFlux(); }
 
+        // Build any tables that xValue and kValue would otherwise build lazily.  After this,
+        // drawing doesn't modify the profile, so it may be drawn from several threads at once.
+        // Compound profiles pass this on to their components.
+        virtual void prepareDraw() const {}
+
+        // Whether xValue may be called from several threads at once.  Profiles that lazily
+        // build tables or cache intermediate results in mutable members must not claim this.
+        virtual bool hasThreadSafeXValue() const { return false; }
+
         // Utility for drawing into Image data structures.
         // returns flux integral
         template <typename T>
@@ -140,6 +140,8 @@ namespace galsim {
 
         double maxK() const;
         double stepK() const;
+        // The SersicInfo builds its Fourier transform table the first time maxK is needed.
+        void prepareDraw() const { _info->maxK(); }
 
         void getXRange(double& xmin, double& xmax, std::vector<double>& splits) const
         {
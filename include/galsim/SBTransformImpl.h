@@ -42,6 +42,8 @@ namespace galsim {
         bool hasHardEdges() const { return _adaptee.hasHardEdges(); }
         bool isAnalyticX() const { return _adaptee.isAnalyticX(); }
         bool isAnalyticK() const { return _adaptee.isAnalyticK(); }
+        bool hasThreadSafeXValue() const { return GetImpl(_adaptee)->hasThreadSafeXValue(); }
+        void prepareDraw() const { _adaptee.prepareDraw(); }
 
         double maxK() const { return _maxk; }
         double stepK() const { return _stepk; }
@@ -84,8 +84,20 @@ namespace galsim {
         template<class InputIterator>
         ArgVec(InputIterator first, InputIterator last) : vec(first, last), isReady(false) {}
 
+        /// Check the arguments and note whether they are equally spaced.  This is done
+        /// automatically by the first lookup if necessary, but after calling it, lookups
+        /// don't modify the ArgVec, so it may then be used from several threads at once.
+        void setup() const;
+
         int upperIndex(const A a) const;
 
+        /// The same, but start the search at hint (e.g. the result of the previous lookup),
+        /// and update hint to the result.
+        int upperIndex(const A a, int& hint) const;
+
+        /// Find upperIndex for each of the N values in a.
+        void upperIndexMany(const A* a, int* indices, int N) const;
+
         // pass through a few std::vector methods.
         typename std::vector<A>::iterator begin() {return vec.begin();}
         typename std::vector<A>::iterator end() {return vec.end();}
@@ -105,8 +117,6 @@ namespace galsim {
         mutable A lower_slop, upper_slop;
         mutable bool equalSpaced;
         mutable A da;
-        mutable int lastIndex;
-        void setup() const;
     };
 
     /**
@@ -127,9 +137,11 @@ namespace galsim {
 
         /// Table from args, vals
         Table(const A* _args, const V* _vals, int N, interpolant in) :
-                iType(in), args(_args, _args+N), vals(_vals, _vals+N), isReady(false) {}
+                iType(in), args(_args, _args+N), vals(_vals, _vals+N), isReady(false)
+        { setup(); }
         Table(const std::vector<A>& _args, const std::vector<V>& _vals, interpolant in) :
-                iType(in), args(_args), vals(_vals), isReady(false) {}
+                iType(in), args(_args), vals(_vals), isReady(false)
+        { setup(); }
         /// Empty Table
         Table(interpolant in) : iType(in), isReady(false) {}
 
@@ -144,6 +156,11 @@ namespace galsim {
         /// Insert an (x, y(x)) pair into the table.
         void addEntry(const A arg, const V val);
 
+        /// Finish setting up the table (e.g. the spline coefficients) after the last addEntry.
+        /// This is done automatically by the first lookup if necessary, but after calling it,
+        /// lookups don't modify the table, so it may then be used from several threads at once.
+        void setup() const;
+
         /// interp, return V(0) if beyond bounds
         V operator()(const A a) const;
 
@@ -174,7 +191,6 @@ namespace galsim {
         V nearestInterpolate(const A a, int i) const;
         V splineInterpolate(const A a, int i) const;
 
-        void setup() const;
         void setupSpline() const;
     };
 
@@ -203,6 +219,11 @@ namespace galsim {
     /**
      * @brief A class to represent lookup tables for a function z = f(x, y).
      *
+     * The spline interpolant is a bicubic Hermite interpolation, where the derivatives at each
+     * grid point are estimated from the neighboring grid points (one-sided at the edges).  On
+     * an equally spaced grid, this is the same as Catmull-Rom interpolation.  It requires at
+     * least 4 points along each axis.
+     *
      * A is the type of the argument of the function.
      * V is the type of the value of the function.
      *
@@ -214,7 +235,7 @@ namespace galsim {
     class Table2D
     {
     public:
-        enum interpolant { linear, floor, ceil, nearest };
+        enum interpolant { linear, floor, ceil, nearest, spline };
 
         /// Table from xargs, yargs, vals
         Table2D(const A* _xargs, const A* _yargs, const V* _vals, int Nx, int Ny, interpolant in);
@@ -245,12 +266,18 @@ namespace galsim {
         const ArgVec<A> yargs;
         const std::vector<V> vals;
 
-        typedef V (Table2D<V,A>::*Table2DMemFn)(const A x, const A y, int i, int j) const;
-        Table2DMemFn interpolate;
-        V linearInterpolate(const A x, const A y, int i, int j) const;
-        V floorInterpolate(const A x, const A y, int i, int j) const;
-        V ceilInterpolate(const A x, const A y, int i, int j) const;
-        V nearestInterpolate(const A x, const A y, int i, int j) const;
+        // The interpolation is separable, so the work along each axis is done first for all
+        // the x and y values.  For each value, this finds the first index k of the table
+        // entries to use along that axis and the weights to give to them.  Linear uses
+        // 2 entries, spline uses 4, and the others use just the one entry k.
+        int nWeights() const { return iType == linear ? 2 : iType == spline ? 4 : 0; }
+        void axisWeights(const ArgVec<A>& args, const A* a, int n, int* k, A* w) const;
+
+        // Evaluate the interpolation for n points given the results of axisWeights along
+        // each axis.  For interpMany, the x and y values are paired (xstep = 1).  For
+        // interpManyMesh, there is one x value for all of the y values (xstep = 0).
+        void interpWeights(const int* kx, const A* wx, int xstep,
+                           const int* ky, const A* wy, V* valvec, int n) const;
     };
 }
 
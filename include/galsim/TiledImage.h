@@ -0,0 +1,253 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_TiledImage_H
+#define GalSim_TiledImage_H
+
+#include <vector>
+#include "Image.h"
+
+namespace galsim {
+
+    /**
+     *  @brief An image whose pixels are stored in square tiles rather than in rows.
+     *
+     *  Each tile of tileSize x tileSize pixels is contiguous in memory, and the tiles are
+     *  stored in row-major order.  The tiles along the right and top edges are stored at full
+     *  size, so every tile has the same stride; the extra pixels there are never seen through
+     *  the public interface.
+     *
+     *  This layout is useful for building a very large image from many small stamps.  With a
+     *  normal row-major image, each row of a stamp lies on a different memory page, so adding
+     *  a stamp touches nearly as many pages as it has rows.  In a TiledImage, a stamp that is
+     *  not much larger than a tile touches only a few tiles, each of which is a single
+     *  contiguous block.
+     *
+     *  A TiledImage is assignable to an ImageView, which copies the pixels into normal
+     *  row-major order, one tile at a time:
+     *
+     *      TiledImage<float> tiled(bounds);
+     *      tiled += stamp1;
+     *      tiled += stamp2;
+     *      ...
+     *      ImageAlloc<float> image(bounds);
+     *      image = tiled;
+     */
+    template <typename T>
+    class TiledImage : public AssignableToImage<T>
+    {
+    public:
+
+        /**
+         *  @brief Create a new tiled image with the given bounds, initialized to init_value.
+         */
+        TiledImage(const Bounds<int>& bounds, int tileSize=64, T init_value=T(0));
+
+        /**
+         *  @brief Create a new tiled image with a copy of the pixel values of an image.
+         */
+        TiledImage(const BaseImage<T>& image, int tileSize=64);
+
+        /**
+         *  @brief Destructor
+         */
+        ~TiledImage() {}
+
+        /**
+         *  @brief The width of the (square) tiles.
+         */
+        int getTileSize() const { return _tileSize; }
+
+        /**
+         *  @brief The number of tiles in the x and y directions.
+         */
+        int getNTilesX() const { return _ntx; }
+        int getNTilesY() const { return _nty; }
+
+        /**
+         *  @brief The bounds of the pixels in tile (i,j).
+         *
+         *  These are the bounds of the part of the tile that is inside the image, so they
+         *  are smaller than tileSize x tileSize for the tiles along the right and top edges.
+         */
+        Bounds<int> getTileBounds(int i, int j) const;
+
+        /**
+         *  @brief A pointer to the first pixel of tile (i,j).
+         *
+         *  Pixel (x,y) of the tile is at getTileData(i,j)[x + y * getTileSize()], where x and y
+         *  are measured from the lower left corner of the tile.
+         */
+        T* getTileData(int i, int j)
+        { return &_data[(size_t(j) * _ntx + i) * _tileArea]; }
+        const T* getTileData(int i, int j) const
+        { return &_data[(size_t(j) * _ntx + i) * _tileArea]; }
+
+        /**
+         *  @brief Unchecked access to the pixel at (x,y).
+         */
+        T& operator()(int x, int y) { return _data[index(x,y)]; }
+        const T& operator()(int x, int y) const { return _data[index(x,y)]; }
+
+        /**
+         *  @brief Element access with bounds checking.
+         */
+        T& at(int x, int y);
+        const T& at(int x, int y) const;
+
+        /**
+         *  @brief Set the pixel at (x,y), with bounds checking.
+         */
+        void setValue(int x, int y, T value) { at(x,y) = value; }
+
+        /**
+         *  @brief Set all pixel values to the given value.
+         */
+        void fill(T x) { std::fill(_data.begin(), _data.end(), x); }
+
+        /**
+         *  @brief Set all pixel values to zero.
+         */
+        void setZero() { fill(T(0)); }
+
+        /**
+         *  @brief Add the pixel values of an image to the corresponding pixels of this one.
+         *
+         *  Only the part of the image that overlaps the bounds of the tiled image is added.
+         */
+        void addImage(const BaseImage<T>& image);
+
+        /**
+         *  @brief Copy the pixel values of an image into the corresponding pixels of this one.
+         *
+         *  Only the part of the image that overlaps the bounds of the tiled image is copied.
+         */
+        void copyFrom(const BaseImage<T>& image);
+
+        /**
+         *  @brief Copy the pixel values into normal row-major order in an ImageView.
+         *
+         *  The bounds of the ImageView must match the bounds of the tiled image.
+         */
+        void assignTo(const ImageView<T>& rhs) const;
+
+        /**
+         *  @brief Call a unary function on each pixel value.
+         */
+        template <typename Op>
+        Op forEachPixel(Op f) const;
+
+        /**
+         *  @brief Replace each pixel value with a function of its value.
+         */
+        template <typename Op>
+        Op transformPixel(Op f);
+
+        /**
+         *  @brief The sum of all the pixel values.
+         */
+        T sumElements() const;
+
+    private:
+
+        int _tileSize;
+        int _tileArea;
+        int _ntx;
+        int _nty;
+        std::vector<T> _data;
+
+        void allocate(int tileSize);
+
+        size_t index(int x, int y) const
+        {
+            x -= this->_bounds.getXMin();
+            y -= this->_bounds.getYMin();
+            int i = x / _tileSize;
+            int j = y / _tileSize;
+            return (size_t(j) * _ntx + i) * _tileArea +
+                (y - j * _tileSize) * _tileSize + (x - i * _tileSize);
+        }
+
+        // Apply op(tile_row, image_row, n) to each row segment of the overlap of the image
+        // with this one, going through the tiles in memory order.
+        template <typename Op>
+        void forEachOverlapRow(const BaseImage<T>& image, Op op);
+    };
+
+    template <typename T> template <typename Op>
+    Op TiledImage<T>::forEachPixel(Op f) const
+    {
+        // Skip the parts of the edge tiles that are outside the image.
+        for (int j = 0; j < _nty; ++j) {
+            for (int i = 0; i < _ntx; ++i) {
+                Bounds<int> b = getTileBounds(i,j);
+                const int nx = b.getXMax() - b.getXMin() + 1;
+                const int ny = b.getYMax() - b.getYMin() + 1;
+                const T* ptr = getTileData(i,j);
+                if (nx == _tileSize) {
+                    f = std::for_each(ptr, ptr + ny * _tileSize, f);
+                } else {
+                    for (int y = 0; y < ny; ++y, ptr += _tileSize)
+                        f = std::for_each(ptr, ptr + nx, f);
+                }
+            }
+        }
+        return f;
+    }
+
+    template <typename T> template <typename Op>
+    Op TiledImage<T>::transformPixel(Op f)
+    {
+        // The unused pixels in the edge tiles are never seen, so it is fine to transform
+        // them along with everything else.  This keeps the loop over one contiguous array.
+        typedef typename std::vector<T>::iterator Iter;
+        const Iter ee = _data.end();
+        for (Iter it = _data.begin(); it != ee; ++it) *it = T(f(*it));
+        return f;
+    }
+
+    /**
+     *  @brief Add an image to the overlapping part of a TiledImage.
+     */
+    template <typename T>
+    inline TiledImage<T>& operator+=(TiledImage<T>& im, const BaseImage<T>& x)
+    { im.addImage(x); return im; }
+
+    /**
+     *  @brief Arithmetic with a scalar, applied to every pixel of a TiledImage.
+     */
+    template <typename T>
+    inline TiledImage<T>& operator+=(TiledImage<T>& im, T x)
+    { im.transformPixel(bind2nd(std::plus<T>(),x)); return im; }
+
+    template <typename T>
+    inline TiledImage<T>& operator-=(TiledImage<T>& im, T x)
+    { im.transformPixel(bind2nd(std::minus<T>(),x)); return im; }
+
+    template <typename T>
+    inline TiledImage<T>& operator*=(TiledImage<T>& im, T x)
+    { im.transformPixel(bind2nd(std::multiplies<T>(),x)); return im; }
+
+    template <typename T>
+    inline TiledImage<T>& operator/=(TiledImage<T>& im, T x)
+    { im.transformPixel(bind2nd(std::divides<T>(),x)); return im; }
+
+} // namespace galsim
+
+#endif
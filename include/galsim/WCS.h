@@ -0,0 +1,137 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_WCS_H
+#define GalSim_WCS_H
+
+/**
+ *  @file WCS.h
+ *  @brief The transformations between image and celestial coordinates used by GSFitsWCS.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace galsim {
+
+    /**
+     *  @brief Exception class thrown when a WCS transformation fails.
+     */
+    class WCSError : public std::runtime_error {
+    public:
+        WCSError(const std::string& m) : std::runtime_error(m) {}
+    };
+
+    /**
+     *  @brief The FITS WCS transformation from image coordinates to celestial coordinates
+     *  and back.
+     *
+     *  The transformation from image position (x,y) to (ra,dec) is done in the usual FITS
+     *  steps:
+     *
+     *  1. Subtract crpix, and (for TAN-SIP) add the SIP distortion polynomials A and B.
+     *  2. Multiply by the CD matrix to get the intermediate world coordinates (u,v) in degrees.
+     *  3. (For TPV and TNX) apply the 3rd order PV distortion polynomials to (u,v).
+     *  4. Deproject (u,v) from the tangent plane onto the sphere at (ra0,dec0), using one
+     *     of the projections available for CelestialCoord.deproject.
+     *
+     *  All the functions work on arrays of n positions at a time.  The inverse transformation
+     *  solves for (x,y) by Newton-Raphson iteration of each of the polynomial steps, starting
+     *  from the AP and BP polynomials for TAN-SIP if they are given.  The positions are done in
+     *  parallel if OpenMP is enabled.
+     *
+     *  The polynomials are given as coefficient arrays in row-major order, so the coefficient
+     *  of x^i y^j in A is ab[i*(order+1)+j], and the coefficient for B follows all the ones for
+     *  A.  Likewise, the coefficient of u^i v^j in the PV polynomial for the first axis is
+     *  pv[i*4+j], and the ones for the second axis are at pv[16+i*4+j].  This is the order of
+     *  the numpy arrays GSFitsWCS.ab and GSFitsWCS.pv.
+     */
+    class FitsWCSTransform
+    {
+    public:
+
+        enum Projection { Gnomonic, Stereographic, Lambert, Postel };
+
+        /**
+         *  @brief Construct the transformation.
+         *
+         *  @param[in] proj         The projection of the tangent plane onto the sphere.
+         *  @param[in] ra0, dec0    The tangent point (in radians).
+         *  @param[in] crpix        The image position of the tangent point (2 values).
+         *  @param[in] cd           The CD matrix in degrees per pixel (4 values, row-major).
+         *  @param[in] pv           The PV distortion coefficients (32 values), or null.
+         *  @param[in] abOrder      The order of the SIP A and B polynomials.
+         *  @param[in] ab           The A and B coefficients (2*(abOrder+1)^2 values), or null.
+         *  @param[in] abpOrder     The order of the SIP AP and BP polynomials.
+         *  @param[in] abp          The AP and BP coefficients, or null.
+         */
+        FitsWCSTransform(Projection proj, double ra0, double dec0,
+                         const double* crpix, const double* cd, const double* pv,
+                         int abOrder, const double* ab, int abpOrder, const double* abp);
+
+        /**
+         *  @brief Convert the n image positions (x[k], y[k]) to (ra[k], dec[k]) in radians.
+         */
+        void toWorld(const double* x, const double* y, int n, double* ra, double* dec) const;
+
+        /**
+         *  @brief Convert the n celestial positions (ra[k], dec[k]) in radians to image
+         *  positions (x[k], y[k]).
+         *
+         *  A WCSError is thrown if the iteration fails to converge for any of them.
+         */
+        void toImage(const double* ra, const double* dec, int n, double* x, double* y) const;
+
+        /**
+         *  @brief Calculate the local jacobian at the n image positions (x[k], y[k]).
+         *
+         *  The jacobian is given in arcsec per pixel, in the local (u,v) coordinates with +u
+         *  pointing west and +v pointing north.  The elements dudx, dudy, dvdx, dvdy for
+         *  position k are written to jac[4*k] ... jac[4*k+3].
+         */
+        void jacobian(const double* x, const double* y, int n, double* jac) const;
+
+    private:
+
+        Projection _proj;
+        double _ra0;
+        double _sindec0;
+        double _cosdec0;
+        double _crpix[2];
+        double _cd[4];
+        double _cdinv[4];
+        std::vector<double> _pv;
+        int _abOrder;
+        std::vector<double> _ab;
+        int _abpOrder;
+        std::vector<double> _abp;
+
+        // The individual steps for one position.  toImage1 returns 0 on success, or an error
+        // code if the iteration fails.
+        void toWorld1(double x, double y, double& ra, double& dec) const;
+        int toImage1(double ra, double dec, double& x, double& y) const;
+        void jacobian1(double x, double y, double* jac) const;
+        void project(double ra, double dec, double& u, double& v) const;
+        void deproject(double u, double v, double& ra, double& dec) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#ifndef GalSim_BesselJ_H
+#define GalSim_BesselJ_H
+/**
+ * @file bessel/BesselJ.h
+ * @brief Scalar and batch versions of the cylindrical Bessel functions J0(x) and J1(x)
+ *
+ * These are used in the inner loops of the Hankel transforms (Sersic, Moffat, Kolmogorov)
+ * and the Airy profile, where the integrator or the image fill already knows a whole
+ * set of abscissae at once.  The batch versions evaluate the same Chebyshev expansions as
+ * the scalar versions, but over contiguous arrays with the expansions inlined into the loop,
+ * rather than making a separate library call for each value.
+ *
+ * For |x| <= 8, J0 and J1/x are expanded in Chebyshev polynomials of x^2.  For |x| > 8,
+ * the usual Hankel asymptotic form is used:
+ *
+ *     Jn(x) = sqrt(2/(pi x)) [ Pn(x) cos(chi) - Qn(x) sin(chi) ],  chi = x - (2n+1) pi/4
+ *
+ * with Pn and x Qn expanded in Chebyshev polynomials of (8/x)^2.  The absolute error is
+ * below 3.e-15 everywhere.  It is largest for J1 just below x = 8 (about 2.8e-15), where the
+ * rounding error of the expansion of J1/x is multiplied by x.  So these are effectively exact
+ * for our purposes.
+ */
+
+namespace galsim {
+namespace bessel {
+
+    /// Calculate J0(x)
+    double BesselJ0(double x);
+
+    /// Calculate J1(x)
+    double BesselJ1(double x);
+
+    /// Calculate f[i] = J0(x[i]) for i = 0..n-1.
+    void BesselJ0Many(const double* x, double* f, int n);
+
+    /// Calculate f[i] = J1(x[i]) for i = 0..n-1.
+    void BesselJ1Many(const double* x, double* f, int n);
+
+}}
+
+#endif
@@ -193,6 +193,33 @@ namespace integ {
     int nfeval = 0;  ///< If COUNTFEVAL is defined, this counts the number of function evaluations
 #endif
 
+    /**
+     * @brief Evaluate a function at several points at once.
+     *
+     * The GKP integrators below use this to evaluate the integrand at all of the new
+     * abscissae of each level of the rule together, rather than one point at a time.
+     * The default implementation simply calls func(x[i]) for each point.  Integrands
+     * that can be computed more efficiently in bulk (e.g. ones that need a Bessel function
+     * at every point) may specialize this struct for their functor type:
+     *
+     *     namespace integ {
+     *         template <>
+     *         struct BatchEval<MyIntegrand>
+     *         {
+     *             static void eval(const MyIntegrand& func, const double* x, double* f, int n)
+     *             { ... }
+     *         };
+     *     }
+     */
+    template <class UF>
+    struct BatchEval
+    {
+        typedef typename UF::argument_type A;
+        typedef typename UF::result_type T;
+        static void eval(const UF& func, const A* x, T* f, int n)
+        { for (int i=0; i<n; ++i) f[i] = func(x[i]); }
+    };
+
     /**
      * @brief A type that encapsulates everything known about the integral in a region.
      *
@@ -453,12 +480,9 @@ namespace integ {
             const T half_length =  0.5 * (b - a);
             const T abs_half_length = std::abs(half_length);
             const T center = 0.5 * (b + a);
-            const T f_center = func(center);
-            if (reg.fxmap) (*reg.fxmap)[center] = f_center;
-#ifdef COUNTFEVAL
-            nfeval++;
-#endif
-            const int nmax = 2*gkp_x<T>(NGKPLEVELS-1).size()-1;
+
+            const int nlast = gkp_x<T>(NGKPLEVELS-1).size();
+            const int nmax = 2*nlast-1;
             std::vector<T> fv1(nmax), fv2(nmax);
 
             fv1.clear();
@@ -468,25 +492,39 @@ namespace integ {
             assert(int(fv1.capacity()) == nmax);
             assert(int(fv2.capacity()) == nmax);
 
+            // The new abscissae at each level are evaluated together with BatchEval.
+            // The last level has the most new points.  Level 0 also includes the center.
+            // Within each batch, center - abscissa and center + abscissa are adjacent.
+            assert(int(gkp_x<T>(0).size()) < nlast);
+            std::vector<T> xbatch(2*nlast), fbatch(2*nlast);
+
             assert(gkp_wb<T>(0).size() == gkp_x<T>(0).size()+1);
-            T area1 = gkp_wb<T>(0).back() * f_center;
             int n0 = gkp_x<T>(0).size();
+            xbatch[0] = center;
             for (int k=0; k<n0; k++) {
                 const T abscissa = half_length * gkp_x<T>(0)[k];
-                const T fval1 = func(center - abscissa);
-                const T fval2 = func(center + abscissa);
+                xbatch[2*k+1] = center - abscissa;
+                xbatch[2*k+2] = center + abscissa;
+            }
+            BatchEval<UF>::eval(func, &xbatch[0], &fbatch[0], 2*n0+1);
+#ifdef COUNTFEVAL
+            nfeval+=gkp_x<T>(0).size()*2+1;
+#endif
+            const T f_center = fbatch[0];
+            if (reg.fxmap) (*reg.fxmap)[center] = f_center;
+            T area1 = gkp_wb<T>(0).back() * f_center;
+            for (int k=0; k<n0; k++) {
+                const T fval1 = fbatch[2*k+1];
+                const T fval2 = fbatch[2*k+2];
                 area1 += gkp_wb<T>(0)[k] * (fval1+fval2);
                 fv1.push_back(fval1);
                 fv2.push_back(fval2);
                 if (reg.fxmap) {
-                    (*reg.fxmap)[center-abscissa] = fval1;
-                    (*reg.fxmap)[center+abscissa] = fval2;
+                    (*reg.fxmap)[xbatch[2*k+1]] = fval1;
+                    (*reg.fxmap)[xbatch[2*k+2]] = fval2;
                 }
             }
             area1 *= half_length;
-#ifdef COUNTFEVAL
-            nfeval+=gkp_x<T>(0).size()*2;
-#endif
 
             integ_dbg2<<"level 0 rule: area = "<<area1<<std::endl;
 
@@ -509,8 +547,13 @@ namespace integ {
                 int nl = gkp_x<T>(level).size();
                 for (int k=0; k<nl; k++) {
                     const T abscissa = half_length * gkp_x<T>(level)[k];
-                    const T fval1 = func(center - abscissa);
-                    const T fval2 = func(center + abscissa);
+                    xbatch[2*k] = center - abscissa;
+                    xbatch[2*k+1] = center + abscissa;
+                }
+                BatchEval<UF>::eval(func, &xbatch[0], &fbatch[0], 2*nl);
+                for (int k=0; k<nl; k++) {
+                    const T fval1 = fbatch[2*k];
+                    const T fval2 = fbatch[2*k+1];
                     const T fval = fval1 + fval2;
                     area2 += gkp_wb<T>(level)[k] * fval;
                     if (calc_int_abs) 
@@ -518,8 +561,8 @@ namespace integ {
                     fv1.push_back(fval1);
                     fv2.push_back(fval2);
                     if (reg.fxmap) {
-                        (*reg.fxmap)[center-abscissa] = fval1;
-                        (*reg.fxmap)[center+abscissa] = fval2;
+                        (*reg.fxmap)[xbatch[2*k]] = fval1;
+                        (*reg.fxmap)[xbatch[2*k+1]] = fval2;
                     }
                 }
 #ifdef COUNTFEVAL
@@ -755,6 +798,7 @@ namespace integ {
             typename UF::result_type operator()(
                 typename UF::argument_type x) const 
             { return f(1./x-1.)/(x*x); }
+            const UF& getFunc() const { return f; }
         private:
             const UF& f;
         };
@@ -773,6 +817,7 @@ namespace integ {
             typename UF::result_type operator()(
                 typename UF::argument_type x) const 
             { return f(1./x+1.)/(x*x); }
+            const UF& getFunc() const { return f; }
         private:
             const UF& f;
         };
@@ -782,6 +827,36 @@ namespace integ {
         { return AuxFunc2<UF>(uf); }
     } // anonymous namespace
 
+    // Pass batches through the change of variables for infinite regions, so the
+    // underlying function still gets evaluated in bulk.
+    template <class UF>
+    struct BatchEval<AuxFunc1<UF> >
+    {
+        typedef typename UF::argument_type A;
+        typedef typename UF::result_type T;
+        static void eval(const AuxFunc1<UF>& func, const A* x, T* f, int n)
+        {
+            std::vector<A> y(n);
+            for (int i=0; i<n; ++i) y[i] = 1./x[i]-1.;
+            BatchEval<UF>::eval(func.getFunc(), &y[0], f, n);
+            for (int i=0; i<n; ++i) f[i] /= x[i]*x[i];
+        }
+    };
+
+    template <class UF>
+    struct BatchEval<AuxFunc2<UF> >
+    {
+        typedef typename UF::argument_type A;
+        typedef typename UF::result_type T;
+        static void eval(const AuxFunc2<UF>& func, const A* x, T* f, int n)
+        {
+            std::vector<A> y(n);
+            for (int i=0; i<n; ++i) y[i] = 1./x[i]+1.;
+            BatchEval<UF>::eval(func.getFunc(), &y[0], f, n);
+            for (int i=0; i<n; ++i) f[i] /= x[i]*x[i];
+        }
+    };
+
     /// Perform a 1-dimensional integral using an IntRegion
     template <class UF> 
     inline typename UF::result_type int1d(
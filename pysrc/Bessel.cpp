@@ -22,6 +22,7 @@
 #define BOOST_NO_CXX11_SMART_PTR
 #include "boost/python.hpp"
 #include "bessel/Roots.h"
+#include "bessel/BesselJ.h"
 #include <boost/math/special_functions/bessel.hpp>
 
 namespace bp = boost::python;
@@ -47,9 +48,9 @@ namespace bessel {
 
         bp::def("j0_root", &getBesselRoot0, bp::args("s"),
                 "Get the sth root of the n=0 Bessel function, J_0(x)");
-        bp::def("j0", &j0, bp::args("x"),
+        bp::def("j0", &BesselJ0, bp::args("x"),
                 "Calculate the n=0 cylindrical Bessel function, J_0(x)");
-        bp::def("j1", &j1, bp::args("x"),
+        bp::def("j1", &BesselJ1, bp::args("x"),
                 "Calculate the n=1 cylindrical Bessel function, J_1(x)");
         bp::def("jn", &BesselJn, bp::args("n","x"),
                 "Calculate the arbitrary n cylindrical Bessel function, J_n(x)");
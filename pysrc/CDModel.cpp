@@ -30,14 +30,26 @@ namespace galsim {
     struct PyCDModels
     {
 
+        // Return a view of the result, which shares ownership of the ImageAlloc's memory,
+        // so the python object uses it directly rather than making a copy of it.
+        template <typename U>
+        static ImageView<U> ApplyCDView(
+            const BaseImage<U>& image, ConstImageView<double> aL, ConstImageView<double> aR,
+            ConstImageView<double> aB, ConstImageView<double> aT,
+            const int dmax, const double gain_ratio)
+        {
+            ImageAlloc<U> result = ApplyCD(image, aL, aR, aB, aT, dmax, gain_ratio);
+            return result.view();
+        }
+
         template <typename U>
         static void wrapTemplates() {
 
-            typedef ImageAlloc<U> (*ApplyCD_func)(const BaseImage<U>&, ConstImageView<double>,
+            typedef ImageView<U> (*ApplyCD_func)(const BaseImage<U>&, ConstImageView<double>,
                 ConstImageView<double>, ConstImageView<double>, ConstImageView<double>,
                 const int, const double);
             bp::def("_ApplyCD",
-                ApplyCD_func(&ApplyCD),
+                ApplyCD_func(&ApplyCDView),
                 (bp::arg("image"), bp::arg("aL"), bp::arg("aR"), bp::arg("aB"), bp::arg("aT"),
                 bp::arg("dmax"), bp::arg("gain_ratio")),
                 "Apply an Antilogus et al (2014) charge deflection model to an image.");
@@ -21,6 +21,7 @@
 
 #define BOOST_NO_CXX11_SMART_PTR
 #include "boost/python.hpp"
+#include "NumpyHelper.h"
 #include "Interpolant.h"
 #include "CorrelatedNoise.h"
 
@@ -31,11 +32,52 @@ namespace galsim {
     struct PyCorrelationFunctions
     {
 
+        // Return a view of the result, which shares ownership of the ImageAlloc's memory,
+        // so the python object uses it directly rather than making a copy of it.
+        static ImageView<double> CalculateCovarianceMatrixView(
+            const SBProfile& sbp, const Bounds<int>& bounds, double dx)
+        {
+            ImageAlloc<double> result = calculateCovarianceMatrix(sbp, bounds, dx);
+            return result.view();
+        }
+
+        static void AddNoiseFromRootPS(
+            const ImageView<double>& image, const bp::object& rootps, BaseDeviate rng)
+        {
+            const Bounds<int>& b = image.getBounds();
+            const int nx = b.getXMax() - b.getXMin() + 1;
+            const int ny = b.getYMax() - b.getYMin() + 1;
+            if (GetNumpyArrayDim(rootps.ptr(), 0) != ny ||
+                GetNumpyArrayDim(rootps.ptr(), 1) != nx/2+1) {
+                PyErr_SetString(PyExc_ValueError, "rootps must have shape (ny, nx//2+1)");
+                bp::throw_error_already_set();
+            }
+            addNoiseFromRootPS(image, GetNumpyArrayData<double>(rootps.ptr()), rng);
+        }
+
+        static void AddTiledNoiseFromRootPS(
+            const ImageView<double>& image, const bp::object& rootps, int knx, int fft_size,
+            BaseDeviate rng)
+        {
+            const int kny = GetNumpyArrayDim(rootps.ptr(), 0);
+            if (GetNumpyArrayDim(rootps.ptr(), 1) != knx/2+1) {
+                PyErr_SetString(PyExc_ValueError, "rootps must have shape (kny, knx//2+1)");
+                bp::throw_error_already_set();
+            }
+            addTiledNoiseFromRootPS(image, GetNumpyArrayData<double>(rootps.ptr()), kny, knx,
+                                    fft_size, rng);
+        }
+
         static void wrap() {
             bp::def("_calculateCovarianceMatrix",
-                calculateCovarianceMatrix, 
+                &CalculateCovarianceMatrixView, 
                 (bp::arg("sbprofile"), bp::arg("bounds"), bp::arg("dx"))
             );
+            bp::def("_addNoiseFromRootPS", &AddNoiseFromRootPS,
+                    (bp::arg("image"), bp::arg("rootps"), bp::arg("rng")));
+            bp::def("_addTiledNoiseFromRootPS", &AddTiledNoiseFromRootPS,
+                    (bp::arg("image"), bp::arg("rootps"), bp::arg("knx"), bp::arg("fft_size"),
+                     bp::arg("rng")));
         }
 
     };
@@ -0,0 +1,80 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#include "galsim/IgnoreWarnings.h"
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include "boost/python.hpp"
+#include "NumpyHelper.h"
+#include "FitsIO.h"
+
+namespace bp = boost::python;
+
+namespace galsim {
+
+    template <typename T>
+    struct PyFitsIO
+    {
+        static bp::object wrapFitsWriter(const std::string& suffix)
+        {
+            bp::class_< FitsWriter<T>, boost::noncopyable >
+                pyFitsWriter(("FitsWriter" + suffix).c_str(), "", bp::no_init);
+            pyFitsWriter
+                .def(bp::init<const std::string&, const Bounds<int>&, const std::string&,
+                     const std::string&>(
+                         (bp::arg("file_name"), bp::arg("bounds"), bp::arg("cards")="",
+                          bp::arg("compression")="none")))
+                .def("write", &FitsWriter<T>::write, bp::args("rows"))
+                .def("close", &FitsWriter<T>::close)
+                .add_property("next_row", &FitsWriter<T>::getNextRow)
+                ;
+            return pyFitsWriter;
+        }
+
+        static void wrapFunctions()
+        {
+            bp::def("_WriteFitsImage", &WriteFitsImage<T>,
+                    (bp::arg("image"), bp::arg("file_name"), bp::arg("cards")="",
+                     bp::arg("compression")="none"),
+                    "Write an image to a FITS file");
+            bp::def("_ReadFitsImage", &ReadFitsImage<T>,
+                    (bp::arg("image"), bp::arg("file_name"), bp::arg("hdu")=0),
+                    "Read part of an image from a FITS file");
+        }
+    };
+
+    void pyExportFitsIO()
+    {
+        bp::dict pyFitsWriterDict;  // dict that lets us say "FitsWriter[numpy.float32]", etc.
+
+        pyFitsWriterDict[GetNumPyType<int16_t>()] = PyFitsIO<int16_t>::wrapFitsWriter("S");
+        pyFitsWriterDict[GetNumPyType<int32_t>()] = PyFitsIO<int32_t>::wrapFitsWriter("I");
+        pyFitsWriterDict[GetNumPyType<float>()] = PyFitsIO<float>::wrapFitsWriter("F");
+        pyFitsWriterDict[GetNumPyType<double>()] = PyFitsIO<double>::wrapFitsWriter("D");
+
+        PyFitsIO<int16_t>::wrapFunctions();
+        PyFitsIO<int32_t>::wrapFunctions();
+        PyFitsIO<float>::wrapFunctions();
+        PyFitsIO<double>::wrapFunctions();
+
+        bp::scope scope;
+        scope.attr("FitsWriter") = pyFitsWriterDict;
+    }
+
+} // namespace galsim
@@ -24,6 +24,7 @@
 
 #include "NumpyHelper.h"
 #include "Image.h"
+#include "TiledImage.h"
 
 namespace bp = boost::python;
 
@@ -41,6 +42,7 @@ template <typename T>
 struct PyImage {
 
     // This one is mostly just used to enable a repr that actually gets back to the original.
+    // If the array is contiguous, the ImageAlloc just uses the NumPy memory directly.
     static ImageAlloc<T>* MakeAllocFromArray(const Bounds<int>& bounds, const bp::object& array)
     {
         int stride = 0;
@@ -49,13 +51,20 @@ struct PyImage {
         Bounds<int> bounds2;
         BuildConstructorArgs(array, bounds.getXMin(), bounds.getYMin(), false, data, owner, 
                              stride, bounds2);
-        ImageView<T>* imview = new ImageView<T>(data, owner, stride, bounds2);
-        return new ImageAlloc<T>(*imview);
+        if (stride == bounds2.getXMax() - bounds2.getXMin() + 1) {
+            return new ImageAlloc<T>(data, owner, bounds2);
+        } else {
+            ++ImageCopyCount();
+            return new ImageAlloc<T>(ImageView<T>(data, owner, stride, bounds2));
+        }
     }
 
     template <typename U>
     static ImageAlloc<T>* MakeFromImage(const BaseImage<U>& rhs)
-    { return new ImageAlloc<T>(rhs); }
+    {
+        ++ImageCopyCount();
+        return new ImageAlloc<T>(rhs);
+    }
 
     template <typename U, typename W>
     static void wrapImageAllocTemplates(W& wrapper) {
@@ -196,6 +205,9 @@ struct PyImage {
             .def(bp::init<const Bounds<int>&, T>(
                     (bp::arg("bounds"), bp::arg("init_value")=T(0))
             ))
+            .def(bp::init<const Bounds<int>&, const std::string&, long>(
+                    (bp::arg("bounds"), bp::arg("file_name"), bp::arg("offset")=0)
+            ))
             .def("__init__", bp::make_constructor(
                     &MakeAllocFromArray, bp::default_call_policies(),
                     (bp::arg("bounds"), bp::arg("array"))))
@@ -295,8 +307,53 @@ struct PyImage {
         return pyConstImageView;
     }
 
+    static bp::object wrapTiledImage(const std::string& suffix) {
+        typedef const T& (TiledImage<T>::*at_func_type)(int, int) const;
+
+        bp::object at = bp::make_function(
+            at_func_type(&TiledImage<T>::at),
+            bp::return_value_policy<bp::copy_const_reference>(),
+            bp::args("x", "y")
+        );
+        bp::object getBounds = bp::make_function(
+            &TiledImage<T>::getBounds, 
+            bp::return_value_policy<bp::copy_const_reference>()
+        ); 
+
+        bp::class_< TiledImage<T> >
+            pyTiledImage(("TiledImage" + suffix).c_str(), "", bp::no_init);
+        pyTiledImage
+            .def(bp::init<const Bounds<int>&, int, T>(
+                    (bp::arg("bounds"), bp::arg("tile_size")=64, bp::arg("init_value")=T(0))
+            ))
+            .def(bp::init<const BaseImage<T>&, int>(
+                    (bp::arg("image"), bp::arg("tile_size")=64)
+            ))
+            .def("getBounds", getBounds)
+            .add_property("bounds", getBounds)
+            .add_property("tile_size", &TiledImage<T>::getTileSize)
+            .def("__call__", at)
+            .def("setValue", &TiledImage<T>::setValue, bp::args("x","y","value"))
+            .def("fill", &TiledImage<T>::fill)
+            .def("setZero", &TiledImage<T>::setZero)
+            .def("addImage", &TiledImage<T>::addImage, bp::args("image"))
+            .def("copyFrom", &TiledImage<T>::copyFrom, bp::args("image"))
+            .def("assignTo", &TiledImage<T>::assignTo, bp::args("image"))
+            .def("sumElements", &TiledImage<T>::sumElements)
+            .def(bp::self += bp::other<BaseImage<T> >())
+            .def(bp::self += bp::other<T>())
+            .def(bp::self -= bp::other<T>())
+            .def(bp::self *= bp::other<T>())
+            .def(bp::self /= bp::other<T>())
+            ;
+
+        return pyTiledImage;
+    }
+
 };
 
+static int GetImageCopyCount() { return ImageCopyCount(); }
+
 void pyExportImage() {
     bp::dict pyImageAllocDict;  // dict that lets us say "Image[numpy.float32]", etc.
 
@@ -319,10 +376,20 @@ void pyExportImage() {
     pyImageViewDict[GetNumPyType<float>()] = PyImage<float>::wrapImageView("F");
     pyImageViewDict[GetNumPyType<double>()] = PyImage<double>::wrapImageView("D");
 
+    bp::dict pyTiledImageDict;
+
+    pyTiledImageDict[GetNumPyType<int16_t>()] = PyImage<int16_t>::wrapTiledImage("S");
+    pyTiledImageDict[GetNumPyType<int32_t>()] = PyImage<int32_t>::wrapTiledImage("I");
+    pyTiledImageDict[GetNumPyType<float>()] = PyImage<float>::wrapTiledImage("F");
+    pyTiledImageDict[GetNumPyType<double>()] = PyImage<double>::wrapTiledImage("D");
+
+    bp::def("_getImageCopyCount", &GetImageCopyCount);
+
     bp::scope scope;  // a default constructed scope represents the module we're creating
     scope.attr("ImageAlloc") = pyImageAllocDict;
     scope.attr("ConstImageView") = pyConstImageViewDict;
     scope.attr("ImageView") = pyImageViewDict;
+    scope.attr("TiledImage") = pyTiledImageDict;
 }
 
 } // namespace galsim
@@ -0,0 +1,148 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include "galsim/IgnoreWarnings.h"
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include "boost/python.hpp"
+#include "NumpyHelper.h"
+#include "LensingPS.h"
+
+namespace bp = boost::python;
+
+namespace galsim {
+namespace {
+
+    struct PyLensingPS {
+
+        static bool isSquare(const bp::object& array, int N)
+        {
+            return (GetNumpyArrayNDim(array.ptr()) == 2 &&
+                    GetNumpyArrayDim(array.ptr(), 0) == N &&
+                    GetNumpyArrayDim(array.ptr(), 1) == N);
+        }
+
+        static const double* getAmplitude(const bp::object& amp, int N)
+        {
+            if (amp.ptr() == Py_None) return 0;
+            if (GetNumpyArrayNDim(amp.ptr()) != 2 ||
+                GetNumpyArrayDim(amp.ptr(), 0) != N ||
+                GetNumpyArrayDim(amp.ptr(), 1) != N/2+1) {
+                PyErr_SetString(PyExc_ValueError, "Amplitude array has the wrong shape");
+                bp::throw_error_already_set();
+            }
+            return GetNumpyArrayData<double>(amp.ptr());
+        }
+
+        static void realize(const bp::object& ampE, const bp::object& ampB, GaussianDeviate& gd,
+                            const bp::object& g1, const bp::object& g2, const bp::object& kappa)
+        {
+            const int N = GetNumpyArrayDim(g1.ptr(), 0);
+            if (!isSquare(g1, N) || !isSquare(g2, N) || !isSquare(kappa, N)) {
+                PyErr_SetString(PyExc_ValueError, "g1, g2, kappa must be square arrays");
+                bp::throw_error_already_set();
+            }
+            RealizePowerSpectrum(getAmplitude(ampE, N), getAmplitude(ampB, N), N, gd,
+                                 GetNumpyArrayData<double>(g1.ptr()),
+                                 GetNumpyArrayData<double>(g2.ptr()),
+                                 GetNumpyArrayData<double>(kappa.ptr()));
+        }
+
+        static void kaiserSquires(const bp::object& g1, const bp::object& g2,
+                                  const bp::object& kappaE, const bp::object& kappaB)
+        {
+            const int N = GetNumpyArrayDim(g1.ptr(), 0);
+            if (!isSquare(g1, N) || !isSquare(g2, N) || !isSquare(kappaE, N) ||
+                !isSquare(kappaB, N)) {
+                PyErr_SetString(PyExc_ValueError, "g1, g2, kappaE, kappaB must be square arrays");
+                bp::throw_error_already_set();
+            }
+            KaiserSquires(GetNumpyArrayData<double>(g1.ptr()),
+                          GetNumpyArrayData<double>(g2.ptr()), N,
+                          GetNumpyArrayData<double>(kappaE.ptr()),
+                          GetNumpyArrayData<double>(kappaB.ptr()));
+        }
+
+        static LensingGrid* makeLensingGrid(
+            const bp::object& fields, double x0, double y0, double dx,
+            boost::shared_ptr<Interpolant> interp, bool periodic)
+        {
+            const int nfield = GetNumpyArrayDim(fields.ptr(), 0);
+            const int N = GetNumpyArrayDim(fields.ptr(), 1);
+            if (GetNumpyArrayNDim(fields.ptr()) != 3 || GetNumpyArrayDim(fields.ptr(), 2) != N) {
+                PyErr_SetString(PyExc_ValueError, "fields must have shape (nfield, N, N)");
+                bp::throw_error_already_set();
+            }
+            return new LensingGrid(GetNumpyArrayData<double>(fields.ptr()), nfield, N,
+                                   x0, y0, dx, interp, periodic);
+        }
+
+        static void interpolate(const LensingGrid& grid, const bp::object& x,
+                                const bp::object& y, const bp::object& out)
+        {
+            const int n = GetNumpyArrayDim(x.ptr(), 0);
+            if (GetNumpyArrayDim(y.ptr(), 0) != n ||
+                GetNumpyArrayDim(out.ptr(), 0) != grid.getNField() ||
+                GetNumpyArrayDim(out.ptr(), 1) != n) {
+                PyErr_SetString(PyExc_ValueError, "Inconsistent array shapes in interpolate");
+                bp::throw_error_already_set();
+            }
+            grid.interpolate(GetNumpyArrayData<double>(x.ptr()),
+                             GetNumpyArrayData<double>(y.ptr()), n,
+                             GetNumpyArrayData<double>(out.ptr()));
+        }
+
+        static void wrap()
+        {
+            // docstrings are in galsim/lensing_ps.py
+            bp::class_<LensingGrid, boost::noncopyable> pyLensingGrid("_LensingGrid", bp::no_init);
+            pyLensingGrid
+                .def("__init__",
+                     bp::make_constructor(
+                         &makeLensingGrid, bp::default_call_policies(),
+                         (bp::arg("fields"), bp::arg("x0"), bp::arg("y0"), bp::arg("dx"),
+                          bp::arg("interp"), bp::arg("periodic"))
+                     )
+                )
+                .def("interpolate", &interpolate, (bp::arg("x"), bp::arg("y"), bp::arg("out")))
+                .add_property("nfield", &LensingGrid::getNField)
+                .add_property("N", &LensingGrid::getN)
+                .add_property("periodic", &LensingGrid::isPeriodic)
+                ;
+
+            bp::def("_RealizePowerSpectrum", &realize,
+                    (bp::arg("ampE"), bp::arg("ampB"), bp::arg("gd"), bp::arg("g1"),
+                     bp::arg("g2"), bp::arg("kappa")),
+                    "Draw a realization of the shear and convergence from a power spectrum");
+            bp::def("_KaiserSquires", &kaiserSquires,
+                    (bp::arg("g1"), bp::arg("g2"), bp::arg("kappaE"), bp::arg("kappaB")),
+                    "Do a Kaiser & Squires inversion of gridded shears");
+        }
+
+    }; // struct PyLensingPS
+
+} // anonymous
+
+void pyExportLensingPS()
+{
+    PyLensingPS::wrap();
+}
+
+} // namespace galsim
@@ -137,6 +137,16 @@ inline void DestroyCapsule(PyObject* capsule)
 }
 #endif
 
+// The number of times the python layer has had to copy the pixel data of an image, rather
+// than share the memory between C++ and NumPy.  This is just a diagnostic, so we can check
+// that common operations are not doing unnecessary copies.  It is accessible in python as
+// galsim._galsim._getImageCopyCount().
+inline int& ImageCopyCount()
+{
+    static int count = 0;
+    return count;
+}
+
 template <typename T>
 struct PythonDeleter {
     void operator()(T* p) { owner.reset(); }
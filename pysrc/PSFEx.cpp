@@ -0,0 +1,120 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include "galsim/IgnoreWarnings.h"
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include "boost/python.hpp"
+#include "NumpyHelper.h"
+#include "PSFEx.h"
+
+namespace bp = boost::python;
+
+namespace galsim {
+namespace {
+
+    struct PyPSFExModel {
+
+        static PSFExModel* construct(const bp::object& basis, int order,
+                                     double x0, double y0, double xscale, double yscale)
+        {
+            if (GetNumpyArrayNDim(basis.ptr()) != 3) {
+                PyErr_SetString(PyExc_ValueError, "basis must be a 3-d array");
+                bp::throw_error_already_set();
+            }
+            return new PSFExModel(GetNumpyArrayData<double>(basis.ptr()),
+                                  GetNumpyArrayDim(basis.ptr(), 0),
+                                  GetNumpyArrayDim(basis.ptr(), 2),
+                                  GetNumpyArrayDim(basis.ptr(), 1),
+                                  order, x0, y0, xscale, yscale);
+        }
+
+        static int checkSizes(const bp::object& x, const bp::object& y)
+        {
+            const int n = GetNumpyArrayDim(x.ptr(), 0);
+            if (GetNumpyArrayNDim(x.ptr()) != 1 || GetNumpyArrayNDim(y.ptr()) != 1 ||
+                GetNumpyArrayDim(y.ptr(), 0) != n) {
+                PyErr_SetString(PyExc_ValueError, "Inconsistent array sizes");
+                bp::throw_error_already_set();
+            }
+            return n;
+        }
+
+        static void getImages(const PSFExModel& model, const bp::object& x, const bp::object& y,
+                              const bp::object& images)
+        {
+            const int n = checkSizes(x, y);
+            if (GetNumpyArrayNDim(images.ptr()) != 3 ||
+                GetNumpyArrayDim(images.ptr(), 0) != n ||
+                GetNumpyArrayDim(images.ptr(), 1) != model.getNY() ||
+                GetNumpyArrayDim(images.ptr(), 2) != model.getNX()) {
+                PyErr_SetString(PyExc_ValueError, "images must have shape (n, ny, nx)");
+                bp::throw_error_already_set();
+            }
+            model.getImages(GetNumpyArrayData<double>(x.ptr()),
+                            GetNumpyArrayData<double>(y.ptr()), n,
+                            GetNumpyArrayData<float>(images.ptr()));
+        }
+
+        static bp::list getProfiles(const PSFExModel& model,
+                                    const bp::object& x, const bp::object& y,
+                                    boost::shared_ptr<Interpolant> xInterp,
+                                    boost::shared_ptr<Interpolant> kInterp,
+                                    double pad_factor, const GSParamsPtr& gsparams)
+        {
+            const int n = checkSizes(x, y);
+            std::vector<boost::shared_ptr<SBInterpolatedImage> > profiles;
+            model.getProfiles(GetNumpyArrayData<double>(x.ptr()),
+                              GetNumpyArrayData<double>(y.ptr()), n,
+                              xInterp, kInterp, pad_factor, gsparams, profiles);
+            bp::list result;
+            for (int i=0; i<n; ++i) result.append(*profiles[i]);
+            return result;
+        }
+
+        static void wrap()
+        {
+            // docstrings are in galsim/des/des_psfex.py
+            bp::class_<PSFExModel> pyPSFExModel("_PSFExModel", bp::no_init);
+            pyPSFExModel
+                .def("__init__",
+                     bp::make_constructor(
+                         &construct, bp::default_call_policies(),
+                         (bp::arg("basis"), bp::arg("order"), bp::arg("x0"), bp::arg("y0"),
+                          bp::arg("xscale"), bp::arg("yscale"))
+                     )
+                )
+                .def("getImages", &getImages, (bp::arg("x"), bp::arg("y"), bp::arg("images")))
+                .def("getProfiles", &getProfiles,
+                     (bp::arg("x"), bp::arg("y"), bp::arg("xInterp"), bp::arg("kInterp"),
+                      bp::arg("pad_factor"), bp::arg("gsparams")=bp::object()))
+                ;
+        }
+
+    }; // struct PyPSFExModel
+
+} // anonymous
+
+void pyExportPSFEx()
+{
+    PyPSFExModel::wrap();
+}
+
+} // namespace galsim
@@ -0,0 +1,166 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#include "galsim/IgnoreWarnings.h"
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include "boost/python.hpp"
+#include "NumpyHelper.h"
+#include "PhaseScreen.h"
+
+namespace bp = boost::python;
+
+namespace galsim {
+namespace {
+
+    struct PyPhaseScreen {
+
+        static PhaseScreen* makePhaseScreen(const bp::object& screen, double scale, double x0)
+        {
+            const int npix = GetNumpyArrayDim(screen.ptr(), 0);
+            if (GetNumpyArrayDim(screen.ptr(), 1) != npix) {
+                PyErr_SetString(PyExc_ValueError, "screen must be a square array");
+                bp::throw_error_already_set();
+            }
+            const double* data = GetNumpyArrayData<double>(screen.ptr());
+            return new PhaseScreen(data, npix, scale, x0);
+        }
+
+        static void setScreen(PhaseScreen& ps, const bp::object& screen)
+        {
+            if (GetNumpyArrayDim(screen.ptr(), 0) != ps.getNPix() ||
+                GetNumpyArrayDim(screen.ptr(), 1) != ps.getNPix()) {
+                PyErr_SetString(PyExc_ValueError, "screen has the wrong shape");
+                bp::throw_error_already_set();
+            }
+            ps.setScreen(GetNumpyArrayData<double>(screen.ptr()));
+        }
+
+        static void getScreen(const PhaseScreen& ps, const bp::object& screen)
+        {
+            ps.getScreen(GetNumpyArrayData<double>(screen.ptr()));
+        }
+
+        static void wavefront(const PhaseScreen& ps, const bp::object& u, const bp::object& v,
+                              const bp::object& out, double dx, double dy)
+        {
+            const double* uvec = GetNumpyArrayData<double>(u.ptr());
+            const double* vvec = GetNumpyArrayData<double>(v.ptr());
+            double* outvec = GetNumpyArrayData<double>(out.ptr());
+            int n = GetNumpyArrayDim(u.ptr(), 0);
+            ps.wavefront(uvec, vvec, n, dx, dy, outvec);
+        }
+
+        static void sumWavefronts(const bp::list& screens, const bp::object& u,
+                                  const bp::object& v, const bp::object& offsets,
+                                  const bp::object& out)
+        {
+            const int nscreen = bp::len(screens);
+            std::vector<const PhaseScreen*> vscreens(nscreen);
+            for (int s=0; s<nscreen; ++s) {
+                const PhaseScreen& ps = bp::extract<const PhaseScreen&>(screens[s]);
+                vscreens[s] = &ps;
+            }
+            const int n = GetNumpyArrayDim(u.ptr(), 0);
+            const int nfield = GetNumpyArrayDim(out.ptr(), 0);
+            if (GetNumpyArrayDim(out.ptr(), 1) != n ||
+                GetNumpyArrayDim(offsets.ptr(), 0) != nfield ||
+                GetNumpyArrayDim(offsets.ptr(), 1) != nscreen) {
+                PyErr_SetString(PyExc_ValueError, "Inconsistent array shapes in SumWavefronts");
+                bp::throw_error_already_set();
+            }
+            SumWavefronts(vscreens,
+                          GetNumpyArrayData<double>(u.ptr()), GetNumpyArrayData<double>(v.ptr()),
+                          n, GetNumpyArrayData<double>(offsets.ptr()), nfield,
+                          GetNumpyArrayData<double>(out.ptr()));
+        }
+
+        static PupilFFT* makePupilFFT(int nrow, int ncol, const bp::object& index)
+        {
+            const int32_t* data = GetNumpyArrayData<int32_t>(index.ptr());
+            const int n = GetNumpyArrayDim(index.ptr(), 0);
+            std::vector<int> vindex(data, data+n);
+            return new PupilFFT(nrow, ncol, vindex);
+        }
+
+        static void accumulate(const PupilFFT& pfft, const bp::object& wf, double lam,
+                               const bp::object& images)
+        {
+            const int nfield = GetNumpyArrayDim(wf.ptr(), 0);
+            if (GetNumpyArrayDim(wf.ptr(), 1) != pfft.getNPoint() ||
+                GetNumpyArrayDim(images.ptr(), 0) != nfield ||
+                GetNumpyArrayDim(images.ptr(), 1) != pfft.getNRow() ||
+                GetNumpyArrayDim(images.ptr(), 2) != pfft.getNCol()) {
+                PyErr_SetString(PyExc_ValueError, "Inconsistent array shapes in accumulate");
+                bp::throw_error_already_set();
+            }
+            pfft.accumulate(GetNumpyArrayData<double>(wf.ptr()), nfield, lam,
+                            GetNumpyArrayData<double>(images.ptr()));
+        }
+
+        static void wrap()
+        {
+            // docstrings are in galsim/phase_screens.py
+            bp::class_<PhaseScreen> pyPhaseScreen("_PhaseScreen", bp::no_init);
+            pyPhaseScreen
+                .def("__init__",
+                     bp::make_constructor(
+                         &makePhaseScreen, bp::default_call_policies(),
+                         (bp::arg("screen"), bp::arg("scale"), bp::arg("x0"))
+                     )
+                )
+                .def("setScreen", &setScreen, bp::args("screen"))
+                .def("getScreen", &getScreen, bp::args("screen"))
+                .def("wavefront", &wavefront,
+                     (bp::arg("u"), bp::arg("v"), bp::arg("out"), bp::arg("dx"), bp::arg("dy")))
+                .def("__call__", &PhaseScreen::operator(), bp::args("x", "y"))
+                .add_property("npix", &PhaseScreen::getNPix)
+                .add_property("scale", &PhaseScreen::getScale)
+                .add_property("x0", &PhaseScreen::getX0)
+                ;
+
+            bp::class_<PupilFFT, boost::noncopyable> pyPupilFFT("_PupilFFT", bp::no_init);
+            pyPupilFFT
+                .def("__init__",
+                     bp::make_constructor(
+                         &makePupilFFT, bp::default_call_policies(),
+                         (bp::arg("nrow"), bp::arg("ncol"), bp::arg("index"))
+                     )
+                )
+                .def("accumulate", &accumulate,
+                     (bp::arg("wf"), bp::arg("lam"), bp::arg("images")))
+                .add_property("npoint", &PupilFFT::getNPoint)
+                ;
+
+            bp::def("_SumWavefronts", &sumWavefronts,
+                    (bp::arg("screens"), bp::arg("u"), bp::arg("v"), bp::arg("offsets"),
+                     bp::arg("out")),
+                    "Evaluate the summed wavefront of several phase screens at many field angles");
+        }
+
+    }; // struct PyPhaseScreen
+
+} // anonymous
+
+void pyExportPhaseScreen()
+{
+    PyPhaseScreen::wrap();
+}
+
+} // namespace galsim
@@ -21,6 +21,7 @@
 
 #define BOOST_NO_CXX11_SMART_PTR
 #include "boost/python.hpp"
+#include "NumpyHelper.h"
 #include "SBInterpolatedImage.h"
 
 namespace bp = boost::python;
@@ -44,11 +45,44 @@ namespace galsim {
                           bp::arg("gsparams")=bp::object())
                      )
                 )
+                .def(bp::init<const BaseImage<U> &,
+                     boost::shared_ptr<Interpolant>,
+                     boost::shared_ptr<Interpolant>,
+                     double, double, double, boost::shared_ptr<GSParams>,
+                     const NoisePad&, int, BaseDeviate>(
+                         (bp::arg("image"),
+                          bp::arg("xInterp"), bp::arg("kInterp"),
+                          bp::arg("pad_factor"), bp::arg("stepk"), bp::arg("maxk"),
+                          bp::arg("gsparams"), bp::arg("noise_pad"),
+                          bp::arg("noise_pad_size"), bp::arg("rng"))
+                     )
+                )
                 ;
         }
 
+        static NoisePad* makeCorrelatedNoisePad(const bp::object& rootps)
+        {
+            const int N = GetNumpyArrayDim(rootps.ptr(), 0);
+            if (GetNumpyArrayDim(rootps.ptr(), 1) != N/2+1) {
+                PyErr_SetString(PyExc_ValueError, "rootps must have shape (N, N//2+1)");
+                bp::throw_error_already_set();
+            }
+            return new NoisePad(GetNumpyArrayData<double>(rootps.ptr()), N);
+        }
+
         static void wrap()
         {
+            bp::class_<NoisePad> pyNoisePad("_NoisePad", bp::no_init);
+            // Note: boost python tries the later overloads first, so the one that takes any
+            // object needs to come before the one that takes a double.
+            pyNoisePad
+                .def("__init__", bp::make_constructor(
+                        &makeCorrelatedNoisePad, bp::default_call_policies(),
+                        bp::arg("rootps")))
+                .def(bp::init<double>(bp::arg("variance")))
+                .add_property("N", &NoisePad::getN)
+                ;
+
             bp::class_< SBInterpolatedImage, bp::bases<SBProfile> > pySBInterpolatedImage(
                 "SBInterpolatedImage", bp::init<const SBInterpolatedImage &>()
             );
@@ -123,6 +157,10 @@ namespace galsim {
     void pyExportSBInterpolatedImage()
     {
         PySBInterpolatedImage::wrap();
+
+        bp::def("SetInterpolatedImageCacheSize", &SetInterpolatedImageCacheSize,
+                bp::arg("max_bytes"));
+        bp::def("GetInterpolatedImageCacheBytes", &GetInterpolatedImageCacheBytes);
     }
 
     void pyExportSBInterpolatedKImage()
@@ -89,9 +89,47 @@ namespace galsim {
     };
 
 
+    // Release the GIL while drawing, so python threads can draw several profiles at once.
+    // The state shared between draws (e.g. the FFTW planner, the cache of InterpolatedImage
+    // transforms) is protected by a Mutex, which works for python threads as well as OpenMP
+    // threads.
+    class ReleaseGIL
+    {
+    public:
+        ReleaseGIL() : _state(PyEval_SaveThread()) {}
+        ~ReleaseGIL() { PyEval_RestoreThread(_state); }
+    private:
+        PyThreadState* _state;
+    };
+
     struct PySBProfile
     {
 
+        // Some profiles build lookup tables the first time they are needed, and some share
+        // them with other profiles via an LRUCache (e.g. all Sersic profiles with the same n).
+        // prepareDraw (and maxK and stepK, which some profiles also calculate lazily) builds
+        // them while we still hold the GIL, so the draw itself only reads the profile.
+        template <typename U>
+        static double draw(const SBProfile& prof, ImageView<U> image, double gain, double wmult)
+        {
+            prof.maxK();
+            prof.stepK();
+            prof.prepareDraw();
+            ReleaseGIL release;
+            return prof.draw(image, gain, wmult);
+        }
+
+        template <typename U>
+        static void drawK(const SBProfile& prof, ImageView<U> re, ImageView<U> im,
+                          double gain, double wmult)
+        {
+            prof.maxK();
+            prof.stepK();
+            prof.prepareDraw();
+            ReleaseGIL release;
+            prof.drawK(re, im, gain, wmult);
+        }
+
         template <typename U, typename W>
         static void wrapTemplates(W & wrapper) {
             // We don't need to wrap templates in a separate function, but it keeps us
@@ -112,13 +150,10 @@ namespace galsim {
                      "according to Poisson statistics for N samples.\n"
                      "\n"
                      "Returns total flux of photons that landed inside image bounds.")
-                .def("draw",
-                     (double (SBProfile::*)(ImageView<U>, double, double) const)&SBProfile::draw,
+                .def("draw", &draw<U>,
                      (bp::arg("image"), bp::arg("gain")=1., bp::arg("wmult")=1.),
                      "Draw in-place and return the summed flux.")
-                .def("drawK",
-                     (void (SBProfile::*)(ImageView<U>, ImageView<U>,
-                                          double, double) const)&SBProfile::drawK,
+                .def("drawK", &drawK<U>,
                      (bp::arg("re"), bp::arg("im"), bp::arg("gain")=1., bp::arg("wmult")=1.),
                      "Draw k-space image (real and imaginary components).")
                 ;
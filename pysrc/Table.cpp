@@ -166,6 +166,7 @@ namespace {
             else if (interp == "floor") i = Table2D<double,double>::floor;
             else if (interp == "ceil") i = Table2D<double,double>::ceil;
             else if (interp == "nearest") i = Table2D<double,double>::nearest;
+            else if (interp == "spline") i = Table2D<double,double>::spline;
             else {
                 PyErr_SetString(PyExc_ValueError, "Invalid interpolant");
                 bp::throw_error_already_set();
@@ -228,6 +229,8 @@ namespace {
                     return std::string("ceil");
                 case Table2D<double,double>::nearest:
                     return std::string("nearest");
+                case Table2D<double,double>::spline:
+                    return std::string("spline");
                 default:
                     PyErr_SetString(PyExc_ValueError, "Invalid interpolant");
                     bp::throw_error_already_set();
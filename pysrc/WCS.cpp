@@ -0,0 +1,151 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include "galsim/IgnoreWarnings.h"
+
+#define BOOST_NO_CXX11_SMART_PTR
+#include "boost/python.hpp"
+#include "NumpyHelper.h"
+#include "WCS.h"
+
+namespace bp = boost::python;
+
+namespace galsim {
+namespace {
+
+    struct PyFitsWCSTransform {
+
+        // Get the coefficients of a (2, order+1, order+1) polynomial array, or null for None.
+        static const double* getPoly(const bp::object& array, int& order)
+        {
+            order = 0;
+            if (array.ptr() == Py_None) return 0;
+            order = GetNumpyArrayDim(array.ptr(), 1) - 1;
+            if (GetNumpyArrayNDim(array.ptr()) != 3 || GetNumpyArrayDim(array.ptr(), 0) != 2 ||
+                GetNumpyArrayDim(array.ptr(), 2) != order+1) {
+                PyErr_SetString(PyExc_ValueError, "Polynomial array has the wrong shape");
+                bp::throw_error_already_set();
+            }
+            return GetNumpyArrayData<double>(array.ptr());
+        }
+
+        static FitsWCSTransform* construct(
+            const std::string& projection, double ra0, double dec0,
+            const bp::object& crpix, const bp::object& cd,
+            const bp::object& pv, const bp::object& ab, const bp::object& abp)
+        {
+            FitsWCSTransform::Projection proj;
+            if (projection == "gnomonic") proj = FitsWCSTransform::Gnomonic;
+            else if (projection == "stereographic") proj = FitsWCSTransform::Stereographic;
+            else if (projection == "lambert") proj = FitsWCSTransform::Lambert;
+            else if (projection == "postel") proj = FitsWCSTransform::Postel;
+            else {
+                PyErr_SetString(PyExc_ValueError, "Invalid projection");
+                bp::throw_error_already_set();
+            }
+            int pvOrder, abOrder, abpOrder;
+            const double* pvData = getPoly(pv, pvOrder);
+            if (pvData && pvOrder != 3) {
+                PyErr_SetString(PyExc_ValueError, "pv must have shape (2,4,4)");
+                bp::throw_error_already_set();
+            }
+            const double* abData = getPoly(ab, abOrder);
+            const double* abpData = getPoly(abp, abpOrder);
+            return new FitsWCSTransform(proj, ra0, dec0,
+                                        GetNumpyArrayData<double>(crpix.ptr()),
+                                        GetNumpyArrayData<double>(cd.ptr()),
+                                        pvData, abOrder, abData, abpOrder, abpData);
+        }
+
+        static int checkSizes(const bp::object& a1, const bp::object& a2, const bp::object& a3)
+        {
+            const int n = GetNumpyArrayDim(a1.ptr(), 0);
+            if (GetNumpyArrayNDim(a1.ptr()) != 1 || GetNumpyArrayDim(a2.ptr(), 0) != n ||
+                GetNumpyArrayDim(a3.ptr(), 0) != n) {
+                PyErr_SetString(PyExc_ValueError, "Inconsistent array sizes");
+                bp::throw_error_already_set();
+            }
+            return n;
+        }
+
+        static void toWorld(const FitsWCSTransform& wcs, const bp::object& x,
+                            const bp::object& y, const bp::object& ra, const bp::object& dec)
+        {
+            const int n = checkSizes(x, y, ra);
+            checkSizes(x, y, dec);
+            wcs.toWorld(GetNumpyArrayData<double>(x.ptr()), GetNumpyArrayData<double>(y.ptr()),
+                        n, GetNumpyArrayData<double>(ra.ptr()),
+                        GetNumpyArrayData<double>(dec.ptr()));
+        }
+
+        static void toImage(const FitsWCSTransform& wcs, const bp::object& ra,
+                            const bp::object& dec, const bp::object& x, const bp::object& y)
+        {
+            const int n = checkSizes(ra, dec, x);
+            checkSizes(ra, dec, y);
+            wcs.toImage(GetNumpyArrayData<double>(ra.ptr()),
+                        GetNumpyArrayData<double>(dec.ptr()),
+                        n, GetNumpyArrayData<double>(x.ptr()),
+                        GetNumpyArrayData<double>(y.ptr()));
+        }
+
+        static void jacobian(const FitsWCSTransform& wcs, const bp::object& x,
+                             const bp::object& y, const bp::object& jac)
+        {
+            const int n = checkSizes(x, y, jac);
+            if (GetNumpyArrayNDim(jac.ptr()) != 2 || GetNumpyArrayDim(jac.ptr(), 1) != 4) {
+                PyErr_SetString(PyExc_ValueError, "jac must have shape (n,4)");
+                bp::throw_error_already_set();
+            }
+            wcs.jacobian(GetNumpyArrayData<double>(x.ptr()), GetNumpyArrayData<double>(y.ptr()),
+                         n, GetNumpyArrayData<double>(jac.ptr()));
+        }
+
+        static void wrap()
+        {
+            // docstrings are in galsim/fitswcs.py
+            bp::class_<FitsWCSTransform> pyFitsWCSTransform("_FitsWCSTransform", bp::no_init);
+            pyFitsWCSTransform
+                .def("__init__",
+                     bp::make_constructor(
+                         &construct, bp::default_call_policies(),
+                         (bp::arg("projection"), bp::arg("ra0"), bp::arg("dec0"),
+                          bp::arg("crpix"), bp::arg("cd"), bp::arg("pv"), bp::arg("ab"),
+                          bp::arg("abp"))
+                     )
+                )
+                .def("toWorld", &toWorld,
+                     (bp::arg("x"), bp::arg("y"), bp::arg("ra"), bp::arg("dec")))
+                .def("toImage", &toImage,
+                     (bp::arg("ra"), bp::arg("dec"), bp::arg("x"), bp::arg("y")))
+                .def("jacobian", &jacobian, (bp::arg("x"), bp::arg("y"), bp::arg("jac")))
+                ;
+        }
+
+    }; // struct PyFitsWCSTransform
+
+} // anonymous
+
+void pyExportWCS()
+{
+    PyFitsWCSTransform::wrap();
+}
+
+} // namespace galsim
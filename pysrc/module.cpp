@@ -59,9 +59,14 @@ namespace galsim {
     void pyExportNoise();
     void pyExportTable();
     void pyExportTable2D();
+    void pyExportPhaseScreen();
+    void pyExportLensingPS();
+    void pyExportWCS();
+    void pyExportPSFEx();
     void pyExportInterpolant();
     void pyExportCorrelationFunction();
     void pyExportCDModel();
+    void pyExportFitsIO();
 
     namespace hsm {
         void pyExportHSM();
@@ -104,9 +109,14 @@ BOOST_PYTHON_MODULE(_galsim) {
     galsim::pyExportInterpolant();
     galsim::pyExportCorrelationFunction();
     galsim::pyExportCDModel();
+    galsim::pyExportFitsIO();
     galsim::hsm::pyExportHSM();
     galsim::integ::pyExportInteg();
     galsim::pyExportTable();
     galsim::pyExportTable2D();
+    galsim::pyExportPhaseScreen();
+    galsim::pyExportLensingPS();
+    galsim::pyExportWCS();
+    galsim::pyExportPSFEx();
     galsim::bessel::pyExportBessel();
 }
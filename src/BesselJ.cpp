@@ -0,0 +1,162 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include <cmath>
+#include "bessel/BesselJ.h"
+
+namespace galsim {
+namespace bessel {
+
+    // The coefficients below are Chebyshev expansions fit to 40-digit values of the Bessel
+    // functions.  The small-x expansions are in s = x^2/32 - 1, and the large-x expansions are
+    // in s = 128/x^2 - 1, so s is in [-1,1] in both cases.
+
+    // J0(x) for |x| <= 8
+    const int n_j0_small = 16;
+    const double j0_small[n_j0_small] = {
+        1.57727971474890094e-01, -8.72344235285229391e-03, 2.65178613203336744e-01,
+        -3.70094993872649769e-01, 1.58067102332097198e-01, -3.48937694114086969e-02,
+        4.81918006946745799e-03, -4.60626166206321713e-04, 3.24603288209435615e-05,
+        -1.76194690771011201e-06, 7.60816357674688847e-08, -2.67925344422022983e-09,
+        7.84868552665744287e-11, -1.94380019492245962e-12, 4.12321781345067392e-14,
+        -7.56608135166098532e-16,
+    };
+
+    // J1(x)/x for |x| <= 8
+    const int n_j1_small = 16;
+    const double j1_small[n_j1_small] = {
+        8.10448463256581014e-02, -1.48975145067652248e-01, 1.60999262357209710e-01,
+        -8.26804917668178263e-02, 2.22136396549659984e-02, -3.64694060076924207e-03,
+        4.05033772835402942e-04, -3.25555486685601931e-05, 1.98587740493929019e-06,
+        -9.52198475284735595e-08, 3.68713369369147625e-09, -1.17802635963913774e-10,
+        3.16004920374408884e-12, -7.21945999440593722e-14, 1.37890937911537835e-15,
+        -4.23289537148452759e-17,
+    };
+
+    // P0(x) for |x| > 8
+    const int n_p0_large = 13;
+    const double p0_large[n_p0_large] = {
+        9.99460349347518595e-01, -5.36522046813214435e-04, 3.07518478751691984e-06,
+        -5.17059453773555592e-08, 1.63064646041359123e-09, -7.86409169022025190e-11,
+        5.16825865901031005e-12, -4.30459842850997478e-13, 4.32626985394201117e-14,
+        -5.07206872027675748e-15, 6.71734065901272232e-16, -1.03158140763446160e-16,
+        1.25752482757382347e-17,
+    };
+
+    // x Q0(x) for |x| > 8
+    const int n_q0_large = 13;
+    const double q0_large[n_q0_large] = {
+        -1.24446836842696029e-01, 5.47081595408934222e-04, -5.93159872884651682e-06,
+        1.43779657985578984e-07, -5.81753274788128638e-09, 3.37609754126629756e-10,
+        -2.56539776296535060e-11, 2.40491804914414665e-12, -2.66904022735619786e-13,
+        3.40437070854630330e-14, -4.87806497902310002e-15, 7.74706782654684587e-16,
+        -1.31427218993785019e-16,
+    };
+
+    // P1(x) for |x| > 8
+    const int n_p1_large = 13;
+    const double p1_large[n_p1_large] = {
+        1.00090304086001325e+00, 8.98989833085923808e-04, -3.98728430050279806e-06,
+        6.17763395918341846e-08, -1.87189076710362187e-09, 8.81689692257723666e-11,
+        -5.70487930629974153e-12, 4.69902784640563992e-13, -4.68562243986178652e-14,
+        5.43302294427413155e-15, -7.37805280622103415e-16, 8.81497364872978758e-17,
+        -3.66667899217623269e-17,
+    };
+
+    // x Q1(x) for |x| > 8
+    const int n_q1_large = 13;
+    const double q1_large[n_q1_large] = {
+        3.74222296556282530e-01, -7.70217883932568649e-04, 7.31089220636252974e-06,
+        -1.67678251074977330e-07, 6.58335466018099921e-09, -3.74909097442906870e-10,
+        2.81217477019676879e-11, -2.61145504750647397e-12, 2.87739047542601649e-13,
+        -3.64921327810095734e-14, 5.20471681589550511e-15, -8.24376527662212611e-16,
+        1.38754855322378239e-16,
+    };
+
+    // Evaluate sum_k c_k T_k(s) using Clenshaw's recurrence.
+    static inline double Chebyshev(const double* c, int n, double s)
+    {
+        double s2 = 2.*s;
+        double b1 = 0.;
+        double b2 = 0.;
+        for (int k=n-1; k>0; --k) {
+            double temp = b1;
+            b1 = s2*b1 - b2 + c[k];
+            b2 = temp;
+        }
+        return s*b1 - b2 + c[0];
+    }
+
+    // sqrt(1/pi).  The asymptotic forms below fold the 1/sqrt(2) from the phase shift of
+    // cos(x) and sin(x) by pi/4 into the usual sqrt(2/(pi x)) prefactor.
+    const double sqrt_1_pi = 0.564189583547756286948;
+
+    static inline double J0(double x)
+    {
+        double ax = std::abs(x);
+        if (ax <= 8.) {
+            double s = x*x/32. - 1.;
+            return Chebyshev(j0_small, n_j0_small, s);
+        } else {
+            double s = 128./(x*x) - 1.;
+            double p = Chebyshev(p0_large, n_p0_large, s);
+            double q = Chebyshev(q0_large, n_q0_large, s) / ax;
+            double c = std::cos(ax);
+            double sn = std::sin(ax);
+            // cos(x-pi/4) = (c+sn)/sqrt(2),  sin(x-pi/4) = (sn-c)/sqrt(2)
+            return sqrt_1_pi / std::sqrt(ax) * (p*(c+sn) - q*(sn-c));
+        }
+    }
+
+    static inline double J1(double x)
+    {
+        double ax = std::abs(x);
+        if (ax <= 8.) {
+            double s = x*x/32. - 1.;
+            return x * Chebyshev(j1_small, n_j1_small, s);
+        } else {
+            double s = 128./(x*x) - 1.;
+            double p = Chebyshev(p1_large, n_p1_large, s);
+            double q = Chebyshev(q1_large, n_q1_large, s) / ax;
+            double c = std::cos(ax);
+            double sn = std::sin(ax);
+            // cos(x-3pi/4) = (sn-c)/sqrt(2),  sin(x-3pi/4) = -(sn+c)/sqrt(2)
+            double j1 = sqrt_1_pi / std::sqrt(ax) * (p*(sn-c) + q*(sn+c));
+            return x > 0. ? j1 : -j1;
+        }
+    }
+
+    double BesselJ0(double x)
+    { return J0(x); }
+
+    double BesselJ1(double x)
+    { return J1(x); }
+
+    void BesselJ0Many(const double* x, double* f, int n)
+    {
+        for (int i=0; i<n; ++i) f[i] = J0(x[i]);
+    }
+
+    void BesselJ1Many(const double* x, double* f, int n)
+    {
+        for (int i=0; i<n; ++i) f[i] = J1(x[i]);
+    }
+
+}}
@@ -17,7 +17,11 @@
  *    and/or other materials provided with the distribution.
  */
 
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "CorrelatedNoise.h"
+#include "FFT.h"
 
 namespace galsim {
 
@@ -78,4 +82,226 @@ namespace galsim {
         return cov;
     }
 
+    /*
+     * Correlated noise generation from the square root of a power spectrum
+     */
+    void addNoiseFromRootPS(ImageView<double> image, const double* rootps, BaseDeviate rng)
+    {
+        const Bounds<int>& b = image.getBounds();
+        const int nx = b.getXMax() - b.getXMin() + 1;
+        const int ny = b.getYMax() - b.getYMin() + 1;
+        const int nxh = nx/2+1;
+        FFTW_Array<std::complex<double> > kfield(size_t(ny) * nxh);
+        FFTW_Array<double> xfield(size_t(ny) * nx);
+
+        // Draw a Gaussian random field in Fourier space.  The python code used to draw all the
+        // real parts and then all the imaginary parts, so do the same here.  The FFTW transform
+        // is not normalized, so the 1/(nx ny) that numpy's irfft2 would apply goes into the sigma.
+        GaussianDeviate gd(rng, 0., std::sqrt(0.5 / (double(nx) * ny)));
+        const size_t nk = kfield.size();
+        for (size_t i=0; i<nk; ++i) kfield[i] = gd();
+        for (size_t i=0; i<nk; ++i) kfield[i] = std::complex<double>(kfield[i].real(), gd());
+
+        // Impose Hermitian symmetry on the columns with kx = 0 and (for even nx) kx = nx/2, and
+        // make the self-conjugate elements real, with a factor sqrt(2) for the lost variance.
+        const double rt2 = std::sqrt(2.);
+        const int ncol = (nx % 2 == 0) ? 2 : 1;
+        for (int c=0; c<ncol; ++c) {
+            const int i = c * (nx/2);
+            for (int j=1; j<(ny+1)/2; ++j)
+                kfield[size_t(ny-j)*nxh + i] = std::conj(kfield[size_t(j)*nxh + i]);
+            kfield[i] = rt2 * kfield[i].real();
+            if (ny % 2 == 0)
+                kfield[size_t(ny/2)*nxh + i] = rt2 * kfield[size_t(ny/2)*nxh + i].real();
+        }
+        for (size_t i=0; i<nk; ++i) kfield[i] *= rootps[i];
+
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_c2r_2d(ny, nx, kfield.get_fftw(), xfield.get_fftw(),
+                                        FFTW_ESTIMATE);
+        }
+        if (plan==NULL) throw FFTInvalid();
+        fftw_execute(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
+
+        const int step = image.getStride();
+        double* row = image.getData();
+        const double* ptr = xfield.get();
+        for (int y=0; y<ny; ++y, row += step, ptr += nx)
+            for (int x=0; x<nx; ++x) row[x] += ptr[x];
+    }
+
+    void addTiledNoiseFromRootPS(ImageView<double> image, const double* rootps, int kny, int knx,
+                                 int fftSize, BaseDeviate rng)
+    {
+        if (kny <= 0 || knx <= 0)
+            FormatAndThrow<std::invalid_argument>() <<
+                "Invalid kernel size " << knx << " x " << kny << " for tiled noise";
+        if (fftSize <= 0)
+            FormatAndThrow<std::invalid_argument>() << "Invalid FFT size " << fftSize;
+
+        const Bounds<int>& b = image.getBounds();
+        const int nx = b.getXMax() - b.getXMin() + 1;
+        const int ny = b.getYMax() - b.getYMin() + 1;
+
+        // The kernel is the inverse transform of rootps.  Shift it so its center is at
+        // (kny/2, knx/2) rather than wrapped around (0,0).
+        const int knxh = knx/2+1;
+        FFTW_Array<std::complex<double> > kker(size_t(kny) * knxh);
+        FFTW_Array<double> xker(size_t(kny) * knx);
+        for (size_t i=0; i<kker.size(); ++i) kker[i] = rootps[i];
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_c2r_2d(kny, knx, kker.get_fftw(), xker.get_fftw(), FFTW_ESTIMATE);
+        }
+        if (plan==NULL) throw FFTInvalid();
+        fftw_execute(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
+
+        // Each tile of white noise is ty x tx, so its convolution with the kernel just fits in
+        // the my x mx FFT without wrapping around.  Making the FFT at least twice the size of the
+        // kernel means that the tiles are larger than the kernel, so the outputs of two tiles
+        // that are not next to each other never overlap.
+        const int my = goodFFTSize(std::max(fftSize, 2*kny));
+        const int mx = goodFFTSize(std::max(fftSize, 2*knx));
+        const int mxh = mx/2+1;
+        const int ty = my - kny + 1;
+        const int tx = mx - knx + 1;
+
+        // Transform the kernel, zero padded to the tile FFT size.  Both the normalization of
+        // the c2r transform above and the one for each tile below go in here.
+        FFTW_Array<double> xpad(size_t(my) * mx, 0.);
+        FFTW_Array<std::complex<double> > kpad(size_t(my) * mxh);
+        const double norm = 1. / (double(kny) * knx * double(my) * mx);
+        for (int j=0; j<kny; ++j) {
+            const int jj = (j + kny/2) % kny;
+            for (int i=0; i<knx; ++i)
+                xpad[size_t(jj)*mx + (i + knx/2) % knx] = norm * xker[size_t(j)*knx + i];
+        }
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_r2c_2d(my, mx, xpad.get_fftw(), kpad.get_fftw(), FFTW_ESTIMATE);
+        }
+        if (plan==NULL) throw FFTInvalid();
+        fftw_execute(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
+
+        // The white noise covers the image plus the width of the kernel, so that every pixel in
+        // the image gets the full kernel.  Pixel (x,y) of the image is pixel (x + knx-1, y + kny-1)
+        // of the convolution.
+        const int ey = ny + kny - 1;
+        const int ex = nx + knx - 1;
+        const int nty = (ey + ty - 1) / ty;
+        const int ntx = (ex + tx - 1) / tx;
+        const int ntile = nty * ntx;
+
+        // Draw the seeds for the tiles in order, so the result doesn't depend on which thread
+        // does which tile.  (A seed of 0 would mean to seed from the system.)
+        std::vector<long> seeds(ntile);
+        for (int t=0; t<ntile; ++t) {
+            seeds[t] = rng.raw();
+            if (seeds[t] == 0) seeds[t] = 1;
+        }
+
+        // Neighboring tiles overlap in the image, so do the tiles in four passes, according to
+        // whether their row and column are odd or even.  Within each pass, none of the tiles
+        // overlap, so they can be added into the image in parallel.
+        std::vector<int> order;
+        order.reserve(ntile);
+        int pass_start[5];
+        for (int pass=0; pass<4; ++pass) {
+            pass_start[pass] = order.size();
+            for (int a=pass/2; a<nty; a+=2)
+                for (int c=pass%2; c<ntx; c+=2) order.push_back(a*ntx + c);
+        }
+        pass_start[4] = order.size();
+
+        double* data = image.getData();
+        const int step = image.getStride();
+        std::string err;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            FFTW_Array<double> xtile(size_t(my) * mx);
+            FFTW_Array<std::complex<double> > ktile(size_t(my) * mxh);
+            fftw_plan fwd, inv;
+            {
+                MutexLock lock(fftw_plan_mutex);
+                fwd = fftw_plan_dft_r2c_2d(my, mx, xtile.get_fftw(), ktile.get_fftw(),
+                                           FFTW_ESTIMATE);
+                inv = fftw_plan_dft_c2r_2d(my, mx, ktile.get_fftw(), xtile.get_fftw(),
+                                           FFTW_ESTIMATE);
+            }
+
+            for (int pass=0; pass<4; ++pass) {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+                for (int k=pass_start[pass]; k<pass_start[pass+1]; ++k) {
+                    try {
+                        if (fwd==NULL || inv==NULL) throw FFTInvalid();
+                        const int t = order[k];
+                        const int y0 = (t / ntx) * ty;
+                        const int x0 = (t % ntx) * tx;
+                        const int hy = std::min(ty, ey - y0);
+                        const int hx = std::min(tx, ex - x0);
+
+                        BaseDeviate tile_rng(seeds[t]);
+                        GaussianDeviate gd(tile_rng, 0., 1.);
+                        xtile.fill(0.);
+                        for (int j=0; j<hy; ++j) {
+                            double* ptr = xtile.get() + size_t(j)*mx;
+                            for (int i=0; i<hx; ++i) ptr[i] = gd();
+                        }
+                        fftw_execute(fwd);
+                        const size_t nk = ktile.size();
+                        for (size_t i=0; i<nk; ++i) ktile[i] *= kpad[i];
+                        fftw_execute(inv);
+
+                        // Add the part of the convolution that lands on the image.
+                        const int j1 = std::max(0, kny - 1 - y0);
+                        const int j2 = std::min(hy + kny - 1, ey - y0);
+                        const int i1 = std::max(0, knx - 1 - x0);
+                        const int i2 = std::min(hx + knx - 1, ex - x0);
+                        const int n = i2 - i1;
+                        for (int j=j1; j<j2; ++j) {
+                            double* row =
+                                data + size_t(y0 + j - kny + 1)*step + (x0 + i1 - knx + 1);
+                            const double* ptr = xtile.get() + size_t(j)*mx + i1;
+                            for (int i=0; i<n; ++i) row[i] += ptr[i];
+                        }
+                    } catch (std::exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (TiledNoise)
+#endif
+                        {
+                            if (err.empty()) err = e.what();
+                        }
+                    }
+                }
+            }
+
+            {
+                MutexLock lock(fftw_plan_mutex);
+                if (fwd) fftw_destroy_plan(fwd);
+                if (inv) fftw_destroy_plan(inv);
+            }
+        }
+        if (!err.empty()) throw std::runtime_error(err);
+    }
+
 }
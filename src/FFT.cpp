@@ -39,6 +39,8 @@ int verbose_level = 0;
 
 namespace galsim {
 
+    Mutex fftw_plan_mutex;
+
     // A helper function that will return the smallest 2^n or 3x2^n value that is
     // even and >= the input integer.
     int goodFFTSize(int input) 
@@ -77,7 +79,6 @@ namespace galsim {
     void KTable::kSet(int ix, int iy, std::complex<double> value) 
     {
         check_array();
-        clearCache(); // invalidate any stored interpolations
         if (ix<0) {
             _array[index(ix,iy)]=conj(value);
             if (ix==-_No2) _array[index(ix,-iy)]=value;
@@ -88,13 +89,11 @@ namespace galsim {
     }
     void KTable::clear() 
     {
-        clearCache(); // invalidate any stored interpolations
         _array.fill(0.);
     }
 
     void KTable::accumulate(const KTable& rhs, double scalar) 
     {
-        clearCache(); // invalidate any stored interpolations
         check_array();
         if (_N != rhs._N) throw FFTError("KTable::accumulate() with mismatched sizes");
         if (_dk != rhs._dk) throw FFTError("KTable::accumulate() with mismatched dk");
@@ -104,7 +103,6 @@ namespace galsim {
 
     void KTable::operator*=(const KTable& rhs) 
     {
-        clearCache(); // invalidate any stored interpolations
         check_array();
         if (_N != rhs._N) throw FFTError("KTable::operator*=() with mismatched sizes");
         if (_dk != rhs._dk) throw FFTError("KTable::operator*=() with mismatched dk");
@@ -114,7 +112,6 @@ namespace galsim {
 
     void KTable::operator*=(double scale)
     {
-        clearCache(); // invalidate any stored interpolations
         check_array();
         for (int i=0; i<_N*(_No2+1); ++i)
             _array[i] *= scale;
@@ -297,7 +294,7 @@ namespace galsim {
     // Interpolate table to some specific k.  We WILL wrap the KTable to cover
     // entire interpolation kernel:
     std::complex<double> KTable::interpolate(
-        double kx, double ky, const Interpolant2d& interp) const 
+        double kx, double ky, const Interpolant2d& interp, Cache& cache) const
     {
         dbg<<"Start KTable interpolate at "<<kx<<','<<ky<<std::endl;
         dbg<<"N = "<<_N<<std::endl;
@@ -352,22 +349,22 @@ namespace galsim {
             // We have the opportunity to speed up the calculation by
             // re-using the sums over rows.  So we will keep a 
             // cache of them.
-            if (kx != _cacheX || ixy != _cacheInterp) {
-                clearCache();
-                _cacheX = kx;
-                _cacheInterp = ixy;
-            } else if (iyMax==iyMin+1 && !_cache.empty()) {
+            if (kx != cache.x || ixy != cache.interp) {
+                cache.clear();
+                cache.x = kx;
+                cache.interp = ixy;
+            } else if (iyMax==iyMin+1 && !cache.rows.empty()) {
                 // Special case for interpolation on a single iy value:
                 // See if we already have this row in cache:
-                int index = iyMin - _cacheStartY;
+                int index = iyMin - cache.startY;
                 if (index < 0) index += _N;
-                if (index < int(_cache.size()))
+                if (index < int(cache.rows.size()))
                     // We have it!
-                    return _cache[index];
+                    return cache.rows[index];
                 else
                     // Desired row not in cache - kill cache, continue as normal.
                     // (But don't clear xwt, since that's still good.)
-                    _cache.clear();
+                    cache.rows.clear();
             }
 
             const bool simple_xval = ixy->xrange() <= _Nd;
@@ -377,8 +374,8 @@ namespace galsim {
             if (nx<=0) nx += _N;
             dbg<<"nx = "<<nx<<std::endl;
             // This is also cached if possible.  It gets cleared when kx != cacheX above.
-            if (_xwt.empty()) {
-                _xwt.resize(nx);
+            if (cache.xwt.empty()) {
+                cache.xwt.resize(nx);
                 int ix = ixMin;
                 if (simple_xval) {
                     // Then simple xval is fine (and faster)
@@ -388,30 +385,30 @@ namespace galsim {
                     for (int i=0; i<nx; ++i, ++ix, ++arg) {
                         dbg<<"Call xval for arg = "<<arg<<std::endl;
                         if (arg > _halfNd) arg -= _Nd;
-                        _xwt[i] = ixy->xval1d(arg);
-                        dbg<<"xwt["<<i<<"] = "<<_xwt[i]<<std::endl;
+                        cache.xwt[i] = ixy->xval1d(arg);
+                        dbg<<"xwt["<<i<<"] = "<<cache.xwt[i]<<std::endl;
                     }
                 } else {
                     // Then might need to wrap to do the sum that's in xvalWrapped...
                     for (int i=0; i<nx; ++i, ++ix) {
                         dbg<<"Call xvalWrapped1d for ix-kx = "<<ix<<" - "<<kx<<" = "<<
                             ix-kx<<std::endl;
-                        _xwt[i] = ixy->xvalWrapped1d(ix-kx, _N);
-                        dbg<<"xwt["<<i<<"] = "<<_xwt[i]<<std::endl;
+                        cache.xwt[i] = ixy->xvalWrapped1d(ix-kx, _N);
+                        dbg<<"xwt["<<i<<"] = "<<cache.xwt[i]<<std::endl;
                     }
                 }
             } else {
-                assert(int(_xwt.size()) == nx);
+                assert(int(cache.xwt.size()) == nx);
             }
 
             // cache always holds sequential y values (with wrap).  Throw away
             // elements until we get to the one we need first
-            std::deque<std::complex<double> >::iterator nextSaved = _cache.begin();
-            while (nextSaved != _cache.end() && _cacheStartY != iyMin) {
-                _cache.pop_front();
-                ++_cacheStartY;
-                if (_cacheStartY >= _No2) _cacheStartY -= _N;
-                nextSaved = _cache.begin();
+            std::deque<std::complex<double> >::iterator nextSaved = cache.rows.begin();
+            while (nextSaved != cache.rows.end() && cache.startY != iyMin) {
+                cache.rows.pop_front();
+                ++cache.startY;
+                if (cache.startY >= _No2) cache.startY -= _N;
+                nextSaved = cache.rows.begin();
             }
 
             // Accumulate sum of 
@@ -432,7 +429,7 @@ namespace galsim {
                 if (iy >= _No2) iy -= _N;   // wrap iy if needed
                 dbg<<"ny = "<<ny<<", iy = "<<iy<<std::endl;
                 std::complex<double> sumy = 0.;
-                if (nextSaved != _cache.end()) {
+                if (nextSaved != cache.rows.end()) {
                     // This row is cached
                     sumy = *nextSaved;
                     ++nextSaved;
@@ -444,15 +441,15 @@ namespace galsim {
                     for (int i=0; i<nx; ++i, ++ix) {
                         if (ix > N/2) ix -= N; //check for wrap
                         dbg<<"i = "<<i<<", ix = "<<ix<<std::endl;
-                        dbg<<"xwt = "<<_xwt[i]<<", kval = "<<kval(ix,iy)<<std::endl;
-                        sumy += _xwt[i]*kval(ix,iy);
+                        dbg<<"xwt = "<<cache.xwt[i]<<", kval = "<<kval(ix,iy)<<std::endl;
+                        sumy += cache.xwt[i]*kval(ix,iy);
                         dbg<<"index = "<<index(ix,iy)<<", sumy -> "<<sumy<<std::endl;
                     }
 #else
 
                     // Faster way using ptrs, which doesn't need to do index(ix,iy) every time.
                     int count = nx;
-                    const double* xwt_it = &_xwt[0];
+                    const double* xwt_it = &cache.xwt[0];
                     // First do any initial negative ix values:
                     if (ix < 0) {
                         dbg<<"Some initial negative ix: ix = "<<ix<<std::endl;
@@ -486,12 +483,12 @@ namespace galsim {
                             //xwt_it += count;
                         }
                     }
-                    //xassert(xwt_it == &_xwt[0] + _xwt.size());
+                    //xassert(xwt_it == &cache.xwt[0] + cache.xwt.size());
 #endif
                     // Add to back of cache
-                    if (_cache.empty()) _cacheStartY = iy;
-                    _cache.push_back(sumy);
-                    nextSaved = _cache.end();
+                    if (cache.rows.empty()) cache.startY = iy;
+                    cache.rows.push_back(sumy);
+                    nextSaved = cache.rows.end();
                 }
                 if (simple_xval) {
                     if (arg > _halfNd) arg -= _Nd;
@@ -527,7 +524,6 @@ namespace galsim {
     // Fill table from a function:
     void KTable::fill(KTable::function1 func)
     {
-        clearCache(); // invalidate any stored interpolations
         check_array();
         std::complex<double>* zptr=_array.get();
         double kx, ky;
@@ -728,7 +724,6 @@ namespace galsim {
     // Translate the PSF to be for source at (x0,y0);
     void KTable::translate(double x0, double y0) 
     {
-        clearCache(); // invalidate any stored interpolations
         check_array();
         // convert to phases:
         x0*=_dk; y0*=_dk;
@@ -786,20 +781,17 @@ namespace galsim {
     void XTable::xSet(int ix, int iy, double value) 
     {
         check_array();
-        clearCache(); // invalidate any stored interpolations
         _array[index(ix,iy)]=value;
     }
 
     void XTable::clear() 
     {
-        clearCache(); // invalidate any stored interpolations
         _array.fill(0.);
     }
 
     void XTable::accumulate(const XTable& rhs, double scalar) 
     {
         check_array();
-        clearCache(); // invalidate any stored interpolations
         if (_N != rhs._N) throw FFTError("XTable::accumulate() with mismatched sizes");
         const int Nsq = _N*_N;
         for (int i=0; i<Nsq; ++i)
@@ -809,7 +801,6 @@ namespace galsim {
     void XTable::operator*=(double scale) 
     {
         check_array();
-        clearCache(); // invalidate any stored interpolations
         const int Nsq = _N*_N;
         for (int i=0; i<Nsq; ++i)
             _array[i] *= scale;
@@ -817,7 +808,8 @@ namespace galsim {
 
     // Interpolate table (linearly) to some specific k:
     // x any y in physical units (to be divided by dx for indices)
-    double XTable::interpolate(double x, double y, const Interpolant2d& interp) const 
+    double XTable::interpolate(double x, double y, const Interpolant2d& interp,
+                               Cache& cache) const
     {
         xdbg << "interpolating " << x << " " << y << " " << std::endl;
         x *= _invdx;
@@ -854,61 +846,61 @@ namespace galsim {
             // We have the opportunity to speed up the calculation by
             // re-using the sums over rows.  So we will keep a 
             // cache of them.
-            if (x != _cacheX || ixy != _cacheInterp) {
-                clearCache();
-                _cacheX = x;
-                _cacheInterp = ixy;
-            } else if (iyMax==iyMin && !_cache.empty()) {
+            if (x != cache.x || ixy != cache.interp) {
+                cache.clear();
+                cache.x = x;
+                cache.interp = ixy;
+            } else if (iyMax==iyMin && !cache.rows.empty()) {
                 // Special case for interpolation on a single iy value:
                 // See if we already have this row in cache:
-                int index = iyMin - _cacheStartY;
+                int index = iyMin - cache.startY;
                 if (index < 0) index += _N;
-                if (index < int(_cache.size())) 
+                if (index < int(cache.rows.size())) 
                     // We have it!
-                    return _cache[index];
+                    return cache.rows[index];
                 else
                     // Desired row not in cache - kill cache, continue as normal.
                     // (But don't clear xwt, since that's still good.)
-                    _cache.clear();
+                    cache.rows.clear();
             }
 
             // Build x factors for interpolant
             int nx = ixMax - ixMin + 1;
             // This is also cached if possible.  It gets cleared when kx != cacheX above.
-            if (_xwt.empty()) {
-                _xwt.resize(nx);
+            if (cache.xwt.empty()) {
+                cache.xwt.resize(nx);
                 for (int i=0; i<nx; ++i) 
-                    _xwt[i] = ixy->xval1d(i+ixMin-x);
+                    cache.xwt[i] = ixy->xval1d(i+ixMin-x);
             } else {
-                assert(int(_xwt.size()) == nx);
+                assert(int(cache.xwt.size()) == nx);
             }
 
             // cache always holds sequential y values (no wrap).  Throw away
             // elements until we get to the one we need first
-            std::deque<double>::iterator nextSaved = _cache.begin();
-            while (nextSaved != _cache.end() && _cacheStartY != iyMin) {
-                _cache.pop_front();
-                ++_cacheStartY;
-                nextSaved = _cache.begin();
+            std::deque<double>::iterator nextSaved = cache.rows.begin();
+            while (nextSaved != cache.rows.end() && cache.startY != iyMin) {
+                cache.rows.pop_front();
+                ++cache.startY;
+                nextSaved = cache.rows.begin();
             }
 
             for (int iy=iyMin; iy<=iyMax; ++iy) {
                 double sumy = 0.;
-                if (nextSaved != _cache.end()) {
+                if (nextSaved != cache.rows.end()) {
                     // This row is cached
                     sumy = *nextSaved;
                     ++nextSaved;
                 } else {
                     // Need to compute a new row's sum
                     const double* dptr = _array.get() + index(ixMin, iy);
-                    std::vector<double>::const_iterator xwt_it = _xwt.begin();
+                    std::vector<double>::const_iterator xwt_it = cache.xwt.begin();
                     int count = nx;
                     for(; count; --count) sumy += (*xwt_it++) * (*dptr++);
-                    xassert(xwt_it == _xwt.end());
+                    xassert(xwt_it == cache.xwt.end());
                     // Add to back of cache
-                    if (_cache.empty()) _cacheStartY = iy;
-                    _cache.push_back(sumy);
-                    nextSaved = _cache.end();
+                    if (cache.rows.empty()) cache.startY = iy;
+                    cache.rows.push_back(sumy);
+                    nextSaved = cache.rows.end();
                 }
                 sum += sumy * ixy->xval1d(iy-y);
             }
@@ -927,7 +919,6 @@ namespace galsim {
     void XTable::fill(XTable::function1 func)
     {
         check_array();
-        clearCache(); // invalidate any stored interpolations
         double* zptr=_array.get();
         double x, y;
         for (int iy=0; iy<_N; ++iy) {
@@ -1016,13 +1007,16 @@ namespace galsim {
         XTable xt( _N, 2.*M_PI*_invNd*_invdk );
 
         // Note: The fftw_execute function is the only thread-safe FFTW routine.
-        // So if we decide to go with some kind of multi-threading (rather than multi-process
-        // parallelism) all of the plan creation and destruction calls in this file 
-        // will need to be placed in critical blocks or the equivalent (mutex locks, etc.).
-        fftw_plan plan = fftw_plan_dft_c2r_2d(
-            _N, _N, t_array.get_fftw(), xt._array.get_fftw(), FFTW_MEASURE);
+        // So all of the plan creation and destruction calls in this file hold the
+        // fftw_plan_mutex, since the python layer may draw from several threads at once.
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_c2r_2d(
+                _N, _N, t_array.get_fftw(), xt._array.get_fftw(), FFTW_MEASURE);
+            if (plan) fftw_destroy_plan(plan);
+        }
         if (plan==NULL) throw FFTInvalid();
-        fftw_destroy_plan(plan);
     }
 
     // Fourier transform from (complex) k to x:
@@ -1053,15 +1047,22 @@ namespace galsim {
         }
         dbg<<"After fill t_array"<<std::endl;
 
-        fftw_plan plan = fftw_plan_dft_c2r_2d(
-            _N, _N, t_array.get_fftw(), xt._array.get_fftw(), FFTW_ESTIMATE);
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_c2r_2d(
+                _N, _N, t_array.get_fftw(), xt._array.get_fftw(), FFTW_ESTIMATE);
+        }
         dbg<<"After make plan"<<std::endl;
         if (plan==NULL) throw FFTInvalid();
 
         // Run the transform:
         fftw_execute(plan);
         dbg<<"After exec plan"<<std::endl;
-        fftw_destroy_plan(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
         dbg<<"After destroy plan"<<std::endl;
 
         xt._dx = 2.*M_PI*_invNd*_invdk;
@@ -1085,11 +1086,14 @@ namespace galsim {
 
         KTable kt( _N, 2.*M_PI*_invNd*_invdx );
 
-        fftw_plan plan = fftw_plan_dft_r2c_2d(
-            _N,_N, t_array.get_fftw(), kt._array.get_fftw(), FFTW_MEASURE);
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_r2c_2d(
+                _N,_N, t_array.get_fftw(), kt._array.get_fftw(), FFTW_MEASURE);
+            if (plan) fftw_destroy_plan(plan);
+        }
         if (plan==NULL) throw FFTInvalid();
-
-        fftw_destroy_plan(plan);
     }
 
     // Fourier transform from x back to (complex) k:
@@ -1100,11 +1104,18 @@ namespace galsim {
         // Make a new copy of data array since measurement will overwrite:
         FFTW_Array<double> t_array = _array;
 
-        fftw_plan plan = fftw_plan_dft_r2c_2d(
-            _N,_N, t_array.get_fftw(), kt._array.get_fftw(), FFTW_ESTIMATE);
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_r2c_2d(
+                _N,_N, t_array.get_fftw(), kt._array.get_fftw(), FFTW_ESTIMATE);
+        }
         if (plan==NULL) throw FFTInvalid();
         fftw_execute(plan);
-        fftw_destroy_plan(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
 
         // Now scale the k spectrum and flip signs for x=0 in middle.
         double fac = _dx * _dx; 
@@ -0,0 +1,897 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+//#define DEBUGLOGGING
+
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <cstdlib>
+#include <cstring>
+#include <sys/types.h>
+#include <zlib.h>
+
+#include "FitsIO.h"
+
+namespace galsim {
+
+namespace {
+
+    const int BLOCK = 2880;     // FITS files are written in blocks of this many bytes.
+    const int CARD = 80;        // Each header card is this long.
+
+    //
+    // Byte order
+    //
+
+    inline bool HostIsLittleEndian()
+    {
+        const int one = 1;
+        return *reinterpret_cast<const char*>(&one) == 1;
+    }
+
+    // Copy n values of size nbytes, reversing the byte order of each if swap is true.
+    void CopyBytes(const unsigned char* in, unsigned char* out, long n, int nbytes, bool swap)
+    {
+        if (!swap || nbytes == 1) {
+            std::memcpy(out, in, n * nbytes);
+        } else {
+            for (long i=0; i<n; ++i, in+=nbytes, out+=nbytes)
+                for (int k=0; k<nbytes; ++k) out[k] = in[nbytes-1-k];
+        }
+    }
+
+    template <typename T> struct FitsBitpix {};
+    template <> struct FitsBitpix<int16_t> { enum { value = 16 }; };
+    template <> struct FitsBitpix<int32_t> { enum { value = 32 }; };
+    template <> struct FitsBitpix<float> { enum { value = -32 }; };
+    template <> struct FitsBitpix<double> { enum { value = -64 }; };
+
+    //
+    // Header cards
+    //
+
+    std::string Card(const std::string& key, const std::string& value)
+    {
+        std::ostringstream os;
+        os << std::left << std::setw(8) << key << "= " << std::right << std::setw(20) << value;
+        std::string card = os.str();
+        card.resize(CARD, ' ');
+        return card;
+    }
+
+    std::string IntCard(const std::string& key, long value)
+    {
+        std::ostringstream os;
+        os << value;
+        return Card(key, os.str());
+    }
+
+    std::string LogicalCard(const std::string& key, bool value)
+    { return Card(key, value ? "T" : "F"); }
+
+    // String values start in column 11, and are padded to at least 8 characters.
+    std::string StringCard(const std::string& key, const std::string& value)
+    {
+        std::ostringstream os;
+        os << std::left << std::setw(8) << key << "= '" << std::setw(8) << value << "'";
+        std::string card = os.str();
+        card.resize(CARD, ' ');
+        return card;
+    }
+
+    std::string EndCard()
+    {
+        std::string card = "END";
+        card.resize(CARD, ' ');
+        return card;
+    }
+
+    void PadToBlock(std::string& header)
+    {
+        header.resize(((header.size() + BLOCK - 1) / BLOCK) * BLOCK, ' ');
+    }
+
+    // Parse the header cards of an HDU into a map of keyword to (unquoted) value.
+    // Returns false at the end of the file.
+    bool ReadHeader(std::FILE* fin, std::map<std::string,std::string>& header)
+    {
+        header.clear();
+        char block[BLOCK];
+        while (true) {
+            if (std::fread(block, 1, BLOCK, fin) != size_t(BLOCK)) return false;
+            for (int k=0; k<BLOCK; k+=CARD) {
+                std::string card(block+k, CARD);
+                std::string key = card.substr(0,8);
+                key.erase(key.find_last_not_of(' ')+1);
+                if (key == "END") return true;
+                if (card.substr(8,2) != "= ") continue;
+                std::string value = card.substr(10);
+                size_t i1 = value.find_first_not_of(' ');
+                if (i1 == std::string::npos) continue;
+                if (value[i1] == '\'') {
+                    // String value, in which '' represents a single quote.
+                    std::string s;
+                    for (size_t i=i1+1; i<value.size(); ++i) {
+                        if (value[i] == '\'') {
+                            if (i+1 < value.size() && value[i+1] == '\'') { s += '\''; ++i; }
+                            else break;
+                        } else {
+                            s += value[i];
+                        }
+                    }
+                    s.erase(s.find_last_not_of(' ')+1);
+                    header[key] = s;
+                } else {
+                    value = value.substr(i1, value.find('/') - i1);
+                    value.erase(value.find_last_not_of(' ')+1);
+                    header[key] = value;
+                }
+            }
+        }
+    }
+
+    bool HasKey(const std::map<std::string,std::string>& header, const std::string& key)
+    { return header.find(key) != header.end(); }
+
+    long GetLong(const std::map<std::string,std::string>& header, const std::string& key,
+                 long def)
+    {
+        std::map<std::string,std::string>::const_iterator it = header.find(key);
+        return it == header.end() ? def : std::atol(it->second.c_str());
+    }
+
+    double GetDouble(const std::map<std::string,std::string>& header, const std::string& key,
+                     double def)
+    {
+        std::map<std::string,std::string>::const_iterator it = header.find(key);
+        if (it == header.end()) return def;
+        // FITS allows D as the exponent character.
+        std::string s = it->second;
+        for (size_t i=0; i<s.size(); ++i) if (s[i] == 'D' || s[i] == 'd') s[i] = 'E';
+        return std::atof(s.c_str());
+    }
+
+    std::string GetString(const std::map<std::string,std::string>& header,
+                          const std::string& key, const std::string& def)
+    {
+        std::map<std::string,std::string>::const_iterator it = header.find(key);
+        return it == header.end() ? def : it->second;
+    }
+
+    //
+    // Compression
+    //
+
+    void GzipCompress(const unsigned char* in, long n, std::vector<unsigned char>& out)
+    {
+        z_stream z;
+        std::memset(&z, 0, sizeof(z));
+        // windowBits = 15 + 16 writes the gzip format, which is what the convention uses.
+        if (deflateInit2(&z, Z_BEST_SPEED, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw FitsError("Error initializing gzip compression");
+        out.resize(deflateBound(&z, n) + 32);
+        z.next_in = const_cast<unsigned char*>(in);
+        z.avail_in = n;
+        z.next_out = &out[0];
+        z.avail_out = out.size();
+        int status = deflate(&z, Z_FINISH);
+        long nout = z.total_out;
+        deflateEnd(&z);
+        if (status != Z_STREAM_END) throw FitsError("Error in gzip compression");
+        out.resize(nout);
+    }
+
+    void GzipDecompress(const unsigned char* in, long n, unsigned char* out, long nout)
+    {
+        z_stream z;
+        std::memset(&z, 0, sizeof(z));
+        // windowBits = 15 + 32 accepts either the gzip or zlib format.
+        if (inflateInit2(&z, 15+32) != Z_OK)
+            throw FitsError("Error initializing gzip decompression");
+        z.next_in = const_cast<unsigned char*>(in);
+        z.avail_in = n;
+        z.next_out = out;
+        z.avail_out = nout;
+        int status = inflate(&z, Z_FINISH);
+        long ndone = z.total_out;
+        inflateEnd(&z);
+        if ((status != Z_STREAM_END && status != Z_OK) || ndone != nout)
+            throw FitsError("Error in gzip decompression of tile");
+    }
+
+    // Rice compression, following the algorithm of fits_rcomp in cfitsio.
+    // U is the unsigned type with the size of the pixels.
+    template <typename U>
+    struct RiceParams {};
+    template <> struct RiceParams<uint8_t> { enum { fsbits = 3, fsmax = 6, bbits = 8 }; };
+    template <> struct RiceParams<uint16_t> { enum { fsbits = 4, fsmax = 14, bbits = 16 }; };
+    template <> struct RiceParams<uint32_t> { enum { fsbits = 5, fsmax = 25, bbits = 32 }; };
+
+    class BitWriter
+    {
+    public:
+        BitWriter(std::vector<unsigned char>& out) : _out(out), _buf(0), _nbits(0) {}
+        // Write the low n bits of value (n <= 32).
+        void write(uint32_t value, int n)
+        {
+            while (n > 0) {
+                int k = std::min(n, 8 - _nbits);
+                n -= k;
+                _buf = (_buf << k) | ((value >> n) & ((1u << k) - 1));
+                _nbits += k;
+                if (_nbits == 8) { _out.push_back(_buf); _buf = 0; _nbits = 0; }
+            }
+        }
+        void writeZeros(uint32_t n)
+        {
+            while (n >= 32) { write(0,32); n -= 32; }
+            write(0,n);
+        }
+        void flush() { if (_nbits > 0) write(0, 8-_nbits); }
+    private:
+        std::vector<unsigned char>& _out;
+        uint32_t _buf;
+        int _nbits;
+    };
+
+    class BitReader
+    {
+    public:
+        BitReader(const unsigned char* in, long n) : _in(in), _end(in+n), _buf(0), _nbits(0) {}
+        uint32_t read(int n)
+        {
+            uint32_t value = 0;
+            while (n > 0) {
+                if (_nbits == 0) next();
+                int k = std::min(n, _nbits);
+                _nbits -= k;
+                n -= k;
+                value = (value << k) | ((_buf >> _nbits) & ((1u << k) - 1));
+            }
+            return value;
+        }
+        // Count the zero bits before the next one bit, and skip past the one.
+        uint32_t readZeros()
+        {
+            uint32_t nzero = 0;
+            while (true) {
+                if (_nbits == 0) next();
+                --_nbits;
+                if ((_buf >> _nbits) & 1) return nzero;
+                ++nzero;
+            }
+        }
+    private:
+        void next()
+        {
+            if (_in == _end) throw FitsError("Unexpected end of Rice compressed data");
+            _buf = *_in++;
+            _nbits = 8;
+        }
+        const unsigned char* _in;
+        const unsigned char* _end;
+        uint32_t _buf;
+        int _nbits;
+    };
+
+    template <typename U>
+    void RiceCompress(const U* in, long n, int nblock, std::vector<unsigned char>& out)
+    {
+        typedef RiceParams<U> P;
+        out.clear();
+        if (n == 0) return;
+        BitWriter bits(out);
+        // The first value is written directly.
+        bits.write(in[0], P::bbits);
+        U last = in[0];
+        std::vector<U> diff(nblock);
+        for (long i=0; i<n; i+=nblock) {
+            const int nb = int(std::min(long(nblock), n-i));
+            double sum = 0.;
+            for (int j=0; j<nb; ++j) {
+                // Map the differences to unsigned values, 0,-1,1,-2,2... -> 0,1,2,3,4...
+                U d = U(in[i+j] - last);
+                U top = U(d >> (P::bbits-1));
+                diff[j] = U(U(d << 1) ^ U(U(0) - top));
+                sum += diff[j];
+                last = in[i+j];
+            }
+            // Choose the number of bits to split off each value based on the mean.
+            double dpsum = (sum - (nb/2) - 1) / nb;
+            if (dpsum < 0.) dpsum = 0.;
+            uint32_t psum = uint32_t(dpsum) >> 1;
+            int fs = 0;
+            for (; psum > 0; ++fs) psum >>= 1;
+
+            if (fs >= P::fsmax) {
+                // High entropy: write the differences directly.
+                bits.write(P::fsmax+1, P::fsbits);
+                for (int j=0; j<nb; ++j) bits.write(diff[j], P::bbits);
+            } else if (fs == 0 && sum == 0.) {
+                // All differences are zero.
+                bits.write(0, P::fsbits);
+            } else {
+                bits.write(fs+1, P::fsbits);
+                const uint32_t mask = (1u << fs) - 1;
+                for (int j=0; j<nb; ++j) {
+                    uint32_t v = diff[j];
+                    bits.writeZeros(v >> fs);
+                    bits.write(1,1);
+                    if (fs > 0) bits.write(v & mask, fs);
+                }
+            }
+        }
+        bits.flush();
+    }
+
+    template <typename U>
+    void RiceDecompress(const unsigned char* in, long nin, int nblock, U* out, long n)
+    {
+        typedef RiceParams<U> P;
+        if (n == 0) return;
+        BitReader bits(in, nin);
+        U last = U(bits.read(P::bbits));
+        for (long i=0; i<n; i+=nblock) {
+            const int nb = int(std::min(long(nblock), n-i));
+            const int fs = int(bits.read(P::fsbits)) - 1;
+            for (int j=0; j<nb; ++j) {
+                U d;
+                if (fs < 0) {
+                    d = 0;
+                } else if (fs == P::fsmax) {
+                    d = U(bits.read(P::bbits));
+                } else {
+                    uint32_t top = bits.readZeros();
+                    uint32_t v = (top << fs) | (fs > 0 ? bits.read(fs) : 0);
+                    d = U(v);
+                }
+                // Undo the mapping to unsigned values.
+                d = (d & 1) ? U(~(d >> 1)) : U(d >> 1);
+                last = U(last + d);
+                out[i+j] = last;
+            }
+        }
+    }
+
+    const int riceBlockSize = 32;
+
+    template <typename T>
+    struct RiceType { typedef uint32_t type; };
+    template <>
+    struct RiceType<int16_t> { typedef uint16_t type; };
+
+    // Compress one tile of pixels.
+    template <typename T>
+    void CompressTile(const T* data, long n, int compress, std::vector<unsigned char>& out)
+    {
+        if (compress == 1) {
+            std::vector<unsigned char> be(n * sizeof(T));
+            CopyBytes(reinterpret_cast<const unsigned char*>(data), &be[0], n, sizeof(T),
+                      HostIsLittleEndian());
+            GzipCompress(&be[0], n * sizeof(T), out);
+        } else {
+            typedef typename RiceType<T>::type U;
+            std::vector<U> u(data, data+n);
+            RiceCompress(&u[0], n, riceBlockSize, out);
+        }
+    }
+
+    //
+    // Conversion from the file's pixel type to T
+    //
+
+    template <typename F, typename T>
+    void ConvertPixels(const F* in, T* out, long n, double bscale, double bzero)
+    {
+        if (bscale == 1. && bzero == 0.) {
+            for (long i=0; i<n; ++i) out[i] = T(in[i]);
+        } else {
+            for (long i=0; i<n; ++i) out[i] = T(in[i] * bscale + bzero);
+        }
+    }
+
+    // Convert n big-endian values with the given BITPIX to T.
+    template <typename T>
+    void ConvertFromFile(const unsigned char* in, int bitpix, T* out, long n,
+                         double bscale, double bzero)
+    {
+        const int nbytes = std::abs(bitpix) / 8;
+        std::vector<unsigned char> buf(n * nbytes);
+        CopyBytes(in, &buf[0], n, nbytes, HostIsLittleEndian());
+        const void* p = &buf[0];
+        switch (bitpix) {
+          case 8:
+               ConvertPixels(static_cast<const uint8_t*>(p), out, n, bscale, bzero);
+               break;
+          case 16:
+               ConvertPixels(static_cast<const int16_t*>(p), out, n, bscale, bzero);
+               break;
+          case 32:
+               ConvertPixels(static_cast<const int32_t*>(p), out, n, bscale, bzero);
+               break;
+          case 64:
+               ConvertPixels(static_cast<const int64_t*>(p), out, n, bscale, bzero);
+               break;
+          case -32:
+               ConvertPixels(static_cast<const float*>(p), out, n, bscale, bzero);
+               break;
+          case -64:
+               ConvertPixels(static_cast<const double*>(p), out, n, bscale, bzero);
+               break;
+          default:
+               FormatAndThrow<FitsError>() << "Invalid BITPIX = " << bitpix;
+        }
+    }
+
+    // Decompress one tile of n pixels into big-endian values with the given BITPIX.
+    void DecompressTile(const unsigned char* in, long nin, const std::string& cmptype,
+                        int bitpix, int bytepix, int blocksize,
+                        std::vector<unsigned char>& out, long n)
+    {
+        const int nbytes = std::abs(bitpix) / 8;
+        out.resize(n * nbytes);
+        if (cmptype == "GZIP_1") {
+            GzipDecompress(in, nin, &out[0], n * nbytes);
+        } else {
+            // Rice compressed data are integers of size bytepix, which we convert to
+            // big-endian values of the type given by bitpix.
+            if (bitpix < 0) throw FitsError("RICE_1 compression of floating point data");
+            std::vector<int64_t> values(n);
+            if (bytepix == 1) {
+                std::vector<uint8_t> u(n);
+                RiceDecompress(in, nin, blocksize, &u[0], n);
+                for (long i=0; i<n; ++i) values[i] = u[i];
+            } else if (bytepix == 2) {
+                std::vector<uint16_t> u(n);
+                RiceDecompress(in, nin, blocksize, &u[0], n);
+                for (long i=0; i<n; ++i) values[i] = int16_t(u[i]);
+            } else if (bytepix == 4) {
+                std::vector<uint32_t> u(n);
+                RiceDecompress(in, nin, blocksize, &u[0], n);
+                for (long i=0; i<n; ++i) values[i] = int32_t(u[i]);
+            } else {
+                FormatAndThrow<FitsError>() << "Invalid BYTEPIX = " << bytepix;
+            }
+            for (long i=0; i<n; ++i) {
+                int64_t v = values[i];
+                for (int k=nbytes-1; k>=0; --k, v >>= 8) out[i*nbytes+k] = (unsigned char)(v);
+            }
+        }
+    }
+
+    void WriteBytes(std::FILE* fout, const void* data, size_t n, const std::string& file_name)
+    {
+        if (n > 0 && std::fwrite(data, 1, n, fout) != n)
+            FormatAndThrow<FitsError>() << "Error writing to file " << file_name;
+    }
+
+    void WriteBigEndianInts(std::FILE* fout, const std::vector<int>& values,
+                            const std::string& file_name)
+    {
+        if (values.empty()) return;
+        std::vector<unsigned char> buf(values.size() * 4);
+        for (size_t i=0; i<values.size(); ++i) {
+            uint32_t v = uint32_t(values[i]);
+            buf[4*i] = v >> 24;
+            buf[4*i+1] = v >> 16;
+            buf[4*i+2] = v >> 8;
+            buf[4*i+3] = v;
+        }
+        WriteBytes(fout, &buf[0], buf.size(), file_name);
+    }
+
+    int ReadBigEndianInt(const unsigned char* p)
+    { return int((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]); }
+
+    long ReadBigEndianLong(const unsigned char* p)
+    { return long((uint64_t(uint32_t(ReadBigEndianInt(p))) << 32) |
+                  uint32_t(ReadBigEndianInt(p+4))); }
+
+} // anonymous
+
+template <typename T>
+FitsWriter<T>::FitsWriter(const std::string& file_name, const Bounds<int>& bounds,
+                          const std::string& cards, const std::string& compression) :
+    _fileName(file_name), _bounds(bounds), _heapSize(0), _maxTileSize(0),
+    _pcountPos(0), _tformPos(0)
+{
+    if (!bounds.isDefined()) throw FitsError("Cannot write an image with undefined bounds");
+    if (cards.size() % CARD != 0) throw FitsError("Header cards must be 80 characters each");
+    if (compression == "none") _compress = 0;
+    else if (compression == "gzip_tile") _compress = 1;
+    else if (compression == "rice") _compress = 2;
+    else FormatAndThrow<FitsError>() << "Invalid compression " << compression;
+    if (_compress == 2 && FitsBitpix<T>::value < 0)
+        throw FitsError("Rice compression is only valid for integer pixel types");
+
+    _ncol = bounds.getXMax() - bounds.getXMin() + 1;
+    const int nrow = bounds.getYMax() - bounds.getYMin() + 1;
+    _nextRow = bounds.getYMin();
+
+    _fout = std::fopen(file_name.c_str(), "wb");
+    if (!_fout) FormatAndThrow<FitsError>() << "Unable to open file " << file_name;
+
+    std::string header = LogicalCard("SIMPLE", true);
+    if (_compress == 0) {
+        header += IntCard("BITPIX", FitsBitpix<T>::value);
+        header += IntCard("NAXIS", 2);
+        header += IntCard("NAXIS1", _ncol);
+        header += IntCard("NAXIS2", nrow);
+        header += LogicalCard("EXTEND", true);
+        header += cards;
+        header += EndCard();
+        PadToBlock(header);
+    } else {
+        // An empty primary HDU, followed by a binary table with one row for each tile.
+        // Each row has a descriptor (length, offset) of the compressed data in the heap.
+        header += IntCard("BITPIX", 8);
+        header += IntCard("NAXIS", 0);
+        header += LogicalCard("EXTEND", true);
+        header += EndCard();
+        PadToBlock(header);
+        header += StringCard("XTENSION", "BINTABLE");
+        header += IntCard("BITPIX", 8);
+        header += IntCard("NAXIS", 2);
+        header += IntCard("NAXIS1", 8);
+        header += IntCard("NAXIS2", nrow);
+        _pcountPos = header.size();
+        header += IntCard("PCOUNT", 0);
+        header += IntCard("GCOUNT", 1);
+        header += IntCard("TFIELDS", 1);
+        header += StringCard("TTYPE1", "COMPRESSED_DATA");
+        _tformPos = header.size();
+        header += StringCard("TFORM1", "1PB(0)");
+        header += LogicalCard("ZIMAGE", true);
+        header += IntCard("ZBITPIX", FitsBitpix<T>::value);
+        header += IntCard("ZNAXIS", 2);
+        header += IntCard("ZNAXIS1", _ncol);
+        header += IntCard("ZNAXIS2", nrow);
+        header += IntCard("ZTILE1", _ncol);
+        header += IntCard("ZTILE2", 1);
+        if (_compress == 1) {
+            header += StringCard("ZCMPTYPE", "GZIP_1");
+            if (FitsBitpix<T>::value < 0) header += StringCard("ZQUANTIZ", "NONE");
+        } else {
+            header += StringCard("ZCMPTYPE", "RICE_1");
+            header += StringCard("ZNAME1", "BLOCKSIZE");
+            header += IntCard("ZVAL1", riceBlockSize);
+            header += StringCard("ZNAME2", "BYTEPIX");
+            header += IntCard("ZVAL2", sizeof(T));
+        }
+        header += cards;
+        header += EndCard();
+        PadToBlock(header);
+        _descriptors.reserve(2*nrow);
+    }
+    WriteBytes(_fout, header.data(), header.size(), _fileName);
+    _dataStart = header.size();
+    if (_compress) {
+        // Leave space for the table, which is written when we close the file.
+        std::vector<unsigned char> zeros(8*long(nrow), 0);
+        WriteBytes(_fout, zeros.empty() ? 0 : &zeros[0], zeros.size(), _fileName);
+    }
+}
+
+template <typename T>
+FitsWriter<T>::~FitsWriter()
+{
+    if (_fout) {
+        try { finish(); } catch (...) {}
+    }
+}
+
+template <typename T>
+void FitsWriter<T>::write(const BaseImage<T>& rows)
+{
+    if (!_fout) throw FitsError("Attempt to write to a closed FitsWriter");
+    if (!rows.getData()) return;
+    const Bounds<int>& b = rows.getBounds();
+    if (b.getXMin() != _bounds.getXMin() || b.getXMax() != _bounds.getXMax())
+        throw FitsError("Rows written to FitsWriter must span the full width of the image");
+    if (b.getYMin() != _nextRow || b.getYMax() > _bounds.getYMax()) {
+        FormatAndThrow<FitsError>() << "Rows written to FitsWriter must start at row " <<
+            _nextRow << ", and end by row " << _bounds.getYMax();
+    }
+    const int nrow = b.getYMax() - b.getYMin() + 1;
+
+    if (_compress == 0) {
+        std::vector<unsigned char> buf(_ncol * sizeof(T));
+        const bool swap = HostIsLittleEndian();
+        for (int y=b.getYMin(); y<=b.getYMax(); ++y) {
+            CopyBytes(reinterpret_cast<const unsigned char*>(&rows(b.getXMin(),y)), &buf[0],
+                      _ncol, sizeof(T), swap);
+            WriteBytes(_fout, &buf[0], buf.size(), _fileName);
+        }
+    } else {
+        // Each row is a tile, so they can all be compressed independently.
+        std::vector<std::vector<unsigned char> > tiles(nrow);
+        std::string err;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int j=0; j<nrow; ++j) {
+            try {
+                CompressTile(&rows(b.getXMin(),b.getYMin()+j), _ncol, _compress, tiles[j]);
+            } catch (std::exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (FitsWriter)
+#endif
+                {
+                    if (err.empty()) err = e.what();
+                }
+            }
+        }
+        if (!err.empty()) throw FitsError(err);
+        for (int j=0; j<nrow; ++j) {
+            const long n = tiles[j].size();
+            if (_heapSize + n > 0x7fffffffL)
+                throw FitsError("Compressed image is too large for 32 bit heap descriptors");
+            _descriptors.push_back(n);
+            _descriptors.push_back(_heapSize);
+            WriteBytes(_fout, n > 0 ? &tiles[j][0] : 0, n, _fileName);
+            _heapSize += n;
+            _maxTileSize = std::max(_maxTileSize, n);
+        }
+    }
+    _nextRow += nrow;
+}
+
+template <typename T>
+void FitsWriter<T>::finish()
+{
+    const long nrow = _bounds.getYMax() - _bounds.getYMin() + 1;
+    long nbytes;
+    if (_compress == 0) {
+        nbytes = long(_ncol) * nrow * sizeof(T);
+    } else {
+        // Unwritten rows (if any) are left as empty tiles.
+        _descriptors.resize(2*nrow, 0);
+        nbytes = 8*nrow + _heapSize;
+    }
+    // Pad the data to a full block.  This also fills any unwritten rows with zeros.
+    const long nwritten = std::ftell(_fout) - _dataStart;
+    const long npad = ((nbytes + BLOCK - 1) / BLOCK) * BLOCK - nwritten;
+    std::vector<unsigned char> zeros(npad, 0);
+    WriteBytes(_fout, zeros.empty() ? 0 : &zeros[0], npad, _fileName);
+
+    if (_compress) {
+        // Now we know the sizes of the tiles, so fill in the table and the header cards
+        // that depend on them.
+        std::string pcount = IntCard("PCOUNT", _heapSize);
+        std::ostringstream tform;
+        tform << "1PB(" << _maxTileSize << ")";
+        std::string tform_card = StringCard("TFORM1", tform.str());
+        if (std::fseek(_fout, _pcountPos, SEEK_SET) != 0)
+            FormatAndThrow<FitsError>() << "Error seeking in file " << _fileName;
+        WriteBytes(_fout, pcount.data(), CARD, _fileName);
+        std::fseek(_fout, _tformPos, SEEK_SET);
+        WriteBytes(_fout, tform_card.data(), CARD, _fileName);
+        std::fseek(_fout, _dataStart, SEEK_SET);
+        WriteBigEndianInts(_fout, _descriptors, _fileName);
+    }
+    int status = std::fclose(_fout);
+    _fout = 0;
+    if (status != 0) FormatAndThrow<FitsError>() << "Error closing file " << _fileName;
+}
+
+template <typename T>
+void FitsWriter<T>::close()
+{
+    if (!_fout) return;
+    bool complete = _nextRow > _bounds.getYMax();
+    finish();
+    if (!complete) {
+        FormatAndThrow<FitsError>() << "FitsWriter closed after writing rows up to " <<
+            _nextRow-1 << " of " << _bounds.getYMax();
+    }
+}
+
+template <typename T>
+void WriteFitsImage(const BaseImage<T>& image, const std::string& file_name,
+                    const std::string& cards, const std::string& compression)
+{
+    FitsWriter<T> writer(file_name, image.getBounds(), cards, compression);
+    writer.write(image);
+    writer.close();
+}
+
+template <typename T>
+void ReadFitsImage(const ImageView<T>& image, const std::string& file_name, int hdu)
+{
+    if (!image.getData()) return;
+    std::FILE* fin = std::fopen(file_name.c_str(), "rb");
+    if (!fin) FormatAndThrow<FitsError>() << "Unable to open file " << file_name;
+
+    try {
+        // Skip to the requested HDU.
+        std::map<std::string,std::string> header;
+        off_t start = 0;
+        for (int k=0; ; ++k) {
+            if (!ReadHeader(fin, header)) {
+                FormatAndThrow<FitsError>() << "File " << file_name << " has fewer than " <<
+                    hdu+1 << " HDUs";
+            }
+            start = ftello(fin);
+            if (k == hdu) break;
+            const int naxis = GetLong(header, "NAXIS", 0);
+            long nbytes = 0;
+            if (naxis > 0) {
+                nbytes = 1;
+                for (int i=1; i<=naxis; ++i) {
+                    std::ostringstream key;
+                    key << "NAXIS" << i;
+                    nbytes *= GetLong(header, key.str(), 0);
+                }
+                nbytes += GetLong(header, "PCOUNT", 0);
+                nbytes *= GetLong(header, "GCOUNT", 1) * std::abs(GetLong(header, "BITPIX", 8))/8;
+            }
+            nbytes = ((nbytes + BLOCK - 1) / BLOCK) * BLOCK;
+            fseeko(fin, start + nbytes, SEEK_SET);
+        }
+
+        const bool compressed = GetString(header, "ZIMAGE", "F") == "T";
+        const std::string prefix = compressed ? "Z" : "";
+        const int bitpix = GetLong(header, prefix + "BITPIX", 0);
+        const int naxis = GetLong(header, prefix + "NAXIS", 0);
+        const long naxis1 = GetLong(header, prefix + "NAXIS1", 0);
+        const long naxis2 = GetLong(header, prefix + "NAXIS2", 0);
+        const double bscale = GetDouble(header, "BSCALE", 1.);
+        const double bzero = GetDouble(header, "BZERO", 0.);
+        const int nbytes = std::abs(bitpix) / 8;
+        if (naxis != 2) FormatAndThrow<FitsError>() << "HDU " << hdu << " is not a 2-d image";
+
+        const Bounds<int>& b = image.getBounds();
+        if (b.getXMin() < 1 || b.getXMax() > naxis1 || b.getYMin() < 1 || b.getYMax() > naxis2) {
+            FormatAndThrow<FitsError>() << "Bounds " << b << " are outside the image in HDU " <<
+                hdu << ", which is " << naxis1 << " x " << naxis2;
+        }
+        const int ncol = b.getXMax() - b.getXMin() + 1;
+
+        if (!compressed) {
+            std::vector<unsigned char> buf(ncol * nbytes);
+            for (int y=b.getYMin(); y<=b.getYMax(); ++y) {
+                off_t pos = start + ((off_t(y-1) * naxis1) + b.getXMin()-1) * nbytes;
+                if (fseeko(fin, pos, SEEK_SET) != 0 ||
+                    std::fread(&buf[0], 1, buf.size(), fin) != buf.size()) {
+                    FormatAndThrow<FitsError>() << "Error reading data from " << file_name;
+                }
+                ConvertFromFile(&buf[0], bitpix, &image(b.getXMin(),y), ncol, bscale, bzero);
+            }
+        } else {
+            const std::string cmptype = GetString(header, "ZCMPTYPE", "");
+            if (cmptype != "GZIP_1" && cmptype != "RICE_1")
+                FormatAndThrow<FitsError>() << "Unsupported compression type " << cmptype;
+            if (GetLong(header, "ZTILE1", naxis1) != naxis1)
+                throw FitsError("Only compressed tiles that span whole rows are supported");
+            const long tile_rows = GetLong(header, "ZTILE2", 1);
+            if (GetString(header, "TTYPE1", "") != "COMPRESSED_DATA")
+                throw FitsError("Expected COMPRESSED_DATA in the first column");
+            if (GetLong(header, "TFIELDS", 1) != 1) {
+                // Other columns are for quantized floating point values, or for tiles that
+                // could not be compressed.
+                throw FitsError("Only compressed images with a single column are supported");
+            }
+            const std::string tform = GetString(header, "TFORM1", "");
+            int desc_size;
+            if (tform.find("PB") != std::string::npos) desc_size = 4;
+            else if (tform.find("QB") != std::string::npos) desc_size = 8;
+            else FormatAndThrow<FitsError>() << "Unsupported column format " << tform;
+            const long row_size = GetLong(header, "NAXIS1", 0);
+            const long heap_start = GetLong(header, "THEAP", row_size * GetLong(header,"NAXIS2",0));
+            const double zscale = GetDouble(header, "ZSCALE", bscale);
+            const double zzero = GetDouble(header, "ZZERO", bzero);
+
+            // Compression parameters are given as ZNAMEn = 'NAME', ZVALn = value.
+            int blocksize = 32;
+            int bytepix = 4;
+            for (int i=1; ; ++i) {
+                std::ostringstream name, val;
+                name << "ZNAME" << i;
+                val << "ZVAL" << i;
+                if (!HasKey(header, name.str())) break;
+                if (GetString(header, name.str(), "") == "BLOCKSIZE")
+                    blocksize = GetLong(header, val.str(), blocksize);
+                else if (GetString(header, name.str(), "") == "BYTEPIX")
+                    bytepix = GetLong(header, val.str(), bytepix);
+            }
+
+            // Read the descriptors and compressed data for the tiles we need.
+            const int t1 = (b.getYMin()-1) / tile_rows;
+            const int t2 = (b.getYMax()-1) / tile_rows;
+            const int ntile = t2 - t1 + 1;
+            std::vector<std::vector<unsigned char> > tiles(ntile);
+            std::vector<unsigned char> desc(2*desc_size);
+            for (int t=t1; t<=t2; ++t) {
+                fseeko(fin, start + off_t(t) * row_size, SEEK_SET);
+                if (std::fread(&desc[0], 1, desc.size(), fin) != desc.size())
+                    FormatAndThrow<FitsError>() << "Error reading table from " << file_name;
+                long n, offset;
+                if (desc_size == 4) {
+                    n = ReadBigEndianInt(&desc[0]);
+                    offset = ReadBigEndianInt(&desc[4]);
+                } else {
+                    n = ReadBigEndianLong(&desc[0]);
+                    offset = ReadBigEndianLong(&desc[8]);
+                }
+                if (n == 0) throw FitsError("Missing compressed data for tile");
+                std::vector<unsigned char>& tile = tiles[t-t1];
+                tile.resize(n);
+                fseeko(fin, start + heap_start + offset, SEEK_SET);
+                if (std::fread(&tile[0], 1, n, fin) != size_t(n))
+                    FormatAndThrow<FitsError>() << "Error reading heap from " << file_name;
+            }
+
+            std::string err;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int t=t1; t<=t2; ++t) {
+                try {
+                    const int y1 = t * tile_rows + 1;
+                    const int y2 = std::min(long(y1) + tile_rows - 1, naxis2);
+                    std::vector<unsigned char> pixels;
+                    std::vector<unsigned char>& tile = tiles[t-t1];
+                    DecompressTile(&tile[0], tile.size(), cmptype, bitpix, bytepix, blocksize,
+                                   pixels, long(y2-y1+1) * naxis1);
+                    for (int y=std::max(y1,b.getYMin()); y<=std::min(y2,b.getYMax()); ++y) {
+                        const long k = (long(y-y1) * naxis1 + b.getXMin()-1) * nbytes;
+                        ConvertFromFile(&pixels[k], bitpix, &image(b.getXMin(),y), ncol,
+                                        zscale, zzero);
+                    }
+                } catch (std::exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (ReadFitsImage)
+#endif
+                    {
+                        if (err.empty()) err = e.what();
+                    }
+                }
+            }
+            if (!err.empty()) throw FitsError(err);
+        }
+    } catch (...) {
+        std::fclose(fin);
+        throw;
+    }
+    std::fclose(fin);
+}
+
+// instantiate for expected types
+
+template class FitsWriter<double>;
+template class FitsWriter<float>;
+template class FitsWriter<int32_t>;
+template class FitsWriter<int16_t>;
+
+template void WriteFitsImage(const BaseImage<double>& image, const std::string& file_name,
+                             const std::string& cards, const std::string& compression);
+template void WriteFitsImage(const BaseImage<float>& image, const std::string& file_name,
+                             const std::string& cards, const std::string& compression);
+template void WriteFitsImage(const BaseImage<int32_t>& image, const std::string& file_name,
+                             const std::string& cards, const std::string& compression);
+template void WriteFitsImage(const BaseImage<int16_t>& image, const std::string& file_name,
+                             const std::string& cards, const std::string& compression);
+
+template void ReadFitsImage(const ImageView<double>& image, const std::string& file_name, int);
+template void ReadFitsImage(const ImageView<float>& image, const std::string& file_name, int);
+template void ReadFitsImage(const ImageView<int32_t>& image, const std::string& file_name, int);
+template void ReadFitsImage(const ImageView<int16_t>& image, const std::string& file_name, int);
+
+} // namespace galsim
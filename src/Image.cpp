@@ -18,6 +18,15 @@
  */
 
 #include <sstream>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "Image.h"
 #include "ImageArith.h"
@@ -78,6 +87,18 @@ public:
     void operator()(T * p) const { delete [] p; }
 };
 
+// The deleter for memory-mapped images unmaps the whole mapped region, which starts at the
+// page boundary at or before the first pixel.
+template <typename T>
+class MappedFileDeleter {
+public:
+    MappedFileDeleter(void* addr, size_t length) : _addr(addr), _length(length) {}
+    void operator()(T * ) const { munmap(_addr, _length); }
+private:
+    void* _addr;
+    size_t _length;
+};
+
 } // anonymous
 
 template <typename T>
@@ -96,7 +117,8 @@ void BaseImage<T>::allocateMem()
     // for whether this is necessary.
     _stride = this->_bounds.getXMax() - this->_bounds.getXMin() + 1;
 
-    _nElements = _stride * (this->_bounds.getYMax() - this->_bounds.getYMin() + 1);
+    // Multiply as ptrdiff_t, since images with more than 2^31 pixels are possible.
+    _nElements = ptrdiff_t(_stride) * (this->_bounds.getYMax() - this->_bounds.getYMin() + 1);
     if (_stride <= 0 || _nElements <= 0) {
         FormatAndThrow<ImageError>() << 
             "Attempt to create an Image with defined but invalid Bounds ("<<this->_bounds<<")";
@@ -109,6 +131,62 @@ void BaseImage<T>::allocateMem()
     _data = _owner.get();
 }
 
+template <typename T>
+void BaseImage<T>::mapFile(const std::string& file_name, long offset)
+{
+    _stride = this->_bounds.getXMax() - this->_bounds.getXMin() + 1;
+    _nElements = ptrdiff_t(_stride) * (this->_bounds.getYMax() - this->_bounds.getYMin() + 1);
+    if (!this->_bounds.isDefined() || _stride <= 0 || _nElements <= 0) {
+        FormatAndThrow<ImageError>() << 
+            "Attempt to map an Image with invalid Bounds ("<<this->_bounds<<")";
+    }
+    if (offset < 0 || offset % sizeof(T) != 0) {
+        FormatAndThrow<ImageError>() << 
+            "Invalid offset "<<offset<<" for mapping an Image onto "<<file_name;
+    }
+    // The end of the image in the file needs to fit in an off_t, and the length of the
+    // mapping in a size_t.
+    const off_t max_end = std::min(std::numeric_limits<off_t>::max(),
+                                   off_t(std::numeric_limits<size_t>::max() >> 1));
+    if (_nElements > (max_end - offset) / off_t(sizeof(T))) {
+        FormatAndThrow<ImageError>() << 
+            "Image with Bounds ("<<this->_bounds<<") is too large to map onto "<<file_name;
+    }
+
+    int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        FormatAndThrow<ImageError>() << 
+            "Unable to open "<<file_name<<" for mapping: "<<strerror(errno);
+    }
+
+    // Make sure the file is big enough.  Extending it this way leaves a sparse file, so the
+    // disk pages are only allocated once something is written to them.
+    off_t end = offset + off_t(_nElements) * sizeof(T);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (st.st_size < end && ftruncate(fd, end) != 0)) {
+        int err = errno;
+        close(fd);
+        FormatAndThrow<ImageError>() << 
+            "Unable to extend "<<file_name<<" for mapping: "<<strerror(err);
+    }
+
+    // mmap needs the file offset to be a multiple of the page size.
+    long page_size = sysconf(_SC_PAGESIZE);
+    off_t start = (offset / page_size) * page_size;
+    size_t length = end - start;
+    void* addr = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, start);
+    int err = errno;
+    // The mapping keeps its own reference to the file, so we can close it now.
+    close(fd);
+    if (addr == MAP_FAILED) {
+        FormatAndThrow<ImageError>() << 
+            "Unable to map "<<file_name<<": "<<strerror(err);
+    }
+
+    _data = reinterpret_cast<T*>(reinterpret_cast<char*>(addr) + (offset - start));
+    _owner.reset(_data, MappedFileDeleter<T>(addr, length));
+}
+
 template <typename T>
 ImageAlloc<T>::ImageAlloc(int ncol, int nrow, T init_value) :
     BaseImage<T>(Bounds<int>(1,ncol,1,nrow)) 
@@ -139,6 +217,14 @@ ImageAlloc<T>::ImageAlloc(const Bounds<int>& bounds, const T init_value) :
     fill(init_value);
 }
 
+template <typename T>
+ImageAlloc<T>::ImageAlloc(const Bounds<int>& bounds, const std::string& file_name, long offset) :
+    BaseImage<T>(Bounds<int>())
+{
+    this->_bounds = bounds;
+    this->mapFile(file_name, offset);
+}
+
 template <typename T>
 void ImageAlloc<T>::resize(const Bounds<int>& new_bounds) 
 {
@@ -210,7 +296,7 @@ ConstImageView<T> BaseImage<T>::subImage(const Bounds<int>& bounds) const
             this->_bounds << ")";
     }
     T* newdata = _data
-        + (bounds.getYMin() - this->_bounds.getYMin()) * _stride
+        + ptrdiff_t(bounds.getYMin() - this->_bounds.getYMin()) * _stride
         + (bounds.getXMin() - this->_bounds.getXMin());
     return ConstImageView<T>(newdata,_owner,_stride,bounds);
 }
@@ -225,7 +311,7 @@ ImageView<T> ImageView<T>::subImage(const Bounds<int>& bounds) const
             this->_bounds << ")";
     }
     T* newdata = this->_data
-        + (bounds.getYMin() - this->_bounds.getYMin()) * this->_stride
+        + ptrdiff_t(bounds.getYMin() - this->_bounds.getYMin()) * this->_stride
         + (bounds.getXMin() - this->_bounds.getXMin());
     return ImageView<T>(newdata,this->_owner,this->_stride,bounds);
 }
@@ -261,13 +347,13 @@ public:
 template <typename T>
 void ImageView<T>::fill(T x) const 
 {
-    transform_pixel(*this, ConstReturn<T>(x));
+    apply_pixel(*this, ConstReturn<T>(x));
 }
 
 template <typename T>
 void ImageView<T>::invertSelf() const 
 {
-    transform_pixel(*this, ReturnInverse<T>());
+    apply_pixel(*this, ReturnInverse<T>());
 }
 
 template <typename T>
@@ -275,7 +361,7 @@ void ImageView<T>::copyFrom(const BaseImage<T>& rhs) const
 {
     if (!this->_bounds.isSameShapeAs(rhs.getBounds()))
         throw ImageError("Attempt im1 = im2, but bounds not the same shape");
-    transform_pixel(*this, rhs, ReturnSecond<T>());
+    apply_pixel(*this, rhs, ReturnSecond<T>());
 }
 
 // instantiate for expected types
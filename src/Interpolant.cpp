@@ -483,6 +483,7 @@ namespace galsim {
                 _tab->addEntry(u, ft);
                 if (std::abs(ft) > _tolerance) _uMax = u;
             }
+            _tab->setup();
             // Save these values in the cache.
             _cache_tab[tol] = _tab;
             _cache_umax[tol] = _uMax;
@@ -636,6 +637,7 @@ namespace galsim {
 #endif
                 if (std::abs(ft) > _tolerance) _uMax = u;
             }
+            _tab->setup();
             // Save these values in the cache.
             _cache_tab[tol] = _tab;
             _cache_umax[tol] = _uMax;
@@ -986,6 +988,7 @@ namespace galsim {
             // Make sure steps hit the integer values exactly.
             const double xStep = 1. / std::ceil(1./xStep1);
             for(double x=0.; x<_nd; x+=xStep) _xtab->addEntry(x, xCalc(x));
+            _xtab->setup();
 #endif
 
             // Build utab = table of u values
@@ -998,6 +1001,7 @@ namespace galsim {
                 _utab->addEntry(u, uval);
                 if (std::abs(uval) > _tolerance) _uMax = u;
             }
+            _utab->setup();
             // Save these values in the cache.
 #ifdef USE_TABLES
             _cache_xtab[key] = _xtab;
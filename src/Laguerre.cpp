@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 #include "BinomFact.h"
 #include "Laguerre.h"
@@ -329,7 +330,9 @@ namespace galsim {
         static double Lsign(double x) { return x; } 
 
         template <class V>
-        static void applyPrefactor(V v, double sigma) { v *= 1./(2.*M_PI*sigma*sigma); }
+        static void applyPrefactor(V v, double sigma) { v *= prefactor(sigma); }
+
+        static double prefactor(double sigma) { return 1./(2.*M_PI*sigma*sigma); }
     };
 
     // Now the fourier space version, marked by T being complex.
@@ -353,6 +356,8 @@ namespace galsim {
 
         template <class V>
         static void applyPrefactor(V , double ) {}
+
+        static double prefactor(double ) { return 1.; }
     };
 
     template <typename T>
@@ -486,6 +491,127 @@ namespace galsim {
     }
 
 
+    void LVector::sumBasis(const double* x, const double* y, double* f, int npts,
+                           double sigma) const
+    { mSumBasis(x, y, _v->cptr(), f, npts, _order, sigma); }
+
+    void LVector::sumKBasis(const double* kx, const double* ky, std::complex<double>* f,
+                            int npts) const
+    { mSumBasis(kx, ky, _v->cptr(), f, npts, _order); }
+
+    // This does the same recurrences as mBasis, but rather than storing each basis function
+    // in a column of psi, it immediately dots them with the coefficients in b.
+    //
+    // For each m, the psi_pq with p-q=m are all L_mq(r^2) times the same q=0 value,
+    // so the sum over q can be done first:
+    //     S0 = sum_q b[iQ] L_mq,  S1 = sum_q b[iQ+1] L_mq
+    // and then f += Asign(m) * (A0 S0 + A1 S1), where A0,A1 are the real and imaginary parts
+    // of the q=0 function.  This way, the only per-point storage is a handful of vectors
+    // of length BLOCKING_FACTOR, and the inner loops are simple element-wise operations
+    // that the compiler can vectorize.
+    template <typename T>
+    void LVector::mSumBasis(
+        const double* x, const double* y, const double* b,
+        T* f, int npts_full, int order, double sigma)
+    {
+        const int N=order;
+        if (npts_full <= 0) return;
+
+        // This is much smaller than for mBasis, since we want all 8 work vectors to stay in L1.
+        const int BLOCKING_FACTOR=256;
+
+        const int max_npts = std::min(BLOCKING_FACTOR,npts_full);
+        std::vector<double> work(8*max_npts);
+        double* Rsq = &work[0];
+        double* A0 = Rsq + max_npts;
+        double* A1 = A0 + max_npts;
+        double* S0 = A1 + max_npts;
+        double* S1 = S0 + max_npts;
+        double* Lmq = S1 + max_npts;
+        double* Lmqm1 = Lmq + max_npts;
+        double* Lmqm2 = Lmqm1 + max_npts;
+
+        for (int ilo=0; ilo<npts_full; ilo+=BLOCKING_FACTOR) {
+            const int ihi = std::min(npts_full, ilo + BLOCKING_FACTOR);
+            const int npts = ihi-ilo;
+            const double* X = x + ilo;
+            const double* Y = y + ilo;
+            T* F = f + ilo;
+
+            for (int i=0; i<npts; i++) Rsq[i] = X[i]*X[i] + Y[i]*Y[i];
+
+            // Build the Gaussian factor
+            const double prefactor = mBasisHelper<T>::prefactor(sigma);
+            for (int i=0; i<npts; i++) {
+                A0[i] = prefactor * std::exp(-0.5*Rsq[i]);
+                A1[i] = 0.;
+                F[i] = 0.;
+            }
+
+            for (int m=0; m<=N; m++) {
+                if (m > 0) {
+                    // Multiply by (X+iY)/sqrt(m), including a factor 2 first time through
+                    const double fact = m==1 ? 2. : 1./sqrtn(m);
+                    for (int i=0; i<npts; i++) {
+                        const double a0 = A0[i];
+                        A0[i] = fact * (X[i]*a0 + Y[i]*A1[i]);
+                        A1[i] = fact * (X[i]*A1[i] - Y[i]*a0);
+                    }
+                }
+
+                PQIndex pq(m,0);
+                const int iQ0 = pq.rIndex();
+                const double b0 = b[iQ0];
+                const double b1 = m==0 ? 0. : b[iQ0+1];
+                for (int i=0; i<npts; i++) { S0[i] = b0; S1[i] = b1; }
+
+                // Go to q=1:
+                pq.incN();
+                if (!pq.pastOrder(N)) {
+                    const int p = pq.getP();
+                    const int q = pq.getQ();
+                    const int iQ = pq.rIndex();
+                    const double bq0 = b[iQ];
+                    const double bq1 = m==0 ? 0. : b[iQ+1];
+                    const double c = mBasisHelper<T>::Lsign(1.) / (sqrtn(p)*sqrtn(q));
+                    for (int i=0; i<npts; i++) {
+                        Lmqm1[i] = 1.;  // This is Lm0.
+                        Lmq[i] = c * (Rsq[i] - (p+q-1.));
+                        S0[i] += bq0 * Lmq[i];
+                        S1[i] += bq1 * Lmq[i];
+                    }
+                }
+
+                // do q=2,...
+                for (pq.incN(); !pq.pastOrder(N); pq.incN()) {
+                    const int p = pq.getP();
+                    const int q = pq.getQ();
+                    const int iQ = pq.rIndex();
+                    const double bq0 = b[iQ];
+                    const double bq1 = m==0 ? 0. : b[iQ+1];
+
+                    // cycle the Lmq vectors
+                    double* temp = Lmqm2;
+                    Lmqm2 = Lmqm1;
+                    Lmqm1 = Lmq;
+                    Lmq = temp;
+
+                    const double invsqrtpq = 1./sqrtn(p)/sqrtn(q);
+                    const double c1 = mBasisHelper<T>::Lsign(invsqrtpq);
+                    const double c2 = sqrtn(p-1)*sqrtn(q-1)*invsqrtpq;
+                    for (int i=0; i<npts; i++) {
+                        Lmq[i] = c1 * (Rsq[i] - (p+q-1.)) * Lmqm1[i] - c2 * Lmqm2[i];
+                        S0[i] += bq0 * Lmq[i];
+                        S1[i] += bq1 * Lmq[i];
+                    }
+                }
+
+                const T sign = mBasisHelper<T>::Asign(m%4);
+                for (int i=0; i<npts; i++) F[i] += sign * (A0[i]*S0[i] + A1[i]*S1[i]);
+            }
+        }
+    }
+
     //---------------------------------------------------------------------------
     //---------------------------------------------------------------------------
     // Flux determinations
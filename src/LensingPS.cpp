@@ -0,0 +1,307 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "LensingPS.h"
+#include "FFT.h"
+#include "Std.h"
+
+namespace galsim {
+
+namespace {
+
+    typedef std::complex<double> CD;
+
+    // The frequency of FFT index i in units of 2pi/N, following the convention of
+    // numpy.fft.fftfreq (which puts the Nyquist frequency of an even N at -N/2).
+    inline int FFTFreq(int i, int N) { return i <= (N-1)/2 ? i : i-N; }
+
+    // exp(2i psi) = (kx + i ky)^2 / |k|^2 for the wave vector with FFT indices (ix,iy).
+    // This is set to 0 for k = 0.
+    inline CD Exp2iPsi(int ix, int iy, int N)
+    {
+        const double kx = FFTFreq(ix, N);
+        const double ky = FFTFreq(iy, N);
+        const double ksq = kx*kx + ky*ky;
+        if (ksq == 0.) return CD(0.);
+        return CD(kx*kx - ky*ky, 2.*kx*ky) / ksq;
+    }
+
+    // Make the columns of an (N x N/2+1) half-plane array with kx = 0 and (for even N)
+    // kx = N/2 Hermitian, as they have to be for the transform of a real field.
+    void MakeHermitian(FFTW_Array<CD>& P, int N)
+    {
+        const int Nh = N/2+1;
+        const int ncol = (N % 2 == 0) ? 2 : 1;
+        for (int c=0; c<ncol; ++c) {
+            const int i = c * (N/2);
+            for (int j=1; j<(N+1)/2; ++j)
+                P[size_t(N-j)*Nh + i] = std::conj(P[size_t(j)*Nh + i]);
+            P[i] = P[i].real();
+            if (N % 2 == 0) P[size_t(N/2)*Nh + i] = P[size_t(N/2)*Nh + i].real();
+        }
+    }
+
+    // Draw a random mode with the given amplitudes: first all the real parts, then all the
+    // imaginary parts, and each multiplied by sqrt(1/2).
+    void DrawMode(const double* amp, int N, GaussianDeviate& gd, FFTW_Array<CD>& P)
+    {
+        const size_t nk = size_t(N) * (N/2+1);
+        const double isqrt2 = std::sqrt(0.5);
+        for (size_t i=0; i<nk; ++i) P[i] = gd();
+        for (size_t i=0; i<nk; ++i) P[i] = CD(amp[i] * P[i].real(), amp[i] * gd()) * isqrt2;
+        MakeHermitian(P, N);
+    }
+
+    // Transform an (N x N/2+1) Hermitian array to the N x N real array out, multiplied by fac.
+    // Note: this overwrites the input array.
+    void TransformC2R(FFTW_Array<CD>& kfield, int N, double fac, double* out)
+    {
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_c2r_2d(N, N, kfield.get_fftw(), out, FFTW_ESTIMATE);
+        }
+        if (plan==NULL) throw FFTInvalid();
+        fftw_execute(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
+        const size_t n = size_t(N) * N;
+        for (size_t i=0; i<n; ++i) out[i] *= fac;
+    }
+
+    // Transform the N x N real array in to its (N x N/2+1) half-plane Fourier transform.
+    void TransformR2C(const double* in, int N, FFTW_Array<CD>& kfield)
+    {
+        // Copy the input, since it isn't ours to hand to FFTW.
+        const size_t n = size_t(N) * N;
+        FFTW_Array<double> xfield(n);
+        std::copy(in, in+n, xfield.get());
+        fftw_plan plan;
+        {
+            MutexLock lock(fftw_plan_mutex);
+            plan = fftw_plan_dft_r2c_2d(N, N, xfield.get(), kfield.get_fftw(), FFTW_ESTIMATE);
+        }
+        if (plan==NULL) throw FFTInvalid();
+        fftw_execute(plan);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(plan);
+        }
+    }
+
+    // Given a(k) and b(k) = conj(a(-k)) on the half plane, replace them with the transforms
+    // of the real and imaginary parts of the field whose transform is a: (a+b)/2 and (a-b)/2i.
+    inline void SplitReIm(CD& a, CD& b)
+    {
+        const CD re = 0.5 * (a + b);
+        const CD im = CD(0.,-0.5) * (a - b);
+        a = re;
+        b = im;
+    }
+
+} // anonymous
+
+    void RealizePowerSpectrum(const double* ampE, const double* ampB, int N, GaussianDeviate& gd,
+                              double* g1, double* g2, double* kappa)
+    {
+        if (N <= 0) {
+            FormatAndThrow<std::invalid_argument>() << "Invalid grid size " << N <<
+                " for RealizePowerSpectrum";
+        }
+        const int Nh = N/2+1;
+        const size_t nk = size_t(N) * Nh;
+
+        // In terms of kappa, the E mode is the real kappa, and the B mode is imaginary kappa.
+        FFTW_Array<CD> E(nk, CD(0.));
+        FFTW_Array<CD> B(nk, CD(0.));
+        if (ampE) DrawMode(ampE, N, gd, E);
+        if (ampB) DrawMode(ampB, N, gd, B);
+
+        // gamma_k = exp(2i psi) kappa_k.  (See the python code for the sign convention.)
+        // g1 and g2 are the real and imaginary parts of gamma, so their transforms are built
+        // from gamma_k and gamma_k at -k.  The latter comes from the Hermitian symmetry of E and
+        // B, but exp(2i psi) has to be evaluated at the wrapped index of -k, since for even N
+        // that is not quite the same as at k along the Nyquist row and column.
+        // G1 goes in G, and then G2 can replace B.
+        FFTW_Array<CD> G(nk);
+        const CD I(0.,1.);
+        for (int iy=0; iy<N; ++iy) {
+            const int my = (N-iy) % N;
+            for (int ix=0; ix<Nh; ++ix) {
+                const size_t i = size_t(iy)*Nh + ix;
+                G[i] = Exp2iPsi(ix, iy, N) * (E[i] + I*B[i]);
+                const CD b = std::conj(Exp2iPsi((N-ix) % N, my, N)) * (E[i] - I*B[i]);
+                B[i] = b;
+                SplitReIm(G[i], B[i]);
+            }
+        }
+
+        // The python version used N * ifft2, which comes to a factor of 1/N with the
+        // unnormalized FFTW transform.
+        const double fac = 1./N;
+        TransformC2R(G, N, fac, g1);
+        TransformC2R(B, N, fac, g2);
+        if (ampE) TransformC2R(E, N, fac, kappa);
+        else std::fill(kappa, kappa + size_t(N)*N, 0.);
+    }
+
+    void KaiserSquires(const double* g1, const double* g2, int N, double* kappaE, double* kappaB)
+    {
+        if (N <= 0) {
+            FormatAndThrow<std::invalid_argument>() << "Invalid grid size " << N <<
+                " for KaiserSquires";
+        }
+        const int Nh = N/2+1;
+        const size_t nk = size_t(N) * Nh;
+        FFTW_Array<CD> G1(nk);
+        FFTW_Array<CD> G2(nk);
+        TransformR2C(g1, N, G1);
+        TransformR2C(g2, N, G2);
+
+        // kappa_k = conj(exp(2i psi)) gamma_k, and kappaE, kappaB are its real and imaginary
+        // parts.  As above, conj(kappa_k(-k)) uses the Hermitian symmetry of G1 and G2.
+        const CD I(0.,1.);
+        for (int iy=0; iy<N; ++iy) {
+            const int my = (N-iy) % N;
+            for (int ix=0; ix<Nh; ++ix) {
+                const size_t i = size_t(iy)*Nh + ix;
+                const CD a = std::conj(Exp2iPsi(ix, iy, N)) * (G1[i] + I*G2[i]);
+                const CD b = Exp2iPsi((N-ix) % N, my, N) * (G1[i] - I*G2[i]);
+                G1[i] = a;
+                G2[i] = b;
+                SplitReIm(G1[i], G2[i]);
+            }
+        }
+
+        const double fac = 1./(double(N)*N);
+        TransformC2R(G1, N, fac, kappaE);
+        TransformC2R(G2, N, fac, kappaB);
+    }
+
+    LensingGrid::LensingGrid(const double* fields, int nfield, int N, double x0, double y0,
+                             double dx, boost::shared_ptr<Interpolant> interp, bool periodic) :
+        _nfield(nfield), _N(N), _x0(x0), _y0(y0), _invdx(1./dx), _interp(interp),
+        _periodic(periodic)
+    {
+        if (nfield <= 0 || N <= 0) {
+            FormatAndThrow<std::invalid_argument>() << "Invalid size " << nfield << " x " <<
+                N << " x " << N << " for LensingGrid";
+        }
+        if (!(dx > 0.)) {
+            FormatAndThrow<std::invalid_argument>() << "Invalid grid spacing " << dx <<
+                " for LensingGrid";
+        }
+
+        // Positions are either inside the grid or wrapped into it, so the interpolant never
+        // needs points more than xrange beyond the edge.
+        _border = int(std::ceil(_interp->xrange())) + 1;
+        _Np = N + 2*_border;
+        _table.resize(size_t(_Np) * _Np * nfield, 0.);
+        for (int j=-_border; j<N+_border; ++j) {
+            int jj = j;
+            if (j < 0 || j >= N) {
+                if (!periodic) continue;
+                jj = ((j % N) + N) % N;
+            }
+            for (int i=-_border; i<N+_border; ++i) {
+                int ii = i;
+                if (i < 0 || i >= N) {
+                    if (!periodic) continue;
+                    ii = ((i % N) + N) % N;
+                }
+                double* t = &_table[(size_t(j+_border) * _Np + (i+_border)) * nfield];
+                for (int f=0; f<nfield; ++f) t[f] = fields[(size_t(f) * N + jj) * N + ii];
+            }
+        }
+
+        // Make sure anything the interpolant sets up on first use is done now, before it is
+        // shared by several threads.
+        _interp->xval(0.);
+    }
+
+    bool LensingGrid::weights(double x, int& imin, int& imax, double* w) const
+    {
+        const double xrange = _interp->xrange();
+        // This also catches NaN.
+        if (!(x > -_border - xrange && x < _N + _border + xrange)) return false;
+
+        // This follows XTable::interpolate, so the results match SBInterpolatedImage.
+        if (_interp->isExactAtNodes() &&
+            std::abs(x - std::floor(x+0.01)) < 10.*std::numeric_limits<double>::epsilon()) {
+            // x lies right on a grid point, so no interpolation is needed along this axis.
+            imin = imax = int(std::floor(x+0.01));
+        } else {
+            imin = int(std::ceil(x - xrange));
+            imax = int(std::floor(x + xrange));
+        }
+        imin = std::max(imin, -_border);
+        imax = std::min(imax, _N+_border-1);
+        if (imin > imax) return false;
+        for (int i=imin; i<=imax; ++i) w[i-imin] = _interp->xval(i-x);
+        return true;
+    }
+
+    void LensingGrid::interpolate(const double* x, const double* y, int n, double* out) const
+    {
+        const int nw = 2*_border + 1;
+        const double N = _N;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<double> wx(nw);
+            std::vector<double> wy(nw);
+            std::vector<double> rowsum(_nfield);
+            std::vector<double> sum(_nfield);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int k=0; k<n; ++k) {
+                double fx = (x[k] - _x0) * _invdx;
+                double fy = (y[k] - _y0) * _invdx;
+                if (_periodic) {
+                    if (fx < 0. || fx >= N) fx -= N * std::floor(fx / N);
+                    if (fy < 0. || fy >= N) fy -= N * std::floor(fy / N);
+                }
+                std::fill(sum.begin(), sum.end(), 0.);
+                int ixmin, ixmax, iymin, iymax;
+                if (weights(fx, ixmin, ixmax, &wx[0]) && weights(fy, iymin, iymax, &wy[0])) {
+                    const int nx = ixmax - ixmin + 1;
+                    for (int iy=iymin; iy<=iymax; ++iy) {
+                        const double* t =
+                            &_table[(size_t(iy+_border) * _Np + (ixmin+_border)) * _nfield];
+                        std::fill(rowsum.begin(), rowsum.end(), 0.);
+                        for (int i=0; i<nx; ++i, t+=_nfield)
+                            for (int f=0; f<_nfield; ++f) rowsum[f] += wx[i] * t[f];
+                        const double w = wy[iy-iymin];
+                        for (int f=0; f<_nfield; ++f) sum[f] += rowsum[f] * w;
+                    }
+                }
+                for (int f=0; f<_nfield; ++f) out[size_t(f) * n + k] = sum[f];
+            }
+        }
+    }
+
+}
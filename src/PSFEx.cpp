@@ -0,0 +1,158 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+
+#include <algorithm>
+#include "PSFEx.h"
+
+namespace galsim {
+
+namespace {
+
+    // The number of positions whose images are calculated together, and the number of pixels
+    // of each image that are accumulated at once.  Together these keep the partial sums in L1
+    // cache while each row of the basis is read only once per block of positions.
+    const int BLOCK = 4;
+    const int CHUNK = 256;
+
+} // anonymous
+
+PSFExModel::PSFExModel(const double* basis, int nbasis, int nx, int ny, int order,
+                       double x0, double y0, double xscale, double yscale) :
+    _nbasis(nbasis), _nx(nx), _ny(ny), _npix(nx*ny), _order(order),
+    _x0(x0), _y0(y0), _xscale(xscale), _yscale(yscale),
+    _basis(basis, basis + size_t(nbasis)*nx*ny)
+{
+    if (nbasis != (order+1)*(order+2)/2)
+        FormatAndThrow<PSFExError>() << "PSFEx basis size " << nbasis <<
+            " does not match polynomial order " << order;
+    if (nx <= 0 || ny <= 0)
+        FormatAndThrow<PSFExError>() << "Invalid PSFEx image size " << nx << " x " << ny;
+}
+
+void PSFExModel::getTerms(double x, double y, double* terms) const
+{
+    const double xs = (x - _x0) / _xscale;
+    const double ys = (y - _y0) / _yscale;
+    double yto = 1.;
+    for (int j=0; j<=_order; ++j) {
+        double xy = yto;
+        for (int i=0; i<=_order-j; ++i) {
+            *terms++ = xy;
+            xy *= xs;
+        }
+        yto *= ys;
+    }
+}
+
+void PSFExModel::getImageBlock(const double* terms, int m, float* images) const
+{
+    double acc[BLOCK][CHUNK];
+    for (int j0=0; j0<_npix; j0+=CHUNK) {
+        const int nj = std::min(CHUNK, _npix-j0);
+        for (int i=0; i<m; ++i) std::fill(acc[i], acc[i]+nj, 0.);
+        for (int k=0; k<_nbasis; ++k) {
+            const double* b = &_basis[size_t(k)*_npix + j0];
+            if (m == BLOCK) {
+                const double p0 = terms[k];
+                const double p1 = terms[_nbasis+k];
+                const double p2 = terms[2*_nbasis+k];
+                const double p3 = terms[3*_nbasis+k];
+                for (int j=0; j<nj; ++j) {
+                    const double bj = b[j];
+                    acc[0][j] += p0 * bj;
+                    acc[1][j] += p1 * bj;
+                    acc[2][j] += p2 * bj;
+                    acc[3][j] += p3 * bj;
+                }
+            } else {
+                for (int i=0; i<m; ++i) {
+                    const double p = terms[i*_nbasis+k];
+                    for (int j=0; j<nj; ++j) acc[i][j] += p * b[j];
+                }
+            }
+        }
+        for (int i=0; i<m; ++i) {
+            float* out = images + size_t(i)*_npix + j0;
+            for (int j=0; j<nj; ++j) out[j] = float(acc[i][j]);
+        }
+    }
+}
+
+void PSFExModel::getImages(const double* x, const double* y, int n, float* images) const
+{
+    const int nblock = (n + BLOCK - 1) / BLOCK;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nblock > 1)
+#endif
+    for (int ib=0; ib<nblock; ++ib) {
+        const int i1 = ib * BLOCK;
+        const int m = std::min(BLOCK, n-i1);
+        std::vector<double> terms(BLOCK * _nbasis);
+        for (int i=0; i<m; ++i) getTerms(x[i1+i], y[i1+i], &terms[i*_nbasis]);
+        getImageBlock(&terms[0], m, images + size_t(i1)*_npix);
+    }
+}
+
+void PSFExModel::getProfiles(const double* x, const double* y, int n,
+                             boost::shared_ptr<Interpolant> xInterp,
+                             boost::shared_ptr<Interpolant> kInterp,
+                             double pad_factor, const GSParamsPtr& gsparams,
+                             std::vector<boost::shared_ptr<SBInterpolatedImage> >& profiles) const
+{
+    profiles.resize(n);
+    if (n == 0) return;
+    std::vector<float> images(size_t(n) * _npix);
+    getImages(x, y, n, &images[0]);
+
+    // The interpolants set up their lookup tables the first time they are used, so do that
+    // here before they are shared among the threads.
+    xInterp->xval(0.);
+    xInterp->uval(0.);
+    kInterp->xval(0.);
+    kInterp->uval(0.);
+
+    std::string err;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+    for (int i=0; i<n; ++i) {
+        try {
+            ImageView<float> image(&images[size_t(i)*_npix], boost::shared_ptr<float>(),
+                                   _nx, Bounds<int>(1,_nx,1,_ny));
+            boost::shared_ptr<SBInterpolatedImage> sbii(
+                new SBInterpolatedImage(image, xInterp, kInterp, pad_factor, 0., 0., gsparams));
+            if (sbii->getFlux() == 0.)
+                throw PSFExError("The PSFEx image has zero total flux.");
+            sbii->calculateStepK();
+            sbii->calculateMaxK();
+            profiles[i] = sbii;
+        } catch (std::exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (PSFExModel)
+#endif
+            {
+                if (err.empty()) err = e.what();
+            }
+        }
+    }
+    if (!err.empty()) throw PSFExError(err);
+}
+
+} // namespace galsim
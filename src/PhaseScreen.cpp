@@ -0,0 +1,175 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "PhaseScreen.h"
+#include "Std.h"
+
+namespace galsim {
+
+    PhaseScreen::PhaseScreen(const double* screen, int npix, double scale, double x0) :
+        _npix(npix), _scale(scale), _x0(x0)
+    {
+        if (npix <= 0) {
+            FormatAndThrow<std::runtime_error>() << "Invalid npix " << npix << " for PhaseScreen";
+        }
+        if (!(scale > 0.)) {
+            FormatAndThrow<std::runtime_error>() << "Invalid scale " << scale <<
+                " for PhaseScreen";
+        }
+        _buf.resize(size_t(npix+1) * (npix+1));
+        setScreen(screen);
+    }
+
+    void PhaseScreen::setScreen(const double* screen)
+    {
+        const int n1 = _npix + 1;
+        for (int i=0; i<_npix; ++i) {
+            double* row = &_buf[size_t(i) * n1];
+            std::copy(screen + size_t(i) * _npix, screen + size_t(i+1) * _npix, row);
+            row[_npix] = row[0];
+        }
+        std::copy(_buf.begin(), _buf.begin() + n1, _buf.begin() + size_t(_npix) * n1);
+    }
+
+    void PhaseScreen::getScreen(double* screen) const
+    {
+        const int n1 = _npix + 1;
+        for (int i=0; i<_npix; ++i) {
+            const double* row = &_buf[size_t(i) * n1];
+            std::copy(row, row + _npix, screen + size_t(i) * _npix);
+        }
+    }
+
+    inline void PhaseScreen::wrap(double x, int& i, double& f) const
+    {
+        const double t = (x - _x0) / _scale;
+        const double fl = std::floor(t);
+        f = t - fl;
+        // fmod keeps the index in range even when the pupil has drifted many periods away.
+        i = int(std::fmod(fl, double(_npix)));
+        if (i < 0) i += _npix;
+    }
+
+    double PhaseScreen::operator()(double x, double y) const
+    {
+        int i, j;
+        double fx, fy;
+        wrap(x, i, fx);
+        wrap(y, j, fy);
+        const int n1 = _npix + 1;
+        const double* p = &_buf[size_t(i) * n1 + j];
+        return (1.-fx) * ((1.-fy) * p[0] + fy * p[1]) + fx * ((1.-fy) * p[n1] + fy * p[n1+1]);
+    }
+
+    void PhaseScreen::wavefront(const double* u, const double* v, int n, double dx, double dy,
+                                double* out, bool add) const
+    {
+        if (add) {
+            for (int k=0; k<n; ++k) out[k] += (*this)(u[k] + dx, v[k] + dy);
+        } else {
+            for (int k=0; k<n; ++k) out[k] = (*this)(u[k] + dx, v[k] + dy);
+        }
+    }
+
+    void SumWavefronts(const std::vector<const PhaseScreen*>& screens,
+                       const double* u, const double* v, int n,
+                       const double* offsets, int nfield, double* out)
+    {
+        // Split the points into blocks, so there is enough work to share among threads even
+        // when there is only one field angle.  Each block is done one screen at a time, which
+        // keeps the reads from each screen close together.
+        const int block = 1024;
+        const int nblock = (n + block - 1) / block;
+        const int nscreen = screens.size();
+        const long ntask = long(nfield) * nblock;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long task=0; task<ntask; ++task) {
+            const int k = task / nblock;
+            const int p1 = (task % nblock) * block;
+            const int np = std::min(block, n - p1);
+            double* wf = out + long(k) * n + p1;
+            std::fill(wf, wf + np, 0.);
+            for (int s=0; s<nscreen; ++s) {
+                const double* off = offsets + 2 * (long(k) * nscreen + s);
+                screens[s]->wavefront(u + p1, v + p1, np, off[0], off[1], wf, true);
+            }
+        }
+    }
+
+    PupilFFT::PupilFFT(int nrow, int ncol, const std::vector<int>& index) :
+        _nrow(nrow), _ncol(ncol), _index(index), _plan(0)
+    {
+        const long npix = long(nrow) * ncol;
+        for (size_t p=0; p<index.size(); ++p) {
+            if (index[p] < 0 || index[p] >= npix) {
+                FormatAndThrow<FFTError>() << "Invalid pupil index " << index[p] <<
+                    " for a pupil plane of size " << nrow << " x " << ncol;
+            }
+        }
+        // The plan is only used with the new-array execute function, so the array here is
+        // just to tell FFTW the layout (and alignment) of the arrays it will be used with.
+        FFTW_Array<std::complex<double> > buf(npix);
+        {
+            MutexLock lock(fftw_plan_mutex);
+            _plan = fftw_plan_dft_2d(nrow, ncol, buf.get_fftw(), buf.get_fftw(),
+                                     FFTW_FORWARD, FFTW_ESTIMATE);
+        }
+        if (_plan == NULL) throw FFTInvalid();
+    }
+
+    PupilFFT::~PupilFFT()
+    {
+        {
+            MutexLock lock(fftw_plan_mutex);
+            fftw_destroy_plan(_plan);
+        }
+    }
+
+    void PupilFFT::accumulate(const double* wf, int nfield, double lam, double* images) const
+    {
+        const long npix = long(_nrow) * _ncol;
+        const int npoint = _index.size();
+        const double fac = 2. * M_PI / lam;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            FFTW_Array<std::complex<double> > buf(npix);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int k=0; k<nfield; ++k) {
+                buf.fill(std::complex<double>(0.));
+                const double* wfk = wf + long(k) * npoint;
+                for (int p=0; p<npoint; ++p) buf[_index[p]] = std::polar(1., fac * wfk[p]);
+                fftw_execute_dft(_plan, buf.get_fftw(), buf.get_fftw());
+                double* img = images + k * npix;
+                for (long q=0; q<npix; ++q) img[q] += std::norm(buf[q]);
+            }
+        }
+    }
+
+}
@@ -20,6 +20,7 @@
 //#define DEBUGLOGGING
 
 #include "SBProfile.h"
+#include "SBConvolveImpl.h"
 #include "integ/Int.h"
 #include "Solve.h"
 
@@ -44,20 +45,33 @@ namespace galsim {
     {
     public:
         ConvolveFunc(const SBProfile& p1, const SBProfile& p2, const Position<double>& pos) :
-            _p1(p1), _p2(p2), _pos(pos) {}
+            _p1(p1), _p2(p2), _pos(pos)
+#ifdef TIMING
+            , _neval(0)
+#endif
+        {}
 
         double operator()(double x, double y) const 
         {
             xdbg<<"Convolve function for pos = "<<_pos<<" at x,y = "<<x<<','<<y<<std::endl;
+#ifdef TIMING
+            ++_neval;
+#endif
             double v1 = _p1.xValue(Position<double>(x,y));
             double v2 = _p2.xValue(Position<double>(_pos.x-x,_pos.y-y));
             xdbg<<"Value = "<<v1<<" * "<<v2<<" = "<<v1*v2<<std::endl;
             return v1*v2;
         }
+#ifdef TIMING
+        long getNEval() const { return _neval; }
+#endif
     private:
         const SBProfile& _p1;
         const SBProfile& _p2;
         const Position<double>& _pos;
+#ifdef TIMING
+        mutable long _neval;
+#endif
     };
 
     class YRegion :
@@ -257,9 +271,32 @@ namespace galsim {
         }
     }
 
-    double RealSpaceConvolve(
-        const SBProfile& p1, const SBProfile& p2, const Position<double>& pos, double flux,
-        const GSParamsPtr& gsparams)
+    // The x and y ranges of the two profiles don't depend on the position where we are
+    // evaluating the convolution.  So when filling a grid of values, we only need to get
+    // them once, rather than once per pixel.
+    struct ProfileRanges
+    {
+        ProfileRanges(const SBProfile& p1, const SBProfile& p2)
+        {
+            p1.getXRange(xmin1,xmax1,xsplits1);
+            p2.getXRange(xmin2,xmax2,xsplits2);
+            xdbg<<"p1 X range = "<<xmin1<<"  "<<xmax1<<std::endl;
+            xdbg<<"p2 X range = "<<xmin2<<"  "<<xmax2<<std::endl;
+            p1.getYRange(ymin1,ymax1,ysplits1);
+            p2.getYRange(ymin2,ymax2,ysplits2);
+            xdbg<<"p1 Y range = "<<ymin1<<"  "<<ymax1<<std::endl;
+            xdbg<<"p2 Y range = "<<ymin2<<"  "<<ymax2<<std::endl;
+        }
+
+        double xmin1, xmax1, xmin2, xmax2;
+        double ymin1, ymax1, ymin2, ymax2;
+        std::vector<double> xsplits1, xsplits2;
+        std::vector<double> ysplits1, ysplits2;
+    };
+
+    static double RealSpaceConvolve(
+        const SBProfile& p1, const SBProfile& p2, const ProfileRanges& ranges,
+        const Position<double>& pos, double flux, const GSParamsPtr& gsparams)
     {
         // Coming in, if only one of them is axisymmetric, it should be p1.
         // This cuts down on some of the logic below.
@@ -270,12 +307,10 @@ namespace galsim {
         assert(p1.isAxisymmetric() || !p2.isAxisymmetric());
         
         xdbg<<"Start RealSpaceConvolve for pos = "<<pos<<std::endl;
-        double xmin1, xmax1, xmin2, xmax2;
-        std::vector<double> xsplits1, xsplits2;
-        p1.getXRange(xmin1,xmax1,xsplits1);
-        p2.getXRange(xmin2,xmax2,xsplits2);
-        xdbg<<"p1 X range = "<<xmin1<<"  "<<xmax1<<std::endl;
-        xdbg<<"p2 X range = "<<xmin2<<"  "<<xmax2<<std::endl;
+        const double xmin1 = ranges.xmin1, xmax1 = ranges.xmax1;
+        const double xmin2 = ranges.xmin2, xmax2 = ranges.xmax2;
+        const std::vector<double>& xsplits1 = ranges.xsplits1;
+        const std::vector<double>& xsplits2 = ranges.xsplits2;
 
         // Check for early exit
         if (pos.x < xmin1 + xmin2 || pos.x > xmax1 + xmax2) {
@@ -283,14 +318,8 @@ namespace galsim {
             return 0;
         }
 
-        double ymin1, ymax1, ymin2, ymax2;
-        std::vector<double> ysplits1, ysplits2;
-        p1.getYRange(ymin1,ymax1,ysplits1);
-        p2.getYRange(ymin2,ymax2,ysplits2);
-        xdbg<<"p1 Y range = "<<ymin1<<"  "<<ymax1<<std::endl;
-        xdbg<<"p2 Y range = "<<ymin2<<"  "<<ymax2<<std::endl;
         // Second check for early exit
-        if (pos.y < ymin1 + ymin2 || pos.y > ymax1 + ymax2) {
+        if (pos.y < ranges.ymin1 + ranges.ymin2 || pos.y > ranges.ymax1 + ranges.ymax2) {
             xdbg<<"y is outside range, so trivially 0\n";
             return 0;
         }
@@ -375,11 +404,85 @@ namespace galsim {
 #ifdef TIMING
         gettimeofday(&tp,0);
         double t2 = tp.tv_sec + tp.tv_usec/1.e6;
-        xdbg<<"Time for ("<<pos.x<<','<<pos.y<<") = "<<t2-t1<<std::endl;
+        xdbg<<"Time for ("<<pos.x<<','<<pos.y<<") = "<<t2-t1<<
+            ", number of evaluations = "<<conv.getNEval()<<std::endl;
 #endif
 
         xdbg<<"Found result = "<<result<<std::endl;
         return result;
     }
 
+    double RealSpaceConvolve(
+        const SBProfile& p1, const SBProfile& p2, const Position<double>& pos, double flux,
+        const GSParamsPtr& gsparams)
+    {
+        ProfileRanges ranges(p1,p2);
+        return RealSpaceConvolve(p1,p2,ranges,pos,flux,gsparams);
+    }
+
+    // Fill one column of val.  We pull this out so the OpenMP version below can
+    // catch any exceptions inside the parallel region.
+    static void RealSpaceConvolveColumn(
+        const SBProfile& p1, const SBProfile& p2, const ProfileRanges& ranges,
+        tmv::VectorView<double> col, double x, double dx, double y, double dyx,
+        double flux, const GSParamsPtr& gsparams)
+    {
+        const int m = col.size();
+        for (int i=0;i<m;++i,x+=dx,y+=dyx)
+            col(i) = RealSpaceConvolve(p1,p2,ranges,Position<double>(x,y),flux,gsparams);
+    }
+
+    void RealSpaceConvolve(
+        const SBProfile& p1, const SBProfile& p2, tmv::MatrixView<double> val,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParamsPtr& gsparams, bool parallel)
+    {
+        assert(p1.isAxisymmetric() || !p2.isAxisymmetric());
+        dbg<<"Start RealSpaceConvolve for grid\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        const int n = val.rowsize();
+
+        ProfileRanges ranges(p1,p2);
+
+#ifdef TIMING
+        timeval tp;
+        gettimeofday(&tp,0);
+        double t1 = tp.tv_sec + tp.tv_usec/1.e6;
+#endif
+
+#ifdef _OPENMP
+        // Each value is an independent integral, so we can do the columns in parallel
+        // as long as the profiles' xValue functions are safe to call from multiple threads.
+        // Exceptions can't propagate out of the parallel region, so save the first
+        // error message and throw it afterwards.
+        std::string err;
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (int j=0;j<n;++j) {
+            try {
+                RealSpaceConvolveColumn(p1,p2,ranges,val.col(j),x0+j*dxy,dx,y0+j*dy,dyx,
+                                        flux,gsparams);
+            } catch (std::exception& e) {
+#pragma omp critical (RealSpaceConvolve)
+                {
+                    if (err.empty()) err = e.what();
+                }
+            }
+        }
+        if (!err.empty()) throw SBError(err);
+#else
+        for (int j=0;j<n;++j) {
+            RealSpaceConvolveColumn(p1,p2,ranges,val.col(j),x0+j*dxy,dx,y0+j*dy,dyx,
+                                    flux,gsparams);
+        }
+#endif
+
+#ifdef TIMING
+        gettimeofday(&tp,0);
+        double t2 = tp.tv_sec + tp.tv_usec/1.e6;
+        dbg<<"Time for "<<val.colsize()<<" x "<<n<<" grid = "<<t2-t1<<
+            " (parallel = "<<parallel<<")"<<std::endl;
+#endif
+    }
+
 }
@@ -21,6 +21,8 @@
 
 #include "SBAdd.h"
 #include "SBAddImpl.h"
+#include "SBConvolve.h"
+#include "SBConvolveImpl.h"
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -56,11 +58,13 @@ namespace galsim {
 
     SBAdd::SBAddImpl::SBAddImpl(const std::list<SBProfile>& slist,
                                 const GSParamsPtr& gsparams) :
-        SBProfileImpl(gsparams ? gsparams : GetImpl(slist.front())->gsparams)
+        SBProfileImpl(gsparams ? gsparams : GetImpl(slist.front())->gsparams),
+        _useHoisted(false)
     {
         for (ConstIter sptr = slist.begin(); sptr!=slist.end(); ++sptr)
             add(*sptr);
         initialize();
+        hoistFactors();
     }
 
     void SBAdd::SBAddImpl::add(const SBProfile& rhs)
@@ -103,6 +107,69 @@ namespace galsim {
         dbg<<"Net maxK, stepK = "<<_maxMaxK<<" , "<<_minStepK<<std::endl;
     }
 
+    void SBAdd::SBAddImpl::hoistFactors()
+    {
+        // A sum of convolutions that share some of their factors, such as several components
+        // of a galaxy each convolved with the same PSF, can be written as
+        //     Add(Convolve(A,P), Convolve(B,P)) = Convolve(Add(A,B), P)
+        // Then the k values of P only need to be calculated once, rather than once for each
+        // summand.  This is only used for the k-space methods.  Everything else (including
+        // maxK and stepK) still comes from the summands, so the rendering is unchanged.
+        if (_plist.size() < 2) return;
+        std::vector<std::list<SBProfile> > factors;
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it) {
+            const SBConvolve::SBConvolveImpl* sbc =
+                dynamic_cast<const SBConvolve::SBConvolveImpl*>(GetImpl(*it));
+            if (!sbc || sbc->isRealSpace()) return;
+            factors.push_back(sbc->getObjs());
+        }
+
+        // The shared factors are the ones in the first convolution that are also (as the same
+        // object, not just an equal one) in all the others.  Take each one out of all the
+        // convolutions as we find it, so a factor that appears twice is handled correctly.
+        std::list<SBProfile> shared;
+        std::list<SBProfile> first = factors[0];
+        for (ConstIter it=first.begin(); it!=first.end(); ++it) {
+            const SBProfileImpl* p = GetImpl(*it);
+            std::vector<Iter> found;
+            for (size_t i=0; i<factors.size(); ++i) {
+                Iter it2 = factors[i].begin();
+                while (it2 != factors[i].end() && GetImpl(*it2) != p) ++it2;
+                if (it2 == factors[i].end()) break;
+                found.push_back(it2);
+            }
+            if (found.size() < factors.size()) continue;
+            for (size_t i=0; i<factors.size(); ++i) factors[i].erase(found[i]);
+            shared.push_back(*it);
+        }
+        dbg<<"SBAdd has "<<shared.size()<<" factors shared by all summands\n";
+        if (shared.empty()) return;
+
+        std::list<SBProfile> terms;
+        for (size_t i=0; i<factors.size(); ++i) {
+            // If nothing is left of one of the summands, there is no point to this.
+            if (factors[i].empty()) return;
+            if (factors[i].size() == 1) terms.push_back(factors[i].front());
+            else terms.push_back(SBConvolve(factors[i], false, this->gsparams));
+        }
+        shared.push_front(SBAdd(terms, this->gsparams));
+        _hoisted = SBConvolve(shared, false, this->gsparams);
+        _useHoisted = true;
+    }
+
+    void SBAdd::SBAddImpl::prepareDraw() const
+    {
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it) it->prepareDraw();
+        if (_useHoisted) _hoisted.prepareDraw();
+    }
+
+    bool SBAdd::SBAddImpl::hasThreadSafeXValue() const
+    {
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it)
+            if (!GetImpl(*it)->hasThreadSafeXValue()) return false;
+        return true;
+    }
+
     double SBAdd::SBAddImpl::xValue(const Position<double>& p) const
     {
         ConstIter pptr = _plist.begin();
@@ -115,6 +182,7 @@ namespace galsim {
 
     std::complex<double> SBAdd::SBAddImpl::kValue(const Position<double>& k) const
     {
+        if (_useHoisted) return _hoisted.kValue(k);
         ConstIter pptr = _plist.begin();
         assert(pptr != _plist.end());
         std::complex<double> kv = pptr->kValue(k);
@@ -149,6 +217,10 @@ namespace galsim {
         dbg<<"SBAdd fillKValue\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<", izero = "<<izero<<std::endl;
         dbg<<"ky = "<<ky0<<" + j * "<<dky<<", jzero = "<<jzero<<std::endl;
+        if (_useHoisted) {
+            GetImpl(_hoisted)->fillKValue(val,kx0,dkx,izero,ky0,dky,jzero);
+            return;
+        }
         ConstIter pptr = _plist.begin();
         assert(pptr != _plist.end());
         GetImpl(*pptr)->fillKValue(val,kx0,dkx,izero,ky0,dky,jzero);
@@ -187,6 +259,10 @@ namespace galsim {
         dbg<<"SBAdd fillKValue\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<" + j * "<<dkxy<<std::endl;
         dbg<<"ky = "<<ky0<<" + i * "<<dkyx<<" + j * "<<dky<<std::endl;
+        if (_useHoisted) {
+            GetImpl(_hoisted)->fillKValue(val,kx0,dkx,dkxy,ky0,dky,dkyx);
+            return;
+        }
         ConstIter pptr = _plist.begin();
         assert(pptr != _plist.end());
         GetImpl(*pptr)->fillKValue(val,kx0,dkx,dkxy,ky0,dky,dkyx);
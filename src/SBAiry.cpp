@@ -29,6 +29,7 @@
 
 #include "SBAiry.h"
 #include "SBAiryImpl.h"
+#include "bessel/BesselJ.h"
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -121,7 +122,7 @@ namespace galsim {
             xval =  0.5 * (1.-_obssq);
         } else {
             // See Schroeder eq (10.1.10)
-            xval = ( j1(nu) - _obscuration*j1(_obscuration*nu) ) / nu ;
+            xval = ( bessel::BesselJ1(nu) - _obscuration*bessel::BesselJ1(_obscuration*nu) ) / nu;
         }
         xval *= xval;
         // Normalize to give unit flux integrated over area.
@@ -129,6 +130,25 @@ namespace galsim {
         return xval;
     }
 
+    void AiryInfoObs::RadialFunction::operator()(const double* radius, double* f, int n) const
+    {
+        if (n <= 0) return;
+        const double thresh = sqrt(8.*_gsparams->xvalue_accuracy);
+        std::vector<double> nu(n);
+        std::vector<double> j1obs(n);
+        for (int i=0; i<n; ++i) {
+            nu[i] = radius[i]*M_PI;
+            j1obs[i] = _obscuration*nu[i];
+        }
+        bessel::BesselJ1Many(&nu[0], f, n);
+        bessel::BesselJ1Many(&j1obs[0], &j1obs[0], n);
+        for (int i=0; i<n; ++i) {
+            double xval = (nu[i] < thresh) ?
+                0.5 * (1.-_obssq) : (f[i] - _obscuration*j1obs[i]) / nu[i];
+            f[i] = xval * xval * _norm;
+        }
+    }
+
     double SBAiry::SBAiryImpl::xValue(const Position<double>& p) const
     {
         double r = sqrt(p.x*p.x+p.y*p.y) * _D;
@@ -138,6 +158,9 @@ namespace galsim {
     double AiryInfoObs::xValue(double r) const
     { return _radial(r); }
 
+    void AiryInfoObs::xValueMany(const double* r, double* f, int n) const
+    { _radial(r, f, n); }
+
     std::complex<double> SBAiry::SBAiryImpl::kValue(const Position<double>& k) const
     {
         double ksq_over_pisq = (k.x*k.x+k.y*k.y) * _inv_Dsq_pisq;
@@ -167,12 +190,16 @@ namespace galsim {
             y0 *= _D;
             dy *= _D;
 
+            // Evaluate a column at a time so the Bessel functions can be done in batches.
+            std::vector<double> r(m);
+            std::vector<double> f(m);
             for (int j=0;j<n;++j,y0+=dy) {
                 double x = x0;
                 double ysq = y0*y0;
+                for (int i=0;i<m;++i,x+=dx) r[i] = sqrt(x*x + ysq);
+                _info->xValueMany(&r[0], &f[0], m);
                 It valit = val.col(j).begin();
-                for (int i=0;i<m;++i,x+=dx)
-                    *valit++ = _xnorm * _info->xValue(sqrt(x*x + ysq));
+                for (int i=0;i<m;++i) *valit++ = _xnorm * f[i];
             }
         }
     }
@@ -229,12 +256,15 @@ namespace galsim {
         dy *= _D;
         dyx *= _D;
 
+        std::vector<double> r(m);
+        std::vector<double> f(m);
         It valit = val.linearView().begin();
         for (int j=0;j<n;++j,x0+=dxy,y0+=dy) {
             double x = x0;
             double y = y0;
-            for (int i=0;i<m;++i,x+=dx,y+=dyx)
-                *valit++ = _xnorm * _info->xValue(sqrt(x*x + y*y));
+            for (int i=0;i<m;++i,x+=dx,y+=dyx) r[i] = sqrt(x*x + y*y);
+            _info->xValueMany(&r[0], &f[0], m);
+            for (int i=0;i<m;++i) *valit++ = _xnorm * f[i];
         }
     }
 
@@ -415,6 +445,9 @@ namespace galsim {
     double AiryInfoNoObs::xValue(double r) const
     { return _radial(r); }
 
+    void AiryInfoNoObs::xValueMany(const double* r, double* f, int n) const
+    { _radial(r, f, n); }
+
     double AiryInfoNoObs::kValue(double ksq_over_pisq) const
     {
         if (ksq_over_pisq >= 4.) return 0.;
@@ -443,7 +476,7 @@ namespace galsim {
             // lim j1(u)/u = 1/2
             xval = 0.5;
         } else {
-            xval = j1(nu) / nu;
+            xval = bessel::BesselJ1(nu) / nu;
         }
         xval *= xval;
         // Normalize to give unit flux integrated over area.
@@ -451,6 +484,19 @@ namespace galsim {
         return xval;
     }
 
+    void AiryInfoNoObs::RadialFunction::operator()(const double* radius, double* f, int n) const
+    {
+        if (n <= 0) return;
+        const double thresh = sqrt(8.*_gsparams->xvalue_accuracy);
+        std::vector<double> nu(n);
+        for (int i=0; i<n; ++i) nu[i] = radius[i]*M_PI;
+        bessel::BesselJ1Many(&nu[0], f, n);
+        for (int i=0; i<n; ++i) {
+            double xval = (nu[i] < thresh) ? 0.5 : f[i] / nu[i];
+            f[i] = xval * xval * M_PI;
+        }
+    }
+
     // Constructor to initialize Airy constants and k lookup table
     AiryInfoNoObs::AiryInfoNoObs(const GSParamsPtr& gsparams) :
         _radial(gsparams),
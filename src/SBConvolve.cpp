@@ -19,9 +19,13 @@
 
 //#define DEBUGLOGGING
 
+#include <iterator>
 #include "SBConvolve.h"
 #include "SBConvolveImpl.h"
 #include "SBTransform.h"
+#include "SBTransformImpl.h"
+#include "SBGaussian.h"
+#include "SBGaussianImpl.h"
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -70,9 +74,109 @@ namespace galsim {
     {
         for (ConstIter sptr = slist.begin(); sptr!=slist.end(); ++sptr)
             add(*sptr);
+        combineGaussians();
         initialize();
     }
 
+    // Check if prof is a Gaussian, possibly transformed by an SBTransform.
+    // If so, return its covariance matrix and centroid.
+    bool SBConvolve::SBConvolveImpl::GetGaussianMoments(
+        const SBProfile& prof, double& cxx, double& cxy, double& cyy, Position<double>& cen)
+    {
+        const SBProfileImpl* p = GetImpl(prof);
+        const SBGaussian::SBGaussianImpl* sbg = dynamic_cast<const SBGaussian::SBGaussianImpl*>(p);
+        if (sbg) {
+            double sigsq = sbg->getSigma() * sbg->getSigma();
+            cxx = cyy = sigsq;
+            cxy = 0.;
+            cen = Position<double>(0.,0.);
+            return true;
+        }
+        const SBTransform::SBTransformImpl* sbt =
+            dynamic_cast<const SBTransform::SBTransformImpl*>(p);
+        if (sbt) {
+            // Nested transforms are always compounded, so the adaptee cannot be another
+            // SBTransform.  Only need to check for a Gaussian here.
+            SBProfile adaptee = sbt->getObj();
+            sbg = dynamic_cast<const SBGaussian::SBGaussianImpl*>(GetImpl(adaptee));
+            if (!sbg) return false;
+            double sigsq = sbg->getSigma() * sbg->getSigma();
+            double mA, mB, mC, mD;
+            sbt->getJac(mA,mB,mC,mD);
+            // Covariance is sigma^2 M M^T
+            cxx = sigsq * (mA*mA + mB*mB);
+            cxy = sigsq * (mA*mC + mB*mD);
+            cyy = sigsq * (mC*mC + mD*mD);
+            cen = sbt->getOffset();
+            return true;
+        }
+        return false;
+    }
+
+    void SBConvolve::SBConvolveImpl::combineGaussians()
+    {
+        // The convolution of any number of Gaussians (sheared, shifted or otherwise transformed)
+        // is another Gaussian whose covariance matrix is the sum of the individual covariances.
+        // So rather than multiply their k values together at every point, or shoot photons
+        // through each of them, replace them with a single equivalent Gaussian.
+        int nGauss = 0;
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it) {
+            double cxx, cxy, cyy;
+            Position<double> cen;
+            if (GetGaussianMoments(*it,cxx,cxy,cyy,cen)) ++nGauss;
+        }
+        dbg<<"SBConvolve has "<<nGauss<<" Gaussian components\n";
+        if (nGauss < 2) return;
+
+        double sumxx = 0., sumxy = 0., sumyy = 0.;
+        Position<double> sumcen(0.,0.);
+        double flux = 1.;
+        // Keep the combined Gaussian where the first one was in the list.  This is recorded as
+        // the number of other components before it, since the following ones may be erased too.
+        int npos = -1;
+        int nkept = 0;
+        for (Iter it=_plist.begin(); it!=_plist.end();) {
+            double cxx, cxy, cyy;
+            Position<double> cen;
+            if (GetGaussianMoments(*it,cxx,cxy,cyy,cen)) {
+                sumxx += cxx;
+                sumxy += cxy;
+                sumyy += cyy;
+                sumcen += cen;
+                flux *= it->getFlux();
+                if (npos < 0) npos = nkept;
+                it = _plist.erase(it);
+            } else {
+                ++it;
+                ++nkept;
+            }
+        }
+        dbg<<"Combined covariance = "<<sumxx<<','<<sumxy<<','<<sumyy<<std::endl;
+        dbg<<"Combined centroid = "<<sumcen<<", flux = "<<flux<<std::endl;
+
+        SBProfile gauss;
+        if (sumxy == 0. && sumxx == sumyy) {
+            gauss = SBGaussian(sqrt(sumxx), flux, this->gsparams);
+            if (sumcen.x != 0. || sumcen.y != 0.)
+                gauss = SBTransform(gauss, 1., 0., 0., 1., sumcen, 1., this->gsparams);
+        } else {
+            // Use the symmetric square root of the covariance matrix as the transformation of
+            // a unit Gaussian.  For a 2x2 positive definite matrix C, this is
+            //     sqrt(C) = (C + s I) / t
+            // where s = sqrt(det(C)) and t = sqrt(trace(C) + 2s).  Also det(sqrt(C)) = s.
+            double s = sqrt(sumxx*sumyy - sumxy*sumxy);
+            double t = sqrt(sumxx + sumyy + 2.*s);
+            double mA = (sumxx + s) / t;
+            double mB = sumxy / t;
+            double mD = (sumyy + s) / t;
+            gauss = SBTransform(SBGaussian(1., flux / s, this->gsparams),
+                                mA, mB, mB, mD, sumcen, 1., this->gsparams);
+        }
+        Iter pos = _plist.begin();
+        std::advance(pos, npos);
+        _plist.insert(pos, gauss);
+    }
+
     void SBConvolve::SBConvolveImpl::add(const SBProfile& rhs)
     {
         dbg<<"Start SBConvolveImpl::add.  Adding item # "<<_plist.size()+1<<std::endl;
@@ -171,6 +275,56 @@ namespace galsim {
             throw SBError("Real-space integration of more than 2 profiles is not implemented.");
     }
 
+    void SBConvolve::SBConvolveImpl::prepareDraw() const
+    {
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it) it->prepareDraw();
+    }
+
+    bool SBConvolve::SBConvolveImpl::hasThreadSafeXValue() const
+    {
+        // The real-space integration itself doesn't have any shared state, so this is
+        // safe as long as the components are.
+        if (!_real_space) return false;
+        for (ConstIter it=_plist.begin(); it!=_plist.end(); ++it)
+            if (!GetImpl(*it)->hasThreadSafeXValue()) return false;
+        return true;
+    }
+
+    void SBConvolve::SBConvolveImpl::fillXValue(tmv::MatrixView<double> val,
+                                                double x0, double dx, int izero,
+                                                double y0, double dy, int jzero) const
+    {
+        dbg<<"SBConvolve fillXValue\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<", izero = "<<izero<<std::endl;
+        dbg<<"y = "<<y0<<" + j * "<<dy<<", jzero = "<<jzero<<std::endl;
+        fillXValue(val,x0,dx,0.,y0,dy,0.);
+    }
+
+    void SBConvolve::SBConvolveImpl::fillXValue(tmv::MatrixView<double> val,
+                                                double x0, double dx, double dxy,
+                                                double y0, double dy, double dyx) const
+    {
+        dbg<<"SBConvolve fillXValue\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        if (_real_space && _plist.size() == 2) {
+            // Do all the real-space integrals together, so RealSpaceConvolve can share the
+            // setup between pixels and (with OpenMP) run them in parallel.
+            const SBProfile& p1 = _plist.front();
+            const SBProfile& p2 = _plist.back();
+            bool parallel = GetImpl(p1)->hasThreadSafeXValue() &&
+                GetImpl(p2)->hasThreadSafeXValue();
+            if (p2.isAxisymmetric())
+                RealSpaceConvolve(p2,p1,val,x0,dx,dxy,y0,dy,dyx,_fluxProduct,this->gsparams,
+                                  parallel);
+            else
+                RealSpaceConvolve(p1,p2,val,x0,dx,dxy,y0,dy,dyx,_fluxProduct,this->gsparams,
+                                  parallel);
+        } else {
+            SBProfileImpl::fillXValue(val,x0,dx,dxy,y0,dy,dyx);
+        }
+    }
+
     std::complex<double> SBConvolve::SBConvolveImpl::kValue(const Position<double>& k) const
     {
         ConstIter pptr = _plist.begin();
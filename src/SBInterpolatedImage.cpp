@@ -20,8 +20,15 @@
 //#define DEBUGLOGGING
 
 #include <algorithm>
+#include <list>
+#include <map>
 #include "SBInterpolatedImage.h"
 #include "SBInterpolatedImageImpl.h"
+#include "CorrelatedNoise.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -32,6 +39,230 @@ int verbose_level = 1;
 
 namespace galsim {
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Cache of padded images and their transforms
+    //
+    // It is common to make many SBInterpolatedImages from the same pixel values, e.g. a
+    // RealGalaxy that is drawn many times with different shears, or an InterpolatedImage that is
+    // remade every time it is pickled or rescaled in python.  The padded XTable and its FFT
+    // only depend on the pixel values and the padded size (not on the interpolants), so these
+    // are shared among all such profiles through a global cache, keyed by a hash of the padded
+    // image.  Entries are reference counted, so an entry that is dropped from the cache stays
+    // alive as long as some profile still uses it.
+
+    class KTableCacheEntry
+    {
+    public:
+        KTableCacheEntry(boost::shared_ptr<XTable> xtab) :
+            xtab(xtab), key(0), bytes(xBytes()), cached(false) {}
+
+        // Return the KTable, doing the FFT the first time this is called.  If several threads
+        // ask for it at once, only one of them does the FFT, and the others wait for it.
+        // built is set to whether this call was the one that did the FFT.
+        boost::shared_ptr<KTable> getKTable(bool& built)
+        {
+            built = false;
+            MutexLock lock(_mutex);
+            if (!_ktab) {
+                _ktab = xtab->transform();
+                built = true;
+            }
+            return _ktab;
+        }
+
+        size_t xBytes() const
+        { size_t N = xtab->getN(); return N * N * sizeof(double); }
+
+        size_t kBytes() const
+        { size_t N = xtab->getN(); return N * (N/2+1) * sizeof(std::complex<double>); }
+
+        const boost::shared_ptr<XTable> xtab;
+
+        // These are only used by KTableCache, while holding its mutex.
+        unsigned long long key;
+        size_t bytes;
+        bool cached;
+
+    private:
+        boost::shared_ptr<KTable> _ktab;
+        Mutex _mutex;
+
+        // Disable copying
+        KTableCacheEntry(const KTableCacheEntry& );
+        void operator=(const KTableCacheEntry& );
+    };
+
+namespace {
+
+    class KTableCache
+    {
+        typedef std::list<boost::shared_ptr<KTableCacheEntry> > List;
+        typedef std::map<unsigned long long, List::iterator> Map;
+
+    public:
+        KTableCache(size_t max_bytes) : _max_bytes(max_bytes), _bytes(0) {}
+
+        // Return the entry for the given padded image, adding it to the cache if it is not
+        // already there.
+        boost::shared_ptr<KTableCacheEntry> get(const boost::shared_ptr<XTable>& xtab)
+        {
+            const unsigned long long key = hash(*xtab);
+            boost::shared_ptr<KTableCacheEntry> entry;
+            {
+                MutexLock lock(_mutex);
+                if (_max_bytes > 0) {
+                    Map::iterator it = _map.find(key);
+                    if (it == _map.end()) {
+                        entry.reset(new KTableCacheEntry(xtab));
+                        _list.push_front(entry);
+                        _map[key] = _list.begin();
+                        entry->key = key;
+                        entry->cached = true;
+                        _bytes += entry->bytes;
+                        evict();
+                    } else if (equal(*(*it->second)->xtab, *xtab)) {
+                        // Move it to the front of the list.
+                        _list.splice(_list.begin(), _list, it->second);
+                        entry = _list.front();
+                    }
+                    // Else the hash collided with a different image.  This should never
+                    // really happen, but if it does, just don't use the cache for this one.
+                }
+            }
+            if (!entry) entry.reset(new KTableCacheEntry(xtab));
+            return entry;
+        }
+
+        // Count the bytes of a newly built KTable against the cache.
+        void addKTable(KTableCacheEntry& entry)
+        {
+            MutexLock lock(_mutex);
+            if (entry.cached) {
+                entry.bytes += entry.kBytes();
+                _bytes += entry.kBytes();
+                evict();
+            }
+        }
+
+        void setMaxBytes(size_t max_bytes)
+        {
+            MutexLock lock(_mutex);
+            _max_bytes = max_bytes;
+            evict();
+        }
+
+        size_t getBytes() { MutexLock lock(_mutex); return _bytes; }
+
+    private:
+
+        // Drop the least recently used entries until the cache is at most _max_bytes.
+        void evict()
+        {
+            while (_bytes > _max_bytes && !_list.empty()) {
+                boost::shared_ptr<KTableCacheEntry> entry = _list.back();
+                _map.erase(entry->key);
+                _list.pop_back();
+                entry->cached = false;
+                _bytes -= entry->bytes;
+            }
+        }
+
+        // FNV-1a hash of the size and values of the padded image.
+        static unsigned long long hash(const XTable& xtab)
+        {
+            const unsigned long long prime = 1099511628211ULL;
+            unsigned long long h = 14695981039346656037ULL;
+            const int N = xtab.getN();
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(&N);
+            for (size_t i=0; i<sizeof(int); ++i) { h ^= p[i]; h *= prime; }
+            p = reinterpret_cast<const unsigned char*>(xtab.getArray());
+            const size_t n = size_t(N) * N * sizeof(double);
+            for (size_t i=0; i<n; ++i) { h ^= p[i]; h *= prime; }
+            return h;
+        }
+
+        static bool equal(const XTable& xtab1, const XTable& xtab2)
+        {
+            if (xtab1.getN() != xtab2.getN()) return false;
+            const size_t n = size_t(xtab1.getN()) * xtab1.getN();
+            return std::equal(xtab1.getArray(), xtab1.getArray() + n, xtab2.getArray());
+        }
+
+        size_t _max_bytes;
+        size_t _bytes;
+        List _list;
+        Map _map;
+        Mutex _mutex;
+    };
+
+    KTableCache ktable_cache(256 * 1024 * 1024);
+
+} // anonymous
+
+    void SetInterpolatedImageCacheSize(size_t max_bytes)
+    { ktable_cache.setMaxBytes(max_bytes); }
+
+    size_t GetInterpolatedImageCacheBytes()
+    { return ktable_cache.getBytes(); }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // NoisePad methods
+
+    NoisePad::NoisePad(double variance) : _variance(variance), _N(0)
+    {
+        if (variance < 0.)
+            FormatAndThrow<std::invalid_argument>() << "Invalid noise_pad variance " << variance;
+    }
+
+    NoisePad::NoisePad(const double* rootps, int N) :
+        _variance(0.), _N(N), _rootps(rootps, rootps + size_t(N) * (N/2+1))
+    {
+        if (N <= 0) FormatAndThrow<std::invalid_argument>() << "Invalid noise_pad size " << N;
+    }
+
+    void NoisePad::fill(XTable& xtab, int N, const Bounds<int>& hole, BaseDeviate rng) const
+    {
+        const int x0 = -(N/2);
+        const int y0 = -(N/2);
+
+        if (_N == 0) {
+            // The XTable starts out as zeros, so there is nothing to do for zero variance.
+            if (_variance == 0.) return;
+            // White noise: just draw the pixels that are not in the hole.
+            GaussianDeviate gd(rng, 0., std::sqrt(_variance));
+            for (int y=y0; y<y0+N; ++y) {
+                const bool in_rows = y >= hole.getYMin() && y <= hole.getYMax();
+                for (int x=x0; x<x0+N; ++x) {
+                    if (in_rows && x >= hole.getXMin() && x <= hole.getXMax()) {
+                        x = hole.getXMax();
+                        continue;
+                    }
+                    xtab.xSet(x, y, gd());
+                }
+            }
+            return;
+        }
+
+        if (N != _N)
+            FormatAndThrow<std::invalid_argument>() <<
+                "noise_pad size " << N << " does not match the size of the power spectrum " << _N;
+
+        // Correlated noise: Make the full periodic field on the N x N grid the same way
+        // CorrelatedNoise.applyTo() does, and then use the part outside the hole.
+        ImageAlloc<double> field(N, N, 0.);
+        addNoiseFromRootPS(field.view(), &_rootps[0], rng);
+
+        // Copy the part outside the hole into xtab.
+        const double* ptr = field.getData();
+        for (int y=y0; y<y0+N; ++y) {
+            const bool in_rows = y >= hole.getYMin() && y <= hole.getYMax();
+            for (int x=x0; x<x0+N; ++x, ++ptr) {
+                if (in_rows && x >= hole.getXMin() && x <= hole.getXMax()) continue;
+                xtab.xSet(x, y, *ptr);
+            }
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // SBInterpolatedImage methods
 
@@ -57,6 +288,20 @@ namespace galsim {
             new SBInterpolatedImageImpl(image,xInterp,kInterp,pad_factor,stepk,maxk,gsparams)
         ) {}
 
+    template <typename T>
+    SBInterpolatedImage::SBInterpolatedImage(
+        const BaseImage<T>& image,
+        boost::shared_ptr<Interpolant> xInterp, boost::shared_ptr<Interpolant> kInterp,
+        double pad_factor, double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad& noise_pad, int noise_pad_size, BaseDeviate rng) :
+        SBProfile(
+            new SBInterpolatedImageImpl(
+                image,
+                boost::shared_ptr<Interpolant2d>(new InterpolantXY(xInterp)),
+                boost::shared_ptr<Interpolant2d>(new InterpolantXY(kInterp)),
+                pad_factor, stepk, maxk, gsparams, &noise_pad, noise_pad_size, &rng)
+        ) {}
+
     SBInterpolatedImage::SBInterpolatedImage(const SBInterpolatedImage& rhs) : SBProfile(rhs) {}
 
     SBInterpolatedImage::~SBInterpolatedImage() {}
@@ -104,9 +349,10 @@ namespace galsim {
     SBInterpolatedImage::SBInterpolatedImageImpl::SBInterpolatedImageImpl(
         const BaseImage<T>& image,
         boost::shared_ptr<Interpolant2d> xInterp, boost::shared_ptr<Interpolant2d> kInterp,
-        double pad_factor, double stepk, double maxk, const GSParamsPtr& gsparams) :
+        double pad_factor, double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad* noise_pad, int noise_pad_size, BaseDeviate* rng) :
         SBProfileImpl(gsparams),
-        _xInterp(xInterp), _kInterp(kInterp), _stepk(stepk), _maxk(maxk),
+        _xInterp(xInterp), _kInterp(kInterp), _stepk(stepk), _maxk(maxk), _ktab(0),
         _readyToShoot(false)
     {
         dbg<<"image bounds = "<<image.getBounds()<<std::endl;
@@ -114,32 +360,59 @@ namespace galsim {
         assert(_xInterp.get());
         assert(_kInterp.get());
 
-        _Ninitx = image.getXMax()-image.getXMin()+1;
-        _Ninity = image.getYMax()-image.getYMin()+1;
+        const int nx = image.getXMax()-image.getXMin()+1;
+        const int ny = image.getYMax()-image.getYMin()+1;
+        // Only pad with noise if the noise square contains the image and is bigger than it.
+        if (!noise_pad || noise_pad_size < std::max(nx,ny) ||
+            (nx == noise_pad_size && ny == noise_pad_size)) noise_pad_size = 0;
+        if (noise_pad_size > 0) {
+            // The noise square has the same center as the image.
+            _Ninitx = _Ninity = noise_pad_size;
+            int xmin = image.getXMin() + nx/2 - noise_pad_size/2;
+            int ymin = image.getYMin() + ny/2 - noise_pad_size/2;
+            _init_bounds = Bounds<int>(xmin, xmin + noise_pad_size - 1,
+                                       ymin, ymin + noise_pad_size - 1);
+        } else {
+            _Ninitx = nx;
+            _Ninity = ny;
+            _init_bounds = image.getBounds();
+        }
         _Ninitial = std::max(_Ninitx, _Ninity);
-        _init_bounds = image.getBounds();
         dbg<<"Ninitial = "<<_Ninitial<<std::endl;
         assert(pad_factor > 0.);
         _Nk = goodFFTSize(int(pad_factor*_Ninitial));
         dbg<<"_Nk = "<<_Nk<<std::endl;
-        double sum = 0.;
-        double sumx = 0.;
-        double sumy = 0.;
 
         _xtab = boost::shared_ptr<XTable>(new XTable(_Nk, 1.));
-        int xStart = -((image.getXMax()-image.getXMin()+1)/2);
-        int y = -((image.getYMax()-image.getYMin()+1)/2);
+        int xStart = -(nx/2);
+        int y = -(ny/2);
         dbg<<"xStart = "<<xStart<<", yStart = "<<y<<std::endl;
         for (int iy = image.getYMin(); iy<= image.getYMax(); ++iy, ++y) {
             int x = xStart;
             for (int ix = image.getXMin(); ix<= image.getXMax(); ++ix, ++x) {
-                double value = image(ix,iy);
-                _xtab->xSet(x, y, value);
+                _xtab->xSet(x, y, image(ix,iy));
+            }
+        }
+        if (noise_pad_size > 0) {
+            assert(rng);
+            noise_pad->fill(*_xtab, noise_pad_size,
+                            Bounds<int>(xStart, xStart+nx-1, -(ny/2), -(ny/2)+ny-1), *rng);
+        }
+
+        double sum = 0.;
+        double sumx = 0.;
+        double sumy = 0.;
+        xStart = -(_Ninitx/2);
+        y = -(_Ninity/2);
+        for (int iy = 0; iy < _Ninity; ++iy, ++y) {
+            int x = xStart;
+            for (int ix = 0; ix < _Ninitx; ++ix, ++x) {
+                double value = _xtab->xval(x, y);
                 sum += value;
                 sumx += value*x;
                 sumy += value*y;
-                xxdbg<<"ix,iy,x,y = "<<ix<<','<<iy<<','<<x<<','<<y<<std::endl;
-                xxdbg<<"value = "<<value<<", sums = "<<sum<<','<<sumx<<','<<sumy<<std::endl;
+                xxdbg<<"x,y = "<<x<<','<<y<<", value = "<<value<<std::endl;
+                xxdbg<<"sums = "<<sum<<','<<sumx<<','<<sumy<<std::endl;
             }
         }
 
@@ -150,6 +423,11 @@ namespace galsim {
         dbg<<"N = "<<_Ninitial<<", xrange = "<<_xInterp->xrange()<<std::endl;
         dbg<<"xtab size = "<<_xtab->getN()<<", scale = "<<_xtab->getDx()<<std::endl;
 
+        // Share the padded image (and its transform) with any other profiles made from the
+        // same pixel values.
+        _cacheEntry = ktable_cache.get(_xtab);
+        _xtab = _cacheEntry->xtab;
+
         if (_stepk <= 0.) {
             // Calculate stepK:
             //
@@ -212,18 +490,35 @@ namespace galsim {
     {
         // Don't bother if the desired k value is cut off by the x interpolant:
         if (std::abs(k.x) > _maxk1 || std::abs(k.y) > _maxk1) return std::complex<double>(0.,0.);
-        checkK();
         double xKernelTransform = _xInterp->uval(k.x*_uscale, k.y*_uscale);
-        return xKernelTransform * _ktab->interpolate(k.x, k.y, *_kInterp);
+        return xKernelTransform * getKTable().interpolate(k.x, k.y, *_kInterp);
     }
 
-    void SBInterpolatedImage::SBInterpolatedImageImpl::checkK() const
+    // The KTable is built under the mutex of the cache entry, so only one thread does the FFT.
+    // The entry owns the table and lives as long as this profile, so once it is built we just
+    // keep a pointer to it.  The flushes make sure that an OpenMP thread that sees the pointer
+    // also sees the finished table.  Python threads that draw with the GIL released call
+    // prepareDraw first, so for them the pointer is already set and is only read here.
+    const KTable& SBInterpolatedImage::SBInterpolatedImageImpl::getKTable() const
     {
-        // Conduct FFT
-        if (_ktab.get()) return;
-        _ktab = _xtab->transform();
-        dbg<<"Built ktab\n";
-        dbg<<"ktab size = "<<_ktab->getN()<<", scale = "<<_ktab->getDk()<<std::endl;
+        const KTable* ktab = _ktab;
+#ifdef _OPENMP
+#pragma omp flush
+#endif
+        if (!ktab) {
+            bool built;
+            ktab = _cacheEntry->getKTable(built).get();
+            if (built) {
+                ktable_cache.addKTable(*_cacheEntry);
+                dbg<<"Built ktab\n";
+                dbg<<"ktab size = "<<ktab->getN()<<", scale = "<<ktab->getDk()<<std::endl;
+            }
+#ifdef _OPENMP
+#pragma omp flush
+#endif
+            _ktab = ktab;
+        }
+        return *ktab;
     }
 
     void SBInterpolatedImage::SBInterpolatedImageImpl::fillXValue(
@@ -237,6 +532,7 @@ namespace galsim {
         assert(val.stepi() == 1);
         const int m = val.colsize();
         const int n = val.rowsize();
+        XTable::Cache cache;
 
         if (dynamic_cast<const InterpolantXY*> (_xInterp.get())) {
             // If the interpolant is separable, the XTable interpolation routine
@@ -245,7 +541,7 @@ namespace galsim {
             for (int i=0;i<m;++i,x0+=dx) {
                 double y = y0;
                 RMIt valit = val.row(i).begin();
-                for (int j=0;j<n;++j,y+=dy) *valit++ = _xtab->interpolate(x0, y, *_xInterp);
+                for (int j=0;j<n;++j,y+=dy) *valit++ = _xtab->interpolate(x0, y, *_xInterp, cache);
             }
         } else {
             // Otherwise, just do the values in storage order
@@ -253,7 +549,8 @@ namespace galsim {
             for (int j=0;j<n;++j,y0+=dy) {
                 double x = x0;
                 CMIt valit = val.col(j).begin();
-                for (int i=0;i<m;++i,x+=dx) *valit++ = _xtab->interpolate(x, y0, *_xInterp);
+                for (int i=0;i<m;++i,x+=dx)
+                    *valit++ = _xtab->interpolate(x, y0, *_xInterp, cache);
             }
         }
     }
@@ -271,13 +568,14 @@ namespace galsim {
         const int m = val.colsize();
         const int n = val.rowsize();
         typedef tmv::VIt<double,1,tmv::NonConj> It;
+        XTable::Cache cache;
 
         It valit = val.linearView().begin();
         for (int j=0;j<n;++j,x0+=dxy,y0+=dy) {
             double x = x0;
             double y = y0;
             for (int i=0;i<m;++i,x+=dx,y+=dyx) {
-                *valit++ = _xtab->interpolate(x, y, *_xInterp);
+                *valit++ = _xtab->interpolate(x, y, *_xInterp, cache);
             }
         }
     }
@@ -293,7 +591,8 @@ namespace galsim {
         assert(val.stepi() == 1);
         const int m = val.colsize();
         const int n = val.rowsize();
-        checkK();
+        const KTable& ktab = getKTable();
+        KTable::Cache cache;
 
         // Assign zeros for range that has |u| > maxu
         double absdkx = std::abs(dkx);
@@ -346,7 +645,7 @@ namespace galsim {
                     uyit = uy.begin();
                     RMIt valit = val.row(i,j1,j2).begin();
                     for (int j=j1;j<j2;++j,ky+=dky) {
-                        *valit++ = *uxit * *uyit++ * _ktab->interpolate(kx0, ky, *kInterpXY);
+                        *valit++ = *uxit * *uyit++ * ktab.interpolate(kx0, ky, *kInterpXY, cache);
                     }
                 }
             } else {
@@ -357,7 +656,7 @@ namespace galsim {
                     RMIt valit = val.row(i,j1,j2).begin();
                     for (int j=j1;j<j2;++j,ky+=dky) {
                         double xKernelTransform = _xInterp->uval(*uxit, *uyit++);
-                        *valit++ = xKernelTransform * _ktab->interpolate(kx0, ky, *kInterpXY);
+                        *valit++ = xKernelTransform * ktab.interpolate(kx0, ky, *kInterpXY, cache);
                     }
                 }
             }
@@ -376,7 +675,7 @@ namespace galsim {
                     uxit = ux.begin();
                     CMIt valit = val.col(j,i1,i2).begin();
                     for (int i=i1;i<i2;++i,kx+=dkx) {
-                        *valit++ = *uxit++ * *uyit * _ktab->interpolate(kx, ky0, *_kInterp);
+                        *valit++ = *uxit++ * *uyit * ktab.interpolate(kx, ky0, *_kInterp, cache);
                     }
                 }
             } else {
@@ -387,7 +686,7 @@ namespace galsim {
                     CMIt valit = val.col(j,i1,i2).begin();
                     for (int i=i1;i<i2;++i,kx+=dkx) {
                         double xKernelTransform = _xInterp->uval(*uxit++, *uyit);
-                        *valit++ = xKernelTransform * _ktab->interpolate(kx, ky0, *_kInterp);
+                        *valit++ = xKernelTransform * ktab.interpolate(kx, ky0, *_kInterp, cache);
                     }
                 }
             }
@@ -407,7 +706,8 @@ namespace galsim {
         const int m = val.colsize();
         const int n = val.rowsize();
         typedef tmv::VIt<std::complex<double>,1,tmv::NonConj> It;
-        checkK();
+        const KTable& ktab = getKTable();
+        KTable::Cache cache;
 
         double ux0 = kx0 * _uscale;
         double uy0 = ky0 * _uscale;
@@ -427,7 +727,7 @@ namespace galsim {
                     *valit++ = 0.;
                 } else {
                     double xKernelTransform = _xInterp->uval(ux, uy);
-                    *valit++ = xKernelTransform * _ktab->interpolate(kx, ky, *_kInterp);
+                    *valit++ = xKernelTransform * ktab.interpolate(kx, ky, *_kInterp, cache);
                 }
             }
         }
@@ -549,27 +849,40 @@ namespace galsim {
         // enclosed enough flux again.
         int d1 = 0;
         const int Nino2 = _Ninitial/2;
-        const Bounds<int> b = _init_bounds;
-        int dx = b.getXMin() + ((b.getXMax()-b.getXMin()+1)/2);
-        int dy = b.getYMin() + ((b.getYMax()-b.getYMin()+1)/2);
-        dbg<<"b = "<<b<<std::endl;
-        dbg<<"dx,dy = "<<dx<<','<<dy<<std::endl;
         int min_d = max_stepk == 0. ? 0 : int(ceil(M_PI/max_stepk/scale));
         dbg<<"min_d = "<<min_d<<std::endl;
+
+        // Build a summed-area table of the original image, so the flux enclosed in each box
+        // is just a few lookups, rather than a sum over the new pixels along its edges.
+        // sat[(y+1)*(nx+1) + (x+1)] is the sum of the image pixels with indices <= (x,y),
+        // where x,y here count from the lower left corner of the original image.
+        const int nx = _Ninitx;
+        const int ny = _Ninity;
+        const int x0 = -(nx/2);  // The XTable position of the lower left corner.
+        const int y0 = -(ny/2);
+        std::vector<double> sat((nx+1)*(ny+1), 0.);
+        for (int y=0; y<ny; ++y) {
+            double rowsum = 0.;
+            double* sat_row = &sat[(y+1)*(nx+1)];
+            const double* sat_prev = &sat[y*(nx+1)];
+            for (int x=0; x<nx; ++x) {
+                rowsum += _xtab->xval(x+x0, y+y0);
+                sat_row[x+1] = sat_prev[x+1] + rowsum;
+            }
+        }
+
         double max_flux = flux;
         for (int d=1; d<=Nino2; ++d) {
             xdbg<<"d = "<<d<<std::endl;
             xdbg<<"d1 = "<<d1<<std::endl;
+            // The box -d <= x,y <= d, clipped to the image, in the coordinates of sat.
+            const int xa = std::max(-d-x0, 0);
+            const int xb = std::min(d-x0+1, nx);
+            const int ya = std::max(-d-y0, 0);
+            const int yb = std::min(d-y0+1, ny);
+            flux = sat[yb*(nx+1) + xb] - sat[ya*(nx+1) + xb]
+                - sat[yb*(nx+1) + xa] + sat[ya*(nx+1) + xa];
             xdbg<<"flux = "<<flux<<std::endl;
-            // Add the left, right, top and bottom sides of box:
-            for(int x = -d; x < d; ++x) {
-                // Note: All 4 corners are added exactly once by including x=-d but omitting
-                // x=d from the loop.
-                if (b.includes(Position<int>(x+dx,-d+dy))) flux += _xtab->xval(x,-d);  // bottom
-                if (b.includes(Position<int>(d+dx,x+dy))) flux += _xtab->xval(d,x);   // right
-                if (b.includes(Position<int>(-x+dx,d+dy))) flux += _xtab->xval(-x,d);  // top
-                if (b.includes(Position<int>(-d+dx,-x+dy))) flux += _xtab->xval(-d,-x); // left
-            }
             if (flux > max_flux) {
                 max_flux = flux;
                 if (flux > 1.01 * fluxTot) {
@@ -620,10 +933,27 @@ namespace galsim {
         dbg<<"max_maxk = "<<max_maxk<<std::endl;
         dbg<<"Find the smallest k such that all values outside of this are less than "
             <<this->gsparams->maxk_threshold<<std::endl;
-        checkK();
-        dbg<<"ktab size = "<<_ktab->getN()<<", scale = "<<_ktab->getDk()<<std::endl;
-
-        double dk = _ktab->getDk();
+        // The padded KTable is only needed for drawing in k space, so don't build it here.
+        // The padding just interpolates between the k values of the original image, so the FT
+        // of the image in the smallest box that holds it samples the same function on a
+        // coarser grid.  This is (pad_factor)^2 times faster, and is usually enough to find
+        // where the FT drops below the threshold.  The resulting maxk is a multiple of the
+        // coarser spacing, and it is not always larger than the value from the padded grid:
+        // if |FT| only rises above the threshold between two coarse samples, that k is missed.
+        // Since the image fits in the coarse box, the FT doesn't vary much on scales smaller
+        // than the coarse spacing, so in practice maxk is within about one coarse spacing of
+        // the padded value either way.
+        const int N0 = goodFFTSize(_Ninitial);
+        XTable xt(N0, _xtab->getDx());
+        const int x0 = -(_Ninitx/2);
+        const int y0 = -(_Ninity/2);
+        for (int y=y0; y<y0+_Ninity; ++y)
+            for (int x=x0; x<x0+_Ninitx; ++x)
+                xt.xSet(x, y, _xtab->xval(x,y));
+        boost::shared_ptr<KTable> ktab = xt.transform();
+        dbg<<"ktab size = "<<ktab->getN()<<", scale = "<<ktab->getDk()<<std::endl;
+
+        double dk = ktab->getDk();
 
         // Among the elements with kval > thresh, find the one with the maximum ksq
         double thresh = this->gsparams->maxk_threshold * getFlux();
@@ -631,7 +961,7 @@ namespace galsim {
         double maxk_ix = 0.;
         // When we get 5 rows in a row all below thresh, stop.
         int n_below_thresh = 0;
-        int N = _ktab->getN();
+        int N = ktab->getN();
         // Don't go past the current value of maxk
         if (max_maxk == 0.) max_maxk = _maxk;
         int max_ix = int(std::ceil(max_maxk / dk));
@@ -647,23 +977,23 @@ namespace galsim {
             // Search along the two sides with either kx = ix or ky = ix.
             for(int iy=0; iy<=ix; ++iy) {
                 // The right side of the square in the upper-right quadrant.
-                double norm_kval = fast_norm(_ktab->kval2(ix,iy));
+                double norm_kval = fast_norm(ktab->kval2(ix,iy));
                 xdbg<<"norm_kval at "<<ix<<','<<iy<<" = "<<norm_kval<<std::endl;
                 if (norm_kval <= thresh && iy != ix) {
                     // The top side of the square in the upper-right quadrant.
-                    norm_kval = fast_norm(_ktab->kval2(iy,ix));
+                    norm_kval = fast_norm(ktab->kval2(iy,ix));
                     xdbg<<"norm_kval at "<<iy<<','<<ix<<" = "<<norm_kval<<std::endl;
                 }
                 if (norm_kval <= thresh && iy > 0) {
                     // The right side of the square in the lower-right quadrant.
                     // The ky argument is wrapped to positive values.
-                    norm_kval = fast_norm(_ktab->kval2(ix,N-iy));
+                    norm_kval = fast_norm(ktab->kval2(ix,N-iy));
                     xdbg<<"norm_kval at "<<ix<<','<<-iy<<" = "<<norm_kval<<std::endl;
                 }
                 if (norm_kval <= thresh && ix > 0) {
                     // The bottom side of the square in the lower-right quadrant.
                     // The ky argument is wrapped to positive values.
-                    norm_kval = fast_norm(_ktab->kval2(iy,N-ix));
+                    norm_kval = fast_norm(ktab->kval2(iy,N-ix));
                     xdbg<<"norm_kval at "<<iy<<','<<-ix<<" = "<<norm_kval<<std::endl;
                 }
                 if (norm_kval > thresh) {
@@ -1041,14 +1371,27 @@ namespace galsim {
         boost::shared_ptr<Interpolant> kInterp, double pad_factor,
         double stepk, double maxk, const GSParamsPtr& gsparams);
 
+    template SBInterpolatedImage::SBInterpolatedImage(
+        const BaseImage<float>& image, boost::shared_ptr<Interpolant> xInterp,
+        boost::shared_ptr<Interpolant> kInterp, double pad_factor,
+        double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad& noise_pad, int noise_pad_size, BaseDeviate rng);
+    template SBInterpolatedImage::SBInterpolatedImage(
+        const BaseImage<double>& image, boost::shared_ptr<Interpolant> xInterp,
+        boost::shared_ptr<Interpolant> kInterp, double pad_factor,
+        double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad& noise_pad, int noise_pad_size, BaseDeviate rng);
+
     template SBInterpolatedImage::SBInterpolatedImageImpl::SBInterpolatedImageImpl(
         const BaseImage<float>& image, boost::shared_ptr<Interpolant2d> xInterp,
         boost::shared_ptr<Interpolant2d> kInterp, double pad_factor,
-        double stepk, double maxk, const GSParamsPtr& gsparams);
+        double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad* noise_pad, int noise_pad_size, BaseDeviate* rng);
     template SBInterpolatedImage::SBInterpolatedImageImpl::SBInterpolatedImageImpl(
         const BaseImage<double>& image, boost::shared_ptr<Interpolant2d> xInterp,
         boost::shared_ptr<Interpolant2d> kInterp, double pad_factor,
-        double stepk, double maxk, const GSParamsPtr& gsparams);
+        double stepk, double maxk, const GSParamsPtr& gsparams,
+        const NoisePad* noise_pad, int noise_pad_size, BaseDeviate* rng);
 
     template SBInterpolatedKImage::SBInterpolatedKImage(
         const BaseImage<float>& realKImage, const BaseImage<float>& imageKImage,
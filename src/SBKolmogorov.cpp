@@ -21,6 +21,7 @@
 
 #include "SBKolmogorov.h"
 #include "SBKolmogorovImpl.h"
+#include "bessel/BesselJ.h"
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -252,12 +253,30 @@ namespace galsim {
     public:
         KolmIntegrand(double r) : _r(r) {}
         double operator()(double k) const
-        { return k*std::exp(-std::pow(k, 5./3.))*j0(k*_r); }
+        { return k*std::exp(-std::pow(k, 5./3.))*bessel::BesselJ0(k*_r); }
+
+        // f[i] = operator()(k[i]) for i = 0..n-1, using the batch J0.
+        void operator()(const double* k, double* f, int n) const
+        {
+            for (int i=0; i<n; ++i) f[i] = k[i]*_r;
+            bessel::BesselJ0Many(f, f, n);
+            for (int i=0; i<n; ++i) f[i] *= k[i]*std::exp(-std::pow(k[i], 5./3.));
+        }
 
     private:
         double _r;
     };
 
+    namespace integ {
+        // Let the GKP integrator evaluate KolmIntegrand a whole level of abscissae at a time.
+        template <>
+        struct BatchEval<KolmIntegrand>
+        {
+            static void eval(const KolmIntegrand& func, const double* x, double* f, int n)
+            { func(x, f, n); }
+        };
+    }
+
     // Perform the integral
     class KolmXValue : public std::unary_function<double,double>
     {
@@ -379,6 +398,7 @@ namespace galsim {
             if (R == 0. && sum > thresh1) R = r;
             if (hlr == 0. && sum > thresh0) hlr = r;
         }
+        _radial.setup();
         dbg<<"Done loop to build radial function.\n";
         dbg<<"R = "<<R<<std::endl;
         dbg<<"hlr = "<<hlr<<std::endl;
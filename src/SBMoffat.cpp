@@ -30,6 +30,7 @@
 #include "integ/Int.h"
 #include "Solve.h"
 #include "bessel/Roots.h"
+#include "bessel/BesselJ.h"
 
 // Define this variable to find azimuth (and sometimes radius within a unit disc) of 2d photons by
 // drawing a uniform deviate for theta, instead of drawing 2 deviates for a point on the unit
@@ -576,7 +577,15 @@ namespace galsim {
         MoffatIntegrand(double beta, double k, double (*pb)(double, double)) :
             _beta(beta), _k(k), _pow_beta(pb) {}
         double operator()(double r) const
-        { return r/_pow_beta(1.+r*r, _beta)*j0(_k*r); }
+        { return r/_pow_beta(1.+r*r, _beta)*bessel::BesselJ0(_k*r); }
+
+        // f[i] = operator()(r[i]) for i = 0..n-1, using the batch J0.
+        void operator()(const double* r, double* f, int n) const
+        {
+            for (int i=0; i<n; ++i) f[i] = _k*r[i];
+            bessel::BesselJ0Many(f, f, n);
+            for (int i=0; i<n; ++i) f[i] *= r[i]/_pow_beta(1.+r[i]*r[i], _beta);
+        }
 
     private:
         double _beta;
@@ -584,6 +593,16 @@ namespace galsim {
         double (*_pow_beta)(double x, double beta);
     };
 
+    namespace integ {
+        // Let the GKP integrator evaluate MoffatIntegrand a whole level of abscissae at a time.
+        template <>
+        struct BatchEval<MoffatIntegrand>
+        {
+            static void eval(const MoffatIntegrand& func, const double* x, double* f, int n)
+            { func(x, f, n); }
+        };
+    }
+
     void SBMoffat::SBMoffatImpl::setupFT() const
     {
         assert(_trunc > 0.);
@@ -643,6 +662,7 @@ namespace galsim {
             else ++n_below_thresh;
             if (n_below_thresh == 5) break;
         }
+        _ft.setup();
         dbg<<"maxk = "<<_maxk<<std::endl;
     }
 
@@ -125,6 +125,12 @@ namespace galsim {
         return _pimpl->stepK();
     }
 
+    void SBProfile::prepareDraw() const
+    {
+        assert(_pimpl.get());
+        _pimpl->prepareDraw();
+    }
+
     bool SBProfile::isAxisymmetric() const
     {
         assert(_pimpl.get());
@@ -602,7 +608,6 @@ namespace galsim {
 
         int N = xt.getN();
         double dx = xt.getDx();
-        xt.clearCache();
 
         tmv::Matrix<double> val(N,N);
 #ifdef DEBUGLOGGING
@@ -619,7 +624,6 @@ namespace galsim {
         dbg<<"Start fillKGrid\n";
         int N = kt.getN();
         double dk = kt.getDk();
-        kt.clearCache();
 
         tmv::Matrix<std::complex<double> > val(N/2+1,N+1);
 #ifdef DEBUGLOGGING
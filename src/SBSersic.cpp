@@ -30,6 +30,7 @@
 #include "integ/Int.h"
 #include "Solve.h"
 #include "bessel/Roots.h"
+#include "bessel/BesselJ.h"
 
 #ifdef DEBUGLOGGING
 #include <fstream>
@@ -460,13 +461,31 @@ namespace galsim {
         SersicHankel(double invn, double k): _invn(invn), _k(k) {}
 
         double operator()(double r) const
-        { return r*std::exp(-std::pow(r, _invn))*j0(_k*r); }
+        { return r*std::exp(-std::pow(r, _invn))*bessel::BesselJ0(_k*r); }
+
+        // f[i] = operator()(r[i]) for i = 0..n-1, using the batch J0.
+        void operator()(const double* r, double* f, int n) const
+        {
+            for (int i=0; i<n; ++i) f[i] = _k*r[i];
+            bessel::BesselJ0Many(f, f, n);
+            for (int i=0; i<n; ++i) f[i] *= r[i]*std::exp(-std::pow(r[i], _invn));
+        }
 
     private:
         double _invn;
         double _k;
     };
 
+    namespace integ {
+        // Let the GKP integrator evaluate SersicHankel a whole level of abscissae at a time.
+        template <>
+        struct BatchEval<SersicHankel>
+        {
+            static void eval(const SersicHankel& func, const double* x, double* f, int n)
+            { func(x, f, n); }
+        };
+    }
+
     void SersicInfo::buildFT() const
     {
         // The small-k expansion of the Hankel transform is (normalized to have flux=1):
@@ -609,6 +628,7 @@ namespace galsim {
         // If didn't find a good approximation for large k, just use the largest k we put in
         // in the table.  (Need to use some approximation after this anyway!)
         if (_ksq_max <= 0.) _ksq_max = std::exp(2. * _ft.argMax());
+        _ft.setup();
         xdbg<<"ft.argMax = "<<_ft.argMax()<<std::endl;
         xdbg<<"ksq_max = "<<_ksq_max<<std::endl;
 
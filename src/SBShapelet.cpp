@@ -86,41 +86,20 @@ namespace galsim {
 
     double SBShapelet::SBShapeletImpl::xValue(const Position<double>& p) const
     {
-        LVector psi(_bvec.getOrder());
-        psi.fillBasis(p.x/_sigma, p.y/_sigma, _sigma);
-        double xval = _bvec.dot(psi);
+        double x = p.x/_sigma;
+        double y = p.y/_sigma;
+        double xval;
+        _bvec.sumBasis(&x, &y, &xval, 1, _sigma);
         return xval;
     }
 
     std::complex<double> SBShapelet::SBShapeletImpl::kValue(const Position<double>& k) const
     {
-        int N=_bvec.getOrder();
-        LVector psi(N);
-        psi.fillBasis(k.x*_sigma, k.y*_sigma);  // Fourier[Psi_pq] is unitless
-        // rotate kvalues of Psi with i^(p+q)
-        // dotting b_pq with psi in k-space:
-        double rr=0.;
-        double ii=0.;
-        for (PQIndex pq(0,0); !pq.pastOrder(N); pq.nextDistinct()) {
-            int j = pq.rIndex();
-            double x = _bvec[j]*psi[j] + (pq.isReal() ? 0 : _bvec[j+1]*psi[j+1]);
-            switch (pq.N() % 4) {
-              case 0:
-                   rr += x;
-                   break;
-              case 1:
-                   ii -= x;
-                   break;
-              case 2:
-                   rr -= x;
-                   break;
-              case 3:
-                   ii += x;
-                   break;
-            }
-        }
-        // difference in Fourier convention with FFTW ???
-        return std::complex<double>(2.*M_PI*rr, 2.*M_PI*ii);
+        double kx = k.x*_sigma;
+        double ky = k.y*_sigma;
+        std::complex<double> kval;
+        _bvec.sumKBasis(&kx, &ky, &kval, 1);  // Fourier[Psi_pq] is unitless
+        return kval;
     }
 
     double SBShapelet::SBShapeletImpl::getFlux() const
@@ -262,10 +241,7 @@ namespace galsim {
         assert(val.canLinearize());
         const int m = val.colsize();
         const int n = val.rowsize();
-        tmv::Matrix<double> psi(m*n,_bvec.size());
-        LVector::basis(x.constLinearView(),y.constLinearView(),psi.view(),
-                       _bvec.getOrder(),_sigma);
-        val.linearView() = psi * _bvec.rVector();
+        _bvec.sumBasis(x.cptr(),y.cptr(),val.linearView().ptr(),m*n,_sigma);
     }
 
     void SBShapelet::SBShapeletImpl::fillKValue(
@@ -278,13 +254,7 @@ namespace galsim {
         assert(val.canLinearize());
         const int m = val.colsize();
         const int n = val.rowsize();
-        tmv::Matrix<std::complex<double> > psi_k(m*n,_bvec.size());
-        LVector::kBasis(kx.constLinearView(),ky.constLinearView(),psi_k.view(),
-                        _bvec.getOrder(),_sigma);
-        // Note: the explicit cast to Vector<complex<double> > shouldn't be necessary.
-        // But not doing so fails for Apple's default BLAS library.  It should be a pretty
-        // minimal efficiency difference, so we always do the explicit cast to be safe.
-        val.linearView() = psi_k * tmv::Vector<std::complex<double> >(_bvec.rVector());
+        _bvec.sumKBasis(kx.cptr(),ky.cptr(),val.linearView().ptr(),m*n);
     }
 
     template <typename T>
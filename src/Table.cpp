@@ -23,10 +23,15 @@
 #include "TMV_SymBand.h"
 #include "Table.h"
 #include <cmath>
+#include <algorithm>
 #include <vector>
 
 #include <iostream>
 
+#ifdef __SSE2__
+#include "emmintrin.h"
+#endif
+
 namespace galsim {
 
     // ArgVec
@@ -34,6 +39,7 @@ namespace galsim {
     template<class A>
     void ArgVec<A>::setup() const
     {
+        if (isReady) return;
         int N = vec.size();
         const double tolerance = 0.01;
         da = (vec.back() - vec.front()) / (N-1);
@@ -44,7 +50,6 @@ namespace galsim {
             if (vec[i] <= vec[i-1])
                 throw TableError("Table arguments not strictly increasing.");
         }
-        lastIndex = 1;
         lower_slop = (vec[1]-vec[0]) * 1.e-6;
         upper_slop = (vec[N-1]-vec[N-2]) * 1.e-6;
         isReady = true;
@@ -53,6 +58,14 @@ namespace galsim {
     // Look up an index.  Use STL binary search.
     template<class A>
     int ArgVec<A>::upperIndex(const A a) const
+    {
+        // Without a hint from a previous lookup, start from the middle.
+        int hint = vec.size()/2;
+        return upperIndex(a, hint);
+    }
+
+    template<class A>
+    int ArgVec<A>::upperIndex(const A a, int& hint) const
     {
         if (!isReady) setup();
         if (a<vec.front()-lower_slop || a>vec.back()+upper_slop)
@@ -70,37 +83,76 @@ namespace galsim {
             while (a < vec[i-1]) --i;
             return i;
         } else {
-            xassert(lastIndex >= 1);
-            xassert(lastIndex < vec.size());
-
-            if ( a < vec[lastIndex-1] ) {
-                xassert(lastIndex-2 >= 0);
+            // The hint is kept by the caller rather than in the ArgVec, since the table may be
+            // used from several threads at once.
+            int i = hint;
+            xassert(i >= 1);
+            xassert(i < vec.size());
+
+            if ( a < vec[i-1] ) {
+                xassert(i-2 >= 0);
                 // Check to see if the previous one is it.
-                if (a >= vec[lastIndex-2]) return --lastIndex;
+                if (a >= vec[i-2]) --i;
                 else {
-                    // Look for the entry from 0..lastIndex-1:
-                    citer p = std::upper_bound(vec.begin(), vec.begin()+lastIndex-1, a);
+                    // Look for the entry from 0..i-1:
+                    citer p = std::upper_bound(vec.begin(), vec.begin()+i-1, a);
                     xassert(p != vec.begin());
-                    xassert(p != vec.begin()+lastIndex-1);
-                    lastIndex = p-vec.begin();
-                    return lastIndex;
+                    xassert(p != vec.begin()+i-1);
+                    i = p-vec.begin();
                 }
-            } else if (a > vec[lastIndex]) {
-                xassert(lastIndex+1 < vec.size());
+            } else if (a > vec[i]) {
+                xassert(i+1 < vec.size());
                 // Check to see if the next one is it.
-                if (a <= vec[lastIndex+1]) return ++lastIndex;
+                if (a <= vec[i+1]) ++i;
                 else {
-                    // Look for the entry from lastIndex..end
-                    citer p = std::lower_bound(vec.begin()+lastIndex+1, vec.end(), a);
-                    xassert(p != vec.begin()+lastIndex+1);
+                    // Look for the entry from i..end
+                    citer p = std::lower_bound(vec.begin()+i+1, vec.end(), a);
+                    xassert(p != vec.begin()+i+1);
                     xassert(p != vec.end());
-                    lastIndex = p-vec.begin();
-                    return lastIndex;
+                    i = p-vec.begin();
                 }
-            } else {
-                // Then lastIndex is correct.
-                return lastIndex;
             }
+            // Else the hint is correct.
+            hint = i;
+            return i;
+        }
+    }
+
+    template<class A>
+    void ArgVec<A>::upperIndexMany(const A* a, int* indices, int N) const
+    {
+        if (!isReady) setup();
+        if (!equalSpaced) {
+            // Successive values are often close together, so starting each search from the
+            // previous result makes this fast enough.
+            int hint = vec.size()/2;
+            for (int k=0; k<N; ++k) indices[k] = upperIndex(a[k], hint);
+            return;
+        }
+
+        // For equally spaced arguments, this is the same calculation as in upperIndex, but
+        // without repeating the setup and slop calculations for each value.
+        const int n = vec.size();
+        const A lo = vec.front();
+        const A hi = vec.back();
+        const A lo_slop = lo - lower_slop;
+        const A hi_slop = hi + upper_slop;
+        const A invda = 1. / da;
+        for (int k=0; k<N; ++k) {
+            const A ak = a[k];
+            if (ak < lo_slop || ak > hi_slop) throw TableOutOfRange(ak,lo,hi);
+            int i;
+            if (ak < lo) i = 1;
+            else if (ak > hi) i = n-1;
+            else {
+                i = int(std::ceil((ak-lo) * invda));
+                if (i >= n) i = n-1;
+                if (i == 0) i = 1;
+                // check if we need to move ahead or back one step due to rounding errors
+                while (ak > vec[i]) ++i;
+                while (ak < vec[i-1]) --i;
+            }
+            indices[k] = i;
         }
     }
 
@@ -156,6 +208,7 @@ namespace galsim {
           default:
                throw TableError("interpolation method not yet implemented");
         }
+        args.setup();
         if (iType == spline) setupSpline();
         isReady = true;
     }
@@ -187,8 +240,9 @@ namespace galsim {
     {
         setup();
         int i;
+        int hint = args.size()/2;
         for (int k=0; k<N; k++) {
-            i = args.upperIndex(argvec[k]);
+            i = args.upperIndex(argvec[k], hint);
             valvec[k] = (this->*interpolate)(argvec[k], i);
         }
     }
@@ -303,38 +357,64 @@ namespace galsim {
 
     // Table2D
 
+namespace {
+
+    // Bilinear interpolation between the pairs (v0[0], v0[1]) and (v1[0], v1[1]), which are
+    // adjacent in y, with weights (ax, bx) in x and (ay, by) in y.
+    template <class V, class A>
+    inline V Bilinear(const V* v0, const V* v1, A ax, A bx, A ay, A by)
+    { return (v0[0] * ax + v1[0] * bx) * ay + (v0[1] * ax + v1[1] * bx) * by; }
+
+#ifdef __SSE2__
+    // The same thing using SSE2 to do the two y values at once.  This does exactly the same
+    // floating point operations as the generic version, so the results are identical.
+    template <>
+    inline double Bilinear(const double* v0, const double* v1,
+                           double ax, double bx, double ay, double by)
+    {
+        __m128d r = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(v0), _mm_set1_pd(ax)),
+                               _mm_mul_pd(_mm_loadu_pd(v1), _mm_set1_pd(bx)));
+        union { __m128d xm; double xd[2]; } xr;
+        xr.xm = _mm_mul_pd(r, _mm_set_pd(by, ay));
+        return xr.xd[0] + xr.xd[1];
+    }
+#endif
+
+    // The number of values to do at a time in interpMany.
+    const int TABLE2D_BLOCK = 256;
+
+} // anonymous
+
     template<class V, class A>
     Table2D<V,A>::Table2D(const A* _xargs, const A* _yargs, const V* _vals, int _Nx, int _Ny,
         interpolant in) : iType(in), Nx(_Nx), Ny(_Ny),
                           xargs(_xargs, _xargs+Nx), yargs(_yargs, _yargs+Ny),
                           vals(_vals, _vals+Nx*Ny)
     {
-        // Map specific interpolator to `interpolate`.
         switch (iType) {
           case linear:
-               interpolate = &Table2D<V,A>::linearInterpolate;
-               break;
           case floor:
-               interpolate = &Table2D<V,A>::floorInterpolate;
-               break;
           case ceil:
-               interpolate = &Table2D<V,A>::ceilInterpolate;
-               break;
           case nearest:
-               interpolate = &Table2D<V,A>::nearestInterpolate;
+               break;
+          case spline:
+               if (Nx < 4 || Ny < 4)
+                   throw TableError("input arrays are too short to spline interpolate");
                break;
           default:
                throw TableError("interpolation method not yet implemented");
         }
+        xargs.setup();
+        yargs.setup();
     }
 
     //lookup and interpolate function value.
     template<class V, class A>
     V Table2D<V,A>::lookup(const A x, const A y) const
     {
-        int i = xargs.upperIndex(x);
-        int j = yargs.upperIndex(y);
-        return (this->*interpolate)(x, y, i, j);
+        V val;
+        interpMany(&x, &y, &val, 1);
+        return val;
     }
 
     //lookup and interpolate an array of function values.
@@ -343,11 +423,14 @@ namespace galsim {
     template<class V, class A>
     void Table2D<V,A>::interpMany(const A* xvec, const A* yvec, V* valvec, int N) const
     {
-        int i, j;
-        for (int k=0; k<N; k++, valvec++) {
-            i = xargs.upperIndex(xvec[k]);
-            j = yargs.upperIndex(yvec[k]);
-            *valvec = (this->*interpolate)(xvec[k], yvec[k], i, j);
+        // Work in blocks, so the indices and weights stay in cache.
+        int kx[TABLE2D_BLOCK], ky[TABLE2D_BLOCK];
+        A wx[4*TABLE2D_BLOCK], wy[4*TABLE2D_BLOCK];
+        for (int k0=0; k0<N; k0+=TABLE2D_BLOCK) {
+            const int n = std::min(TABLE2D_BLOCK, N-k0);
+            axisWeights(xargs, xvec+k0, n, kx, wx);
+            axisWeights(yargs, yvec+k0, n, ky, wy);
+            interpWeights(kx, wx, 1, ky, wy, valvec+k0, n);
         }
     }
 
@@ -357,55 +440,139 @@ namespace galsim {
     void Table2D<V,A>::interpManyMesh(const A* xvec, const A* yvec, V* valvec,
                                        int outNx, int outNy) const
     {
-        int i, j;
-        for (int outi=0; outi<outNx; outi++) {
-            i = xargs.upperIndex(xvec[outi]);
-            for (int outj=0; outj<outNy; outj++, valvec++) {
-                j = yargs.upperIndex(yvec[outj]);
-                *valvec = (this->*interpolate)(xvec[outi], yvec[outj], i, j);
-            }
+        // The indices and weights along each axis only need to be found once.
+        const int nw = nWeights();
+        std::vector<int> kx(outNx), ky(outNy);
+        std::vector<A> wx(nw*outNx + 1), wy(nw*outNy + 1);
+        axisWeights(xargs, xvec, outNx, &kx[0], &wx[0]);
+        axisWeights(yargs, yvec, outNy, &ky[0], &wy[0]);
+        for (int outi=0; outi<outNx; outi++, valvec+=outNy) {
+            interpWeights(&kx[outi], &wx[nw*outi], 0, &ky[0], &wy[0], valvec, outNy);
         }
     }
 
     template<class V, class A>
-    V Table2D<V,A>::linearInterpolate(const A x, const A y, int i, int j) const
+    void Table2D<V,A>::axisWeights(
+        const ArgVec<A>& args, const A* a, int n, int* k, A* w) const
     {
-        A ax = (xargs[i] - x) / (xargs[i] - xargs[i-1]);
-        A bx = 1.0 - ax;
-        A ay = (yargs[j] - y) / (yargs[j] - yargs[j-1]);
-        A by = 1.0 - ay;
-
-        return (vals[(i-1)*Ny+j-1] * ax * ay
-                + vals[i*Ny+j-1] * bx * ay
-                + vals[(i-1)*Ny+j] * ax * by
-                + vals[i*Ny+j] * bx * by);
-    }
-
-    template<class V, class A>
-    V Table2D<V,A>::floorInterpolate(const A x, const A y, int i, int j) const
-    {
-        // On entry, it is only guaranteed that xargs[i-1] <= x <= xargs[i] (and similarly y).
-        // Normally those ='s are ok, but for floor and ceil we make the extra
-        // check to see if we should choose the opposite bound.
-        if (x == xargs[i]) i++;
-        if (y == yargs[j]) j++;
-        return vals[(i-1)*Ny+j-1];
-    }
+        // On return from upperIndexMany, it is only guaranteed that
+        // args[k-1] <= a <= args[k].
+        args.upperIndexMany(a, k, n);
 
-    template<class V, class A>
-    V Table2D<V,A>::ceilInterpolate(const A x, const A y, int i, int j) const
-    {
-        if (x == xargs[i-1]) i--;
-        if (y == yargs[j-1]) j--;
-        return vals[i*Ny+j];
+        switch (iType) {
+          case linear:
+               for (int m=0; m<n; ++m) {
+                   const int i = k[m];
+                   const A wa = (args[i] - a[m]) / (args[i] - args[i-1]);
+                   w[2*m] = wa;
+                   w[2*m+1] = 1.0 - wa;
+                   k[m] = i-1;
+               }
+               break;
+          case floor:
+               // Normally those ='s are ok, but for floor and ceil we make the extra
+               // check to see if we should choose the opposite bound.
+               for (int m=0; m<n; ++m) {
+                   const int i = k[m];
+                   k[m] = (a[m] == args[i]) ? i : i-1;
+               }
+               break;
+          case ceil:
+               for (int m=0; m<n; ++m) {
+                   const int i = k[m];
+                   k[m] = (a[m] == args[i-1]) ? i-1 : i;
+               }
+               break;
+          case nearest:
+               for (int m=0; m<n; ++m) {
+                   const int i = k[m];
+                   k[m] = ((a[m] - args[i-1]) < (args[i] - a[m])) ? i-1 : i;
+               }
+               break;
+          case spline:
+               {
+                   const int N = args.size();
+                   for (int m=0; m<n; ++m) {
+                       const int i = k[m];
+                       // Cubic Hermite basis functions for the interval args[i-1]..args[i].
+                       const A dx = args[i] - args[i-1];
+                       const A t = (a[m] - args[i-1]) / dx;
+                       const A s = 1.0 - t;
+                       const A h00 = (1.0 + 2.0*t) * s * s;
+                       const A h01 = t * t * (3.0 - 2.0*t);
+                       const A h10 = t * s * s;
+                       const A h11 = -t * t * s;
+                       // The derivatives at args[i-1] and args[i] are the centered finite
+                       // differences, or one-sided ones at the edges.  Written as weights for
+                       // the entries i-2, i-1, i, i+1:
+                       A c[4] = { 0., h00, h01, 0. };
+                       if (i >= 2) {
+                           const A r = h10 * dx / (args[i] - args[i-2]);
+                           c[2] += r;
+                           c[0] -= r;
+                       } else {
+                           c[2] += h10;
+                           c[1] -= h10;
+                       }
+                       if (i+1 < N) {
+                           const A r = h11 * dx / (args[i+1] - args[i-1]);
+                           c[3] += r;
+                           c[1] -= r;
+                       } else {
+                           c[2] += h11;
+                           c[1] -= h11;
+                       }
+                       // Use the 4 entries starting at i-2, shifted to stay inside the table.
+                       // Any entry that is off the edge has zero weight.
+                       const int k0 = std::min(std::max(i-2, 0), N-4);
+                       A* wm = w + 4*m;
+                       wm[0] = wm[1] = wm[2] = wm[3] = 0.;
+                       for (int q=0; q<4; ++q) {
+                           const int iq = i-2+q;
+                           if (iq >= 0 && iq < N) wm[iq-k0] += c[q];
+                       }
+                       k[m] = k0;
+                   }
+               }
+               break;
+          default:
+               throw TableError("interpolation method not yet implemented");
+        }
     }
 
     template<class V, class A>
-    V Table2D<V,A>::nearestInterpolate(const A x, const A y, int i, int j) const
+    void Table2D<V,A>::interpWeights(
+        const int* kx, const A* wx, int xstep,
+        const int* ky, const A* wy, V* valvec, int n) const
     {
-        if ((x - xargs[i-1]) < (xargs[i] - x)) i--;
-        if ((y - yargs[j-1]) < (yargs[j] - y)) j--;
-        return vals[i*Ny+j];
+        switch (iType) {
+          case linear:
+               for (int m=0; m<n; ++m) {
+                   const int mx = m*xstep;
+                   const V* v0 = &vals[kx[mx]*Ny + ky[m]];
+                   valvec[m] = Bilinear(v0, v0+Ny, wx[2*mx], wx[2*mx+1], wy[2*m], wy[2*m+1]);
+               }
+               break;
+          case spline:
+               for (int m=0; m<n; ++m) {
+                   const int mx = m*xstep;
+                   const V* v = &vals[kx[mx]*Ny + ky[m]];
+                   const A* wxm = wx + 4*mx;
+                   const A* wym = wy + 4*m;
+                   V sum = v[0] * wym[0] + v[1] * wym[1] + v[2] * wym[2] + v[3] * wym[3];
+                   sum *= wxm[0];
+                   for (int p=1; p<4; ++p) {
+                       v += Ny;
+                       sum += (v[0] * wym[0] + v[1] * wym[1] + v[2] * wym[2] + v[3] * wym[3])
+                           * wxm[p];
+                   }
+                   valvec[m] = sum;
+               }
+               break;
+          default:
+               // floor, ceil and nearest just use the one entry.
+               for (int m=0; m<n; ++m) valvec[m] = vals[kx[m*xstep]*Ny + ky[m]];
+        }
     }
 
     template class Table2D<double,double>;
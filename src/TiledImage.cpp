@@ -0,0 +1,181 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#include "TiledImage.h"
+
+namespace galsim {
+
+namespace {
+
+    template <typename T>
+    struct AddRow
+    {
+        void operator()(T* tile_row, const T* image_row, int n) const
+        { for (int k=0; k<n; ++k) tile_row[k] += image_row[k]; }
+    };
+
+    template <typename T>
+    struct CopyRow
+    {
+        void operator()(T* tile_row, const T* image_row, int n) const
+        { std::copy(image_row, image_row+n, tile_row); }
+    };
+
+    template <typename T>
+    struct SumPixels
+    {
+        SumPixels() : sum(T(0)) {}
+        void operator()(const T& x) { sum += x; }
+        T sum;
+    };
+
+} // anonymous
+
+template <typename T>
+TiledImage<T>::TiledImage(const Bounds<int>& bounds, int tileSize, T init_value) :
+    AssignableToImage<T>(bounds)
+{
+    allocate(tileSize);
+    fill(init_value);
+}
+
+template <typename T>
+TiledImage<T>::TiledImage(const BaseImage<T>& image, int tileSize) :
+    AssignableToImage<T>(image.getBounds())
+{
+    allocate(tileSize);
+    copyFrom(image);
+}
+
+template <typename T>
+void TiledImage<T>::allocate(int tileSize)
+{
+    if (tileSize <= 0) {
+        FormatAndThrow<ImageError>() << "Invalid tile size " << tileSize << " for TiledImage";
+    }
+    if (!this->_bounds.isDefined()) {
+        throw ImageError("Attempt to create a TiledImage with undefined bounds");
+    }
+    const int ncol = this->_bounds.getXMax() - this->_bounds.getXMin() + 1;
+    const int nrow = this->_bounds.getYMax() - this->_bounds.getYMin() + 1;
+    _tileSize = tileSize;
+    _tileArea = tileSize * tileSize;
+    _ntx = (ncol + tileSize - 1) / tileSize;
+    _nty = (nrow + tileSize - 1) / tileSize;
+    _data.resize(size_t(_ntx) * _nty * _tileArea);
+}
+
+template <typename T>
+Bounds<int> TiledImage<T>::getTileBounds(int i, int j) const
+{
+    const int x1 = this->_bounds.getXMin() + i * _tileSize;
+    const int y1 = this->_bounds.getYMin() + j * _tileSize;
+    return Bounds<int>(x1, std::min(x1 + _tileSize - 1, this->_bounds.getXMax()),
+                       y1, std::min(y1 + _tileSize - 1, this->_bounds.getYMax()));
+}
+
+template <typename T>
+T& TiledImage<T>::at(int x, int y)
+{
+    if (!this->_bounds.includes(x,y)) throw ImageBoundsError(x, y, this->_bounds);
+    return (*this)(x,y);
+}
+
+template <typename T>
+const T& TiledImage<T>::at(int x, int y) const
+{
+    if (!this->_bounds.includes(x,y)) throw ImageBoundsError(x, y, this->_bounds);
+    return (*this)(x,y);
+}
+
+template <typename T> template <typename Op>
+void TiledImage<T>::forEachOverlapRow(const BaseImage<T>& image, Op op)
+{
+    if (!image.getData()) return;
+    const Bounds<int> b = this->_bounds & image.getBounds();
+    if (!b.isDefined()) return;
+
+    const int xmin = this->_bounds.getXMin();
+    const int ymin = this->_bounds.getYMin();
+    const int i1 = (b.getXMin() - xmin) / _tileSize;
+    const int i2 = (b.getXMax() - xmin) / _tileSize;
+    const int j1 = (b.getYMin() - ymin) / _tileSize;
+    const int j2 = (b.getYMax() - ymin) / _tileSize;
+    const int step = image.getStride();
+
+    for (int j = j1; j <= j2; ++j) {
+        const int ty1 = ymin + j * _tileSize;
+        const int y1 = std::max(b.getYMin(), ty1);
+        const int y2 = std::min(b.getYMax(), ty1 + _tileSize - 1);
+        for (int i = i1; i <= i2; ++i) {
+            const int tx1 = xmin + i * _tileSize;
+            const int x1 = std::max(b.getXMin(), tx1);
+            const int x2 = std::min(b.getXMax(), tx1 + _tileSize - 1);
+            const int n = x2 - x1 + 1;
+            T* tile_row = getTileData(i,j) + (y1 - ty1) * _tileSize + (x1 - tx1);
+            const T* image_row = &image(x1, y1);
+            for (int y = y1; y <= y2; ++y, tile_row += _tileSize, image_row += step)
+                op(tile_row, image_row, n);
+        }
+    }
+}
+
+template <typename T>
+void TiledImage<T>::addImage(const BaseImage<T>& image)
+{ forEachOverlapRow(image, AddRow<T>()); }
+
+template <typename T>
+void TiledImage<T>::copyFrom(const BaseImage<T>& image)
+{ forEachOverlapRow(image, CopyRow<T>()); }
+
+template <typename T>
+void TiledImage<T>::assignTo(const ImageView<T>& rhs) const
+{
+    if (!rhs.getData()) return;
+    if (this->_bounds != rhs.getBounds()) {
+        throw ImageError("Attempt to assign a TiledImage to an image with different bounds");
+    }
+    const int step = rhs.getStride();
+    for (int j = 0; j < _nty; ++j) {
+        for (int i = 0; i < _ntx; ++i) {
+            const Bounds<int> b = getTileBounds(i,j);
+            const int n = b.getXMax() - b.getXMin() + 1;
+            const T* tile_row = getTileData(i,j);
+            T* image_row = &rhs(b.getXMin(), b.getYMin());
+            for (int y = b.getYMin(); y <= b.getYMax(); ++y) {
+                std::copy(tile_row, tile_row + n, image_row);
+                tile_row += _tileSize;
+                image_row += step;
+            }
+        }
+    }
+}
+
+template <typename T>
+T TiledImage<T>::sumElements() const
+{ return forEachPixel(SumPixels<T>()).sum; }
+
+// instantiate for expected types
+
+template class TiledImage<double>;
+template class TiledImage<float>;
+template class TiledImage<int32_t>;
+template class TiledImage<int16_t>;
+
+} // namespace galsim
@@ -0,0 +1,382 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "WCS.h"
+#include "Angle.h"
+
+namespace galsim {
+
+namespace {
+
+    // Return codes of SolvePoly.
+    enum { NotImproving=1, MaxIter=2 };
+
+    // Evaluate the polynomial f(x,y) = sum_ij c[i*(order+1)+j] x^i y^j.
+    inline double Poly(const double* c, int order, double x, double y)
+    {
+        double f = 0.;
+        for (int i=order; i>=0; --i) {
+            const double* ci = c + i*(order+1);
+            double r = 0.;
+            for (int j=order; j>=0; --j) r = r*y + ci[j];
+            f = f*x + r;
+        }
+        return f;
+    }
+
+    // The same polynomial along with its derivatives df/dx and df/dy.
+    inline void PolyDeriv(const double* c, int order, double x, double y,
+                          double& f, double& dfdx, double& dfdy)
+    {
+        f = dfdx = dfdy = 0.;
+        for (int i=order; i>=0; --i) {
+            const double* ci = c + i*(order+1);
+            double r = 0.;
+            double drdy = 0.;
+            for (int j=order; j>=0; --j) {
+                drdy = drdy*y + r;
+                r = r*y + ci[j];
+            }
+            dfdx = dfdx*x + f;
+            f = f*x + r;
+            dfdy = dfdy*x + drdy;
+        }
+    }
+
+    // Solve (f0(x,y), f1(x,y)) = (s,t) by Newton-Raphson iteration, starting from the input
+    // values of x and y.  f0 and f1 are the polynomials with coefficients c and c+(order+1)^2,
+    // plus x and y respectively if addxy is true.  This is the iteration that GSFitsWCS used
+    // to do in python, including its tolerance and failure conditions.
+    int SolvePoly(const double* c, int order, bool addxy, double s, double t,
+                  double& x, double& y)
+    {
+        const int MAX_ITER = 10;
+        const double TOL = 1.e-8 * arcsec.getValue() / degrees.getValue();
+        const int nc = (order+1)*(order+1);
+        double prev_err = 0.;
+        for (int iter=0; iter<MAX_ITER; ++iter) {
+            double f0, dfdx0, dfdy0, f1, dfdx1, dfdy1;
+            PolyDeriv(c, order, x, y, f0, dfdx0, dfdy0);
+            PolyDeriv(c+nc, order, x, y, f1, dfdx1, dfdy1);
+            if (addxy) {
+                f0 += x; dfdx0 += 1.;
+                f1 += y; dfdy1 += 1.;
+            }
+            const double d0 = f0 - s;
+            const double d1 = f1 - t;
+            const double err = std::max(std::abs(d0), std::abs(d1));
+            if (iter > 0 && err > prev_err) return NotImproving;
+            prev_err = err;
+            if (err < TOL) return 0;
+            const double det = dfdx0*dfdy1 - dfdy0*dfdx1;
+            x -= (dfdy1*d0 - dfdy0*d1) / det;
+            y -= (dfdx0*d1 - dfdx1*d0) / det;
+        }
+        return MaxIter;
+    }
+
+} // anonymous
+
+FitsWCSTransform::FitsWCSTransform(
+    Projection proj, double ra0, double dec0, const double* crpix, const double* cd,
+    const double* pv, int abOrder, const double* ab, int abpOrder, const double* abp) :
+    _proj(proj), _ra0(ra0), _sindec0(std::sin(dec0)), _cosdec0(std::cos(dec0)),
+    _abOrder(abOrder), _abpOrder(abpOrder)
+{
+    _crpix[0] = crpix[0];
+    _crpix[1] = crpix[1];
+    std::copy(cd, cd+4, _cd);
+    const double det = cd[0]*cd[3] - cd[1]*cd[2];
+    if (det == 0.) throw WCSError("The CD matrix is singular");
+    _cdinv[0] = cd[3] / det;
+    _cdinv[1] = -cd[1] / det;
+    _cdinv[2] = -cd[2] / det;
+    _cdinv[3] = cd[0] / det;
+    if (pv) _pv.assign(pv, pv + 32);
+    if (ab) _ab.assign(ab, ab + 2*(abOrder+1)*(abOrder+1));
+    if (abp) _abp.assign(abp, abp + 2*(abpOrder+1)*(abpOrder+1));
+}
+
+// (u,v) here are in radians, with +u pointing west.  See CelestialCoord._deproject_core
+// in celestial.py for the equations.
+void FitsWCSTransform::deproject(double u, double v, double& ra, double& dec) const
+{
+    const double rsq = u*u + v*v;
+    double cosc, sinc_over_r;
+    switch (_proj) {
+      case Lambert:
+           cosc = 1. - rsq/2.;
+           sinc_over_r = std::sqrt(4.-rsq) / 2.;
+           break;
+      case Stereographic:
+           cosc = (4.-rsq) / (4.+rsq);
+           sinc_over_r = 4. / (4.+rsq);
+           break;
+      case Gnomonic:
+           cosc = sinc_over_r = 1./std::sqrt(1.+rsq);
+           break;
+      default: {
+           const double r = std::sqrt(rsq);
+           cosc = std::cos(r);
+           sinc_over_r = r == 0. ? 1. : std::sin(r) / r;
+      }
+    }
+    const double sindec = cosc * _sindec0 + v * sinc_over_r * _cosdec0;
+    ra = _ra0 + std::atan2(-u * sinc_over_r, cosc * _cosdec0 - v * sinc_over_r * _sindec0);
+    dec = std::asin(sindec);
+}
+
+// See CelestialCoord._project_core.
+void FitsWCSTransform::project(double ra, double dec, double& u, double& v) const
+{
+    const double cosdra = std::cos(ra - _ra0);
+    const double sindra = -std::sin(ra - _ra0);
+    const double sindec = std::sin(dec);
+    const double cosdec = std::cos(dec);
+    const double cosc = _sindec0 * sindec + _cosdec0 * cosdec * cosdra;
+    double k;
+    switch (_proj) {
+      case Lambert:
+           k = std::sqrt(2. / (1.+cosc));
+           break;
+      case Stereographic:
+           k = 2. / (1.+cosc);
+           break;
+      case Gnomonic:
+           k = 1. / cosc;
+           break;
+      default: {
+           const double c = std::acos(cosc);
+           k = c == 0. ? 1. : c / std::sin(c);
+      }
+    }
+    u = k * cosdec * sindra;
+    v = k * (_cosdec0 * sindec - _sindec0 * cosdec * cosdra);
+}
+
+void FitsWCSTransform::toWorld1(double x, double y, double& ra, double& dec) const
+{
+    x -= _crpix[0];
+    y -= _crpix[1];
+    if (!_ab.empty()) {
+        const int nc = (_abOrder+1)*(_abOrder+1);
+        const double dx = Poly(&_ab[0], _abOrder, x, y);
+        const double dy = Poly(&_ab[nc], _abOrder, x, y);
+        x += dx;
+        y += dy;
+    }
+    double u = _cd[0] * x + _cd[1] * y;
+    double v = _cd[2] * x + _cd[3] * y;
+    if (!_pv.empty()) {
+        const double u2 = Poly(&_pv[0], 3, u, v);
+        const double v2 = Poly(&_pv[16], 3, u, v);
+        u = u2;
+        v = v2;
+    }
+    // FITS has +u pointing east, so flip the sign to get our convention.
+    deproject(-u * degrees.getValue(), v * degrees.getValue(), ra, dec);
+}
+
+int FitsWCSTransform::toImage1(double ra, double dec, double& x, double& y) const
+{
+    double u, v;
+    project(ra, dec, u, v);
+    u /= -degrees.getValue();
+    v /= degrees.getValue();
+    if (!_pv.empty()) {
+        // The PV distortions are small, so (u,v) is a good starting point.
+        const double s = u;
+        const double t = v;
+        int status = SolvePoly(&_pv[0], 3, false, s, t, u, v);
+        if (status) return status;
+    }
+    x = _cdinv[0] * u + _cdinv[1] * v;
+    y = _cdinv[2] * u + _cdinv[3] * v;
+    if (!_ab.empty()) {
+        const double s = x;
+        const double t = y;
+        if (!_abp.empty()) {
+            const int nc = (_abpOrder+1)*(_abpOrder+1);
+            const double dx = Poly(&_abp[0], _abpOrder, s, t);
+            const double dy = Poly(&_abp[nc], _abpOrder, s, t);
+            x += dx;
+            y += dy;
+        }
+        // Iterate even if we have AP and BP, since they are usually only approximate.
+        int status = SolvePoly(&_ab[0], _abOrder, true, s, t, x, y);
+        if (status) return status;
+    }
+    x += _crpix[0];
+    y += _crpix[1];
+    return 0;
+}
+
+// The jacobian of each step is calculated along with the position, and they are multiplied
+// together according to the chain rule.
+void FitsWCSTransform::jacobian1(double x, double y, double* jac) const
+{
+    x -= _crpix[0];
+    y -= _crpix[1];
+    double j00 = 1., j01 = 0., j10 = 0., j11 = 1.;
+    if (!_ab.empty()) {
+        const int nc = (_abOrder+1)*(_abOrder+1);
+        double f0, f1;
+        PolyDeriv(&_ab[0], _abOrder, x, y, f0, j00, j01);
+        PolyDeriv(&_ab[nc], _abOrder, x, y, f1, j10, j11);
+        j00 += 1.;
+        j11 += 1.;
+        x += f0;
+        y += f1;
+    }
+
+    double u = _cd[0] * x + _cd[1] * y;
+    double v = _cd[2] * x + _cd[3] * y;
+    double k00 = _cd[0] * j00 + _cd[1] * j10;
+    double k01 = _cd[0] * j01 + _cd[1] * j11;
+    double k10 = _cd[2] * j00 + _cd[3] * j10;
+    double k11 = _cd[2] * j01 + _cd[3] * j11;
+
+    if (!_pv.empty()) {
+        double u2, v2, p00, p01, p10, p11;
+        PolyDeriv(&_pv[0], 3, u, v, u2, p00, p01);
+        PolyDeriv(&_pv[16], 3, u, v, v2, p10, p11);
+        u = u2;
+        v = v2;
+        j00 = p00 * k00 + p01 * k10;
+        j01 = p00 * k01 + p01 * k11;
+        j10 = p10 * k00 + p11 * k10;
+        j11 = p10 * k01 + p11 * k11;
+        k00 = j00; k01 = j01; k10 = j10; k11 = j11;
+    }
+
+    // Convert to arcsec with +u pointing west.
+    const double factor = degrees.getValue() / arcsec.getValue();
+    k00 *= -factor;
+    k01 *= -factor;
+    k10 *= factor;
+    k11 *= factor;
+    u *= -degrees.getValue();
+    v *= degrees.getValue();
+
+    // Finally the jacobian of the deprojection.  See CelestialCoord.deproject_jac.
+    const double rsq = u*u + v*v;
+    double c, s, dcdu, dcdv, dsdu, dsdv;
+    switch (_proj) {
+      case Lambert:
+           c = 1. - rsq/2.;
+           s = std::sqrt(4.-rsq) / 2.;
+           dcdu = -u;
+           dcdv = -v;
+           dsdu = -u/(4.*s);
+           dsdv = -v/(4.*s);
+           break;
+      case Stereographic: {
+           s = 4. / (4.+rsq);
+           c = 2.*s-1.;
+           const double ssq = s*s;
+           dcdu = -u * ssq;
+           dcdv = -v * ssq;
+           dsdu = 0.5*dcdu;
+           dsdv = 0.5*dcdv;
+           break;
+      }
+      case Gnomonic: {
+           c = s = 1./std::sqrt(1.+rsq);
+           const double s3 = s*s*s;
+           dcdu = dsdu = -u*s3;
+           dcdv = dsdv = -v*s3;
+           break;
+      }
+      default: {
+           const double r = std::sqrt(rsq);
+           if (r == 0.) {
+               c = s = 1.;
+               dsdu = dsdv = 0.;
+           } else {
+               c = std::cos(r);
+               s = std::sin(r)/r;
+               dsdu = (c-s)*u/rsq;
+               dsdv = (c-s)*v/rsq;
+           }
+           dcdu = -s*u;
+           dcdv = -s*v;
+      }
+    }
+    const double sindec = c * _sindec0 + v * s * _cosdec0;
+    const double cosdec = std::sqrt(1.-sindec*sindec);
+    const double dddu = (_sindec0 * dcdu + v * dsdu * _cosdec0) / cosdec;
+    const double dddv = (_sindec0 * dcdv + (v * dsdv + s) * _cosdec0) / cosdec;
+    const double num = u * s;
+    const double denom = c * _cosdec0 - v * s * _sindec0;
+    const double A2sec2dra = denom*denom + num*num;
+    const double drdu = cosdec *
+        ((u * dsdu + s) * denom - u * s * (dcdu * _cosdec0 - v * dsdu * _sindec0)) / A2sec2dra;
+    const double drdv = cosdec *
+        (u * dsdv * denom - u * s * (dcdv * _cosdec0 - (v * dsdv + s) * _sindec0)) / A2sec2dra;
+
+    jac[0] = drdu * k00 + drdv * k10;
+    jac[1] = drdu * k01 + drdv * k11;
+    jac[2] = dddu * k00 + dddv * k10;
+    jac[3] = dddu * k01 + dddv * k11;
+}
+
+void FitsWCSTransform::toWorld(const double* x, const double* y, int n,
+                               double* ra, double* dec) const
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n > 1000)
+#endif
+    for (int k=0; k<n; ++k) toWorld1(x[k], y[k], ra[k], dec[k]);
+}
+
+void FitsWCSTransform::toImage(const double* ra, const double* dec, int n,
+                               double* x, double* y) const
+{
+    int err = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n > 1000)
+#endif
+    for (int k=0; k<n; ++k) {
+        int status = toImage1(ra[k], dec[k], x[k], y[k]);
+        if (status) {
+#ifdef _OPENMP
+#pragma omp critical (FitsWCSTransform)
+#endif
+            {
+                if (!err) err = status;
+            }
+        }
+    }
+    if (err == NotImproving)
+        throw WCSError("Unable to solve for image_pos (not improving)");
+    else if (err == MaxIter)
+        throw WCSError("Unable to solve for image_pos (max iter reached)");
+}
+
+void FitsWCSTransform::jacobian(const double* x, const double* y, int n, double* jac) const
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n > 1000)
+#endif
+    for (int k=0; k<n; ++k) jacobian1(x[k], y[k], jac + 4*k);
+}
+
+} // namespace galsim
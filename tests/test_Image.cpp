@@ -427,5 +427,40 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( TestImageArith , T , test_types )
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( TestImageArithLarge , T , test_types )
+{
+    // Large enough that the arithmetic is split among threads when OpenMP is enabled.
+    const int ncol=600;
+    const int nrow=500;
+    galsim::ImageAlloc<T> im1(ncol,nrow);
+    galsim::ImageAlloc<double> im2(ncol,nrow);
+    for (int y=1; y<=nrow; ++y) {
+        for (int x=1; x<=ncol; ++x) {
+            im1.setValue(x,y,T((x+3*y) % 50 + 1));
+            im2.setValue(x,y,double((7*x+y) % 20 + 1));
+        }
+    }
+
+    // Mixed type expression, with the result in the promoted type.
+    galsim::ImageAlloc<double> im3 = im1 * im2;
+    // In-place operations on a non-contiguous view.
+    galsim::Bounds<int> b(11,ncol-10,21,nrow-20);
+    galsim::ImageAlloc<T> im4 = im1;
+    galsim::ImageView<T> sub = im4.subImage(b);
+    sub += T(2);
+    sub *= im1.subImage(b);
+
+    double err3 = 0., err4 = 0.;
+    for (int y=1; y<=nrow; ++y) {
+        for (int x=1; x<=ncol; ++x) {
+            err3 = std::max(err3, std::fabs(im3(x,y) - double(im1(x,y)) * im2(x,y)));
+            T v = b.includes(x,y) ? T((im1(x,y) + T(2)) * im1(x,y)) : im1(x,y);
+            err4 = std::max(err4, std::fabs(double(im4(x,y)) - double(v)));
+        }
+    }
+    BOOST_CHECK(err3 == 0.);
+    BOOST_CHECK(err4 == 0.);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END();
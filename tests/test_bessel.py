@@ -96,6 +96,65 @@ def test_j1():
         vals1, vals2, 8, "bessel.j1 disagrees with reference values")
 
 
+@timer
+def test_j0_j1_accuracy():
+    """Test that bessel.j0 and bessel.j1 are accurate to nearly double precision"""
+    # Reference values from the quad precision j0q and j1q of libquadmath.  The x values include
+    # points on either side of x=8, where the C++ code switches to the asymptotic form, which is
+    # also where the error is largest.
+    x_list = [ 0., 1.e-3, 0.37, 1.01, 2.5, 3.3, 5.9, 7.25, 7.999, 8., 8.001, 9.7, 12.3, 21.,
+               47.5, 77., 250., -7.999, -30.2 ]
+    j0_ref = [  1.0,
+                0.99999975000001562,
+                0.96606672643851299,
+                0.76078097763218855,
+                -0.048383776468197998,
+                -0.34429626039888461,
+                0.12203335459282277,
+                0.29199692419177897,
+                0.17188537228232045,
+                0.1716508071375539,
+                0.17141609967153276,
+                -0.22179548203172286,
+                0.11079795030758544,
+                0.036579071000862745,
+                -0.10608271415889353,
+                0.062379777089647412,
+                -0.026053373425204234,
+                0.17188537228232045,
+                -0.061136277179132954
+             ]
+    j1_ref = [  0.0,
+                0.00049999993750000265,
+                0.1818521944063313,
+                0.4432857612090717,
+                0.49709410246427405,
+                0.22066345298524115,
+                -0.29514244472901607,
+                0.068581700653131739,
+                0.2344939012279374,
+                0.23463634685391463,
+                0.23477854371960058,
+                0.11663864790021317,
+                -0.1942588480405914,
+                0.1711202727639001,
+                0.045235110474968018,
+                0.066560642470572057,
+                -0.043269038410330751,
+                -0.2344939012279374,
+                0.13270983264963129
+             ]
+    j0_vals = [ galsim.bessel.j0(x) for x in x_list ]
+    j1_vals = [ galsim.bessel.j1(x) for x in x_list ]
+    print('j0 errors = ',np.array(j0_vals) - j0_ref)
+    print('j1 errors = ',np.array(j1_vals) - j1_ref)
+    # The documented absolute accuracy is 3.e-15.
+    np.testing.assert_allclose(j0_vals, j0_ref, rtol=0., atol=3.e-15,
+                               err_msg="bessel.j0 is not accurate to 3.e-15")
+    np.testing.assert_allclose(j1_vals, j1_ref, rtol=0., atol=3.e-15,
+                               err_msg="bessel.j1 is not accurate to 3.e-15")
+
+
 @timer
 def test_jn():
     """Test the bessel.jn function"""
@@ -265,6 +324,7 @@ def test_j0_root():
 if __name__ == "__main__":
     test_j0()
     test_j1()
+    test_j0_j1_accuracy()
     test_jn()
     test_jv()
     test_kn()
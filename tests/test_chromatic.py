@@ -1110,6 +1110,39 @@ def test_analytic_integrator():
                                          "Analytic integrator doesn't match sample integrator")
 
 
+@timer
+def test_batch_integrator():
+    """Test that drawing the integral over wavelength as a single weighted sum of monochromatic
+    profiles gives the same image as drawing each wavelength separately.
+    """
+    psf = galsim.ChromaticAtmosphere(galsim.Moffat(fwhm=0.6, beta=PSF_beta),
+                                     base_wavelength=500., zenith_angle=zenith_angle)
+    for rule in [np.trapz, galsim.integ.midpt]:
+        for method in ['auto', 'no_pixel']:
+            integrators = [
+                (galsim.integ.SampleIntegrator(rule, batch=False),
+                 galsim.integ.SampleIntegrator(rule)),
+                (galsim.integ.ContinuousIntegrator(rule, N=50, batch=False),
+                 galsim.integ.ContinuousIntegrator(rule, N=50)) ]
+            for int1, int2 in integrators:
+                im1 = psf.drawImage(bandpass, nx=32, ny=32, scale=0.2, method=method,
+                                    integrator=int1)
+                im2 = psf.drawImage(bandpass, nx=32, ny=32, scale=0.2, method=method,
+                                    integrator=int2)
+                assert int1.last_n_eval == int2.last_n_eval
+                printval(im2, im1)
+                np.testing.assert_allclose(
+                        im2.array, im1.array, rtol=0, atol=1.e-3 * im1.array.max(),
+                        err_msg="Batched integral doesn't match drawing each wavelength")
+
+    # Rules other than the two standard ones are applied to the individual images.
+    assert galsim.integ._rule_weights(lambda f, x: f[0], [1., 2., 3.]) is None
+    w = galsim.integ._rule_weights(np.trapz, [1., 2., 4.])
+    np.testing.assert_almost_equal(w, [0.5, 1.5, 1.])
+    w = galsim.integ._rule_weights(galsim.integ.midpt, [1., 2., 4.])
+    np.testing.assert_almost_equal(w, [1., 1.5, 2.])
+
+
 @timer
 def test_gsparam():
     """Check that gsparams actually gets processed by ChromaticObjects.
@@ -1870,6 +1903,7 @@ if __name__ == "__main__":
     test_ChromaticObject_shift()
     test_ChromaticObject_compound_affine_transformation()
     test_analytic_integrator()
+    test_batch_integrator()
     test_gsparam()
     test_separable_ChromaticSum()
     test_centroid()
@@ -176,6 +176,112 @@ def test_convolve_flux_scaling():
         err_msg="Flux param inconsistent after __div__ (result).")
 
 
+@timer
+def test_convolve_gaussians():
+    """Test that a convolution of several Gaussians matches the equivalent single Gaussian.
+    """
+    # Circular Gaussians add in quadrature.
+    g1 = galsim.Gaussian(sigma=1.3, flux=1.7)
+    g2 = galsim.Gaussian(sigma=0.8, flux=2.3)
+    conv = galsim.Convolve(g1, g2)
+    ref = galsim.Gaussian(sigma=np.sqrt(1.3**2 + 0.8**2), flux=1.7*2.3)
+    np.testing.assert_almost_equal(conv.getFlux(), ref.getFlux(), decimal=12)
+    np.testing.assert_almost_equal(conv.SBProfile.stepK(), ref.SBProfile.stepK(), decimal=12)
+    np.testing.assert_almost_equal(conv.SBProfile.maxK(), ref.SBProfile.maxK(), decimal=12)
+    conv_im = conv.drawImage(nx=64, ny=64, scale=0.2, method='no_pixel')
+    ref_im = ref.drawImage(nx=64, ny=64, scale=0.2, method='no_pixel')
+    np.testing.assert_almost_equal(conv_im.array, ref_im.array, decimal=10)
+
+    # Sheared and shifted Gaussians combine their covariance matrices and centroids.
+    g1 = galsim.Gaussian(sigma=1.1, flux=1.3).shear(g1=0.2, g2=-0.1).shift(0.3, -0.2)
+    g2 = galsim.Gaussian(sigma=0.7).shear(g1=-0.3, g2=0.4).shift(-0.1, 0.5)
+    g3 = galsim.Gaussian(sigma=0.5, flux=0.8).rotate(20 * galsim.degrees)
+    conv = galsim.Convolve(g1, g2, g3)
+    np.testing.assert_equal(len(conv.SBProfile.getObjs()), 1)
+    np.testing.assert_almost_equal(conv.getFlux(), 1.3*0.8, decimal=12)
+    np.testing.assert_almost_equal(conv.centroid().x, 0.2, decimal=12)
+    np.testing.assert_almost_equal(conv.centroid().y, 0.3, decimal=12)
+    # Compare to the k-space product of the individual profiles.
+    for kx, ky in [ (0.,0.), (0.3,0.), (0.,-0.7), (1.1,0.4), (-2.3,1.7) ]:
+        k = galsim.PositionD(kx,ky)
+        ref_kval = g1.kValue(k) * g2.kValue(k) * g3.kValue(k)
+        np.testing.assert_almost_equal(conv.kValue(k), ref_kval, decimal=12)
+    # Real-space convolution of just Gaussians doesn't need any integration now.
+    conv_rs = galsim.Convolve(g1, g2, real_space=True)
+    conv_k = galsim.Convolve(g1, g2, real_space=False)
+    for x, y in [ (0.,0.), (0.3,0.), (0.,-0.7), (1.1,0.4), (-2.3,1.7) ]:
+        pos = galsim.PositionD(x,y)
+        np.testing.assert_almost_equal(conv_rs.xValue(pos), conv_k.xValue(pos), decimal=12)
+
+    # Other components are left alone.
+    psf = galsim.Moffat(beta=2.5, fwhm=0.9)
+    conv2 = galsim.Convolve(g1, psf, g2)
+    np.testing.assert_equal(len(conv2.SBProfile.getObjs()), 2)
+    k = galsim.PositionD(0.8, -0.5)
+    np.testing.assert_almost_equal(conv2.kValue(k), g1.kValue(k) * psf.kValue(k) * g2.kValue(k),
+                                   decimal=12)
+
+    # Several bare Gaussians next to each other, along with another profile.
+    g1 = galsim.Gaussian(sigma=1.3, flux=1.7)
+    g2 = galsim.Gaussian(sigma=0.8, flux=2.3)
+    g3 = galsim.Gaussian(sigma=0.5)
+    ref_gauss = galsim.Gaussian(sigma=np.sqrt(1.3**2 + 0.8**2 + 0.5**2), flux=1.7*2.3)
+    for conv3 in [ galsim.Convolve(g1, g2, psf), galsim.Convolve(psf, g1, g2, g3),
+                   galsim.Convolve(g1, g2, g3, psf), galsim.Convolve(psf, g1, psf, g2) ]:
+        objs = conv3.SBProfile.getObjs()
+        ngauss = len([o for o in objs if repr(o).startswith('galsim._galsim.SBGaussian')])
+        np.testing.assert_equal(ngauss, 1)
+        ref_kval = np.prod([obj.kValue(k) for obj in conv3.obj_list])
+        np.testing.assert_almost_equal(conv3.kValue(k), ref_kval, decimal=12)
+    conv3 = galsim.Convolve(g1, g2, g3, psf)
+    np.testing.assert_almost_equal(conv3.kValue(k), ref_gauss.kValue(k) * psf.kValue(k),
+                                   decimal=12)
+
+    do_pickle(conv)
+    do_pickle(conv2)
+    do_pickle(conv3)
+    do_pickle(conv.SBProfile)
+
+
+@timer
+def test_add_shared_factors():
+    """Test that a sum of convolutions with a common factor matches the individual convolutions.
+    """
+    psf = galsim.Moffat(beta=2.5, fwhm=0.9)
+    pix = galsim.Pixel(scale=0.2)
+    bulge = galsim.DeVaucouleurs(half_light_radius=0.5, flux=0.3)
+    disk = galsim.Exponential(half_light_radius=1.2, flux=0.7).shear(g1=0.2, g2=0.1)
+    knot = galsim.Exponential(half_light_radius=0.3, flux=0.1).shift(0.4, -0.3)
+    c1 = galsim.Convolve(bulge, psf, pix)
+    c2 = galsim.Convolve(disk, psf, pix)
+    c3 = galsim.Convolve(knot, psf)
+    for terms in [ [c1, c2], [c1, c2, c3], [c1, galsim.Convolve(psf, disk)] ]:
+        tot = galsim.Add(terms)
+        np.testing.assert_almost_equal(tot.getFlux(), sum([t.getFlux() for t in terms]),
+                                       decimal=12)
+        for kx, ky in [ (0.,0.), (0.3,0.), (0.,-0.7), (1.1,0.4), (-2.3,1.7) ]:
+            k = galsim.PositionD(kx,ky)
+            ref_kval = sum([t.kValue(k) for t in terms])
+            np.testing.assert_almost_equal(tot.kValue(k), ref_kval, decimal=12)
+        im = tot.drawImage(nx=64, ny=64, scale=0.2, method='no_pixel')
+        ref_im = galsim.ImageD(64, 64, scale=0.2)
+        for t in terms:
+            t.drawImage(ref_im, method='no_pixel', add_to_image=True)
+        np.testing.assert_almost_equal(im.array, ref_im.array, decimal=10)
+
+    # Convolutions with no factors in common, or with a real-space convolution, are unaffected.
+    psf2 = galsim.Moffat(beta=2.5, fwhm=0.9)
+    tot = galsim.Add(galsim.Convolve(bulge, psf), galsim.Convolve(disk, psf2))
+    k = galsim.PositionD(0.8, -0.5)
+    np.testing.assert_almost_equal(
+        tot.kValue(k), bulge.kValue(k) * psf.kValue(k) + disk.kValue(k) * psf.kValue(k),
+        decimal=12)
+    box = galsim.Box(0.3, 0.4)
+    tot = galsim.Add(galsim.Convolve(box, pix, real_space=True), galsim.Convolve(box, pix))
+    np.testing.assert_almost_equal(tot.kValue(k), 2. * box.kValue(k) * pix.kValue(k), decimal=12)
+    do_pickle(galsim.Add(c1, c2, c3))
+
+
 @timer
 def test_shearconvolve():
     """Test the convolution of a sheared Gaussian and a Box SBProfile against a known result.
@@ -401,6 +507,38 @@ def test_realspace_shearconvolve():
             err_msg="Using GSObject Convolve([pixel,psf]) disagrees with expected result")
 
 
+@timer
+def test_realspace_fill():
+    """Test that the images drawn by real-space convolutions match the value of xValue at each
+    pixel.  The image is filled with all the pixels at once, which is done in parallel when
+    GalSim is compiled with OpenMP and both profiles have a thread-safe xValue.
+    """
+    dx = 0.3
+    pixel = galsim.Pixel(scale=dx)
+    # Gaussian and Box are thread-safe, so these use the parallel code when it is available.
+    # Sersic is not, so that one is always done serially.  The sheared versions use the code
+    # for a non-diagonal jacobian.
+    gauss = galsim.Gaussian(sigma=0.7, flux=1.7).shift(0.1, -0.2)
+    sersic = galsim.Sersic(n=2.5, half_light_radius=0.8, trunc=4.)
+    for psf, name in [ (gauss, 'Gaussian'), (sersic, 'Sersic'),
+                       (gauss.shear(g1=0.2, g2=-0.1), 'sheared Gaussian'),
+                       (sersic.rotate(20 * galsim.degrees).shear(g1=0.1, g2=0.3),
+                        'sheared Sersic') ]:
+        for conv in [ galsim.Convolve(psf, pixel, real_space=True),
+                      galsim.Convolve(pixel, psf, real_space=True),
+                      galsim.Convolve(psf, pixel, real_space=True).shear(g1=0.05, g2=0.2) ]:
+            img = galsim.ImageD(23, 20, scale=dx)
+            img.setCenter(0,0)
+            conv.drawImage(img, method='sb', use_true_center=False)
+            ref = img.copy()
+            for j in range(ref.ymin, ref.ymax+1):
+                for i in range(ref.xmin, ref.xmax+1):
+                    ref.setValue(i, j, conv.xValue(galsim.PositionD(i*dx, j*dx)))
+            np.testing.assert_array_almost_equal(
+                img.array, ref.array, 10,
+                err_msg="Real-space convolution of %s with a Box does not match xValue"%name)
+
+
 @timer
 def test_add():
     """Test the addition of two rescaled Gaussian profiles against a known double Gaussian result.
@@ -809,10 +947,13 @@ def test_sum_transform():
 if __name__ == "__main__":
     test_convolve()
     test_convolve_flux_scaling()
+    test_convolve_gaussians()
+    test_add_shared_factors()
     test_shearconvolve()
     test_realspace_convolve()
     test_realspace_distorted_convolve()
     test_realspace_shearconvolve()
+    test_realspace_fill()
     test_add()
     test_add_flux_scaling()
     test_autoconvolve()
@@ -139,6 +139,13 @@ def test_scattered():
 
     np.testing.assert_almost_equal(image.array, image2.array)
 
+    # Building the image in tiles gives the same result.  Use a tile size that doesn't evenly
+    # divide the image, so some stamps overlap partial tiles.
+    config = copy.deepcopy(config)
+    config['image']['tile_size'] = 10
+    image3 = galsim.config.BuildImage(config)
+    np.testing.assert_array_equal(image3.array, image.array)
+
 
 @timer
 def test_ccdnoise():
@@ -446,8 +453,120 @@ def test_njobs():
                             err_msg="01 image was different for one job vs two jobs")
 
 
+@timer
+def test_threads():
+    """Test that using threads for the stamps and images gives the same result as a single
+    process.
+    """
+    config = {
+        'gal' : {
+            'type' : 'Sersic',
+            'n' : { 'type' : 'Random', 'min' : 1., 'max' : 4. },
+            'half_light_radius' : { 'type' : 'Random', 'min' : 0.5, 'max' : 1.2 },
+            'flux' : 1.e4,
+            'ellip' : { 'type' : 'EBeta', 'e' : 0.3, 'beta' : { 'type' : 'Random' } },
+        },
+        'psf' : { 'type' : 'Moffat', 'beta' : 2.5, 'fwhm' : 0.7 },
+        'image' : {
+            'type' : 'Scattered',
+            'size' : 200,
+            'pixel_scale' : 0.2,
+            'nobjects' : 20,
+            'random_seed' : 1234,
+            'noise' : { 'type' : 'Gaussian', 'sigma' : 2. },
+        },
+    }
+    config1 = galsim.config.CopyConfig(config)
+    image1 = galsim.config.BuildImage(config1)
+
+    config2 = galsim.config.CopyConfig(config)
+    config2['image']['nproc'] = 4
+    config2['image']['use_threads'] = True
+    image2 = galsim.config.BuildImage(config2)
+    np.testing.assert_array_equal(image2.array, image1.array)
+
+    # Threads for the images rather than the stamps.
+    config['image']['nobjects'] = 4
+    config['image']['size'] = 100
+    config1 = galsim.config.CopyConfig(config)
+    images1 = galsim.config.BuildImages(3, config1)
+
+    config2 = galsim.config.CopyConfig(config)
+    config2['image']['nproc'] = 3
+    config2['image']['use_threads'] = True
+    images2 = galsim.config.BuildImages(3, config2)
+    for im1, im2 in zip(images1, images2):
+        np.testing.assert_array_equal(im2.array, im1.array)
+
+    # Several threads drawing the same InterpolatedImage at once.  The k-space image is built
+    # by whichever thread needs it first, so use new pixel values and don't calculate maxk,
+    # to make sure it isn't built yet when the threads start.  Likewise the truncated Moffat
+    # has a lookup table for its Fourier transform.
+    import threading
+    rng = galsim.UniformDeviate(1234)
+    im = galsim.ImageD(40, 40, scale=0.2)
+    im.addNoise(galsim.GaussianNoise(rng, sigma=1.))
+    psf = galsim.Moffat(beta=2.5, fwhm=0.7, trunc=3.)
+    def draw(ii, results, k):
+        image = galsim.Convolve(ii, psf).drawImage(nx=64, ny=64, scale=0.2, method='no_pixel')
+        re, im = ii.drawKImage(nx=32, ny=32, scale=0.5)
+        results[k] = (image, re, im)
+
+    nthreads = 8
+    ii = galsim.InterpolatedImage(im, calculate_maxk=False)
+    results = [None] * nthreads
+    threads = [ threading.Thread(target=draw, args=(ii, results, k)) for k in range(nthreads) ]
+    for t in threads: t.start()
+    for t in threads: t.join()
+
+    # Compare to drawing the same profile without threads, now that its k-space image is built.
+    ref = [None]
+    draw(ii, ref, 0)
+    for k in range(nthreads):
+        for a, b in zip(results[k], ref[0]):
+            np.testing.assert_array_equal(a.array, b.array,
+                                          err_msg="Threaded InterpolatedImage draw %d differs"%k)
+
+
+@timer
+def test_stamp_order():
+    """Test that the stamps expected to take the longest are built first when using multiple
+    processes, and that this does not change the resulting image.
+    """
+    config = {
+        'gal' : {
+            'type' : 'Exponential',
+            'half_light_radius' : 0.5,
+            'flux' : { 'type' : 'List', 'items' : [ 10., 3.e4, 100., 1.e5, 30. ] },
+        },
+        'psf' : { 'type' : 'Gaussian', 'sigma' : 0.4 },
+        'stamp' : { 'draw_method' : 'phot' },
+        'image' : {
+            'type' : 'Scattered',
+            'size' : 64,
+            'stamp_size' : 24,
+            'pixel_scale' : 0.3,
+            'nobjects' : 5,
+            'random_seed' : 1234,
+        },
+    }
+    jobs = [ { 'obj_num' : k, 'xsize' : 0, 'ysize' : 0, 'do_noise' : True } for k in range(5) ]
+    tasks = galsim.config.MakeStampTasks(config, jobs, None)
+    tasks = galsim.config.OrderStampTasks(config, tasks, None)
+    assert [ task[0][1] for task in tasks ] == [ 3, 1, 2, 4, 0 ]
+
+    config1 = galsim.config.CopyConfig(config)
+    image1 = galsim.config.BuildImage(config1)
+    config2 = galsim.config.CopyConfig(config)
+    config2['image']['nproc'] = 2
+    image2 = galsim.config.BuildImage(config2)
+    np.testing.assert_array_equal(image2.array, image1.array)
+
+
 if __name__ == "__main__":
     test_scattered()
     test_ccdnoise()
     test_cosmosnoise()
     test_njobs()
+    test_threads()
+    test_stamp_order()
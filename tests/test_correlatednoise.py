@@ -1195,6 +1195,104 @@ def test_cosmos_wcs():
         do_pickle(cn_test)
 
 
+@timer
+def test_tiled_noise():
+    """Test the C++ noise generation, both with a single FFT of the whole image, and one tile at a
+    time for large images, and that the stored power spectra are reused.
+    """
+    # First check that the periodic noise matches what the original numpy implementation made
+    # from the same random numbers, for all combinations of odd and even sizes.
+    for ny, nx in [ (16, 16), (17, 15), (16, 17), (17, 16) ]:
+        rootps = np.sqrt(np.abs(np.fft.rfft2(np.random.RandomState(rseed).rand(ny, nx))))
+        rng = galsim.BaseDeviate(rseed)
+        gd = galsim.GaussianDeviate(rng.duplicate(), sigma=np.sqrt(.5 * ny * nx))
+        gvec = galsim.utilities.rand_arr((ny, nx//2+1), gd)
+        gvec = gvec + 1j * galsim.utilities.rand_arr((ny, nx//2+1), gd)
+        for col in [0, nx//2] if nx % 2 == 0 else [0]:
+            gvec[-1:ny//2:-1, col] = np.conj(gvec[1:(ny+1)//2, col])
+            gvec[0, col] = np.sqrt(2.) * gvec[0, col].real
+            if ny % 2 == 0:
+                gvec[ny//2, col] = np.sqrt(2.) * gvec[ny//2, col].real
+        ref = np.fft.irfft2(gvec * rootps, s=(ny, nx))
+        im = galsim.ImageD(nx, ny)
+        galsim.correlatednoise._add_noise_from_rootps(rng, im, rootps, (ny, nx))
+        np.testing.assert_array_almost_equal(
+            im.array, ref, decimal=10,
+            err_msg="Periodic noise does not match numpy implementation for shape %s"%((ny,nx),))
+
+    # Now make the noise in tiles by lowering the threshold for this CorrelatedNoise.
+    gd = galsim.GaussianDeviate(rseed)
+    cosmos_scale = 7.5
+    ccn = galsim.getCOSMOSNoise(rng=gd, cosmos_scale=cosmos_scale)
+    ccn._max_periodic_size = 64
+    ccn._noise_tile_size = 128
+    outimage = galsim.ImageD(3 * largeim_size + 11, 3 * largeim_size, scale=cosmos_scale)
+    outimage.addNoise(ccn)
+    ps_shape, fft_size = ccn._get_ps_shape(outimage.array.shape, outimage.wcs)
+    assert fft_size == 128
+    assert max(ps_shape) < min(outimage.array.shape)
+    # The noise is not periodic, so the correlation function can be measured without the
+    # correction for periodicity.
+    cntest_correlated = galsim.CorrelatedNoise(outimage, ccn.rng, correct_periodicity=False)
+    pos = galsim.PositionD(0., 0.)
+    cf00 = ccn._profile.xValue(pos)
+    cftest00 = cntest_correlated._profile.xValue(pos)
+    np.testing.assert_almost_equal(
+        cftest00 / cf00, 1., decimal=2,
+        err_msg="Tiled noise does not approximately match input variance")
+    for xpos, ypos in zip((cosmos_scale, 0., cosmos_scale, cosmos_scale),
+                          (0., cosmos_scale, -cosmos_scale, cosmos_scale)):
+        pos = galsim.PositionD(xpos, ypos)
+        cf = ccn._profile.xValue(pos)
+        cftest = cntest_correlated._profile.xValue(pos)
+        np.testing.assert_almost_equal(
+            cftest / cftest00, cf / cf00, decimal=2,
+            err_msg="Tiled noise does not have approximately matching interpixel covariances")
+
+    # Whitening uses the same stored rootps.
+    whitened_variance = ccn.whitenImage(outimage)
+    keys = [ key for key, value in ccn._rootps_store ]
+    assert keys[0] == ('whitening', ps_shape, outimage.wcs)
+    assert keys.count(('rootps', ps_shape, outimage.wcs)) == 1
+    cntest_whitened = galsim.CorrelatedNoise(outimage, ccn.rng, correct_periodicity=False)
+    cftest00 = cntest_whitened._profile.xValue(galsim.PositionD(0., 0.))
+    np.testing.assert_almost_equal(
+        cftest00 / whitened_variance, 1., decimal=2,
+        err_msg="Tiled whitening noise does not approximately match theoretical variance")
+    for xpos, ypos in zip((cosmos_scale, 0., cosmos_scale, cosmos_scale),
+                          (0., cosmos_scale, -cosmos_scale, cosmos_scale)):
+        pos = galsim.PositionD(xpos, ypos)
+        cftest = cntest_whitened._profile.xValue(pos)
+        np.testing.assert_almost_equal(
+            cftest / cftest00, 0., decimal=2,
+            err_msg="Tiled whitening noise does not have approximately zero interpixel "+
+            "covariances")
+
+    # If the correlation function is too large for the kernel, a single FFT is used instead.
+    ccn._max_kernel_size = 8
+    import warnings
+    with warnings.catch_warnings(record=True) as w:
+        warnings.simplefilter("always")
+        ps_shape, fft_size = ccn._get_ps_shape(outimage.array.shape, outimage.wcs)
+    assert len(w) == 1
+    assert ps_shape == outimage.array.shape
+    assert fft_size is None
+    ccn._max_kernel_size = galsim.correlatednoise._BaseCorrelatedNoise._max_kernel_size
+
+    # The same rng gives the same noise, and the noise can be added to a float image.
+    im1 = galsim.ImageD(300, 200, scale=cosmos_scale)
+    im2 = galsim.ImageF(300, 200, scale=cosmos_scale)
+    im1.addNoise(ccn.copy(rng=galsim.BaseDeviate(1234)))
+    im2.addNoise(ccn.copy(rng=galsim.BaseDeviate(1234)))
+    np.testing.assert_array_almost_equal(im1.array, im2.array, decimal=5)
+
+    # Only _max_stored power spectra are kept.
+    for n in range(ccn._max_stored + 5):
+        ccn._get_rootps((8, 8 + n), ccn.wcs)
+    assert len(ccn._rootps_store) == ccn._max_stored
+    assert ccn._rootps_store[0][0] == ('rootps', (8, 12 + ccn._max_stored), ccn.wcs)
+
+
 if __name__ == "__main__":
     test_uncorrelated_noise_zero_lag()
     test_uncorrelated_noise_nonzero_lag()
@@ -1216,3 +1314,4 @@ if __name__ == "__main__":
     test_uncorrelated_noise_tracking()
     test_variance_changes()
     test_cosmos_wcs()
+    test_tiled_noise()
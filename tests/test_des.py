@@ -288,6 +288,16 @@ def test_meds_config():
     import logging
     logging.basicConfig(format="%(message)s", level=logging.WARN, stream=sys.stdout)
     logger = logging.getLogger('test_meds_config')
+    # The objects are built and written in batches.  Use small batches (2 objects each here)
+    # to check that the batches are put together correctly.
+    batch_nimages = galsim.des.des_meds.MEDSBuilder._batch_nimages
+    galsim.des.des_meds.MEDSBuilder._batch_nimages = 2 * n_per_obj
+    try:
+        galsim.config.Process(galsim.config.CopyConfig(config), logger=logger)
+    finally:
+        galsim.des.des_meds.MEDSBuilder._batch_nimages = batch_nimages
+    file_name_batched = 'output/test_meds_batched.fits'
+    os.rename(file_name, file_name_batched)
     galsim.config.Process(config, logger=logger)
 
     # Now repeat, making a separate file for each
@@ -310,6 +320,23 @@ def test_meds_config():
                       }
     galsim.config.Process(config, logger=logger)
 
+    # Check the image cutouts against the separate files without needing the meds package.
+    from galsim._pyfits import pyfits
+    for meds_file in [ file_name, file_name_batched ]:
+        hdu_list = pyfits.open(meds_file)
+        cutouts = hdu_list['image_cutouts'].data
+        cat = hdu_list['object_data'].data
+        assert len(cat) == nobj
+        for iobj in range(nobj):
+            ref_im = galsim.fits.read(os.path.join('output','test_meds%d.fits' % iobj))
+            for icut in range(n_per_obj):
+                k = cat['start_row'][iobj][icut]
+                numpy.testing.assert_array_equal(
+                        cutouts[k:k+stamp_size**2].reshape(stamp_size, stamp_size),
+                        ref_im.array[icut*stamp_size:(icut+1)*stamp_size,:],
+                        err_msg="%s has wrong im for object %d"%(meds_file,iobj))
+        hdu_list.close()
+
     try:
         import meds
         import fitsio
@@ -408,6 +435,111 @@ def test_meds_config():
             numpy.testing.assert_almost_equal(info['position_offset'], 0.)
 
 
+@timer
+def test_meds_writer():
+    """
+    Write a MEDS file one object at a time with MEDSWriter and check the contents of the file
+    against the objects that were written.
+    """
+    from galsim._pyfits import pyfits
+
+    rng = galsim.UniformDeviate(1234)
+    objlist = []
+    for iobj in range(7):
+        box_size = galsim.des.BOX_SIZES[iobj % 3]
+        n_cut = 1 + iobj % 4
+        images = []
+        weight = []
+        wcs = []
+        for icut in range(n_cut):
+            im = galsim.ImageF(box_size, box_size)
+            im.addNoise(galsim.GaussianNoise(rng))
+            images.append(im)
+            wt = galsim.ImageF(box_size, box_size, init_value=iobj + icut)
+            weight.append(wt)
+            wcs.append(galsim.AffineTransform(0.26, 0.01*icut, -0.02*iobj, 0.27,
+                                              galsim.PositionD(box_size/2., box_size/2.+icut)))
+        psf = [ galsim.ImageF(32, 32, init_value=icut) for icut in range(n_cut) ]
+        objlist.append(galsim.des.MultiExposureObject(images=images, weight=weight, psf=psf,
+                                                      wcs=wcs, id=100+iobj))
+
+    file_name = 'output/test_meds_writer.fits'
+    with galsim.des.MEDSWriter(file_name) as meds:
+        for obj in objlist:
+            meds.write(obj)
+        assert meds.nobjects == len(objlist)
+
+    hdu_list = pyfits.open(file_name)
+    assert [ hdu.name.lower() for hdu in hdu_list ] == [
+            'primary', 'object_data', 'image_info', 'metadata',
+            'image_cutouts', 'weight_cutouts', 'seg_cutouts', 'psf' ]
+
+    # The cutout vectors are the flattened images of each object in order.
+    expected = {}
+    for key, name in [ ('images', 'image_cutouts'), ('weight', 'weight_cutouts'),
+                       ('seg', 'seg_cutouts'), ('psf', 'psf') ]:
+        expected[name] = numpy.concatenate(
+                [ im.array.ravel() for obj in objlist for im in getattr(obj, key) ])
+        numpy.testing.assert_array_equal(hdu_list[name].data, expected[name],
+                                         err_msg="Mismatch in %s"%name)
+
+    # Check the object_data table.  Unused cutouts have the EMPTY values.
+    m = galsim.des.des_meds
+    cat = hdu_list['object_data'].data
+    assert len(cat) == len(objlist)
+    start_row = 0
+    psf_start_row = 0
+    for iobj, obj in enumerate(objlist):
+        n = obj.n_cutouts
+        assert cat['id'][iobj] == obj.id
+        assert cat['number'][iobj] == obj.id
+        assert cat['box_size'][iobj] == obj.box_size
+        assert cat['psf_box_size'][iobj] == 32
+        assert cat['ncutout'][iobj] == n
+        for icut in range(n):
+            assert cat['start_row'][iobj][icut] == start_row
+            assert cat['psf_start_row'][iobj][icut] == psf_start_row
+            start_row += obj.box_size**2
+            psf_start_row += 32**2
+            wcs = obj.wcs[icut]
+            numpy.testing.assert_almost_equal(
+                    [ cat[col][iobj][icut] for col in [ 'dudcol', 'dudrow', 'dvdcol', 'dvdrow',
+                                                        'cutout_col', 'cutout_row' ] ],
+                    [ wcs.dudx, wcs.dudy, wcs.dvdx, wcs.dvdy, wcs.origin.x, wcs.origin.y ],
+                    err_msg="Wrong wcs for object %d, cutout %d"%(iobj,icut))
+        numpy.testing.assert_array_equal(cat['start_row'][iobj][n:], m.EMPTY_START_INDEX)
+        numpy.testing.assert_array_equal(cat['psf_start_row'][iobj][n:], m.EMPTY_START_INDEX)
+        numpy.testing.assert_array_equal(cat['dudcol'][iobj][n:], m.EMPTY_JAC_offdiag)
+        numpy.testing.assert_array_equal(cat['dudrow'][iobj][n:], m.EMPTY_JAC_diag)
+        numpy.testing.assert_array_equal(cat['cutout_row'][iobj][n:], m.EMPTY_SHIFT)
+    assert start_row == len(expected['image_cutouts'])
+    assert psf_start_row == len(expected['psf'])
+    hdu_list.close()
+
+    # WriteMEDS writes the same thing from a list of objects.
+    # With gzip compression, the full file is compressed.
+    file_name2 = 'output/test_meds_writer.fits.gz'
+    galsim.des.WriteMEDS(objlist, file_name2)
+    hdu_list2 = pyfits.open(file_name2)
+    numpy.testing.assert_array_equal(hdu_list2['image_cutouts'].data, expected['image_cutouts'])
+    numpy.testing.assert_array_equal(hdu_list2['seg_cutouts'].data, expected['seg_cutouts'])
+    numpy.testing.assert_array_equal(hdu_list2['object_data'].data['start_row'],
+                                     pyfits.getdata(file_name, 'object_data')['start_row'])
+    hdu_list2.close()
+
+    # No objects may be added after the file is written.
+    meds = galsim.des.MEDSWriter(file_name)
+    meds.write(objlist[0])
+    meds.close()
+    meds.close()  # Closing twice is fine.
+    assert pyfits.getdata(file_name, 'object_data')['id'] == [100]
+    try:
+        numpy.testing.assert_raises(RuntimeError, meds.write, objlist[1])
+        numpy.testing.assert_raises(IOError, galsim.des.MEDSWriter, file_name, clobber=False)
+    except ImportError:
+        pass
+
+
 @timer
 def test_nan_fits():
     """Test reading in a FITS file that has NAN.0 entries in the header.
@@ -586,6 +718,59 @@ def test_psf():
                                       err_msg="Shapelet PSF shape.g2 doesn't match")
 
 
+@timer
+def test_psfex_batch():
+    """Test that the batched PSFEx functions match the single position ones.
+    """
+    data_dir = 'des_data'
+    psfex_file = "DECam_00154912_12_psfcat.psf"
+    wcs_file = "DECam_00154912_12_header.fits"
+
+    psfex = galsim.des.DES_PSFEx(psfex_file, wcs_file, dir=data_dir)
+    ud = galsim.UniformDeviate(8675309)
+    image_pos_list = [ galsim.PositionD(1 + 2047*ud(), 1 + 4095*ud()) for i in range(9) ]
+
+    # Check the images against a direct numpy calculation.
+    arrays = psfex.getPSFArrays(image_pos_list)
+    assert arrays.shape == (len(image_pos_list),) + psfex.basis.shape[1:]
+    order = psfex.fit_order
+    for image_pos, ar in zip(image_pos_list, arrays):
+        xs = (image_pos.x - psfex.x_zero) / psfex.x_scale
+        ys = (image_pos.y - psfex.y_zero) / psfex.y_scale
+        P = numpy.array([ xs**nx * ys**ny for ny in range(order+1) for nx in range(order+1-ny) ])
+        ref = numpy.tensordot(P, psfex.basis, (0,0)).astype(numpy.float32)
+        numpy.testing.assert_allclose(ar, ref, rtol=1.e-6, atol=1.e-6 * numpy.max(numpy.abs(ref)),
+                                      err_msg="PSFEx batch image doesn't match")
+        numpy.testing.assert_array_equal(psfex.getPSFArray(image_pos), ar)
+
+    # Check that the profiles draw the same as the ones from getPSF.
+    psfs = psfex.getPSFs(image_pos_list)
+    for image_pos, psf in zip(image_pos_list, psfs):
+        psf1 = psfex.getPSF(image_pos)
+        local_wcs = psfex.getLocalWCS(image_pos)
+        im1 = psf1.drawImage(nx=32, ny=32, wcs=local_wcs, method='no_pixel')
+        im2 = psf.drawImage(nx=32, ny=32, wcs=local_wcs, method='no_pixel')
+        numpy.testing.assert_almost_equal(im2.array, im1.array, decimal=12,
+                                          err_msg="PSFEx getPSFs doesn't match getPSF")
+        numpy.testing.assert_almost_equal(psf.stepK(), psf1.stepK())
+        numpy.testing.assert_almost_equal(psf.maxK(), psf1.maxK())
+
+    # Also in image coordinates.
+    psfex = galsim.des.DES_PSFEx(psfex_file, dir=data_dir)
+    psfs = psfex.getPSFs(image_pos_list[:3])
+    for image_pos, psf in zip(image_pos_list, psfs):
+        im1 = psfex.getPSF(image_pos).drawImage(nx=32, ny=32, scale=1., method='no_pixel')
+        im2 = psf.drawImage(nx=32, ny=32, scale=1., method='no_pixel')
+        numpy.testing.assert_almost_equal(im2.array, im1.array, decimal=12,
+                                          err_msg="no-wcs PSFEx getPSFs doesn't match getPSF")
+    assert psfex.getPSFs([]) == []
+
+    # The C++ model is rebuilt after pickling.
+    import pickle
+    psfex2 = pickle.loads(pickle.dumps(psfex))
+    numpy.testing.assert_array_equal(psfex2.getPSFArray(image_pos_list[0]), arrays[0])
+
+
 @timer
 def test_psf_config():
     """Test building the two PSF types using the config layer.
@@ -645,6 +830,8 @@ def test_psf_config():
 if __name__ == "__main__":
     test_meds()
     test_meds_config()
+    test_meds_writer()
     test_nan_fits()
     test_psf()
+    test_psfex_batch()
     test_psf_config()
@@ -1798,6 +1798,254 @@ def test_copy():
     assert im(3,8) != 11.
 
 
+@timer
+def test_zero_copy():
+    """Test that the C++ layer shares memory with numpy arrays rather than copying them.
+    """
+    ncopy = galsim._galsim._getImageCopyCount()
+
+    # Views of a numpy array and their array attributes share the same memory.
+    a = np.arange(35, dtype=np.float32).reshape(5,7)
+    im = galsim.Image(a)
+    assert im.array is a
+    view = galsim._galsim.ImageViewF(a, 1, 1)
+    view.setValue(2,3,-1.)
+    assert a[2,1] == -1.
+    assert view.array.ctypes.data == a.ctypes.data
+
+    # Making an ImageAlloc from a contiguous array (as happens with eval(repr(image)))
+    # also uses the numpy memory directly.
+    b = np.arange(35, dtype=np.float64).reshape(5,7)
+    alloc = galsim._galsim.ImageAllocD(galsim.BoundsI(1,7,1,5), b)
+    assert alloc.array.ctypes.data == b.ctypes.data
+    b[4,6] = 100.
+    assert alloc(7,5) == 100.
+    del b
+    assert alloc(7,5) == 100.   # alloc keeps the memory alive.
+    assert galsim._galsim._getImageCopyCount() == ncopy
+
+    # Results returned from C++ as new images are also not copied on the way to python.
+    cd = galsim.cdmodel.PowerLawCD(2, 1.e-7, 1.e-7, 1.e-8, 1.e-8, 1.e-9, 1.e-9, 0.)
+    im = galsim.ImageD(np.ones((10,10)))
+    im2 = cd.applyForward(im)
+    assert im2.array.flags.writeable
+    im2.setValue(1,1,7.)
+    assert im2.array[0,0] == 7.
+    assert galsim._galsim._getImageCopyCount() == ncopy
+
+    # A non-contiguous array needs to be copied to make an ImageAlloc, and explicit copies
+    # are copies, of course.  These are both counted.
+    c = np.arange(70, dtype=np.float64).reshape(10,7)[::2,:]
+    alloc = galsim._galsim.ImageAllocD(galsim.BoundsI(1,7,1,5), c)
+    np.testing.assert_array_equal(alloc.array, c)
+    assert alloc.array.ctypes.data != c.ctypes.data
+    assert galsim._galsim._getImageCopyCount() == ncopy + 1
+    im3 = im2.copy()
+    assert galsim._galsim._getImageCopyCount() == ncopy + 2
+
+
+@timer
+def test_mapped_image():
+    """Test images whose memory is a memory-mapped file.
+    """
+    # A raw MappedImage.  The pixels are stored in the file in native byte order.
+    bounds = galsim.BoundsI(1,40,1,30)
+    file_name = os.path.join('output', 'test_mapped_image.dat')
+    if os.path.exists(file_name):
+        os.remove(file_name)
+    im = galsim.MappedImage(bounds, file_name, dtype=np.float32)
+    assert im.bounds == bounds
+    assert im.dtype == np.float32
+    assert os.path.getsize(file_name) == 40*30*4
+    gal = galsim.Gaussian(sigma=1.7)
+    sub = im[galsim.BoundsI(11,30,6,25)]
+    gal.drawImage(sub, scale=0.3)
+    del sub, im
+    a = np.fromfile(file_name, dtype=np.float32).reshape(30,40)
+    im_ref = galsim.ImageF(bounds)
+    gal.drawImage(im_ref[galsim.BoundsI(11,30,6,25)], scale=0.3)
+    np.testing.assert_array_equal(a, im_ref.array)
+
+    # Mapping an existing file with an offset sees the values already there.
+    im = galsim.MappedImage(galsim.BoundsI(1,40,2,30), file_name, dtype=np.float32, offset=160)
+    np.testing.assert_array_equal(im.array, im_ref.array[1:,:])
+    try:
+        np.testing.assert_raises(ValueError, galsim.MappedImage, bounds, file_name,
+                                 dtype=np.float32, offset=3)
+        np.testing.assert_raises(ValueError, galsim.MappedImage, bounds, file_name,
+                                 dtype=np.complex128)
+    except ImportError:
+        pass
+
+    # An image with more than 2^31 pixels.  The file is sparse, so only the pages that are
+    # written to take any disk space.
+    if sys.maxsize > 2**32:
+        big = galsim.BoundsI(1,65536,1,32769)
+        os.remove(file_name)
+        im = galsim.MappedImage(big, file_name, dtype=np.int16)
+        assert im.array.shape == (32769, 65536)
+        assert os.path.getsize(file_name) == 65536 * 32769 * 2
+        im.setValue(65536, 32769, 7)
+        im.setValue(3, 32768, 5)
+        assert im(65536, 32769) == 7
+        assert im.array[-1,-1] == 7
+        assert im.array[-2,2] == 5
+        sub = im[galsim.BoundsI(1,10,32760,32769)]
+        assert sub(3, 32768) == 5
+        del sub, im
+        os.remove(file_name)
+
+    # Build a FITS file in place.
+    file_name = os.path.join('output', 'test_mapped_image.fits')
+    for dtype in [ np.int16, np.int32, np.float32, np.float64 ]:
+        im = galsim.fits.mapImage(file_name, galsim.BoundsI(-5,60,3,50), dtype=dtype, scale=0.2)
+        im_ref = galsim.Image(galsim.BoundsI(-5,60,3,50), dtype=dtype, scale=0.2)
+        gal.withFlux(1.e4).drawImage(im[galsim.BoundsI(5,40,10,40)])
+        gal.withFlux(1.e4).drawImage(im_ref[galsim.BoundsI(5,40,10,40)])
+        galsim.fits.unmapImage(im)
+        del im
+        im2 = galsim.fits.read(file_name)
+        assert im2.bounds == im_ref.bounds
+        assert im2.scale == 0.2
+        np.testing.assert_array_equal(im2.array, im_ref.array)
+
+
+@timer
+def test_tiled_image():
+    """Test accumulating stamps in a TiledImage.
+    """
+    bounds = galsim.BoundsI(-3,150,5,120)
+    rng = np.random.RandomState(1234)
+    for dtype in [ np.int16, np.int32, np.float32, np.float64 ]:
+        for tile_size in [ 16, 37, 64 ]:
+            tiled = galsim._galsim.TiledImage[dtype](bounds, tile_size)
+            assert tiled.bounds == bounds
+            assert tiled.tile_size == tile_size
+            im = galsim.Image(bounds, dtype=dtype)
+            # Include some stamps that hang off the edges or miss entirely.
+            for k in range(50):
+                x = rng.randint(-40,160)
+                y = rng.randint(-30,130)
+                stamp = galsim.Image(rng.randint(0,100,size=(rng.randint(1,40),
+                                                             rng.randint(1,40))).astype(dtype),
+                                     xmin=x, ymin=y)
+                if k % 2 == 0:
+                    tiled.addImage(stamp.image)
+                else:
+                    tiled += stamp.image
+                b = stamp.bounds & bounds
+                if b.isDefined():
+                    im[b] += stamp[b]
+            assert tiled(1,8) == im(1,8)
+            assert tiled(150,120) == im(150,120)
+            np.testing.assert_almost_equal(tiled.sumElements(), im.array.sum())
+
+            im2 = galsim.Image(bounds, dtype=dtype)
+            tiled.assignTo(im2.image.view())
+            np.testing.assert_array_equal(im2.array, im.array)
+
+            # Round trip through the tiled layout.
+            tiled2 = galsim._galsim.TiledImage[dtype](im.image, tile_size)
+            tiled2.setValue(20,30,7)
+            im3 = galsim.Image(bounds, dtype=dtype)
+            tiled2.assignTo(im3.image.view())
+            im.setValue(20,30,7)
+            np.testing.assert_array_equal(im3.array, im.array)
+
+            # Arithmetic with scalars is applied to every pixel.
+            tiled2 += 3
+            tiled2 *= 2
+            tiled2 -= 1
+            tiled2 /= 2
+            tiled2.assignTo(im3.image.view())
+            expected = (im.array + 3) * 2 - 1
+            if dtype in [ np.int16, np.int32 ]:
+                expected //= 2
+            else:
+                expected /= 2
+            np.testing.assert_array_equal(im3.array, expected)
+
+
+@timer
+def test_fits_native_io():
+    """Test writing and reading FITS images with the C++ FITS writer and reader.
+    """
+    bounds = galsim.BoundsI(-5,60,3,50)
+    gal = galsim.Gaussian(sigma=1.7, flux=1.e4)
+    file_name = os.path.join('output', 'test_native_io.fits')
+    file_name2 = os.path.join('output', 'test_native_io_pyfits.fits')
+    for dtype in [ np.int16, np.int32, np.float32, np.float64 ]:
+        im = galsim.Image(bounds, dtype=dtype, scale=0.2)
+        gal.drawImage(im, method='no_pixel')
+        im += 3
+        im.header = galsim.FitsHeader({ 'OBJECT' : 'Gaussian', 'EXPTIME' : 30. })
+        for compression in [ 'none', 'gzip_tile', 'rice' ]:
+            if compression == 'rice' and dtype in [ np.float32, np.float64 ]:
+                # This goes through pyfits, which quantizes the values, so skip it here.
+                continue
+            galsim.fits.write(im, file_name, compression=compression, native=True)
+            im2 = galsim.fits.read(file_name, compression=compression)
+            assert im2.bounds == bounds
+            assert im2.dtype == dtype
+            assert im2.scale == 0.2
+            np.testing.assert_array_equal(im2.array, im.array)
+
+            # Compare to the same image written by pyfits (the default).  The headers should
+            # have the same items.  Only pyfits quantizes floats with gzip_tile.
+            galsim.fits.write(im, file_name2, compression=compression)
+            im4 = galsim.fits.read(file_name2, compression=compression)
+            assert im4.bounds == im2.bounds
+            assert im4.wcs == im2.wcs
+            if compression == 'gzip_tile' and dtype in [ np.float32, np.float64 ]:
+                np.testing.assert_allclose(im4.array, im.array, rtol=1.e-3, atol=1.e-3)
+            else:
+                np.testing.assert_array_equal(im4.array, im2.array)
+            hdu1, hdu_list1, fin1 = galsim.fits.readFile(file_name, compression=compression)
+            hdu2, hdu_list2, fin2 = galsim.fits.readFile(file_name2, compression=compression)
+            for key in hdu2.header.keys():
+                if key.startswith('Z') or key in [ '', 'COMMENT', 'HISTORY', 'EXTEND',
+                                                   'CHECKSUM', 'DATASUM' ]:
+                    continue
+                assert key in hdu1.header, "Native header is missing %s"%key
+                assert hdu1.header[key] == hdu2.header[key], "Native header differs for %s"%key
+            galsim.fits.closeHDUList(hdu_list1, fin1)
+            galsim.fits.closeHDUList(hdu_list2, fin2)
+
+            # Read part of the image.
+            b = galsim.BoundsI(10,33,7,41)
+            im3 = galsim.fits.read(file_name, compression=compression, bounds=b)
+            assert im3.bounds == b
+            assert im3.scale == 0.2
+            np.testing.assert_array_equal(im3.array, im[b].array)
+
+    # Write the image a few rows at a time.
+    for compression in [ 'none', 'gzip_tile' ]:
+        im = galsim.ImageF(bounds, scale=0.2)
+        gal.drawImage(im)
+        with galsim.fits.FitsWriter(file_name, bounds, wcs=im.wcs,
+                                    compression=compression) as writer:
+            for ymin in range(bounds.ymin, bounds.ymax+1, 7):
+                assert writer.next_row == ymin
+                b = galsim.BoundsI(bounds.xmin, bounds.xmax, ymin, min(ymin+6, bounds.ymax))
+                writer.write(im[b])
+        im2 = galsim.fits.read(file_name, compression=compression)
+        assert im2.bounds == bounds
+        assert im2.scale == 0.2
+        np.testing.assert_array_equal(im2.array, im.array)
+
+    try:
+        writer = galsim.fits.FitsWriter(file_name, bounds)
+        b = galsim.BoundsI(bounds.xmin, bounds.xmax, bounds.ymin+1, bounds.ymin+5)
+        np.testing.assert_raises(RuntimeError, writer.write, galsim.ImageF(b))
+        np.testing.assert_raises(RuntimeError, writer.close)
+        np.testing.assert_raises(ValueError, galsim.fits.FitsWriter, file_name, bounds,
+                                 compression='hcompress')
+        np.testing.assert_raises(IOError, galsim.fits.FitsWriter, file_name, bounds,
+                                 clobber=False)
+    except ImportError:
+        pass
+
+
 if __name__ == "__main__":
     test_Image_basic()
     test_Image_FITS_IO()
@@ -1831,3 +2079,7 @@ if __name__ == "__main__":
     test_Image_writeheader()
     test_ne()
     test_copy()
+    test_zero_copy()
+    test_mapped_image()
+    test_tiled_image()
+    test_fits_native_io()
@@ -62,6 +62,39 @@ private :
     double _expon;
 };
 
+// A Gaussian that counts how many points are evaluated through the batch interface
+class BatchGauss : public std::unary_function<double,double>
+{
+public :
+    BatchGauss(double sig) : _sig(sig), _nbatch(0), _nsingle(0) {}
+
+    double operator()(double x) const
+    { ++_nsingle; return exp(-0.5*pow(x/_sig,2)); }
+
+    void eval(const double* x, double* f, int n) const
+    {
+        _nbatch += n;
+        for (int i=0; i<n; ++i) f[i] = exp(-0.5*pow(x[i]/_sig,2));
+    }
+
+    int getNBatch() const { return _nbatch; }
+    int getNSingle() const { return _nsingle; }
+
+private :
+    double _sig;
+    mutable int _nbatch, _nsingle;
+};
+
+namespace galsim {
+namespace integ {
+    template <>
+    struct BatchEval<BatchGauss>
+    {
+        static void eval(const BatchGauss& func, const double* x, double* f, int n)
+        { func.eval(x,f,n); }
+    };
+}}
+
 // A straight function, rather than a functional class:
 double osc_func(double x)
 { return sin(pow(x,2)) * exp(-std::abs(x)); }
@@ -112,6 +145,37 @@ BOOST_AUTO_TEST_CASE( TestGaussian )
         100 * test_rel_err);
 }
 
+BOOST_AUTO_TEST_CASE( TestBatch )
+{
+    // Should get the same answers as TestGaussian, but with all the function evaluations
+    // going through the batch interface.
+    BatchGauss gauss(test_sigma);
+
+    BOOST_CHECK_CLOSE(
+        galsim::integ::int1d(gauss, -1., 1., test_rel_err, test_abs_err),
+        1.99321805307377285009,
+        100 * test_rel_err);
+
+    BOOST_CHECK_CLOSE(
+        galsim::integ::int1d(gauss, 0., 20., test_rel_err, test_abs_err),
+        8.73569586966967345835,
+        100 * test_rel_err);
+
+    // The infinite regions use a change of variables, which should still use the batches.
+    BOOST_CHECK_CLOSE(
+        galsim::integ::int1d(gauss, 0., test_mock_inf, test_rel_err, test_abs_err),
+        8.77319896120850210849,
+        100 * test_rel_err);
+
+    BOOST_CHECK_CLOSE(
+        galsim::integ::int1d(gauss, -test_mock_inf, test_mock_inf, test_rel_err, test_abs_err),
+        17.54639792241700421699,
+        100 * test_rel_err);
+
+    BOOST_CHECK(gauss.getNBatch() > 0);
+    BOOST_CHECK_EQUAL(gauss.getNSingle(), 0);
+}
+
 BOOST_AUTO_TEST_CASE( TestOscillatory )
 {
     BOOST_CHECK_CLOSE(
@@ -693,6 +693,75 @@ def test_corr_padding():
         do_pickle(int_im3)
 
 
+@timer
+def test_noise_pad_cpp():
+    """Test the details of the noise padding, which is done in the C++ layer.
+    """
+    noise_var = 1.7
+    orig_img = galsim.ImageF(33, 40, scale=1.)
+    galsim.Gaussian(sigma=3., flux=100.).drawImage(orig_img, method='no_pixel')
+    orig_img.setCenter(0,0)
+    pad_size = 192
+
+    def outside(im, b):
+        # The pixels of im that are outside the bounds b.
+        mask = np.ones(im.array.shape, dtype=bool)
+        mask[b.ymin-im.ymin:b.ymax-im.ymin+1, b.xmin-im.xmin:b.xmax-im.xmin+1] = False
+        return im.array[mask]
+
+    # The image is in the center of the padded image, and the rest is noise.
+    int_im = galsim.InterpolatedImage(orig_img, noise_pad=noise_var, noise_pad_size=pad_size,
+                                      rng=galsim.BaseDeviate(1234))
+    pad_im = int_im._pad_image
+    assert pad_im.array.shape == (pad_size, pad_size)
+    np.testing.assert_array_equal(pad_im[orig_img.bounds].array, orig_img.array,
+                                  err_msg='Original image not at the center of the padding')
+    np.testing.assert_almost_equal(np.var(outside(pad_im, orig_img.bounds)) / noise_var, 1.,
+                                   decimal=1, err_msg='Wrong variance of padding noise')
+    np.testing.assert_almost_equal(int_im.flux, pad_im.array.sum(), decimal=8)
+    do_pickle(int_im)
+
+    # Zero variance is the same as padding with zeros.
+    int_im0 = galsim.InterpolatedImage(orig_img, noise_pad=0., noise_pad_size=pad_size)
+    assert np.all(outside(int_im0._pad_image, orig_img.bounds) == 0.)
+    np.testing.assert_array_equal(int_im0._pad_image[orig_img.bounds].array, orig_img.array)
+
+    # Correlated noise uses the square root of the power spectrum stored in the CorrelatedNoise,
+    # so it is only calculated once for many objects.
+    cn = galsim.CorrelatedNoise(1.e2*galsim.fits.read('fits_files/blankimg.fits'),
+                                galsim.BaseDeviate(5))
+    int_im1 = galsim.InterpolatedImage(orig_img, noise_pad=cn, noise_pad_size=pad_size,
+                                       rng=galsim.BaseDeviate(5678))
+    assert len(cn._rootps_store) == 1
+    assert cn._rootps_store[0][1].shape == (pad_size, pad_size//2+1)
+    int_im2 = galsim.InterpolatedImage(orig_img, noise_pad=cn, noise_pad_size=pad_size,
+                                       rng=galsim.BaseDeviate(5678))
+    assert len(cn._rootps_store) == 1
+    np.testing.assert_array_equal(int_im1._pad_image.array, int_im2._pad_image.array)
+    np.testing.assert_array_equal(int_im1._pad_image[orig_img.bounds].array, orig_img.array)
+    np.testing.assert_almost_equal(
+        np.var(outside(int_im1._pad_image, orig_img.bounds)) / cn.getVariance(), 1., decimal=1,
+        err_msg='Wrong variance of correlated padding noise')
+    # The padding is the same noise that CorrelatedNoise would add to the whole padded image.
+    ref = galsim.ImageD(int_im1._pad_image.bounds)
+    galsim.correlatednoise._add_noise_from_rootps(galsim.BaseDeviate(5678), ref,
+                                                  cn._rootps_store[0][1], (pad_size, pad_size))
+    np.testing.assert_array_almost_equal(
+        outside(int_im1._pad_image, orig_img.bounds), outside(ref, orig_img.bounds), decimal=5,
+        err_msg='Correlated padding noise does not match CorrelatedNoise')
+    do_pickle(int_im1)
+
+    # The pad_image goes between the image and the noise.
+    pad_img = galsim.ImageF(64, 64, init_value=0.5)
+    int_im3 = galsim.InterpolatedImage(orig_img, noise_pad=noise_var, noise_pad_size=pad_size,
+                                       pad_image=pad_img, rng=galsim.BaseDeviate(1234))
+    pad_img.setCenter(0,0)
+    expected = pad_img.copy()
+    expected[orig_img.bounds] = orig_img
+    np.testing.assert_array_equal(int_im3._pad_image[pad_img.bounds].array, expected.array)
+    assert np.all(outside(int_im3._pad_image, pad_img.bounds) != 0.5)
+
+
 @timer
 def test_realspace_conv():
     """Test that real-space convolution of an InterpolatedImage matches the FFT result
@@ -969,6 +1038,111 @@ def test_stepk_maxk():
     do_pickle(new_int_im)
 
 
+@timer
+def test_calculate_stepk_maxk():
+    """Test the stepK and maxK calculations against direct numpy versions of the same thing.
+    """
+    scale = 0.2
+    n = 61
+    obj = galsim.Gaussian(sigma=1.3) + galsim.Gaussian(sigma=0.4, flux=0.3).shift(0.5, -0.3)
+    im = obj.drawImage(nx=n, ny=n, scale=scale, method='no_pixel')
+    gsp = galsim.GSParams(folding_threshold=1.e-2, maxk_threshold=1.e-3)
+    int_im = galsim.InterpolatedImage(im, gsparams=gsp)
+
+    # A single central pixel encloses all the flux within d=1, which gives us the interpolant's
+    # contribution to R.
+    delta = galsim.ImageD(n, n, scale=scale)
+    delta.setValue(n//2+1, n//2+1, 1.)
+    delta_im = galsim.InterpolatedImage(delta, gsparams=gsp)
+    R2sq = (np.pi / delta_im._sbii.stepK())**2 - 1.5**2
+
+    # Find the smallest box enclosing (1-folding_threshold) of the flux, using the same rules as
+    # the C++ code.
+    arr = im.array
+    c = n//2
+    thresh = (1.-gsp.folding_threshold) * arr.sum()
+    d1 = 0
+    for d in range(1, n//2+1):
+        flux = arr[c-d:c+d+1, c-d:c+d+1].sum()
+        if flux < thresh:
+            d1 = 0
+        elif d1 == 0:
+            d1 = d
+    assert d1 > 0
+    np.testing.assert_almost_equal(int_im._sbii.stepK(), np.pi / np.sqrt((d1+0.5)**2 + R2sq),
+                                   decimal=10, err_msg="InterpolatedImage stepK is incorrect")
+
+    # The maxk calculation uses the FT of the unpadded image, which samples the FT on a coarser
+    # grid than the padded one.  So it can differ from the value found from the padded FT by
+    # about one unpadded k spacing, in either direction.
+    pad = 4 * n
+    karr = np.abs(np.fft.fft2(np.pad(arr, [(0, pad-n), (0, pad-n)], mode='constant')))
+    kthresh = gsp.maxk_threshold * arr.sum()
+    ik = np.fft.fftfreq(pad) * pad
+    kmax = np.maximum.outer(np.abs(ik), np.abs(ik))
+    maxk_fine = (kmax[karr > kthresh].max() + 1) * 2.*np.pi/pad
+    maxk = int_im._sbii.maxK()
+    dk_coarse = 2.*np.pi / galsim._galsim.goodFFTSize(n)
+    print('maxk = ', maxk, maxk_fine, dk_coarse)
+    assert maxk >= maxk_fine - dk_coarse - 1.e-10
+    assert maxk <= maxk_fine + dk_coarse + 1.e-10
+
+    # The padded KTable is built when a k value is first needed.
+    np.testing.assert_almost_equal(int_im.kValue(galsim.PositionD(0.,0.)).real / int_im.flux,
+                                   1., decimal=10)
+
+
+@timer
+def test_ktable_cache():
+    """Test that InterpolatedImages made from the same pixels share their padded image and FT.
+    """
+    im = galsim.Exponential(half_light_radius=0.7).drawImage(nx=48, ny=48, scale=0.2)
+    galsim.InterpolatedImage.resize_ktable_cache(0)
+    assert galsim.InterpolatedImage.ktable_cache_bytes() == 0
+    ii0 = galsim.InterpolatedImage(im, x_interpolant='lanczos5')
+    kim0 = ii0.drawKImage(nx=32, ny=32, scale=0.3)
+    assert galsim.InterpolatedImage.ktable_cache_bytes() == 0
+
+    galsim.InterpolatedImage.resize_ktable_cache(256 * 1024**2)
+    ii1 = galsim.InterpolatedImage(im, x_interpolant='lanczos5')
+    nbytes_x = galsim.InterpolatedImage.ktable_cache_bytes()
+    N = ii1._sbii.getPaddedImage().array.shape[0]
+    assert nbytes_x == N * N * 8
+    kim1 = ii1.drawKImage(nx=32, ny=32, scale=0.3)
+    nbytes_k = galsim.InterpolatedImage.ktable_cache_bytes()
+    assert nbytes_k == nbytes_x + N * (N//2+1) * 16
+
+    # The same pixel values reuse the cached tables, even with a different interpolant.
+    ii2 = galsim.InterpolatedImage(im.copy(), x_interpolant='lanczos5')
+    kim2 = ii2.drawKImage(nx=32, ny=32, scale=0.3)
+    assert galsim.InterpolatedImage.ktable_cache_bytes() == nbytes_k
+    ii3 = galsim.InterpolatedImage(im, x_interpolant='quintic', k_interpolant='cubic')
+    ii3.drawKImage(nx=32, ny=32, scale=0.3)
+    assert galsim.InterpolatedImage.ktable_cache_bytes() == nbytes_k
+    for kim in (kim1, kim2):
+        np.testing.assert_array_equal(kim[0].array, kim0[0].array)
+        np.testing.assert_array_equal(kim[1].array, kim0[1].array)
+    ii4 = galsim.InterpolatedImage(im, x_interpolant='lanczos5', k_interpolant='cubic')
+    np.testing.assert_almost_equal(
+        ii4.kValue(galsim.PositionD(0.3, -0.2)),
+        galsim.InterpolatedImage(im, k_interpolant='cubic').kValue(galsim.PositionD(0.3, -0.2)),
+        decimal=12)
+
+    # Different pixel values get their own entry.
+    ii6 = galsim.InterpolatedImage(im * 2., x_interpolant='lanczos5')
+    assert galsim.InterpolatedImage.ktable_cache_bytes() == nbytes_k + nbytes_x
+
+    # A small cache only keeps the most recent entries, but the profiles still work.
+    galsim.InterpolatedImage.resize_ktable_cache(nbytes_k)
+    assert galsim.InterpolatedImage.ktable_cache_bytes() <= nbytes_k
+    kim6 = ii6.drawKImage(nx=32, ny=32, scale=0.3)
+    np.testing.assert_array_almost_equal(kim6[0].array, 2.*kim0[0].array, decimal=12)
+    kim1b = ii1.drawKImage(nx=32, ny=32, scale=0.3)
+    np.testing.assert_array_equal(kim1b[0].array, kim1[0].array)
+
+    galsim.InterpolatedImage.resize_ktable_cache(256 * 1024**2)
+
+
 @timer
 def test_kroundtrip():
     a = final
@@ -1167,6 +1341,7 @@ if __name__ == "__main__":
     test_uncorr_padding()
     test_pad_image()
     test_corr_padding()
+    test_noise_pad_cpp()
     test_realspace_conv()
     test_Cubic_ref()
     test_Quintic_ref()
@@ -1174,6 +1349,8 @@ if __name__ == "__main__":
     test_Lanczos7_ref()
     test_conserve_dc()
     test_stepk_maxk()
+    test_calculate_stepk_maxk()
+    test_ktable_cache()
     test_kroundtrip()
     test_multihdu_readin()
     test_ne()
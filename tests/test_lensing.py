@@ -1150,6 +1150,98 @@ def test_psr():
     do_pickle(psr)
 
 
+@timer
+def test_lensing_engine():
+    """Check the C++ realization, Kaiser-Squires inversion and interpolation against the
+    equivalent python calculations.
+    """
+    # The C++ realization should draw the same random numbers as the numpy version.
+    for ngrid in [40, 41]:
+        for p_E, p_B in [(pk2, None), (None, pk2), (pk2, pk1)]:
+            psr = galsim.lensing_ps.PowerSpectrumRealizer(ngrid, 10., p_E, p_B)
+            fields = psr(galsim.GaussianDeviate(1234))
+            fields_py = psr._generate_realization(galsim.GaussianDeviate(1234))
+            for f, f_py in zip(fields, fields_py):
+                np.testing.assert_allclose(
+                    f, f_py, rtol=0, atol=1.e-12 * np.max(np.abs(f_py)),
+                    err_msg="PowerSpectrumRealizer disagrees with numpy version for N=%d"%ngrid)
+
+        # Kaiser-Squires
+        ud = galsim.UniformDeviate(314)
+        g1 = galsim.utilities.rand_arr((ngrid,ngrid), ud) - 0.5
+        g2 = galsim.utilities.rand_arr((ngrid,ngrid), ud) - 0.5
+        kE, kB = galsim.lensing_ps.kappaKaiserSquires(g1, g2)
+        kx, ky = galsim.utilities.kxky(g1.shape)
+        kz = kx + ky*1j
+        ksq = kz*np.conj(kz)
+        ksq[0,0] = 1.
+        kz_k = np.conj(kz*kz/ksq) * np.fft.fft2(g1 + g2*1j)
+        kz = np.fft.ifft2(kz_k)
+        np.testing.assert_array_almost_equal(kE, np.real(kz), decimal=12,
+                                             err_msg="Kaiser-Squires kappa_E is incorrect")
+        np.testing.assert_array_almost_equal(kB, np.imag(kz), decimal=12,
+                                             err_msg="Kaiser-Squires kappa_B is incorrect")
+
+    # The interpolation should match SBInterpolatedImage, as the python code used to do.
+    tab_ps = galsim.LookupTable(file='../examples/data/cosmo-fid.zmed1.00_smoothed.out')
+    ps = galsim.PowerSpectrum(tab_ps, units=galsim.radians)
+    for ngrid in [50, 51]:
+        g1, g2, kappa = ps.buildGrid(grid_spacing=0.1, ngrid=ngrid, units=galsim.degrees,
+                                     rng=galsim.BaseDeviate(8675309), get_convergence=True)
+        g1_r, g2_r, mu = galsim.lensing_ps.theoryToObserved(g1, g2, kappa)
+        ud = galsim.UniformDeviate(1234)
+        b = ps.bounds
+        x = b.xmin + (b.xmax-b.xmin) * galsim.utilities.rand_arr((1,30), ud)[0]
+        y = b.ymin + (b.ymax-b.ymin) * galsim.utilities.rand_arr((1,30), ud)[0]
+        u = (x - ps.center.x) / ps.grid_spacing
+        v = (y - ps.center.y) / ps.grid_spacing
+        for interpolant in [None, 'linear', galsim.Quintic()]:
+            if interpolant is None:
+                xinterp = galsim.Lanczos(5)
+            else:
+                xinterp = galsim.utilities.convert_interpolant(interpolant)
+
+            def ref(arr):
+                sbii = galsim._galsim.SBInterpolatedImage(galsim.ImageD(arr).image,
+                                                          xInterp=xinterp,
+                                                          kInterp=galsim.Quintic())
+                return [sbii.xValue(galsim.PositionD(u[i],v[i])) for i in range(len(u))]
+
+            test_g1_r, test_g2_r, test_mu = ps.getLensing((x,y), interpolant=interpolant)
+            test_g1, test_g2 = ps.getShear((x,y), reduced=False, interpolant=interpolant)
+            test_kappa = ps.getConvergence((x,y), interpolant=interpolant)
+            test_mu_2 = ps.getMagnification((x,y), interpolant=interpolant)
+            np.testing.assert_array_almost_equal(test_g1_r, ref(g1_r), decimal=12)
+            np.testing.assert_array_almost_equal(test_g2_r, ref(g2_r), decimal=12)
+            np.testing.assert_array_almost_equal(test_mu, np.array(ref(mu-1))+1, decimal=12)
+            np.testing.assert_array_almost_equal(test_mu_2, test_mu, decimal=12)
+            np.testing.assert_array_almost_equal(test_g1, ref(g1), decimal=12)
+            np.testing.assert_array_almost_equal(test_g2, ref(g2), decimal=12)
+            np.testing.assert_array_almost_equal(test_kappa, ref(kappa), decimal=12)
+
+        # The quantities for getLensing, getShear(reduced=True), and getMagnification share a
+        # table, so there should be one table per kind and interpolant.
+        assert len(ps._lensing_grids) == 3 * 3
+
+        # Periodic interpolation should repeat with the period of the grid, and match the
+        # non-periodic interpolation away from the edges.
+        period = ngrid * ps.grid_spacing
+        test_g1, test_g2 = ps.getShear((x,y), periodic=True)
+        test_g1_shift, test_g2_shift = ps.getShear((x+3*period, y-2*period), periodic=True)
+        np.testing.assert_array_almost_equal(test_g1_shift, test_g1, decimal=10)
+        np.testing.assert_array_almost_equal(test_g2_shift, test_g2, decimal=10)
+        inner = ((np.abs(u) < ngrid/2. - 6) & (np.abs(v) < ngrid/2. - 6))
+        test_g1_np, test_g2_np = ps.getShear((x,y))
+        np.testing.assert_array_almost_equal(test_g1[inner], test_g1_np[inner], decimal=12)
+        np.testing.assert_array_almost_equal(test_g2[inner], test_g2_np[inner], decimal=12)
+
+        # The tables are remade as needed after pickling.
+        import pickle
+        do_pickle(ps)
+        ps2 = pickle.loads(pickle.dumps(ps))
+        np.testing.assert_array_equal(ps2.getShear((x,y)), ps.getShear((x,y)))
+
+
 if __name__ == "__main__":
     test_nfwhalo()
     test_cosmology()
@@ -1165,3 +1257,4 @@ if __name__ == "__main__":
     test_periodic()
     test_bandlimit()
     test_psr()
+    test_lensing_engine()
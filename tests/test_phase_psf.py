@@ -308,6 +308,78 @@ def test_phase_psf_batch():
             "Individually generated AtmosphericPSF differs from AtmosphericPSF generated in batch")
 
 
+@timer
+def test_screen_wavefront():
+    """Test the C++ evaluation of AtmosphericScreen wavefronts."""
+    rng = galsim.BaseDeviate(5678)
+    aper = galsim.Aperture(diam=1.0, lam=500.0)
+    atm = galsim.Atmosphere(screen_size=10.0, altitude=[0.0, 5.0, 10.0], speed=[1.0, 5.0, 9.0],
+                            direction=[0*galsim.degrees, 60*galsim.degrees, 200*galsim.degrees],
+                            alpha=[1.0, 0.99, 1.0], rng=rng)
+    atm.append(galsim.OpticalScreen(defocus=0.2, coma1=0.1))
+    # Advance a few times, so the pupil wraps around the periodic screens.
+    atm.advance_by(1.5)
+
+    theta = [(0.*galsim.arcmin, 0.*galsim.arcmin), (2.*galsim.arcmin, -1.*galsim.arcmin),
+             (-3.*galsim.arcmin, 0.5*galsim.arcmin)]
+    u, v = aper.u[aper.illuminated], aper.v[aper.illuminated]
+    for layer in atm[:3]:
+        for th in theta:
+            x = u + layer.origin[0] + 1000*layer.altitude*th[0].tan()
+            y = v + layer.origin[1] + 1000*layer.altitude*th[1].tan()
+            np.testing.assert_allclose(
+                layer.wavefront(aper, th), layer.tab2d(x, y), rtol=1.e-10, atol=1.e-10,
+                err_msg="AtmosphericScreen wavefront doesn't match LookupTable2D")
+        np.testing.assert_allclose(
+            layer.wavefront(aper, compact=False)[aper.illuminated], layer.wavefront(aper),
+            rtol=1.e-12, err_msg="Non-compact wavefront doesn't match compact wavefront")
+
+    # The batched wavefronts should match the ones done one field angle at a time.
+    wfs = atm._wavefronts(aper, theta)
+    assert wfs.shape == (len(theta), len(u))
+    for wf, th in zip(wfs, theta):
+        np.testing.assert_array_equal(wf, atm.wavefront(aper, th),
+                                      "Batched wavefront doesn't match single wavefront")
+        np.testing.assert_allclose(
+            wf, np.sum([layer.wavefront(aper, th) for layer in atm], axis=0), rtol=1.e-12,
+            err_msg="PhaseScreenList wavefront doesn't match sum of layers")
+
+    # Check that the screen survives pickling after boiling.
+    do_pickle(atm[1], func=lambda x: x.wavefront(aper).sum())
+
+
+@timer
+def test_pupil_fft():
+    """Test the C++ pupil FFT against the equivalent numpy calculation."""
+    rng = galsim.BaseDeviate(9876)
+    lam = 700.0
+    atm = galsim.Atmosphere(screen_size=10.0, altitude=[0.0, 8.0], speed=[2.0, 7.0], rng=rng)
+    aper = galsim.Aperture(diam=2.0, lam=lam, obscuration=0.3, nstruts=3, screen_list=atm)
+    theta = [(0.*galsim.arcmin, 0.*galsim.arcmin), (1.*galsim.arcmin, 2.*galsim.arcmin),
+             (-2.*galsim.arcmin, 1.*galsim.arcmin)]
+    wfs = atm._wavefronts(aper, theta)
+
+    imgs = np.zeros((len(theta),) + aper.illuminated.shape)
+    aper._get_pupil_fft().accumulate(wfs, lam, imgs)
+    for wf, img in zip(wfs, imgs):
+        expwf_grid = np.zeros_like(aper.illuminated).astype(np.complex128)
+        expwf_grid[aper.illuminated] = np.exp(2j * np.pi * wf / lam)
+        ref = np.abs(np.fft.fft2(np.fft.fftshift(expwf_grid)))**2
+        np.testing.assert_allclose(img, ref, rtol=1.e-9, atol=1.e-9*ref.max(),
+                                   err_msg="Pupil FFT doesn't match numpy calculation")
+
+    # Accumulating adds to what is already there.
+    aper._get_pupil_fft().accumulate(wfs, lam, imgs)
+    for wf, img in zip(wfs, imgs):
+        single = np.zeros((1,) + aper.illuminated.shape)
+        aper._get_pupil_fft().accumulate(wf.reshape(1,-1), lam, single)
+        np.testing.assert_allclose(img, 2*single[0], rtol=1.e-12,
+                                   err_msg="Pupil FFT didn't accumulate correctly")
+
+    # The cached object should not be pickled with the aperture.
+    do_pickle(aper)
+
+
 @timer
 def test_opt_indiv_aberrations():
     """Test that aberrations specified by name match those specified in `aberrations` list."""
@@ -428,6 +500,8 @@ if __name__ == "__main__":
     test_frozen_flow()
     test_phase_psf_reset()
     test_phase_psf_batch()
+    test_screen_wavefront()
+    test_pupil_fft()
     test_opt_indiv_aberrations()
     test_scale_unit()
     test_ne()
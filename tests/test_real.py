@@ -202,6 +202,67 @@ def test_real_galaxy_saved():
     do_pickle(rg)
 
 
+@timer
+def test_stamp_store():
+    """Test reading the images from a stamp store and the caching of InterpolatedImages"""
+    rgc = galsim.RealGalaxyCatalog(catalog_file, dir=image_dir)
+    store_file = os.path.abspath(os.path.join('output', 'test_real_stamps.dat'))
+    rgc.writeStampStore(store_file)
+
+    rgc2 = galsim.RealGalaxyCatalog(catalog_file, dir=image_dir, stamp_store=store_file)
+    for i in range(rgc.getNObjects()):
+        for im1, im2 in [ (rgc.getGal(i), rgc2.getGal(i)), (rgc.getPSF(i), rgc2.getPSF(i)) ]:
+            np.testing.assert_equal(im2.bounds, im1.bounds)
+            np.testing.assert_equal(im2.scale, im1.scale)
+            np.testing.assert_equal(im2.array.dtype, np.float64)
+            np.testing.assert_array_equal(im2.array, im1.array,
+                                          "Image %d from stamp store is wrong"%i)
+
+    # RealGalaxy objects built from either catalog should be identical.
+    rg1 = galsim.RealGalaxy(rgc, index=ind_real)
+    rg2 = galsim.RealGalaxy(rgc2, index=ind_real)
+    psf = galsim.Gaussian(sigma=0.3)
+    im1 = galsim.Convolve(rg1, psf).drawImage(nx=32, ny=32, scale=0.1)
+    im2 = galsim.Convolve(rg2, psf).drawImage(nx=32, ny=32, scale=0.1)
+    np.testing.assert_array_equal(im2.array, im1.array,
+                                  "RealGalaxy from stamp store is wrong")
+
+    # Without noise padding, the InterpolatedImages are shared among RealGalaxy objects.
+    rg3 = galsim.RealGalaxy(rgc2, index=ind_real)
+    assert rg3.original_gal is rg2.original_gal
+    assert rg3.original_psf is rg2.original_psf
+    rg4 = galsim.RealGalaxy(rgc2, index=ind_real, x_interpolant='linear')
+    assert rg4.original_gal is not rg2.original_gal
+    rg5 = galsim.RealGalaxy(rgc2, index=ind_real, noise_pad_size=5, rng=galsim.BaseDeviate(123))
+    assert rg5.original_gal is not rg2.original_gal
+
+    # The caching can be turned off.
+    rgc3 = galsim.RealGalaxyCatalog(catalog_file, dir=image_dir, stamp_store=store_file,
+                                    cache_size=0)
+    rg6 = galsim.RealGalaxy(rgc3, index=ind_real)
+    rg7 = galsim.RealGalaxy(rgc3, index=ind_real)
+    assert rg7.original_gal is not rg6.original_gal
+    np.testing.assert_array_equal(rg7.gal_image.array, rg6.gal_image.array)
+
+    # The store is opened again when the catalog is unpickled or used after close().
+    do_pickle(rgc2, lambda x: [ x.getGal(ind_real), x.getPSF(ind_real) ])
+    do_pickle(rg2)
+    rgc2.close()
+    np.testing.assert_array_equal(rgc2.getGal(ind_fake).array, rgc.getGal(ind_fake).array)
+
+    # A file that is not a stamp store is an error.
+    with open(store_file, 'rb') as f:
+        data = f.read()
+    bad_file = os.path.join('output', 'test_real_stamps_bad.dat')
+    with open(bad_file, 'wb') as f:
+        f.write(b'NotAStampStore!!' + data[16:])
+    try:
+        np.testing.assert_raises(IOError, galsim.RealGalaxyCatalog, catalog_file, dir=image_dir,
+                                 stamp_store=os.path.abspath(bad_file))
+    except ImportError:
+        print('The assert_raises tests require nose')
+
+
 @timer
 def test_ne():
     """ Check that inequality works as expected."""
@@ -222,4 +283,5 @@ def test_ne():
 if __name__ == "__main__":
     test_real_galaxy_ideal()
     test_real_galaxy_saved()
+    test_stamp_store()
     test_ne()
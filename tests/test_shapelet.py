@@ -157,6 +157,37 @@ def test_shapelet_properties():
     do_pickle(shapelet)
 
 
+@timer
+def test_shapelet_high_order():
+    """Test that the grid fills for a high-order Shapelet match xValue and kValue.
+    """
+    sigma = 1.3
+    order = 16
+    rng = np.random.RandomState(1234)
+    bvec = rng.uniform(-0.5, 0.5, size=galsim.ShapeletSize(order))
+    shapelet = galsim.Shapelet(sigma=sigma, order=order, bvec=bvec)
+
+    # Use a shear so we get the general (non-quadrant) fill too.
+    for obj in [shapelet, shapelet.shear(g1=0.2, g2=-0.1)]:
+        im = obj.drawImage(nx=21, ny=19, scale=0.4, method='no_pixel', dtype=float)
+        for x,y in [ (1,1), (3,17), (11,10), (20,4), (21,19) ]:
+            pos = im.wcs.toWorld(galsim.PositionD(x,y) - im.trueCenter())
+            np.testing.assert_almost_equal(
+                im(x,y), obj.xValue(pos) * 0.4**2, 10,
+                err_msg="Shapelet drawImage disagrees with xValue at %d,%d"%(x,y))
+
+        re, im = obj.drawKImage(nx=21, ny=19, dk=0.3, dtype=float)
+        for x,y in [ (1,1), (3,17), (11,10), (20,4), (21,19) ]:
+            kpos = galsim.PositionD((x-11)*0.3, (y-10)*0.3)
+            kval = obj.kValue(kpos)
+            np.testing.assert_almost_equal(
+                re(x,y), kval.real, 10,
+                err_msg="Shapelet drawKImage (real) disagrees with kValue at %d,%d"%(x,y))
+            np.testing.assert_almost_equal(
+                im(x,y), kval.imag, 10,
+                err_msg="Shapelet drawKImage (imag) disagrees with kValue at %d,%d"%(x,y))
+
+
 @timer
 def test_shapelet_fit():
     """Test fitting a Shapelet decomposition of an image
@@ -293,6 +324,7 @@ if __name__ == "__main__":
     test_shapelet_gaussian()
     test_shapelet_drawImage()
     test_shapelet_properties()
+    test_shapelet_high_order()
     test_shapelet_fit()
     test_shapelet_adjustments()
     test_ne()
@@ -361,6 +361,79 @@ def test_table2d():
         print('The assert_raises tests require nose')
 
 
+@timer
+def test_table2d_interpolants():
+    """Check that the various ways of evaluating a LookupTable2D agree for all the interpolants,
+    and check the accuracy of the spline interpolant.
+    """
+    def f(x_, y_):
+        return np.sin(x_) * np.cos(y_) + x_
+
+    x = np.linspace(0.1, 3.3, 25)
+    y = np.linspace(0.2, 10.4, 75)
+    newx = np.linspace(0.2, 3.1, 45)
+    newy = np.linspace(0.3, 10.1, 85)
+    newyy, newxx = np.meshgrid(newy, newx)
+
+    # Check both equally-spaced and non-equally-spaced grids.
+    for xx_, yy_ in [(x, y), (np.delete(x, 10), np.delete(y, 10))]:
+        yy, xx = np.meshgrid(yy_, xx_)
+        z = f(xx, yy)
+        for interpolant in ['linear', 'floor', 'ceil', 'nearest', 'spline']:
+            tab2d = galsim.LookupTable2D(xx_, yy_, z, interpolant=interpolant)
+            do_pickle(tab2d)
+            # Evaluating arrays (with interpMany) must match the individual lookups and
+            # interpManyMesh.
+            ref = tab2d(newxx, newyy)
+            np.testing.assert_array_equal(
+                ref, np.array([[tab2d(x0, y0) for y0 in newy] for x0 in newx]),
+                err_msg="Table2D lookup disagrees with interpMany for %s"%interpolant)
+            vals = np.empty_like(ref)
+            tab2d.table.interpManyMesh(newx, newy, vals)
+            np.testing.assert_array_equal(
+                ref, vals,
+                err_msg="Table2D interpManyMesh disagrees with interpMany for %s"%interpolant)
+            # At the grid points, all the interpolants should give the input values.
+            np.testing.assert_array_almost_equal(tab2d(xx, yy), z, decimal=12)
+
+        # The spline should be much more accurate than linear for this smooth function.
+        lin_err = np.max(np.abs(galsim.LookupTable2D(xx_, yy_, z)(newxx, newyy) -
+                                f(newxx, newyy)))
+        spl_err = np.max(np.abs(galsim.LookupTable2D(xx_, yy_, z, interpolant='spline')(
+            newxx, newyy) - f(newxx, newyy)))
+        print('linear err = ',lin_err,', spline err = ',spl_err)
+        assert spl_err < 0.1 * lin_err, "Spline interpolant not more accurate than linear."
+
+    # The spline should reproduce a (bi-)linear function exactly, including at the edges.
+    def f(x_, y_):
+        return 2*x_ + 3*y_
+    x = np.delete(x, 10)
+    yy, xx = np.meshgrid(y, x)
+    tab2d = galsim.LookupTable2D(x, y, f(xx, yy), interpolant='spline')
+    np.testing.assert_array_almost_equal(f(newxx, newyy), tab2d(newxx, newyy))
+    np.testing.assert_array_almost_equal(f(x[0], y[-1]), tab2d(x[0], y[-1]))
+    np.testing.assert_array_almost_equal(f(x[0]+1.e-3, y[-1]-1.e-3),
+                                         tab2d(x[0]+1.e-3, y[-1]-1.e-3))
+
+    # Spline with edge_mode='wrap'
+    x = np.arange(8.)
+    y = np.arange(6.)
+    yy, xx = np.meshgrid(y, x)
+    tab2d = galsim.LookupTable2D(x, y, np.cos(2*np.pi*xx/8.) + np.sin(2*np.pi*yy/6.),
+                                 interpolant='spline', edge_mode='wrap')
+    np.testing.assert_array_almost_equal(tab2d(newxx, newyy), tab2d(newxx+16, newyy-12))
+
+    # Spline needs at least 4 points in each direction.
+    try:
+        x = np.arange(3.)
+        y = np.arange(5.)
+        yy, xx = np.meshgrid(y, x)
+        np.testing.assert_raises(RuntimeError, galsim.LookupTable2D, x, y, xx+yy,
+                                 interpolant='spline')
+    except ImportError:
+        print('The assert_raises tests require nose')
+
+
 @timer
 def test_ne():
     """ Check that inequality works as expected."""
@@ -384,4 +457,5 @@ if __name__ == "__main__":
     test_log()
     test_roundoff()
     test_table2d()
+    test_table2d_interpolants()
     test_ne()
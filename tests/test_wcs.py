@@ -1691,6 +1691,71 @@ def test_gsfitswcs():
     do_celestial_wcs(wcs, 'TanWCS 3')
 
 
+@timer
+def test_gsfitswcs_arrays():
+    """Test the GSFitsWCS transformations of arrays of positions
+    """
+    dir = 'fits_files'
+    rng = np.random.RandomState(8675309)
+
+    for tag in [ 'TAN', 'ZEA', 'TPV', 'SIP' ]:
+        file_name, ref_list = references[tag]
+        wcs = galsim.GSFitsWCS(file_name, dir=dir)
+
+        # The array transformations should match the reference values.
+        ref_ra = np.array([ galsim.HMS_Angle(ref[0]).rad() for ref in ref_list ])
+        ref_dec = np.array([ galsim.DMS_Angle(ref[1]).rad() for ref in ref_list ])
+        ref_x = np.array([ ref[2] for ref in ref_list ], dtype=float)
+        ref_y = np.array([ ref[3] for ref in ref_list ], dtype=float)
+        ra, dec = wcs._radec(ref_x, ref_y)
+        x, y = wcs._xy(ref_ra, ref_dec)
+        for k in range(len(ref_list)):
+            ref_coord = galsim.CelestialCoord(ref_ra[k] * galsim.radians,
+                                              ref_dec[k] * galsim.radians)
+            coord = galsim.CelestialCoord(ra[k] * galsim.radians, dec[k] * galsim.radians)
+            dist = ref_coord.distanceTo(coord) / galsim.arcsec
+            np.testing.assert_almost_equal(dist, 0, digits,
+                                           err_msg="GSFitsWCS %s ra,dec array is wrong"%tag)
+            pixel_scale = wcs.minLinearScale(galsim.PositionD(ref_x[k], ref_y[k]))
+            np.testing.assert_almost_equal((x[k]-ref_x[k])*pixel_scale, 0, digits,
+                                           err_msg="GSFitsWCS %s x array is wrong"%tag)
+            np.testing.assert_almost_equal((y[k]-ref_y[k])*pixel_scale, 0, digits,
+                                           err_msg="GSFitsWCS %s y array is wrong"%tag)
+
+        x = rng.uniform(1., 400., size=(5,20))
+        y = rng.uniform(1., 400., size=(5,20))
+        ra, dec = wcs._radec(x, y)
+        np.testing.assert_equal(ra.shape, x.shape)
+        np.testing.assert_equal(dec.shape, x.shape)
+
+        # The inverse transformation should get back to the original positions.
+        x2, y2 = wcs._xy(ra, dec)
+        np.testing.assert_equal(x2.shape, x.shape)
+        np.testing.assert_almost_equal(x2, x, decimal=6,
+                                       err_msg="GSFitsWCS %s x array is wrong"%tag)
+        np.testing.assert_almost_equal(y2, y, decimal=6,
+                                       err_msg="GSFitsWCS %s y array is wrong"%tag)
+
+        # The analytic jacobians should match the finite difference version in CelestialWCS.
+        # The finite differences over 1 pixel are accurate to better than 1.e-5 of the pixel
+        # scale for these files.
+        jac = wcs._jacobian(x, y)
+        np.testing.assert_equal(jac.shape, (x.size, 4))
+        for k in range(0, x.size, 7):
+            pos = galsim.PositionD(x.flat[k], y.flat[k])
+            jac2 = galsim.wcs.CelestialWCS._local(wcs, pos, None)
+            jac2 = np.array([jac2.dudx, jac2.dudy, jac2.dvdx, jac2.dvdy])
+            np.testing.assert_allclose(jac[k], jac2, rtol=0, atol=2.e-5 * np.max(np.abs(jac2)),
+                                       err_msg="GSFitsWCS %s jacobian array is wrong"%tag)
+
+        # The transformation is made in C++, which needs to be remade when pickling.
+        do_pickle(wcs)
+        wcs2 = wcs.withOrigin(galsim.PositionD(17., -23.))
+        ra2, dec2 = wcs2._radec(x + 17., y - 23.)
+        np.testing.assert_almost_equal(ra2, ra, decimal=12)
+        np.testing.assert_almost_equal(dec2, dec, decimal=12)
+
+
 @timer
 def test_fitswcs():
     """Test the FitsWCS factory function
@@ -1768,5 +1833,6 @@ if __name__ == "__main__":
     test_pyastwcs()
     test_wcstools()
     test_gsfitswcs()
+    test_gsfitswcs_arrays()
     test_fitswcs()
     test_scamp()
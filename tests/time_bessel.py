@@ -0,0 +1,103 @@
+# Copyright (c) 2012-2016 by the GalSim developers team on GitHub
+# https://github.com/GalSim-developers
+#
+# This file is part of GalSim: The modular galaxy image simulation toolkit.
+# https://github.com/GalSim-developers/GalSim
+#
+# GalSim is free software: redistribution and use in source and binary forms,
+# with or without modification, are permitted provided that the following
+# conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions, and the disclaimer given in the accompanying LICENSE
+#    file.
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions, and the disclaimer given in the documentation
+#    and/or other materials provided with the distribution.
+#
+"""Timing tests for the parts of GalSim that use the J0 and J1 Bessel functions.
+
+Run this with the current version and with one from before the batch Bessel functions (or with
+the scalar calls put back) to compare.
+"""
+
+from __future__ import print_function
+import numpy as np
+import os
+import sys
+import time
+
+n_iter = 20
+
+try:
+    import galsim
+except ImportError:
+    path, filename = os.path.split(__file__)
+    sys.path.append(os.path.abspath(os.path.join(path, "..")))
+    import galsim
+
+def funcname():
+    import inspect
+    return inspect.stack()[1][3]
+
+def time_j0_j1():
+    """Time the scalar python functions.  This is mostly the python call overhead, so the
+    ctypes calls of the C library j0 and j1 are timed too for comparison.
+    """
+    import ctypes
+    import ctypes.util
+    libm = ctypes.CDLL(ctypes.util.find_library('m'))
+    libm.j0.restype = ctypes.c_double
+    libm.j0.argtypes = [ ctypes.c_double ]
+    libm.j1.restype = ctypes.c_double
+    libm.j1.argtypes = [ ctypes.c_double ]
+
+    for xmax in [ 6., 30. ]:
+        x_list = list(np.linspace(0., xmax, 100000))
+        for name, f in [ ('galsim.bessel.j0', galsim.bessel.j0), ('libm j0', libm.j0),
+                         ('galsim.bessel.j1', galsim.bessel.j1), ('libm j1', libm.j1) ]:
+            t1 = time.time()
+            for x in x_list: f(x)
+            t2 = time.time()
+            print('time for %s, x < %d = %.3f'%(name,xmax,t2-t1))
+
+def time_hankel():
+    """Time the Hankel transforms of Sersic, Moffat, and Kolmogorov profiles, which integrate
+    J0 in the integrands.  The parameters are changed each time, so the cached results can't
+    be reused.
+    """
+    t1 = time.time()
+    for i in range(n_iter):
+        galsim.Sersic(n=1.5 + 0.01*i, half_light_radius=1.).maxK()
+    t2 = time.time()
+    print('time for Sersic = %.3f'%(t2-t1))
+
+    t1 = time.time()
+    for i in range(n_iter):
+        moffat = galsim.Moffat(beta=2.5 + 0.01*i, fwhm=1., trunc=4.)
+        moffat.kValue(galsim.PositionD(1.,0.))
+    t2 = time.time()
+    print('time for truncated Moffat = %.3f'%(t2-t1))
+
+    t1 = time.time()
+    for i in range(n_iter):
+        gsp = galsim.GSParams(kvalue_accuracy=1.e-5 * (1. + 0.01*i))
+        galsim.Kolmogorov(fwhm=1., gsparams=gsp).kValue(galsim.PositionD(1.,0.))
+    t2 = time.time()
+    print('time for Kolmogorov = %.3f'%(t2-t1))
+
+def time_airy():
+    """Time drawing Airy profiles in real space, which fills the image with J1."""
+    im = galsim.ImageD(512, 512, scale=0.05)
+    for obs in [ 0., 0.3 ]:
+        airy = galsim.Airy(lam_over_diam=1., obscuration=obs)
+        t1 = time.time()
+        for i in range(n_iter):
+            airy.drawImage(im, method='no_pixel')
+        t2 = time.time()
+        print('time for Airy, obscuration = %.1f = %.3f'%(obs,t2-t1))
+
+if __name__ == "__main__":
+    time_j0_j1()
+    time_hankel()
+    time_airy()